@@ -0,0 +1,65 @@
+from conan import ConanFile
+from conan.tools.cmake import CMake, CMakeToolchain, CMakeDeps, cmake_layout
+from conan.tools.files import copy
+import os
+
+
+class MatlabAlgorithmsConan(ConanFile):
+    name = "matlab_algorithms"
+    license = "Proprietary"
+    description = "All algorithms in one unity/LTO static library (auto-generated from MATLAB via MATLAB Coder)"
+    settings = "os", "compiler", "build_type", "arch"
+
+    def set_version(self):
+        """Pass --version; the bundle has no VERSION file of its own."""
+        if not self.version:
+            self.version = "0.0.0"
+
+    def export_sources(self):
+        # Each algorithm's build inputs, plus the shared CMake modules and
+        # the header-only runtime helpers
+        copy(self, "CMakeLists.txt", self.recipe_folder, self.export_sources_folder)
+        for pattern in ("*/algorithm.yaml", "*/cpp/CMakeLists.txt", "*/cpp/*.cpp",
+                        "*/cpp/*.h", "*/generated/*"):
+            copy(self, pattern, self.recipe_folder, self.export_sources_folder,
+                 excludes=("*/cpp/test_*", "_gate_build/*"))
+        copy(self, "*.cmake", os.path.join(self.recipe_folder, "..", "cmake"),
+             os.path.join(self.export_sources_folder, "cmake"))
+        copy(self, "*", os.path.join(self.recipe_folder, "..", "runtime"),
+             os.path.join(self.export_sources_folder, "runtime"), excludes=("test_*", "conanfile.py"))
+
+    def generate(self):
+        tc = CMakeToolchain(self)
+        tc.variables["CMAKE_MODULES_DIR"] = os.path.join(self.source_folder, "cmake").replace("\\", "/")
+        tc.variables["RUNTIME_DIR"] = os.path.join(self.source_folder, "runtime").replace("\\", "/")
+        tc.variables["BUILD_TESTING"] = False  # Tests run separately in CI
+        tc.generate()
+
+        deps = CMakeDeps(self)
+        deps.generate()
+
+    def layout(self):
+        cmake_layout(self)
+
+    def build(self):
+        cmake = CMake(self)
+        cmake.configure()
+        cmake.build()
+
+    def package(self):
+        cmake = CMake(self)
+        cmake.install()
+        # The per-algorithm archives are installed too; only the bundle ships
+        for lib in os.listdir(os.path.join(self.package_folder, "lib")):
+            if lib not in ("libmatlab_algorithms.a", "matlab_algorithms.lib"):
+                os.remove(os.path.join(self.package_folder, "lib", lib))
+
+    def package_info(self):
+        self.cpp_info.libs = ["matlab_algorithms"]
+        if self.settings.os in ("Linux", "FreeBSD"):
+            self.cpp_info.system_libs = ["pthread"]
+        include = os.path.join(self.package_folder, "include")
+        self.cpp_info.includedirs = ["include"] + [
+            os.path.join("include", d) for d in sorted(os.listdir(include))
+            if os.path.isdir(os.path.join(include, d))
+        ]
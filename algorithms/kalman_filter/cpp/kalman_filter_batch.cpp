@@ -0,0 +1,269 @@
+#include "kalman_filter_batch.h"
+
+#include <atomic>
+#include <cmath>
+#include <limits>
+
+#include "kalman_filter.h"
+#include "kalman_filter_batch_kernels.h"
+
+namespace kalman_filter {
+
+namespace kernels {
+
+void batch_portable(
+    int n,
+    double position[],
+    double velocity[],
+    double cov11[],
+    double cov12[],
+    double cov21[],
+    double cov22[],
+    const double measurement[],
+    const double measurement_noise[],
+    const double process_noise[])
+{
+    for (int i = 0; i < n; i++) {
+        const double state[2] = {position[i], velocity[i]};
+        const double cov[4] = {cov11[i], cov12[i], cov21[i], cov22[i]};
+        double new_state[2];
+        double new_cov[4];
+
+        kalman_filter(state, measurement[i], cov, measurement_noise[i], process_noise[i],
+                      new_state, new_cov);
+
+        position[i] = new_state[0];
+        velocity[i] = new_state[1];
+        cov11[i] = new_cov[0];
+        cov12[i] = new_cov[1];
+        cov21[i] = new_cov[2];
+        cov22[i] = new_cov[3];
+    }
+}
+
+void batch_packed_portable(int n, double position[], double velocity[], double cov11[],
+                           double cov12[], double cov22[], const double measurement[],
+                           const double measurement_noise[], const double process_noise[])
+{
+    for (int i = 0; i < n; i++) {
+        kalman_filter_packed_step(position[i], velocity[i], cov11[i], cov12[i], cov22[i],
+                                  measurement[i], measurement_noise[i], process_noise[i]);
+    }
+}
+
+namespace {
+
+template <typename T>
+void UdPortable(int n, T position[], T velocity[], T d1[], T u[], T d2[], const T measurement[],
+                const T measurement_noise[], const T process_noise[]) {
+    for (int i = 0; i < n; i++) {
+        kalman_filter_ud_step(position[i], velocity[i], d1[i], u[i], d2[i], measurement[i],
+                              measurement_noise[i], process_noise[i]);
+    }
+}
+
+} // namespace
+
+void batch_ud_portable(int n, double position[], double velocity[], double d1[], double u[],
+                       double d2[], const double measurement[], const double measurement_noise[],
+                       const double process_noise[])
+{
+    UdPortable(n, position, velocity, d1, u, d2, measurement, measurement_noise, process_noise);
+}
+
+void batch_ud_portable(int n, float position[], float velocity[], float d1[], float u[],
+                       float d2[], const float measurement[], const float measurement_noise[],
+                       const float process_noise[])
+{
+    UdPortable(n, position, velocity, d1, u, d2, measurement, measurement_noise, process_noise);
+}
+
+void likelihood_portable(int n, const double measurement[], double predicted_position,
+                         double innovation_variance, double gate, double log_normalizer,
+                         double log_likelihood[])
+{
+    for (int i = 0; i < n; i++) {
+        double y = measurement[i] - predicted_position;
+        double d2 = (y * y) / innovation_variance;
+        log_likelihood[i] = d2 <= gate ? log_normalizer - 0.5 * d2
+                                       : -std::numeric_limits<double>::infinity();
+    }
+}
+
+} // namespace kernels
+
+// ---- Dispatch ----
+
+namespace {
+
+struct KernelEntry {
+    BatchIsa isa;
+    const char* name;
+    kernels::BatchFn fn;  // nullptr when not built for this target
+    // The same ISA's kalman_filter_batch_packed(), kalman_filter_ud_batch()
+    // and kalman_filter_likelihood_batch()
+    kernels::PackedBatchFn packed;
+    kernels::UdBatchFn<double> ud;
+    kernels::UdBatchFn<float> ud_f32;
+    kernels::LikelihoodFn likelihood;
+};
+
+#if defined(BATCH_X86_KERNELS)
+const KernelEntry kKernels[] = {
+    {BatchIsa::Portable, "portable", kernels::batch_portable,
+     kernels::batch_packed_portable, kernels::batch_ud_portable, kernels::batch_ud_portable,
+     kernels::likelihood_portable},
+    {BatchIsa::Sse2, "sse2", kernels::batch_sse2,
+     kernels::batch_packed_sse2, kernels::batch_ud_sse2, kernels::batch_ud_sse2,
+     kernels::likelihood_sse2},
+    {BatchIsa::Avx2, "avx2", kernels::batch_avx2,
+     kernels::batch_packed_avx2, kernels::batch_ud_avx2, kernels::batch_ud_avx2,
+     kernels::likelihood_avx2},
+    {BatchIsa::Avx512, "avx512", kernels::batch_avx512,
+     kernels::batch_packed_avx512, kernels::batch_ud_avx512, kernels::batch_ud_avx512,
+     kernels::likelihood_avx512},
+};
+#else
+const KernelEntry kKernels[] = {
+    {BatchIsa::Portable, "portable", kernels::batch_portable,
+     kernels::batch_packed_portable, kernels::batch_ud_portable, kernels::batch_ud_portable,
+     kernels::likelihood_portable},
+    {BatchIsa::Sse2, "sse2", nullptr, nullptr, nullptr, nullptr, nullptr},
+    {BatchIsa::Avx2, "avx2", nullptr, nullptr, nullptr, nullptr, nullptr},
+    {BatchIsa::Avx512, "avx512", nullptr, nullptr, nullptr, nullptr, nullptr},
+};
+#endif
+
+bool CpuSupports(BatchIsa isa) {
+#if defined(BATCH_X86_KERNELS)
+    // May run from a static initializer, before libgcc has probed the CPU
+    __builtin_cpu_init();
+    switch (isa) {
+        case BatchIsa::Portable: return true;
+        case BatchIsa::Sse2: return __builtin_cpu_supports("sse2");
+        case BatchIsa::Avx2: return __builtin_cpu_supports("avx2");
+        case BatchIsa::Avx512: return __builtin_cpu_supports("avx512f");
+    }
+    return false;
+#else
+    return isa == BatchIsa::Portable;
+#endif
+}
+
+const KernelEntry& Entry(BatchIsa isa) {
+    return kKernels[static_cast<int>(isa)];
+}
+
+const KernelEntry* Best() {
+    for (int i = static_cast<int>(BatchIsa::Avx512); i > 0; i--) {
+        if (batch_isa_supported(static_cast<BatchIsa>(i))) return &kKernels[i];
+    }
+    return &kKernels[0];
+}
+
+std::atomic<const KernelEntry*>& Selected() {
+    static std::atomic<const KernelEntry*> selected{Best()};
+    return selected;
+}
+
+// Resolve when the library is loaded rather than on the first batch
+[[maybe_unused]] const bool kResolvedAtLoad = (Selected(), true);
+
+} // namespace
+
+BatchIsa batch_isa() {
+    return Selected().load(std::memory_order_relaxed)->isa;
+}
+
+const char* batch_isa_name(BatchIsa isa) {
+    return Entry(isa).name;
+}
+
+bool batch_isa_supported(BatchIsa isa) {
+    return Entry(isa).fn != nullptr && CpuSupports(isa);
+}
+
+bool set_batch_isa(BatchIsa isa) {
+    if (!batch_isa_supported(isa)) return false;
+    Selected().store(&Entry(isa), std::memory_order_relaxed);
+    return true;
+}
+
+void kalman_filter_batch(
+    int n,
+    double position[],
+    double velocity[],
+    double cov11[],
+    double cov12[],
+    double cov21[],
+    double cov22[],
+    const double measurement[],
+    const double measurement_noise[],
+    const double process_noise[])
+{
+    Selected().load(std::memory_order_relaxed)->fn(
+        n, position, velocity, cov11, cov12, cov21, cov22, measurement, measurement_noise,
+        process_noise);
+}
+
+void kalman_filter_batch_packed(
+    int n,
+    double position[],
+    double velocity[],
+    double cov11[],
+    double cov12[],
+    double cov22[],
+    const double measurement[],
+    const double measurement_noise[],
+    const double process_noise[])
+{
+    Selected().load(std::memory_order_relaxed)->packed(
+        n, position, velocity, cov11, cov12, cov22, measurement, measurement_noise, process_noise);
+}
+
+void kalman_filter_ud_batch(
+    int n,
+    double position[],
+    double velocity[],
+    double d1[],
+    double u[],
+    double d2[],
+    const double measurement[],
+    const double measurement_noise[],
+    const double process_noise[])
+{
+    Selected().load(std::memory_order_relaxed)->ud(
+        n, position, velocity, d1, u, d2, measurement, measurement_noise, process_noise);
+}
+
+void kalman_filter_ud_batch(
+    int n,
+    float position[],
+    float velocity[],
+    float d1[],
+    float u[],
+    float d2[],
+    const float measurement[],
+    const float measurement_noise[],
+    const float process_noise[])
+{
+    Selected().load(std::memory_order_relaxed)->ud_f32(
+        n, position, velocity, d1, u, d2, measurement, measurement_noise, process_noise);
+}
+
+void kalman_filter_likelihood_batch(
+    int n,
+    const double measurement[],
+    double predicted_position,
+    double innovation_variance,
+    double gate,
+    double log_likelihood[])
+{
+    // Shared by every measurement: one log per call, not per lane
+    const double log_normalizer = -0.5 * std::log(2.0 * M_PI * innovation_variance);
+    Selected().load(std::memory_order_relaxed)->likelihood(
+        n, measurement, predicted_position, innovation_variance, gate, log_normalizer,
+        log_likelihood);
+}
+
+} // namespace kalman_filter
@@ -0,0 +1,150 @@
+#ifndef KALMAN_FILTER_BATCH_H
+#define KALMAN_FILTER_BATCH_H
+
+// Batch API for kalman_filter (hand-written, ships in the package).
+//
+// Runs one predict-update step for n independent tracks stored as a
+// structure of arrays, updating state and covariance in place. Every track
+// gets exactly the result of the scalar kalman_filter() — the equivalence
+// matrix in the C++ tests checks this bit for bit.
+//
+// The library carries SSE2, AVX2 and AVX-512 builds of the batch kernel
+// (x86-64 only) and picks the widest one the CPU supports when it is
+// loaded, so a package built for generic x86-64 still uses the host's
+// vector units. batch_isa() reports the choice.
+//
+// kalman_filter_batch_packed() is the same step on packed symmetric
+// covariance (kalman_filter_packed.h), and kalman_filter_ud_batch() the
+// same step in square-root form (kalman_filter_ud.h), in double or in
+// float. kalman_filter_likelihood_batch() scores many candidate
+// measurements against one predicted track, for association (the
+// multiple-hypothesis tracker in kalman_filter_mht.h). All of them run on
+// the same kernel choice.
+
+namespace kalman_filter {
+
+// Inputs/outputs (arrays of n elements, updated in place):
+//   position, velocity   - state vector per track
+//   cov11, cov12,
+//   cov21, cov22         - flattened 2x2 covariance per track
+// Inputs (arrays of n elements):
+//   measurement          - position observation per track
+//   measurement_noise    - R per track
+//   process_noise        - Q per track
+void kalman_filter_batch(
+    int n,
+    double position[],
+    double velocity[],
+    double cov11[],
+    double cov12[],
+    double cov21[],
+    double cov22[],
+    const double measurement[],
+    const double measurement_noise[],
+    const double process_noise[]);
+
+// Packed symmetric covariance: three arrays instead of four, a quarter
+// less covariance traffic per track. For symmetric covariance every track
+// gets the scalar kalman_filter()'s state, P11, P12 and P22 bit for bit
+// (the dropped P21 equals P12). pack_covariance() and unpack_covariance()
+// convert to and from the flattened [P11, P12, P21, P22] layout.
+// Inputs/outputs (arrays of n elements, updated in place):
+//   position, velocity   - state vector per track
+//   cov11, cov12, cov22  - upper triangle of the covariance per track
+// Inputs (arrays of n elements):
+//   measurement, measurement_noise, process_noise - as above
+void kalman_filter_batch_packed(
+    int n,
+    double position[],
+    double velocity[],
+    double cov11[],
+    double cov12[],
+    double cov22[],
+    const double measurement[],
+    const double measurement_noise[],
+    const double process_noise[]);
+
+// Square-root form: one kalman_filter_ud_step() per track, with the
+// covariance kept factored between calls (ud_factor() and
+// ud_to_covariance() convert).
+// Inputs/outputs (arrays of n elements, updated in place):
+//   position, velocity   - state vector per track
+//   d1, u, d2            - P = [1 u; 0 1] diag(d1, d2) [1 0; u 1] per track
+// Inputs (arrays of n elements):
+//   measurement, measurement_noise, process_noise - as above
+// The float overload stays positive definite where float Joseph-form
+// updates do not, and processes twice the tracks per vector.
+void kalman_filter_ud_batch(
+    int n,
+    double position[],
+    double velocity[],
+    double d1[],
+    double u[],
+    double d2[],
+    const double measurement[],
+    const double measurement_noise[],
+    const double process_noise[]);
+
+void kalman_filter_ud_batch(
+    int n,
+    float position[],
+    float velocity[],
+    float d1[],
+    float u[],
+    float d2[],
+    const float measurement[],
+    const float measurement_noise[],
+    const float process_noise[]);
+
+// Gated innovation log-likelihood of n candidate measurements against one
+// predicted track (position x = predicted_position, innovation variance
+// S = P_pred(1,1) + R):
+//   log_likelihood[i] = -0.5 (y^2 / S + log(2 pi S)),  y = measurement[i] - x
+// when the normalized squared innovation y^2 / S is at most `gate`, and
+// -infinity outside the gate (chi-square with one degree of freedom: 9
+// keeps 99.7% of true measurements, 16 keeps 99.99%). Every kernel gives
+// the same bits.
+void kalman_filter_likelihood_batch(
+    int n,
+    const double measurement[],
+    double predicted_position,
+    double innovation_variance,
+    double gate,
+    double log_likelihood[]);
+
+// Kernel builds behind kalman_filter_batch(), narrowest first
+enum class BatchIsa { Portable, Sse2, Avx2, Avx512 };
+
+// Kernel in use by this process
+BatchIsa batch_isa();
+
+// "portable", "sse2", "avx2" or "avx512"
+const char* batch_isa_name(BatchIsa isa);
+
+// Whether this build contains `isa` and the CPU can run it
+bool batch_isa_supported(BatchIsa isa);
+
+// Switch kernels (tests, benchmarks). Returns false and keeps the current
+// kernel if `isa` is not supported. Not meant to race with running batches.
+bool set_batch_isa(BatchIsa isa);
+
+// Kernel, batch size and worker count chosen for this machine
+struct BatchTuning {
+    BatchIsa isa;
+    int batch_size;   // tracks per kalman_filter_batch() call
+    int threads;      // workers, each over a contiguous slice of the table
+    bool from_cache;  // read from the cache rather than measured
+};
+
+// Optional startup calibration. Times the kernels this CPU supports, then
+// batch sizes, then worker counts on a synthetic track table (a fraction of
+// a second), switches to the fastest kernel and returns the choice. The
+// decision is cached per CPU model in `cache_path`, so later startups only
+// read the file: "" means $MATLAB_ALGORITHMS_CALIBRATION_CACHE or
+// ~/.cache/matlab_algorithms/batch_calibration.tsv, nullptr means no cache.
+// recalibrate = true measures even on a cache hit.
+BatchTuning calibrate_batch(const char* cache_path = "", bool recalibrate = false);
+
+} // namespace kalman_filter
+
+#endif // KALMAN_FILTER_BATCH_H
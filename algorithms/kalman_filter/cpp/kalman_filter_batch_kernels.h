@@ -0,0 +1,273 @@
+#ifndef KALMAN_FILTER_BATCH_KERNELS_H
+#define KALMAN_FILTER_BATCH_KERNELS_H
+
+// Instruction-set-specific kernels behind kalman_filter_batch() (internal,
+// not installed).
+//
+// Each kalman_filter_batch_<isa>.cpp is compiled with its own -m flags and
+// -ffp-contract=off, and instantiates BatchKernel with a vector of that
+// ISA's width. The vector body repeats the operations of
+// generated/kalman_filter.cpp in the same order with no fused multiply-add,
+// so every lane rounds exactly like the scalar function; the remainder
+// calls the scalar function itself. If the generated code changes, the
+// equivalence matrix in the C++ tests fails until this is updated.
+//
+// PackedBatchKernel and UdBatchKernel do the same for
+// kalman_filter_batch_packed() and kalman_filter_ud_batch(): each lane runs
+// kalman_filter_packed_step() (kalman_filter_packed.h) or
+// kalman_filter_ud_step() (kalman_filter_ud.h), the latter in double or in
+// float at twice the lanes per vector.
+//
+// LikelihoodKernel is kalman_filter_likelihood_batch(): the gated
+// innovation log-likelihood of many measurements against one predicted
+// track, with every lane rounding like the portable loop.
+
+#include <cstring>
+#include <limits>
+
+#include "kalman_filter_packed.h"
+#include "kalman_filter_ud.h"
+
+namespace kalman_filter {
+namespace kernels {
+
+using BatchFn = void (*)(int n, double position[], double velocity[], double cov11[],
+                         double cov12[], double cov21[], double cov22[],
+                         const double measurement[], const double measurement_noise[],
+                         const double process_noise[]);
+
+void batch_portable(int n, double position[], double velocity[], double cov11[], double cov12[],
+                    double cov21[], double cov22[], const double measurement[],
+                    const double measurement_noise[], const double process_noise[]);
+void batch_sse2(int n, double position[], double velocity[], double cov11[], double cov12[],
+                double cov21[], double cov22[], const double measurement[],
+                const double measurement_noise[], const double process_noise[]);
+void batch_avx2(int n, double position[], double velocity[], double cov11[], double cov12[],
+                double cov21[], double cov22[], const double measurement[],
+                const double measurement_noise[], const double process_noise[]);
+void batch_avx512(int n, double position[], double velocity[], double cov11[], double cov12[],
+                  double cov21[], double cov22[], const double measurement[],
+                  const double measurement_noise[], const double process_noise[]);
+
+// Packed symmetric covariance [P11, P12, P22]
+using PackedBatchFn = void (*)(int n, double position[], double velocity[], double cov11[],
+                               double cov12[], double cov22[], const double measurement[],
+                               const double measurement_noise[], const double process_noise[]);
+
+void batch_packed_portable(int n, double position[], double velocity[], double cov11[],
+                           double cov12[], double cov22[], const double measurement[],
+                           const double measurement_noise[], const double process_noise[]);
+void batch_packed_sse2(int n, double position[], double velocity[], double cov11[],
+                       double cov12[], double cov22[], const double measurement[],
+                       const double measurement_noise[], const double process_noise[]);
+void batch_packed_avx2(int n, double position[], double velocity[], double cov11[],
+                       double cov12[], double cov22[], const double measurement[],
+                       const double measurement_noise[], const double process_noise[]);
+void batch_packed_avx512(int n, double position[], double velocity[], double cov11[],
+                         double cov12[], double cov22[], const double measurement[],
+                         const double measurement_noise[], const double process_noise[]);
+
+// Square-root form, one kernel per precision and ISA
+template <typename T>
+using UdBatchFn = void (*)(int n, T position[], T velocity[], T d1[], T u[], T d2[],
+                           const T measurement[], const T measurement_noise[],
+                           const T process_noise[]);
+
+void batch_ud_portable(int n, double position[], double velocity[], double d1[], double u[],
+                       double d2[], const double measurement[], const double measurement_noise[],
+                       const double process_noise[]);
+void batch_ud_portable(int n, float position[], float velocity[], float d1[], float u[],
+                       float d2[], const float measurement[], const float measurement_noise[],
+                       const float process_noise[]);
+void batch_ud_sse2(int n, double position[], double velocity[], double d1[], double u[],
+                   double d2[], const double measurement[], const double measurement_noise[],
+                   const double process_noise[]);
+void batch_ud_sse2(int n, float position[], float velocity[], float d1[], float u[],
+                   float d2[], const float measurement[], const float measurement_noise[],
+                   const float process_noise[]);
+void batch_ud_avx2(int n, double position[], double velocity[], double d1[], double u[],
+                   double d2[], const double measurement[], const double measurement_noise[],
+                   const double process_noise[]);
+void batch_ud_avx2(int n, float position[], float velocity[], float d1[], float u[],
+                   float d2[], const float measurement[], const float measurement_noise[],
+                   const float process_noise[]);
+void batch_ud_avx512(int n, double position[], double velocity[], double d1[], double u[],
+                     double d2[], const double measurement[], const double measurement_noise[],
+                     const double process_noise[]);
+void batch_ud_avx512(int n, float position[], float velocity[], float d1[], float u[],
+                     float d2[], const float measurement[], const float measurement_noise[],
+                     const float process_noise[]);
+
+// Gated innovation log-likelihood; `log_normalizer` is -0.5 log(2 pi S),
+// computed once by the caller
+using LikelihoodFn = void (*)(int n, const double measurement[], double predicted_position,
+                              double innovation_variance, double gate, double log_normalizer,
+                              double log_likelihood[]);
+
+void likelihood_portable(int n, const double measurement[], double predicted_position,
+                         double innovation_variance, double gate, double log_normalizer,
+                         double log_likelihood[]);
+void likelihood_sse2(int n, const double measurement[], double predicted_position,
+                     double innovation_variance, double gate, double log_normalizer,
+                     double log_likelihood[]);
+void likelihood_avx2(int n, const double measurement[], double predicted_position,
+                     double innovation_variance, double gate, double log_normalizer,
+                     double log_likelihood[]);
+void likelihood_avx512(int n, const double measurement[], double predicted_position,
+                       double innovation_variance, double gate, double log_normalizer,
+                       double log_likelihood[]);
+
+typedef double Vec2d __attribute__((vector_size(16)));
+typedef double Vec4d __attribute__((vector_size(32)));
+typedef double Vec8d __attribute__((vector_size(64)));
+typedef float Vec4f __attribute__((vector_size(16)));
+typedef float Vec8f __attribute__((vector_size(32)));
+typedef float Vec16f __attribute__((vector_size(64)));
+
+// Internal linkage: every kernel TU gets its own copy compiled for its ISA,
+// so the linker can never hand an AVX-512 instantiation to the SSE2 path.
+namespace {
+
+template <class V, typename T>
+inline V Load(const T* p) {
+    V v;
+    std::memcpy(&v, p, sizeof(V));
+    return v;
+}
+
+template <class V, typename T>
+inline void Store(T* p, V v) {
+    std::memcpy(p, &v, sizeof(V));
+}
+
+template <class V>
+inline void BatchKernel(int n, double position[], double velocity[], double cov11[],
+                        double cov12[], double cov21[], double cov22[],
+                        const double measurement[], const double measurement_noise[],
+                        const double process_noise[]) {
+    constexpr int kLanes = sizeof(V) / sizeof(double);
+    int i = 0;
+    for (; i + kLanes <= n; i += kLanes) {
+        V P11 = Load<V>(cov11 + i);
+        V P12 = Load<V>(cov12 + i);
+        V P21 = Load<V>(cov21 + i);
+        V P22 = Load<V>(cov22 + i);
+        V R = Load<V>(measurement_noise + i);
+        V Q = Load<V>(process_noise + i);
+        V vel = Load<V>(velocity + i);
+
+        // Predict
+        V x_pred0 = Load<V>(position + i) + vel;
+        V x_pred1 = vel;
+        V Pp11 = (P11 + P21) + (P12 + P22) + Q;
+        V Pp12 = (P12 + P22);
+        V Pp21 = (P21 + P22);
+        V Pp22 = P22 + Q;
+
+        // Update
+        V y = Load<V>(measurement + i) - x_pred0;
+        V S = Pp11 + R;
+        V K0 = Pp11 / S;
+        V K1 = Pp21 / S;
+        Store(position + i, x_pred0 + K0 * y);
+        Store(velocity + i, x_pred1 + K1 * y);
+
+        // Joseph form
+        V ikh00 = 1.0 - K0;
+        V ikh10 = -K1;
+        V A00 = ikh00 * Pp11;
+        V A01 = ikh00 * Pp12;
+        V A10 = ikh10 * Pp11 + Pp21;
+        V A11 = ikh10 * Pp12 + Pp22;
+        V P_up11 = A00 * ikh00;
+        V P_up12 = A00 * ikh10 + A01;
+        V P_up21 = A10 * ikh00;
+        V P_up22 = A10 * ikh10 + A11;
+        P_up11 += K0 * R * K0;
+        P_up12 += K0 * R * K1;
+        P_up21 += K1 * R * K0;
+        P_up22 += K1 * R * K1;
+        Store(cov11 + i, P_up11);
+        Store(cov12 + i, P_up12);
+        Store(cov21 + i, P_up21);
+        Store(cov22 + i, P_up22);
+    }
+    batch_portable(n - i, position + i, velocity + i, cov11 + i, cov12 + i, cov21 + i, cov22 + i,
+                   measurement + i, measurement_noise + i, process_noise + i);
+}
+
+template <class V>
+inline void PackedBatchKernel(int n, double position[], double velocity[], double cov11[],
+                              double cov12[], double cov22[], const double measurement[],
+                              const double measurement_noise[], const double process_noise[]) {
+    constexpr int kLanes = sizeof(V) / sizeof(double);
+    int i = 0;
+    for (; i + kLanes <= n; i += kLanes) {
+        V x0 = Load<V>(position + i);
+        V x1 = Load<V>(velocity + i);
+        V P11 = Load<V>(cov11 + i);
+        V P12 = Load<V>(cov12 + i);
+        V P22 = Load<V>(cov22 + i);
+        kalman_filter_packed_step(x0, x1, P11, P12, P22, Load<V>(measurement + i),
+                                  Load<V>(measurement_noise + i), Load<V>(process_noise + i));
+        Store(position + i, x0);
+        Store(velocity + i, x1);
+        Store(cov11 + i, P11);
+        Store(cov12 + i, P12);
+        Store(cov22 + i, P22);
+    }
+    batch_packed_portable(n - i, position + i, velocity + i, cov11 + i, cov12 + i, cov22 + i,
+                          measurement + i, measurement_noise + i, process_noise + i);
+}
+
+// V is a vector of T
+template <class V, typename T>
+inline void UdBatchKernel(int n, T position[], T velocity[], T d1[], T u[], T d2[],
+                          const T measurement[], const T measurement_noise[],
+                          const T process_noise[]) {
+    constexpr int kLanes = sizeof(V) / sizeof(T);
+    int i = 0;
+    for (; i + kLanes <= n; i += kLanes) {
+        V x0 = Load<V>(position + i);
+        V x1 = Load<V>(velocity + i);
+        V D1 = Load<V>(d1 + i);
+        V U = Load<V>(u + i);
+        V D2 = Load<V>(d2 + i);
+        kalman_filter_ud_step(x0, x1, D1, U, D2, Load<V>(measurement + i),
+                              Load<V>(measurement_noise + i), Load<V>(process_noise + i));
+        Store(position + i, x0);
+        Store(velocity + i, x1);
+        Store(d1 + i, D1);
+        Store(u + i, U);
+        Store(d2 + i, D2);
+    }
+    batch_ud_portable(n - i, position + i, velocity + i, d1 + i, u + i, d2 + i, measurement + i,
+                      measurement_noise + i, process_noise + i);
+}
+
+template <class V>
+inline void LikelihoodKernel(int n, const double measurement[], double predicted_position,
+                             double innovation_variance, double gate, double log_normalizer,
+                             double log_likelihood[]) {
+    constexpr int kLanes = sizeof(V) / sizeof(double);
+    const V x = V{} + predicted_position;
+    const V S = V{} + innovation_variance;
+    const V G = V{} + gate;
+    const V c = V{} + log_normalizer;
+    const V outside = V{} - std::numeric_limits<double>::infinity();
+    int i = 0;
+    for (; i + kLanes <= n; i += kLanes) {
+        V y = Load<V>(measurement + i) - x;
+        V d2 = (y * y) / S;
+        Store(log_likelihood + i, d2 <= G ? c - 0.5 * d2 : outside);
+    }
+    likelihood_portable(n - i, measurement + i, predicted_position, innovation_variance, gate,
+                        log_normalizer, log_likelihood + i);
+}
+
+} // namespace
+
+} // namespace kernels
+} // namespace kalman_filter
+
+#endif // KALMAN_FILTER_BATCH_KERNELS_H
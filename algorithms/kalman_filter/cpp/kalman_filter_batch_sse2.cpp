@@ -0,0 +1,61 @@
+// SSE2 kernels for kalman_filter_batch(), kalman_filter_batch_packed(),
+// kalman_filter_ud_batch() and kalman_filter_likelihood_batch(), 2 tracks
+// (or measurements) per vector, 4 in float. Built with the ISA's -m flag
+// and -ffp-contract=off; only called once the CPU check in
+// kalman_filter_batch.cpp has passed.
+
+#include "kalman_filter_batch_kernels.h"
+
+namespace kalman_filter {
+namespace kernels {
+
+void batch_sse2(
+    int n,
+    double position[],
+    double velocity[],
+    double cov11[],
+    double cov12[],
+    double cov21[],
+    double cov22[],
+    const double measurement[],
+    const double measurement_noise[],
+    const double process_noise[])
+{
+    BatchKernel<Vec2d>(n, position, velocity, cov11, cov12, cov21, cov22, measurement,
+                       measurement_noise, process_noise);
+}
+
+void batch_packed_sse2(int n, double position[], double velocity[], double cov11[],
+                       double cov12[], double cov22[], const double measurement[],
+                       const double measurement_noise[], const double process_noise[])
+{
+    PackedBatchKernel<Vec2d>(n, position, velocity, cov11, cov12, cov22, measurement,
+                             measurement_noise, process_noise);
+}
+
+void batch_ud_sse2(int n, double position[], double velocity[], double d1[], double u[],
+                   double d2[], const double measurement[], const double measurement_noise[],
+                   const double process_noise[])
+{
+    UdBatchKernel<Vec2d>(n, position, velocity, d1, u, d2, measurement, measurement_noise,
+                         process_noise);
+}
+
+void batch_ud_sse2(int n, float position[], float velocity[], float d1[], float u[],
+                   float d2[], const float measurement[], const float measurement_noise[],
+                   const float process_noise[])
+{
+    UdBatchKernel<Vec4f>(n, position, velocity, d1, u, d2, measurement, measurement_noise,
+                         process_noise);
+}
+
+void likelihood_sse2(int n, const double measurement[], double predicted_position,
+                     double innovation_variance, double gate, double log_normalizer,
+                     double log_likelihood[])
+{
+    LikelihoodKernel<Vec2d>(n, measurement, predicted_position, innovation_variance, gate,
+                            log_normalizer, log_likelihood);
+}
+
+} // namespace kernels
+} // namespace kalman_filter
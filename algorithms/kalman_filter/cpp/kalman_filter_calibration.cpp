@@ -0,0 +1,57 @@
+#include "kalman_filter_batch.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "batch_calibration.h"
+
+namespace kalman_filter {
+
+// calibrate_batch(): the measurement itself is runtime::CalibrateBatch()
+// (runtime/batch_calibration.h); this file supplies the kernel candidates
+// and a synthetic track table to run them on.
+BatchTuning calibrate_batch(const char* cache_path, bool recalibrate)
+{
+    std::vector<BatchIsa> isas;
+    std::vector<std::string> names;
+    for (BatchIsa isa : {BatchIsa::Portable, BatchIsa::Sse2, BatchIsa::Avx2, BatchIsa::Avx512}) {
+        if (!batch_isa_supported(isa)) continue;
+        isas.push_back(isa);
+        names.push_back(batch_isa_name(isa));
+    }
+
+    runtime::CalibrationOptions opts;
+    opts.cache_path = cache_path ? cache_path : "-";
+    opts.recalibrate = recalibrate;
+
+    runtime::CalibrationResult r;
+    if (!runtime::LookupCalibration("kalman_filter", names, opts, &r)) {
+        // Converging tracks; the filter state evolves in place across passes
+        const size_t n = opts.table_elements;
+        std::vector<double> position(n, 0.0), velocity(n, 1.0);
+        std::vector<double> cov11(n, 1.0), cov12(n, 0.0), cov21(n, 0.0), cov22(n, 1.0);
+        std::vector<double> measurement(n), measurement_noise(n, 0.25), process_noise(n, 0.01);
+        for (size_t i = 0; i < n; i++) measurement[i] = static_cast<double>(i % 100);
+
+        auto run = [&](int isa, int batch, size_t begin, size_t end) {
+            set_batch_isa(isas[isa]);
+            for (size_t i = begin; i < end; i += batch) {
+                int count = static_cast<int>(std::min<size_t>(batch, end - i));
+                kalman_filter_batch(count, &position[i], &velocity[i], &cov11[i], &cov12[i],
+                                    &cov21[i], &cov22[i], &measurement[i], &measurement_noise[i],
+                                    &process_noise[i]);
+            }
+        };
+        r = runtime::CalibrateBatch("kalman_filter", names, run, opts);
+    }
+
+    BatchTuning tuning{batch_isa(), r.batch_size, r.threads, r.from_cache};
+    for (size_t i = 0; i < isas.size(); i++) {
+        if (names[i] == r.isa) tuning.isa = isas[i];
+    }
+    set_batch_isa(tuning.isa);
+    return tuning;
+}
+
+} // namespace kalman_filter
@@ -0,0 +1,289 @@
+#ifndef KALMAN_FILTER_CONSISTENCY_H
+#define KALMAN_FILTER_CONSISTENCY_H
+
+// Monte Carlo consistency check for kalman_filter (hand-written, used by
+// consistency_kalman_filter and the C++ tests; not installed).
+//
+// Simulates many independent runs of the filter's own model -- constant
+// velocity, F = [1 1; 0 1], process noise Q = q I, position measurements
+// with variance R -- and feeds the noisy measurements through
+// kalman_filter_batch(). A consistent filter's errors match its own
+// covariance, which two statistics test at every step k, averaged over
+// the N runs:
+//
+//   NEES  e' P^-1 e, e = truth - estimate          mean 2 (chi-square, 2 dof)
+//   NIS   y^2 / S, y the innovation, S its variance  mean 1 (chi-square, 1 dof)
+//
+// N times a per-step average is chi-square with 2N (NEES) or N (NIS)
+// degrees of freedom, which gives its two-sided 95% interval. The report
+// lists the fraction of steps whose averages fall inside; about 95% of
+// them should.
+//
+// Runs are simulated `block` at a time in structure-of-arrays form, one
+// kalman_filter_batch() call per step, and blocks are spread over threads.
+// Every random draw is Philox4x32-10 keyed by (seed, run, step)
+// (runtime/workload.h), and the per-step sums are reduced per block in run
+// order and then across blocks in block order, so the results are
+// bit-identical for any thread count.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "algorithm_harness.h"
+#include "kalman_filter_batch.h"
+#include "workload.h"
+
+namespace kalman_filter {
+
+struct ConsistencyOptions {
+    uint64_t runs = 10000;
+    int steps = 10000;
+    double measurement_noise = 1.0;       // R the filter is given
+    double process_noise = 0.01;          // q the filter is given (Q = q I)
+    double truth_measurement_noise = -1;  // R of the simulated sensor; < 0 = measurement_noise
+    double truth_process_noise = -1;      // q of the simulated motion; < 0 = process_noise
+    double initial_variance = 10.0;       // P0 = p0 I; initial truth ~ N(0, P0), estimate 0
+    uint64_t seed = 1;
+    unsigned threads = harness::DefaultThreadCount();
+    int block = 256;                      // runs per batch call, a multiple of runtime::kPhiloxLanes
+    double min_in_bounds = 0.9;           // pass when both in-bounds fractions reach this
+};
+
+struct ConsistencyReport {
+    uint64_t runs = 0;
+    int steps = 0;
+    std::vector<double> nees;  // per step, averaged over runs
+    std::vector<double> nis;
+    double mean_nees = 0.0;    // over all steps and runs
+    double mean_nis = 0.0;
+    double nees_lower = 0.0, nees_upper = 0.0;  // 95% interval of a per-step average
+    double nis_lower = 0.0, nis_upper = 0.0;
+    double nees_in_bounds = 0.0;  // fraction of steps inside the interval
+    double nis_in_bounds = 0.0;
+    bool consistent = false;
+    double seconds = 0.0;
+};
+
+namespace detail {
+
+// Two-sided 95% interval of chi-square(dof) / dof (Wilson-Hilferty)
+inline void ChiSquareMeanInterval(double dof, double* lower, double* upper) {
+    constexpr double kZ = 1.959963984540054;
+    const double a = 2.0 / (9.0 * dof);
+    *lower = std::pow(1.0 - a - kZ * std::sqrt(a), 3);
+    *upper = std::pow(1.0 - a + kZ * std::sqrt(a), 3);
+}
+
+// Runs [first, first + count) for all steps; adds each step's NEES and NIS
+// sums over those runs, in run order, to nees_sum[k] and nis_sum[k].
+inline void SimulateBlock(const ConsistencyOptions& opts, uint64_t first, int count,
+                          double* nees_sum, double* nis_sum) {
+    const int lanes = (count + runtime::kPhiloxLanes - 1) / runtime::kPhiloxLanes * runtime::kPhiloxLanes;
+    const double R = opts.measurement_noise, q = opts.process_noise;
+    const double sd_v = std::sqrt(opts.truth_measurement_noise < 0 ? R : opts.truth_measurement_noise);
+    const double sd_w = std::sqrt(opts.truth_process_noise < 0 ? q : opts.truth_process_noise);
+    const runtime::PhiloxKey key = {static_cast<uint32_t>(opts.seed), static_cast<uint32_t>(opts.seed >> 32)};
+
+    std::vector<double> buf(16 * static_cast<size_t>(lanes));
+    double* position = buf.data();
+    double* velocity = position + lanes;
+    double* c11 = velocity + lanes;
+    double* c12 = c11 + lanes;
+    double* c21 = c12 + lanes;
+    double* c22 = c21 + lanes;
+    double* measurement = c22 + lanes;
+    double* r = measurement + lanes;
+    double* qs = r + lanes;
+    double* truth0 = qs + lanes;  // true position and velocity
+    double* truth1 = truth0 + lanes;
+    double* w0 = truth1 + lanes;  // standard normals for this step
+    double* w1 = w0 + lanes;
+    double* v = w1 + lanes;
+    double* spare = v + lanes;  // the fourth normal of a step, not needed
+    double* nis = spare + lanes;
+
+    // Normals for `step` of every lane: counter blocks 2 step and
+    // 2 step + 1 of stream (run index)
+    auto draw = [&](uint64_t step) {
+        for (int l0 = 0; l0 < lanes; l0 += runtime::kPhiloxLanes) {
+            for (uint64_t half = 0; half < 2; half++) {
+                uint32_t k0[runtime::kPhiloxLanes], k1[runtime::kPhiloxLanes];
+                uint32_t k2[runtime::kPhiloxLanes], k3[runtime::kPhiloxLanes];
+                const uint64_t ctr = 2 * step + half;
+                for (int l = 0; l < runtime::kPhiloxLanes; l++) {
+                    const uint64_t run = first + l0 + l;
+                    k0[l] = static_cast<uint32_t>(ctr);
+                    k1[l] = static_cast<uint32_t>(ctr >> 32);
+                    k2[l] = static_cast<uint32_t>(run);
+                    k3[l] = static_cast<uint32_t>(run >> 32);
+                }
+                runtime::Philox4x32Lanes(k0, k1, k2, k3, key);
+                if (half == 0) runtime::BoxMullerLanes(k0, k1, k2, k3, w0 + l0, w1 + l0);
+                else runtime::BoxMullerLanes(k0, k1, k2, k3, v + l0, spare + l0);
+            }
+        }
+    };
+
+    // Step 0: initial truth ~ N(0, P0); the filter starts at 0 with P0
+    const double sd0 = std::sqrt(opts.initial_variance);
+    draw(0);
+    for (int l = 0; l < lanes; l++) {
+        truth0[l] = sd0 * w0[l];
+        truth1[l] = sd0 * w1[l];
+        position[l] = velocity[l] = 0.0;
+        c11[l] = c22[l] = opts.initial_variance;
+        c12[l] = c21[l] = 0.0;
+        r[l] = R;
+        qs[l] = q;
+    }
+
+    for (int k = 0; k < opts.steps; k++) {
+        draw(static_cast<uint64_t>(k) + 1);
+        for (int l = 0; l < lanes; l++) {
+            // Truth moves and is measured
+            truth0[l] = truth0[l] + truth1[l] + sd_w * w0[l];
+            truth1[l] = truth1[l] + sd_w * w1[l];
+            measurement[l] = truth0[l] + sd_v * v[l];
+            // Innovation and its variance, from the same prediction the
+            // filter is about to make
+            double y = measurement[l] - (position[l] + velocity[l]);
+            double s = (c11[l] + c21[l]) + (c12[l] + c22[l]) + qs[l] + r[l];
+            nis[l] = y * y / s;
+        }
+
+        kalman_filter_batch(count, position, velocity, c11, c12, c21, c22, measurement, r, qs);
+
+        double nees_total = 0.0, nis_total = 0.0;
+        for (int l = 0; l < count; l++) {
+            double e0 = truth0[l] - position[l], e1 = truth1[l] - velocity[l];
+            double det = c11[l] * c22[l] - c12[l] * c21[l];
+            nees_total += (c22[l] * e0 * e0 - (c12[l] + c21[l]) * e0 * e1 + c11[l] * e1 * e1) / det;
+            nis_total += nis[l];
+        }
+        nees_sum[k] += nees_total;
+        nis_sum[k] += nis_total;
+    }
+}
+
+} // namespace detail
+
+inline ConsistencyReport RunConsistency(const ConsistencyOptions& opts) {
+    if (opts.runs == 0 || opts.steps <= 0) throw std::invalid_argument("runs and steps must be positive");
+    if (opts.block <= 0 || opts.block % runtime::kPhiloxLanes != 0) {
+        throw std::invalid_argument("block must be a positive multiple of " +
+                                    std::to_string(runtime::kPhiloxLanes));
+    }
+    if (!(opts.measurement_noise > 0) || !(opts.process_noise > 0) || !(opts.initial_variance > 0)) {
+        throw std::invalid_argument("noise variances must be positive");
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    const size_t steps = static_cast<size_t>(opts.steps);
+    const uint64_t blocks = (opts.runs + opts.block - 1) / opts.block;
+
+    // Per-block partial sums, reduced in block order afterwards
+    std::vector<double> nees_part(blocks * steps, 0.0), nis_part(blocks * steps, 0.0);
+    harness::ParallelFor(blocks, opts.threads, [&](size_t b) {
+        uint64_t first = b * static_cast<uint64_t>(opts.block);
+        int count = static_cast<int>(std::min<uint64_t>(opts.block, opts.runs - first));
+        detail::SimulateBlock(opts, first, count, &nees_part[b * steps], &nis_part[b * steps]);
+    });
+
+    ConsistencyReport report;
+    report.runs = opts.runs;
+    report.steps = opts.steps;
+    report.nees.assign(steps, 0.0);
+    report.nis.assign(steps, 0.0);
+    for (uint64_t b = 0; b < blocks; b++) {
+        for (size_t k = 0; k < steps; k++) {
+            report.nees[k] += nees_part[b * steps + k];
+            report.nis[k] += nis_part[b * steps + k];
+        }
+    }
+
+    const double n = static_cast<double>(opts.runs);
+    detail::ChiSquareMeanInterval(2.0 * n, &report.nees_lower, &report.nees_upper);
+    report.nees_lower *= 2.0;
+    report.nees_upper *= 2.0;
+    detail::ChiSquareMeanInterval(n, &report.nis_lower, &report.nis_upper);
+    size_t nees_in = 0, nis_in = 0;
+    for (size_t k = 0; k < steps; k++) {
+        report.nees[k] /= n;
+        report.nis[k] /= n;
+        report.mean_nees += report.nees[k];
+        report.mean_nis += report.nis[k];
+        nees_in += report.nees[k] >= report.nees_lower && report.nees[k] <= report.nees_upper;
+        nis_in += report.nis[k] >= report.nis_lower && report.nis[k] <= report.nis_upper;
+    }
+    report.mean_nees /= static_cast<double>(steps);
+    report.mean_nis /= static_cast<double>(steps);
+    report.nees_in_bounds = static_cast<double>(nees_in) / static_cast<double>(steps);
+    report.nis_in_bounds = static_cast<double>(nis_in) / static_cast<double>(steps);
+    report.consistent = report.nees_in_bounds >= opts.min_in_bounds && report.nis_in_bounds >= opts.min_in_bounds;
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return report;
+}
+
+inline nlohmann::json ConsistencyReportToJson(const ConsistencyReport& r, const ConsistencyOptions& opts) {
+    nlohmann::json j;
+    j["algorithm"] = "kalman_filter";
+    j["runs"] = r.runs;
+    j["steps"] = r.steps;
+    j["seed"] = opts.seed;
+    j["threads"] = opts.threads;
+    j["batch_isa"] = batch_isa_name(batch_isa());
+    j["filter"] = {{"measurement_noise", opts.measurement_noise},
+                   {"process_noise", opts.process_noise},
+                   {"initial_variance", opts.initial_variance}};
+    j["truth"] = {{"measurement_noise", opts.truth_measurement_noise < 0 ? opts.measurement_noise
+                                                                         : opts.truth_measurement_noise},
+                  {"process_noise", opts.truth_process_noise < 0 ? opts.process_noise : opts.truth_process_noise}};
+    j["nees"] = {{"mean", r.mean_nees},
+                 {"expected", 2.0},
+                 {"bounds", {r.nees_lower, r.nees_upper}},
+                 {"fraction_in_bounds", r.nees_in_bounds},
+                 {"per_step", r.nees}};
+    j["nis"] = {{"mean", r.mean_nis},
+                {"expected", 1.0},
+                {"bounds", {r.nis_lower, r.nis_upper}},
+                {"fraction_in_bounds", r.nis_in_bounds},
+                {"per_step", r.nis}};
+    j["min_in_bounds"] = opts.min_in_bounds;
+    j["consistent"] = r.consistent;
+    j["seconds"] = r.seconds;
+    return j;
+}
+
+// Inverse of ConsistencyReportToJson(), for reports served from the result
+// cache; throws nlohmann::json::exception on a malformed report
+inline ConsistencyReport ConsistencyReportFromJson(const nlohmann::json& j) {
+    ConsistencyReport r;
+    r.runs = j.at("runs").get<uint64_t>();
+    r.steps = j.at("steps").get<int>();
+    const auto& nees = j.at("nees");
+    r.nees = nees.at("per_step").get<std::vector<double>>();
+    r.mean_nees = nees.at("mean").get<double>();
+    r.nees_lower = nees.at("bounds").at(0).get<double>();
+    r.nees_upper = nees.at("bounds").at(1).get<double>();
+    r.nees_in_bounds = nees.at("fraction_in_bounds").get<double>();
+    const auto& nis = j.at("nis");
+    r.nis = nis.at("per_step").get<std::vector<double>>();
+    r.mean_nis = nis.at("mean").get<double>();
+    r.nis_lower = nis.at("bounds").at(0).get<double>();
+    r.nis_upper = nis.at("bounds").at(1).get<double>();
+    r.nis_in_bounds = nis.at("fraction_in_bounds").get<double>();
+    r.consistent = j.at("consistent").get<bool>();
+    r.seconds = j.at("seconds").get<double>();
+    return r;
+}
+
+} // namespace kalman_filter
+
+#endif // KALMAN_FILTER_CONSISTENCY_H
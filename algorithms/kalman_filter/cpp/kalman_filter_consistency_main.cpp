@@ -0,0 +1,144 @@
+/**
+ * Monte Carlo NEES/NIS consistency check for kalman_filter
+ * (kalman_filter_consistency.h).
+ *
+ * Usage: consistency_kalman_filter [--runs N] [--steps K] [--seed S] [--threads T]
+ *                                  [--block B] [--measurement-noise R] [--process-noise Q]
+ *                                  [--truth-measurement-noise R] [--truth-process-noise Q]
+ *                                  [--initial-variance P] [--min-in-bounds F] [--report PATH]
+ *                                  [--cache-dir DIR | --no-cache]
+ *
+ * A report for the same executable and options is served from the result
+ * cache (runtime/result_cache.h) instead of rerunning the simulation; the
+ * thread count is not part of the key since it does not change the result.
+ *
+ * Exit status: 0 if the filter is consistent, 1 if not, 2 on usage errors.
+ */
+
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "kalman_filter_consistency.h"
+#include "result_cache.h"
+
+namespace {
+
+void PrintUsage(const char* argv0) {
+    std::cerr << "Usage: " << argv0
+              << " [--runs N] [--steps K] [--seed S] [--threads T] [--block B]\n"
+                 "       [--measurement-noise R] [--process-noise Q]\n"
+                 "       [--truth-measurement-noise R] [--truth-process-noise Q]\n"
+                 "       [--initial-variance P] [--min-in-bounds F] [--report PATH]\n"
+                 "       [--cache-dir DIR | --no-cache]\n";
+}
+
+// Everything the report depends on
+std::string CacheKey(const kalman_filter::ConsistencyOptions& opts) {
+    runtime::ResultKey key;
+    key.Add("consistency_kalman_filter").AddExecutable().Add(kalman_filter::batch_isa_name(kalman_filter::batch_isa()));
+    key.Add(opts.runs).Add(static_cast<uint64_t>(opts.steps)).Add(opts.seed).Add(static_cast<uint64_t>(opts.block));
+    key.Add(opts.measurement_noise).Add(opts.process_noise).Add(opts.truth_measurement_noise);
+    key.Add(opts.truth_process_noise).Add(opts.initial_variance).Add(opts.min_in_bounds);
+    return key.Hex();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    kalman_filter::ConsistencyOptions opts;
+    std::string report_path;
+    std::string cache_dir;
+
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            if (arg == "--help" || arg == "-h") {
+                PrintUsage(argv[0]);
+                return 0;
+            }
+            if (arg == "--no-cache") {
+                cache_dir = "-";
+                continue;
+            }
+            if (i + 1 >= argc) throw std::invalid_argument("missing value for " + arg);
+            std::string value = argv[++i];
+            if (arg == "--runs") opts.runs = std::stoull(value);
+            else if (arg == "--steps") opts.steps = std::stoi(value);
+            else if (arg == "--seed") opts.seed = std::stoull(value);
+            else if (arg == "--threads") opts.threads = static_cast<unsigned>(std::stoul(value));
+            else if (arg == "--block") opts.block = std::stoi(value);
+            else if (arg == "--measurement-noise") opts.measurement_noise = std::stod(value);
+            else if (arg == "--process-noise") opts.process_noise = std::stod(value);
+            else if (arg == "--truth-measurement-noise") opts.truth_measurement_noise = std::stod(value);
+            else if (arg == "--truth-process-noise") opts.truth_process_noise = std::stod(value);
+            else if (arg == "--initial-variance") opts.initial_variance = std::stod(value);
+            else if (arg == "--min-in-bounds") opts.min_in_bounds = std::stod(value);
+            else if (arg == "--report") report_path = value;
+            else if (arg == "--cache-dir") cache_dir = value;
+            else throw std::invalid_argument("unknown option " + arg);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "consistency_kalman_filter: " << e.what() << "\n";
+        PrintUsage(argv[0]);
+        return 2;
+    }
+
+    runtime::ResultCache cache(cache_dir);
+    std::string key = cache.enabled() ? CacheKey(opts) : std::string();
+    kalman_filter::ConsistencyReport report;
+    bool cached = false;
+    runtime::CachedResult hit;
+    if (cache.Lookup(key, &hit)) {
+        try {
+            report = kalman_filter::ConsistencyReportFromJson(nlohmann::json::parse(hit.view()));
+            cached = true;
+        } catch (const std::exception&) {
+            // A damaged object is a miss; it is overwritten below
+        }
+    }
+    if (!cached) {
+        try {
+            report = kalman_filter::RunConsistency(opts);
+        } catch (const std::exception& e) {
+            std::cerr << "consistency_kalman_filter: " << e.what() << "\n";
+            return 2;
+        }
+        if (cache.enabled()) cache.Store(key, kalman_filter::ConsistencyReportToJson(report, opts).dump());
+    }
+
+    std::printf("\n============================================================\n");
+    std::printf("CONSISTENCY REPORT: kalman_filter\n");
+    std::printf("============================================================\n");
+    std::printf("Runs x steps:       %llu x %d (seed %llu, %u threads, %s kernel, %.2f s)\n",
+                static_cast<unsigned long long>(report.runs), report.steps,
+                static_cast<unsigned long long>(opts.seed), opts.threads,
+                kalman_filter::batch_isa_name(kalman_filter::batch_isa()), report.seconds);
+    std::printf("Run-steps / s:      %.3g\n",
+                static_cast<double>(report.runs) * report.steps / report.seconds);
+    if (cached) std::printf("Result cache:       hit (%s), simulation not rerun\n", key.substr(0, 12).c_str());
+    std::printf("NEES:               mean %.4f (expect 2), 95%% band [%.4f, %.4f], %.1f%% of steps inside\n",
+                report.mean_nees, report.nees_lower, report.nees_upper, 100.0 * report.nees_in_bounds);
+    std::printf("NIS:                mean %.4f (expect 1), 95%% band [%.4f, %.4f], %.1f%% of steps inside\n",
+                report.mean_nis, report.nis_lower, report.nis_upper, 100.0 * report.nis_in_bounds);
+    std::printf("============================================================\n");
+
+    if (!report_path.empty()) {
+        std::ofstream f(report_path);
+        if (!f.is_open()) {
+            std::cerr << "consistency_kalman_filter: cannot write " << report_path << "\n";
+            return 2;
+        }
+        f << kalman_filter::ConsistencyReportToJson(report, opts).dump(2);
+    }
+
+    if (!report.consistent) {
+        std::fprintf(stderr, "\nCONSISTENCY CHECK FAILED for kalman_filter (need %.0f%% of steps inside)\n",
+                     100.0 * opts.min_in_bounds);
+        return 1;
+    }
+    std::printf("\nCONSISTENCY CHECK PASSED for kalman_filter\n");
+    return 0;
+}
@@ -0,0 +1,83 @@
+#ifndef KALMAN_FILTER_FIXED_H
+#define KALMAN_FILTER_FIXED_H
+
+// kalman_filter() with noise variances fixed at compile time (hand-written,
+// header-only, ships in the package).
+//
+// R and Q are types carrying the constant, e.g.
+//
+//   struct R { static constexpr double value = 0.25; };
+//   struct Q { static constexpr double value = 0.01; };
+//   kalman_filter::kalman_filter_fixed<R, Q>(state, z, P, new_state, new_P);
+//
+// (C++17 does not allow double template arguments.) The operations are the
+// generated code's in the same order, so the result is bit-identical to
+// kalman_filter(state, z, P, R::value, Q::value, ...); the noise terms
+// become immediates. The gain keeps its two divisions by S: S depends on
+// the covariance, and a shared reciprocal would change the rounding (see
+// ReciprocalVariant in kalman_filter_variants.h).
+
+namespace kalman_filter {
+
+template <class R, class Q>
+inline void kalman_filter_fixed(
+    const double state[2],
+    double measurement,
+    const double state_covariance[4],
+    double updated_state[2],
+    double updated_covariance[4])
+{
+    constexpr double measurement_noise = R::value;
+    constexpr double process_noise = Q::value;
+
+    double P11 = state_covariance[0];
+    double P12 = state_covariance[1];
+    double P21 = state_covariance[2];
+    double P22 = state_covariance[3];
+
+    // --- Predict ---
+    double x_pred0 = state[0] + state[1];
+    double x_pred1 = state[1];
+
+    double Pp11 = (P11 + P21) + (P12 + P22) + process_noise;
+    double Pp12 = (P12 + P22);
+    double Pp21 = (P21 + P22);
+    double Pp22 = P22 + process_noise;
+
+    // --- Update ---
+    double y = measurement - x_pred0;
+    double S = Pp11 + measurement_noise;
+    double K0 = Pp11 / S;
+    double K1 = Pp21 / S;
+
+    updated_state[0] = x_pred0 + K0 * y;
+    updated_state[1] = x_pred1 + K1 * y;
+
+    // Joseph form, as generated
+    double ikh00 = 1.0 - K0;
+    double ikh10 = -K1;
+
+    double A00 = ikh00 * Pp11;
+    double A01 = ikh00 * Pp12;
+    double A10 = ikh10 * Pp11 + Pp21;
+    double A11 = ikh10 * Pp12 + Pp22;
+
+    double P_up11 = A00 * ikh00;
+    double P_up12 = A00 * ikh10 + A01;
+    double P_up21 = A10 * ikh00;
+    double P_up22 = A10 * ikh10 + A11;
+
+    P_up11 += K0 * measurement_noise * K0;
+    P_up12 += K0 * measurement_noise * K1;
+    P_up21 += K1 * measurement_noise * K0;
+    P_up22 += K1 * measurement_noise * K1;
+
+    updated_covariance[0] = P_up11;
+    updated_covariance[1] = P_up12;
+    updated_covariance[2] = P_up21;
+    updated_covariance[3] = P_up22;
+}
+
+} // namespace kalman_filter
+
+#endif // KALMAN_FILTER_FIXED_H
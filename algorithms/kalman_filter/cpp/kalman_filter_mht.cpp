@@ -0,0 +1,374 @@
+#include "kalman_filter_mht.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "kalman_filter.h"
+#include "kalman_filter_batch.h"
+#include "object_pool.h"
+
+namespace kalman_filter {
+
+namespace {
+
+struct Node {
+    Node* parent;       // nullptr at the root
+    int children;
+    int depth;          // scans since the track was added
+    int measurement;    // -1: missed detection
+    double score;
+    double state[2];
+    double covariance[4];
+};
+
+// The predict half of generated/kalman_filter.cpp, in the same order
+void Predict(const Node& from, double process_noise, Node& to) {
+    const double* P = from.covariance;
+    to.state[0] = from.state[0] + from.state[1];
+    to.state[1] = from.state[1];
+    to.covariance[0] = (P[0] + P[2]) + (P[1] + P[3]) + process_noise;
+    to.covariance[1] = (P[1] + P[3]);
+    to.covariance[2] = (P[2] + P[3]);
+    to.covariance[3] = P[3] + process_noise;
+}
+
+// ---- k-best assignment ----
+
+// Cost of a forbidden cell. Finite, so reduced costs stay numbers.
+constexpr double kForbidden = 1e30;
+
+struct Assignment {
+    std::vector<int> column;  // per row
+    double cost;
+};
+
+// Lowest-cost assignment of every row to a distinct column (rows <=
+// columns): the Hungarian method with potentials, O(rows^2 columns).
+// Returns false if every assignment uses a forbidden cell.
+bool SolveAssignment(const std::vector<double>& cost, int rows, int cols, Assignment& out) {
+    const double inf = std::numeric_limits<double>::infinity();
+    std::vector<double> u(rows + 1, 0.0), v(cols + 1, 0.0), minv(cols + 1);
+    std::vector<int> row_of(cols + 1, 0), way(cols + 1, 0);
+    std::vector<char> used(cols + 1);
+    for (int i = 1; i <= rows; i++) {
+        row_of[0] = i;
+        int j0 = 0;
+        std::fill(minv.begin(), minv.end(), inf);
+        std::fill(used.begin(), used.end(), 0);
+        do {
+            used[j0] = 1;
+            const int i0 = row_of[j0];
+            double delta = inf;
+            int j1 = 0;
+            for (int j = 1; j <= cols; j++) {
+                if (used[j]) continue;
+                double reduced = cost[(i0 - 1) * cols + (j - 1)] - u[i0] - v[j];
+                if (reduced < minv[j]) {
+                    minv[j] = reduced;
+                    way[j] = j0;
+                }
+                if (minv[j] < delta) {
+                    delta = minv[j];
+                    j1 = j;
+                }
+            }
+            // Only forbidden cells left to augment through
+            if (delta >= kForbidden / 2) return false;
+            for (int j = 0; j <= cols; j++) {
+                if (used[j]) {
+                    u[row_of[j]] += delta;
+                    v[j] -= delta;
+                } else {
+                    minv[j] -= delta;
+                }
+            }
+            j0 = j1;
+        } while (row_of[j0] != 0);
+        do {
+            int j1 = way[j0];
+            row_of[j0] = row_of[j1];
+            j0 = j1;
+        } while (j0 != 0);
+    }
+    out.column.assign(rows, -1);
+    out.cost = 0.0;
+    for (int j = 1; j <= cols; j++) {
+        if (row_of[j] == 0) continue;
+        out.column[row_of[j] - 1] = j - 1;
+        out.cost += cost[(row_of[j] - 1) * cols + (j - 1)];
+    }
+    return true;
+}
+
+// The k lowest-cost assignments, best first (Murty's method). Each
+// solution's problem is split into disjoint subproblems that exclude it:
+// subproblem r keeps rows 0..r-1 on the solution's columns and forbids row
+// r its column. The best solution among the open subproblems is the next
+// assignment.
+std::vector<Assignment> KBestAssignments(std::vector<double> cost, int rows, int cols, int k) {
+    struct Problem {
+        std::vector<double> cost;
+        Assignment solution;
+    };
+    std::vector<Assignment> result;
+    std::vector<Problem> open;
+    Problem first{std::move(cost), {}};
+    if (SolveAssignment(first.cost, rows, cols, first.solution)) open.push_back(std::move(first));
+
+    while (!open.empty() && static_cast<int>(result.size()) < k) {
+        auto next = std::min_element(open.begin(), open.end(), [](const Problem& a, const Problem& b) {
+            return a.solution.cost < b.solution.cost;
+        });
+        Problem problem = std::move(*next);
+        open.erase(next);
+        result.push_back(problem.solution);
+        if (static_cast<int>(result.size()) == k) break;
+
+        std::vector<double>& fixed = problem.cost;
+        for (int r = 0; r < rows; r++) {
+            const int c = problem.solution.column[r];
+            Problem sub{fixed, {}};
+            sub.cost[r * cols + c] = kForbidden;
+            if (SolveAssignment(sub.cost, rows, cols, sub.solution)) open.push_back(std::move(sub));
+            // Hold row r on column c for the subproblems after it
+            for (int j = 0; j < cols; j++) {
+                if (j != c) fixed[r * cols + j] = kForbidden;
+            }
+            for (int i = 0; i < rows; i++) {
+                if (i != r) fixed[i * cols + c] = kForbidden;
+            }
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+// ---- Tracker ----
+
+struct MhtTracker::Impl {
+    struct Track {
+        Node* root;
+        std::vector<Node*> leaves;
+    };
+
+    // A leaf extended by one measurement (or a miss) this scan
+    struct Candidate {
+        Node* leaf;
+        int measurement;
+        double score;
+    };
+
+    explicit Impl(const MhtOptions& o) : options(o), pool(o.pool_nodes) {}
+
+    // Frees a leaf that was not extended, then every ancestor left without
+    // children, up to the root
+    void Release(Track& track, Node* node) {
+        while (node != track.root && node->children == 0) {
+            Node* parent = node->parent;
+            pool.destroy(node);
+            parent->children--;
+            node = parent;
+        }
+    }
+
+    Node* BestLeaf(const Track& track) const {
+        return *std::max_element(track.leaves.begin(), track.leaves.end(),
+                                 [](const Node* a, const Node* b) { return a->score < b->score; });
+    }
+
+    // Commits the best leaf's decision from scan_depth scans back: only the
+    // descendants of that ancestor survive, and it becomes the new root
+    void PruneNScan(Track& track) {
+        const Node* best = BestLeaf(track);
+        const int depth = best->depth - options.scan_depth;
+        if (depth <= track.root->depth) return;
+        Node* keep = best->parent;
+        while (keep->depth > depth) keep = keep->parent;
+
+        std::vector<Node*> survivors;
+        for (Node* leaf : track.leaves) {
+            const Node* ancestor = leaf;
+            while (ancestor->depth > depth) ancestor = ancestor->parent;
+            if (ancestor == keep) {
+                survivors.push_back(leaf);
+            } else {
+                Release(track, leaf);
+            }
+        }
+        track.leaves = std::move(survivors);
+
+        // What is left above `keep` is the single path to the old root
+        Node* node = keep->parent;
+        keep->parent = nullptr;
+        while (node) {
+            Node* parent = node->parent;
+            pool.destroy(node);
+            node = parent;
+        }
+        track.root = keep;
+    }
+
+    MhtOptions options;
+    runtime::ObjectPool<Node> pool;
+    std::vector<Track> tracks;
+
+    // Scratch, reused across scans
+    std::vector<double> log_likelihood;
+    std::vector<Candidate> candidates;
+    std::vector<int> first_candidate;  // per track, into candidates
+    std::vector<double> best_score;    // per (track, column)
+    std::vector<char> selected;        // per (track, column)
+};
+
+MhtTracker::MhtTracker(const MhtOptions& options) {
+    if (!(options.detection_probability > 0.0 && options.detection_probability < 1.0)) {
+        throw std::invalid_argument("MhtTracker: detection_probability must be in (0, 1)");
+    }
+    if (!(options.clutter_density > 0.0) || !(options.gate > 0.0)) {
+        throw std::invalid_argument("MhtTracker: clutter_density and gate must be positive");
+    }
+    if (options.global_hypotheses < 1 || options.hypotheses_per_track < 1 || options.scan_depth < 1) {
+        throw std::invalid_argument(
+            "MhtTracker: global_hypotheses, hypotheses_per_track and scan_depth must be at least 1");
+    }
+    impl_ = std::make_unique<Impl>(options);
+}
+
+MhtTracker::~MhtTracker() = default;
+
+int MhtTracker::add_track(const double state[2], const double state_covariance[4]) {
+    Node* root = impl_->pool.create();
+    root->measurement = -1;
+    std::copy(state, state + 2, root->state);
+    std::copy(state_covariance, state_covariance + 4, root->covariance);
+    impl_->tracks.push_back({root, {root}});
+    return static_cast<int>(impl_->tracks.size()) - 1;
+}
+
+void MhtTracker::scan(const double measurements[], int count) {
+    if (count < 0) throw std::invalid_argument("MhtTracker::scan: count is negative");
+    Impl& s = *impl_;
+    const MhtOptions& o = s.options;
+    const int rows = static_cast<int>(s.tracks.size());
+    if (rows == 0) return;
+    // Columns: the measurements, then one miss column per track
+    const int cols = count + rows;
+    const double detected = std::log(o.detection_probability) - std::log(o.clutter_density);
+    const double missed = std::log1p(-o.detection_probability);
+    const double none = -std::numeric_limits<double>::infinity();
+
+    // Score every leaf against every measurement
+    s.log_likelihood.resize(count);
+    s.candidates.clear();
+    s.first_candidate.assign(rows + 1, 0);
+    s.best_score.assign(static_cast<size_t>(rows) * cols, none);
+    for (int t = 0; t < rows; t++) {
+        s.first_candidate[t] = static_cast<int>(s.candidates.size());
+        double* best = &s.best_score[static_cast<size_t>(t) * cols];
+        for (Node* leaf : s.tracks[t].leaves) {
+            Node predicted;
+            Predict(*leaf, o.process_noise, predicted);
+            kalman_filter_likelihood_batch(count, measurements, predicted.state[0],
+                                           predicted.covariance[0] + o.measurement_noise, o.gate,
+                                           s.log_likelihood.data());
+            for (int m = 0; m < count; m++) {
+                if (s.log_likelihood[m] == none) continue;
+                double score = leaf->score + s.log_likelihood[m] + detected;
+                s.candidates.push_back({leaf, m, score});
+                best[m] = std::max(best[m], score);
+            }
+            double score = leaf->score + missed;
+            s.candidates.push_back({leaf, -1, score});
+            best[count + t] = std::max(best[count + t], score);
+        }
+    }
+    s.first_candidate[rows] = static_cast<int>(s.candidates.size());
+
+    // k best joint assignments over each cell's best branch
+    std::vector<double> cost(s.best_score.size());
+    for (size_t i = 0; i < cost.size(); i++) {
+        cost[i] = s.best_score[i] == none ? kForbidden : -s.best_score[i];
+    }
+    s.selected.assign(cost.size(), 0);
+    for (const Assignment& a : KBestAssignments(std::move(cost), rows, cols, o.global_hypotheses)) {
+        for (int t = 0; t < rows; t++) s.selected[static_cast<size_t>(t) * cols + a.column[t]] = 1;
+    }
+
+    // Extend the selected branches
+    for (int t = 0; t < rows; t++) {
+        Impl::Track& track = s.tracks[t];
+        auto begin = s.candidates.begin() + s.first_candidate[t];
+        auto end = s.candidates.begin() + s.first_candidate[t + 1];
+        const char* selected = &s.selected[static_cast<size_t>(t) * cols];
+        end = std::partition(begin, end, [&](const Impl::Candidate& c) {
+            return selected[c.measurement < 0 ? count + t : c.measurement] != 0;
+        });
+        if (end - begin > o.hypotheses_per_track) {
+            std::nth_element(begin, begin + (o.hypotheses_per_track - 1), end,
+                             [](const Impl::Candidate& a, const Impl::Candidate& b) {
+                                 return a.score > b.score;
+                             });
+            end = begin + o.hypotheses_per_track;
+        }
+
+        std::vector<Node*> leaves;
+        leaves.reserve(end - begin);
+        for (auto c = begin; c != end; ++c) {
+            Node* child = s.pool.create();
+            child->parent = c->leaf;
+            child->depth = c->leaf->depth + 1;
+            child->measurement = c->measurement;
+            child->score = c->score;
+            if (c->measurement >= 0) {
+                kalman_filter(c->leaf->state, measurements[c->measurement], c->leaf->covariance,
+                              o.measurement_noise, o.process_noise, child->state, child->covariance);
+            } else {
+                Predict(*c->leaf, o.process_noise, *child);
+            }
+            c->leaf->children++;
+            leaves.push_back(child);
+        }
+        for (Node* leaf : track.leaves) {
+            if (leaf->children == 0) s.Release(track, leaf);
+        }
+        track.leaves = std::move(leaves);
+        s.PruneNScan(track);
+    }
+}
+
+int MhtTracker::track_count() const {
+    return static_cast<int>(impl_->tracks.size());
+}
+
+MhtEstimate MhtTracker::best(int track) const {
+    if (track < 0 || track >= track_count()) throw std::out_of_range("MhtTracker::best: no such track");
+    const Node* leaf = impl_->BestLeaf(impl_->tracks[track]);
+    MhtEstimate e;
+    std::copy(leaf->state, leaf->state + 2, e.state);
+    std::copy(leaf->covariance, leaf->covariance + 4, e.covariance);
+    e.measurement = leaf->measurement;
+    e.score = leaf->score;
+    return e;
+}
+
+int MhtTracker::hypotheses(int track) const {
+    if (track < 0 || track >= track_count()) {
+        throw std::out_of_range("MhtTracker::hypotheses: no such track");
+    }
+    return static_cast<int>(impl_->tracks[track].leaves.size());
+}
+
+size_t MhtTracker::nodes() const {
+    return impl_->pool.live();
+}
+
+size_t MhtTracker::node_capacity() const {
+    return impl_->pool.capacity();
+}
+
+} // namespace kalman_filter
@@ -0,0 +1,100 @@
+#ifndef KALMAN_FILTER_MHT_H
+#define KALMAN_FILTER_MHT_H
+
+// Multiple-hypothesis tracking on kalman_filter() (hand-written, ships in
+// the package).
+//
+// In dense clutter a tracker that commits to one measurement per track
+// and scan loses tracks to false measurements it cannot take back. The
+// MhtTracker defers the decision instead: each track keeps a tree of
+// association hypotheses (measurement i, or a missed detection, at every
+// scan), and a decision becomes final only N scans later, once the later
+// measurements have shown which branch was right.
+//
+//   kalman_filter::MhtOptions options;
+//   options.measurement_noise = R;
+//   options.process_noise = Q;
+//   kalman_filter::MhtTracker mht(options);
+//   mht.add_track(x0, P0);
+//   for (each scan) {
+//       mht.scan(z, count);
+//       kalman_filter::MhtEstimate e = mht.best(0);
+//   }
+//
+// Every scan:
+// - each leaf of each tree is predicted once, and all measurements are
+//   scored against that shared prediction by
+//   kalman_filter_likelihood_batch() (SIMD, gated);
+// - the k best joint assignments of tracks to distinct measurements (or
+//   to a miss) are found with Murty's method, and only the branches that
+//   appear in one of them are extended, with kalman_filter() for a
+//   measurement and a predict-only step for a miss;
+// - each tree keeps at most `hypotheses_per_track` leaves, and N-scan
+//   pruning drops the branches that disagree with the best leaf N scans
+//   back, which bounds the tree's depth.
+// Hypothesis nodes come from a runtime::ObjectPool (runtime/object_pool.h),
+// so deep trees reuse their pruned nodes rather than going to the heap.
+//
+// This is track-oriented MHT: global hypotheses are formed scan by scan,
+// and branches kept from earlier scans are not checked against each other
+// for measurement conflicts. Starting and deleting tracks is left to the
+// caller. Not thread-safe; use one tracker per thread.
+
+#include <cstddef>
+#include <memory>
+
+namespace kalman_filter {
+
+struct MhtOptions {
+    double measurement_noise = 1.0;     // R
+    double process_noise = 0.01;        // Q
+    double detection_probability = 0.9;
+    double clutter_density = 1e-3;      // false measurements per unit of position per scan
+    double gate = 16.0;                 // on y^2 / S, see kalman_filter_likelihood_batch()
+    int global_hypotheses = 8;          // k best joint assignments kept per scan
+    int hypotheses_per_track = 16;      // leaves kept per tree
+    int scan_depth = 3;                 // N of N-scan pruning
+    size_t pool_nodes = 4096;           // hypothesis nodes in the pool's first slab
+};
+
+struct MhtEstimate {
+    double state[2];
+    double covariance[4];
+    int measurement;  // index into the last scan, -1 for a missed detection
+    double score;     // log-likelihood ratio of the hypothesis' history
+};
+
+class MhtTracker {
+public:
+    // Throws std::invalid_argument for options out of range
+    explicit MhtTracker(const MhtOptions& options = MhtOptions());
+    ~MhtTracker();
+    MhtTracker(const MhtTracker&) = delete;
+    MhtTracker& operator=(const MhtTracker&) = delete;
+
+    // Starts a track from a state and covariance; returns its index
+    int add_track(const double state[2], const double state_covariance[4]);
+
+    // Processes one scan of `count` position measurements
+    void scan(const double measurements[], int count);
+
+    int track_count() const;
+
+    // Highest-scoring leaf of a track (std::out_of_range for a bad index)
+    MhtEstimate best(int track) const;
+
+    // Leaves of a track's tree
+    int hypotheses(int track) const;
+
+    // Hypothesis nodes in use over all trees, and nodes the pool holds
+    size_t nodes() const;
+    size_t node_capacity() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace kalman_filter
+
+#endif // KALMAN_FILTER_MHT_H
@@ -0,0 +1,122 @@
+#ifndef KALMAN_FILTER_PACKED_H
+#define KALMAN_FILTER_PACKED_H
+
+// kalman_filter() on packed symmetric covariance (hand-written,
+// header-only, ships in the package).
+//
+// The generated code stores the 2x2 covariance as four values
+// [P11, P12, P21, P22] and computes both off-diagonals. For a symmetric
+// covariance P21 == P12, so a track needs only the three values
+// [P11, P12, P22]. A large track table then moves a quarter less
+// covariance data, and the step drops the terms that only feed P21.
+//
+// For a symmetric input the step gives the generated function's state,
+// P11, P12 and P22 bit for bit; the generated P21 (which rounds
+// differently from P12) is not computed. The batch form is
+// kalman_filter_batch_packed() in kalman_filter_batch.h.
+//
+//   double packed[3];
+//   kalman_filter::pack_covariance(P0, packed);
+//   kalman_filter::PackedStream track(x0, packed);
+//   for (each measurement z) track.step(z, R, Q);
+//   track.covariance(P);  // back to [P11, P12, P21, P22]
+
+namespace kalman_filter {
+
+// [P11, P12, P21, P22] -> [P11, P12, P22]. P21 is dropped.
+inline void pack_covariance(const double state_covariance[4], double packed_covariance[3]) {
+    packed_covariance[0] = state_covariance[0];
+    packed_covariance[1] = state_covariance[1];
+    packed_covariance[2] = state_covariance[3];
+}
+
+// [P11, P12, P22] -> [P11, P12, P12, P22]
+inline void unpack_covariance(const double packed_covariance[3], double state_covariance[4]) {
+    state_covariance[0] = packed_covariance[0];
+    state_covariance[1] = packed_covariance[1];
+    state_covariance[2] = packed_covariance[1];
+    state_covariance[3] = packed_covariance[2];
+}
+
+// One predict-update step, in place, with the generated operations that
+// reach P11, P12 and P22 in the same order. V is double or a GCC vector of
+// doubles (the batch kernels call it one vector of tracks at a time).
+template <class V>
+inline void kalman_filter_packed_step(V& position, V& velocity, V& P11, V& P12, V& P22,
+                                      V measurement, V measurement_noise, V process_noise) {
+    // --- Predict (Pp21 == Pp12) ---
+    V x_pred0 = position + velocity;
+    V x_pred1 = velocity;
+    V Pp11 = (P11 + P12) + (P12 + P22) + process_noise;
+    V Pp12 = (P12 + P22);
+    V Pp22 = P22 + process_noise;
+
+    // --- Update ---
+    V y = measurement - x_pred0;
+    V S = Pp11 + measurement_noise;
+    V K0 = Pp11 / S;
+    V K1 = Pp12 / S;
+    position = x_pred0 + K0 * y;
+    velocity = x_pred1 + K1 * y;
+
+    // Joseph form, upper triangle
+    V ikh00 = 1.0 - K0;
+    V ikh10 = -K1;
+    V A00 = ikh00 * Pp11;
+    V A01 = ikh00 * Pp12;
+    V A10 = ikh10 * Pp11 + Pp12;
+    V A11 = ikh10 * Pp12 + Pp22;
+    P11 = A00 * ikh00 + K0 * measurement_noise * K0;
+    P12 = (A00 * ikh10 + A01) + K0 * measurement_noise * K1;
+    P22 = (A10 * ikh10 + A11) + K1 * measurement_noise * K1;
+}
+
+// kalman_filter() with packed covariance in and out
+inline void kalman_filter_packed(
+    const double state[2],
+    double measurement,
+    const double packed_covariance[3],
+    double measurement_noise,
+    double process_noise,
+    double updated_state[2],
+    double updated_packed_covariance[3])
+{
+    double position = state[0];
+    double velocity = state[1];
+    double P11 = packed_covariance[0];
+    double P12 = packed_covariance[1];
+    double P22 = packed_covariance[2];
+    kalman_filter_packed_step(position, velocity, P11, P12, P22, measurement, measurement_noise,
+                              process_noise);
+    updated_state[0] = position;
+    updated_state[1] = velocity;
+    updated_packed_covariance[0] = P11;
+    updated_packed_covariance[1] = P12;
+    updated_packed_covariance[2] = P22;
+}
+
+// One track carried from step to step in packed form (the packed
+// counterpart of Stream in kalman_filter_wrappers.h)
+class PackedStream {
+public:
+    PackedStream(const double state[2], const double packed_covariance[3])
+        : state_{state[0], state[1]},
+          covariance_{packed_covariance[0], packed_covariance[1], packed_covariance[2]} {}
+
+    void step(double measurement, double measurement_noise, double process_noise) {
+        kalman_filter_packed_step(state_[0], state_[1], covariance_[0], covariance_[1],
+                                  covariance_[2], measurement, measurement_noise, process_noise);
+    }
+
+    const double* state() const { return state_; }
+    const double* packed_covariance() const { return covariance_; }
+    void covariance(double state_covariance[4]) const { unpack_covariance(covariance_, state_covariance); }
+
+private:
+    double state_[2];
+    double covariance_[3];
+};
+
+} // namespace kalman_filter
+
+#endif // KALMAN_FILTER_PACKED_H
@@ -0,0 +1,164 @@
+#ifndef KALMAN_FILTER_PATHS_H
+#define KALMAN_FILTER_PATHS_H
+
+// Execution paths of kalman_filter for the equivalence matrix: the scalar
+// function, kalman_filter_batch() at several batch sizes, and batches
+// spread over 1..N threads, repeated for each SIMD kernel build the CPU
+// supports, plus the generated SoA wrappers.
+
+#include <string>
+#include <vector>
+
+#include "equivalence_matrix.h"
+#include "kalman_filter_batch.h"
+#include "kalman_filter_signature.h"
+#include "kalman_filter_wrappers.h"
+#include "worker_pool.h"
+
+namespace kalman_filter {
+
+// Test cases -> structure-of-arrays track table -> kalman_filter_batch()
+struct BatchAdapter {
+    // Native batch layout; Call() may run repeatedly (the benchmark does)
+    struct Packed {
+        int n = 0;
+        harness::BatchArray position, velocity, cov11, cov12, cov21, cov22;
+        harness::BatchArray measurement, measurement_noise, process_noise;
+
+        void Call() {
+            kalman_filter_batch(n, position.data(), velocity.data(), cov11.data(), cov12.data(),
+                                cov21.data(), cov22.data(), measurement.data(),
+                                measurement_noise.data(), process_noise.data());
+        }
+    };
+
+    static Packed Pack(const std::vector<const harness::Values*>& in) {
+        Packed p;
+        p.n = static_cast<int>(in.size());
+        for (auto* a : {&p.position, &p.velocity, &p.cov11, &p.cov12, &p.cov21, &p.cov22,
+                        &p.measurement, &p.measurement_noise, &p.process_noise}) {
+            a->resize(in.size());
+        }
+        for (size_t i = 0; i < in.size(); i++) {
+            const harness::Values& v = *in[i];
+            p.position[i] = v[0][0];
+            p.velocity[i] = v[0][1];
+            p.measurement[i] = v[1][0];
+            p.cov11[i] = v[2][0];
+            p.cov12[i] = v[2][1];
+            p.cov21[i] = v[2][2];
+            p.cov22[i] = v[2][3];
+            p.measurement_noise[i] = v[3][0];
+            p.process_noise[i] = v[4][0];
+        }
+        return p;
+    }
+
+    static void Unpack(const Packed& p, std::vector<harness::Values*>& out) {
+        for (size_t i = 0; i < out.size(); i++) {
+            harness::Values& r = *out[i];
+            r[0] = {p.position[i], p.velocity[i]};
+            r[1] = {p.cov11[i], p.cov12[i], p.cov21[i], p.cov22[i]};
+        }
+    }
+
+    static void Run(const std::vector<const harness::Values*>& in, std::vector<harness::Values*>& out) {
+        Packed p = Pack(in);
+        p.Call();
+        Unpack(p, out);
+    }
+};
+
+// Test cases -> component-major state/covariance arrays -> the generated
+// kalman_filter_soa() (Threads == 0) or kalman_filter_soa_parallel(), with
+// the state updated in place
+template <int Threads, bool Pooled = false>
+struct SoaAdapter {
+    struct Packed {
+        int n = 0;
+        harness::BatchArray state, covariance;  // 2n and 4n, x[k * n + i]
+        harness::BatchArray measurement, measurement_noise, process_noise;
+
+        void Call() {
+            if (Threads == 0) {
+                kalman_filter_soa(n, state.data(), measurement.data(), covariance.data(),
+                                  measurement_noise.data(), process_noise.data(), state.data(),
+                                  covariance.data());
+            } else if (Pooled) {
+                // One pool per harness thread, kept across calls
+                thread_local runtime::WorkerPool pool(Threads);
+                kalman_filter_soa_parallel(n, state.data(), measurement.data(), covariance.data(),
+                                           measurement_noise.data(), process_noise.data(), state.data(),
+                                           covariance.data(), pool);
+            } else {
+                kalman_filter_soa_parallel(n, state.data(), measurement.data(), covariance.data(),
+                                           measurement_noise.data(), process_noise.data(), state.data(),
+                                           covariance.data(), Threads);
+            }
+        }
+    };
+
+    static Packed Pack(const std::vector<const harness::Values*>& in) {
+        Packed p;
+        size_t n = in.size();
+        p.n = static_cast<int>(n);
+        p.state.resize(2 * n);
+        p.covariance.resize(4 * n);
+        for (auto* a : {&p.measurement, &p.measurement_noise, &p.process_noise}) a->resize(n);
+        for (size_t i = 0; i < n; i++) {
+            const harness::Values& v = *in[i];
+            for (size_t k = 0; k < 2; k++) p.state[k * n + i] = v[0][k];
+            for (size_t k = 0; k < 4; k++) p.covariance[k * n + i] = v[2][k];
+            p.measurement[i] = v[1][0];
+            p.measurement_noise[i] = v[3][0];
+            p.process_noise[i] = v[4][0];
+        }
+        return p;
+    }
+
+    static void Unpack(const Packed& p, std::vector<harness::Values*>& out) {
+        size_t n = out.size();
+        for (size_t i = 0; i < n; i++) {
+            harness::Values& r = *out[i];
+            r[0] = {p.state[i], p.state[n + i]};
+            r[1] = {p.covariance[i], p.covariance[n + i], p.covariance[2 * n + i], p.covariance[3 * n + i]};
+        }
+    }
+
+    static void Run(const std::vector<const harness::Values*>& in, std::vector<harness::Values*>& out) {
+        Packed p = Pack(in);
+        p.Call();
+        Unpack(p, out);
+    }
+};
+
+// Unprefixed batch paths use the kernel picked at load time; the
+// "<isa>/" paths repeat them with each kernel this CPU can run pinned.
+inline std::vector<harness::ExecutionPath> ExecutionPaths() {
+    auto paths = harness::StandardPaths<Signature, BatchAdapter>();
+    const BatchIsa selected = batch_isa();
+    for (BatchIsa isa : {BatchIsa::Portable, BatchIsa::Sse2, BatchIsa::Avx2, BatchIsa::Avx512}) {
+        if (!batch_isa_supported(isa)) continue;
+        std::string prefix = std::string(batch_isa_name(isa)) + "/";
+        for (auto& path : harness::StandardPaths<Signature, BatchAdapter>(prefix)) {
+            paths.push_back(harness::ScopedPath(
+                std::move(path), [isa] { set_batch_isa(isa); }, [selected] { set_batch_isa(selected); }));
+        }
+    }
+
+    // Generated wrappers (kalman_filter_wrappers.h) over the same cases; the
+    // parallel wrapper splits each call over 3 threads, started per call or
+    // kept in a runtime::WorkerPool
+    for (auto& path : harness::StandardPaths<Signature, SoaAdapter<0>>("soa/")) {
+        paths.push_back(std::move(path));
+    }
+    for (size_t b : {3, 64}) {
+        paths.push_back(harness::BatchPath<Signature, SoaAdapter<3>>(b, "soa_parallel/"));
+        paths.push_back(harness::BatchPath<Signature, SoaAdapter<3, true>>(b, "soa_pool/"));
+    }
+    return paths;
+}
+
+} // namespace kalman_filter
+
+#endif // KALMAN_FILTER_PATHS_H
@@ -0,0 +1,181 @@
+/**
+ * Python bindings for kalman_filter (hand-written; built as the
+ * `kalman_filter` extension module by cmake/PythonModule.cmake).
+ *
+ *   kalman_filter(state, measurement, state_covariance, R, Q)
+ *       -> (updated_state[2], updated_covariance[4])
+ *   kalman_filter_batch(position, velocity, cov11, cov12, cov21, cov22,
+ *                       measurement, measurement_noise, process_noise)
+ *       one step for n tracks, arrays updated in place (kalman_filter_batch())
+ *   kalman_filter_sequence(state, state_covariance, measurements, R, Q,
+ *                          states=None, covariances=None)
+ *       -> (states[n, 2], covariances[n, 4]), the filter run over a series
+ *       (kalman_filter_sequence() in kalman_filter_strided.h)
+ *   batch_isa() -> "portable" | "sse2" | "avx2" | "avx512"
+ *
+ * Arrays are used in place (python/python_buffer.h) and the GIL is
+ * released while C++ runs, so Python threads can filter concurrently.
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <array>
+
+#include "kalman_filter.h"
+#include "kalman_filter_batch.h"
+#include "kalman_filter_strided.h"
+#include "python_buffer.h"
+
+namespace {
+
+using python_buffer::DoubleArray;
+
+PyObject* KalmanFilter(PyObject*, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"state", "measurement", "state_covariance", "measurement_noise",
+                                     "process_noise", nullptr};
+    PyObject *state_obj, *cov_obj;
+    double measurement, measurement_noise, process_noise;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OdOdd", const_cast<char**>(keywords), &state_obj,
+                                     &measurement, &cov_obj, &measurement_noise, &process_noise)) {
+        return nullptr;
+    }
+    DoubleArray state, cov, updated_state, updated_cov;
+    if (!state.Parse(state_obj, "state", false) || !python_buffer::CheckSize(state, 2) ||
+        !cov.Parse(cov_obj, "state_covariance", false) || !python_buffer::CheckSize(cov, 4)) {
+        return nullptr;
+    }
+    PyObject* state_out = python_buffer::NewArray({2}, updated_state, "updated_state");
+    if (!state_out) return nullptr;
+    PyObject* cov_out = python_buffer::NewArray({4}, updated_cov, "updated_covariance");
+    if (!cov_out) {
+        Py_DECREF(state_out);
+        return nullptr;
+    }
+    Py_BEGIN_ALLOW_THREADS
+    kalman_filter::kalman_filter(state.data(), measurement, cov.data(), measurement_noise, process_noise,
+                                 updated_state.data(), updated_cov.data());
+    Py_END_ALLOW_THREADS
+    return Py_BuildValue("(NN)", state_out, cov_out);
+}
+
+PyObject* KalmanFilterBatch(PyObject*, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"position", "velocity", "cov11", "cov12", "cov21", "cov22",
+                                     "measurement", "measurement_noise", "process_noise", nullptr};
+    PyObject* objs[9];
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OOOOOOOOO", const_cast<char**>(keywords), &objs[0],
+                                     &objs[1], &objs[2], &objs[3], &objs[4], &objs[5], &objs[6], &objs[7],
+                                     &objs[8])) {
+        return nullptr;
+    }
+    DoubleArray a[9];
+    for (int i = 0; i < 9; i++) {
+        if (!a[i].Parse(objs[i], keywords[i], i < 6)) return nullptr;  // state and covariance in place
+    }
+    if (!python_buffer::CheckSameSize({&a[0], &a[1], &a[2], &a[3], &a[4], &a[5], &a[6], &a[7], &a[8]}) ||
+        !python_buffer::CheckIntSize(a[0].size())) {
+        return nullptr;
+    }
+    const int n = static_cast<int>(a[0].size());
+    Py_BEGIN_ALLOW_THREADS
+    kalman_filter::kalman_filter_batch(n, a[0].data(), a[1].data(), a[2].data(), a[3].data(), a[4].data(),
+                                       a[5].data(), a[6].data(), a[7].data(), a[8].data());
+    Py_END_ALLOW_THREADS
+    Py_RETURN_NONE;
+}
+
+PyObject* KalmanFilterSequence(PyObject*, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"state", "state_covariance", "measurements", "measurement_noise",
+                                     "process_noise", "states", "covariances", nullptr};
+    PyObject *state_obj, *cov_obj, *z_obj, *states_obj = Py_None, *covs_obj = Py_None;
+    double measurement_noise, process_noise;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OOOdd|OO", const_cast<char**>(keywords), &state_obj,
+                                     &cov_obj, &z_obj, &measurement_noise, &process_noise, &states_obj,
+                                     &covs_obj)) {
+        return nullptr;
+    }
+    DoubleArray state, cov, z, states, covs;
+    if (!state.Parse(state_obj, "state", false) || !python_buffer::CheckSize(state, 2) ||
+        !cov.Parse(cov_obj, "state_covariance", false) || !python_buffer::CheckSize(cov, 4) ||
+        !z.Parse(z_obj, "measurements", false)) {
+        return nullptr;
+    }
+    const Py_ssize_t n = z.size();
+
+    // Caller-provided outputs are filled in place and returned as given
+    PyObject* states_out;
+    if (states_obj == Py_None) {
+        if (!(states_out = python_buffer::NewArray({n, 2}, states, "states"))) return nullptr;
+    } else {
+        if (!states.Parse(states_obj, "states", true) || !python_buffer::CheckSize(states, 2 * n)) return nullptr;
+        Py_INCREF(states_out = states_obj);
+    }
+    PyObject* covs_out;
+    if (covs_obj == Py_None) {
+        covs_out = python_buffer::NewArray({n, 4}, covs, "covariances");
+    } else if (covs.Parse(covs_obj, "covariances", true) && python_buffer::CheckSize(covs, 4 * n)) {
+        Py_INCREF(covs_out = covs_obj);
+    } else {
+        covs_out = nullptr;
+    }
+    if (!covs_out) {
+        Py_DECREF(states_out);
+        return nullptr;
+    }
+
+    // Row k of states/covariances as column views; the sizes match, so
+    // kalman_filter_sequence() does not throw
+    const size_t rows = static_cast<size_t>(n);
+    double x[2] = {state.data()[0], state.data()[1]};
+    double p[4] = {cov.data()[0], cov.data()[1], cov.data()[2], cov.data()[3]};
+    std::array<runtime::StridedSpan<double>, 4> cov_columns;
+    for (int i = 0; i < 4; i++) cov_columns[i] = {covs.data() + i, rows, 4 * sizeof(double)};
+    Py_BEGIN_ALLOW_THREADS
+    kalman_filter::kalman_filter_sequence(x, p, {z.data(), rows}, measurement_noise, process_noise,
+                                          {states.data(), rows, 2 * sizeof(double)},
+                                          {states.data() + 1, rows, 2 * sizeof(double)}, cov_columns);
+    Py_END_ALLOW_THREADS
+    return Py_BuildValue("(NN)", states_out, covs_out);
+}
+
+PyObject* BatchIsa(PyObject*, PyObject*) {
+    return PyUnicode_FromString(kalman_filter::batch_isa_name(kalman_filter::batch_isa()));
+}
+
+PyMethodDef kMethods[] = {
+    {"kalman_filter", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(KalmanFilter)),
+     METH_VARARGS | METH_KEYWORDS,
+     "kalman_filter(state, measurement, state_covariance, measurement_noise, process_noise)\n"
+     "-> (updated_state, updated_covariance)\n\nOne predict-update step."},
+    {"kalman_filter_batch", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(KalmanFilterBatch)),
+     METH_VARARGS | METH_KEYWORDS,
+     "kalman_filter_batch(position, velocity, cov11, cov12, cov21, cov22,\n"
+     "                    measurement, measurement_noise, process_noise)\n\n"
+     "One step for n independent tracks. The first six arrays are updated in place."},
+    {"kalman_filter_sequence", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(KalmanFilterSequence)),
+     METH_VARARGS | METH_KEYWORDS,
+     "kalman_filter_sequence(state, state_covariance, measurements, measurement_noise,\n"
+     "                       process_noise, states=None, covariances=None)\n"
+     "-> (states[n, 2], covariances[n, 4])\n\n"
+     "Runs the filter over a measurement series; row k is the estimate after\n"
+     "measurement k. Pass states/covariances to fill existing arrays."},
+    {"batch_isa", BatchIsa, METH_NOARGS, "Kernel used by kalman_filter_batch()."},
+    {nullptr, nullptr, 0, nullptr},
+};
+
+PyModuleDef kModule = {
+    PyModuleDef_HEAD_INIT,
+    "kalman_filter",  // m_name
+    // m_doc
+    "kalman_filter bindings: float64 arrays in place, GIL released during the C++ calls.",
+    -1,  // m_size
+    kMethods,  // m_methods
+    nullptr,  // m_slots
+    nullptr,  // m_traverse
+    nullptr,  // m_clear
+    nullptr,  // m_free
+};
+
+} // namespace
+
+PyMODINIT_FUNC PyInit_kalman_filter() { return PyModule_Create(&kModule); }
@@ -0,0 +1,96 @@
+#ifndef KALMAN_FILTER_REFERENCE_H
+#define KALMAN_FILTER_REFERENCE_H
+
+// Precision-generic transcription of generated/kalman_filter.cpp.
+//
+// Same operations in the same order as the generated code, evaluated in T.
+// With T = long double it is the high-precision reference for the fuzz
+// engine; other instantiations (e.g. float) model reduced-precision builds.
+
+#include <vector>
+
+#include "algorithm_harness.h"
+#include "kalman_filter_signature.h"
+
+namespace kalman_filter {
+
+template <typename T>
+void kalman_filter_reference(
+    const T state[2],
+    T measurement,
+    const T state_covariance[4],
+    T measurement_noise,
+    T process_noise,
+    T updated_state[2],
+    T updated_covariance[4])
+{
+    T P11 = state_covariance[0];
+    T P12 = state_covariance[1];
+    T P21 = state_covariance[2];
+    T P22 = state_covariance[3];
+
+    // --- Predict ---
+    T x_pred0 = state[0] + state[1];
+    T x_pred1 = state[1];
+
+    T Pp11 = (P11 + P21) + (P12 + P22) + process_noise;
+    T Pp12 = (P12 + P22);
+    T Pp21 = (P21 + P22);
+    T Pp22 = P22 + process_noise;
+
+    // --- Update ---
+    T y = measurement - x_pred0;
+    T S = Pp11 + measurement_noise;
+    T K0 = Pp11 / S;
+    T K1 = Pp21 / S;
+
+    updated_state[0] = x_pred0 + K0 * y;
+    updated_state[1] = x_pred1 + K1 * y;
+
+    // Joseph form
+    T ikh00 = T(1) - K0;
+    T ikh10 = -K1;
+
+    T A00 = ikh00 * Pp11;
+    T A01 = ikh00 * Pp12;
+    T A10 = ikh10 * Pp11 + Pp21;
+    T A11 = ikh10 * Pp12 + Pp22;
+
+    T P_up11 = A00 * ikh00;
+    T P_up12 = A00 * ikh10 + A01;
+    T P_up21 = A10 * ikh00;
+    T P_up22 = A10 * ikh10 + A11;
+
+    P_up11 += K0 * measurement_noise * K0;
+    P_up12 += K0 * measurement_noise * K1;
+    P_up21 += K1 * measurement_noise * K0;
+    P_up22 += K1 * measurement_noise * K1;
+
+    updated_covariance[0] = P_up11;
+    updated_covariance[1] = P_up12;
+    updated_covariance[2] = P_up21;
+    updated_covariance[3] = P_up22;
+}
+
+// Reference descriptor for the fuzz engine and error analyzer (same field
+// layout as Signature).
+struct Reference {
+    using Signature = kalman_filter::Signature;
+
+    static void Invoke(const harness::Values& in, harness::WideValues& out) {
+        Evaluate<long double>(in, out);
+    }
+
+    // Evaluate in T (outputs must be sized, e.g. by harness::ResizeOutputs)
+    template <typename T>
+    static void Evaluate(const harness::Values& in, std::vector<std::vector<T>>& out) {
+        T state[2] = {T(in[0][0]), T(in[0][1])};
+        T cov[4] = {T(in[2][0]), T(in[2][1]), T(in[2][2]), T(in[2][3])};
+        kalman_filter_reference<T>(state, T(in[1][0]), cov, T(in[3][0]), T(in[4][0]),
+                                   out[0].data(), out[1].data());
+    }
+};
+
+} // namespace kalman_filter
+
+#endif // KALMAN_FILTER_REFERENCE_H
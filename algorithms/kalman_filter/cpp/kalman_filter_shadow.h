@@ -0,0 +1,58 @@
+#ifndef KALMAN_FILTER_SHADOW_H
+#define KALMAN_FILTER_SHADOW_H
+
+// kalman_filter() calls for shadow execution of a candidate version
+// (runtime/shadow_runner.h; hand-written, header-only, ships in the
+// package and needs algorithm_runtime).
+//
+// A call is flattened to 9 inputs and 6 outputs in the test-vector field
+// order:
+//
+//   inputs   state[2], measurement, state_covariance[4],
+//            measurement_noise, process_noise
+//   outputs  updated_state[2], updated_covariance[4]
+//
+// On the live path, after the live call:
+//
+//   shadow.Offer([&](double* in, double* live) {
+//       kalman_filter::shadow_pack(state, z, P, R, Q, new_state, new_P, in, live);
+//   });
+//
+// shadow_call() runs this build on a flattened call; it is the candidate
+// when this build is the version on trial, loaded next to the live one.
+// The comparison tolerance of the test vectors is read by
+// shadow_tolerance() in kalman_filter_shadow_tolerance.h, kept apart so this
+// header stays free of JSON parsing.
+
+#include "kalman_filter.h"
+#include "shadow_runner.h"
+
+namespace kalman_filter {
+
+constexpr size_t kShadowInputs = 9;
+constexpr size_t kShadowOutputs = 6;
+
+using ShadowRunner = runtime::ShadowRunner<kShadowInputs, kShadowOutputs>;
+
+inline void shadow_pack(const double state[2], double measurement, const double state_covariance[4],
+                        double measurement_noise, double process_noise,
+                        const double updated_state[2], const double updated_covariance[4],
+                        double* inputs, double* outputs) {
+    inputs[0] = state[0];
+    inputs[1] = state[1];
+    inputs[2] = measurement;
+    for (int k = 0; k < 4; k++) inputs[3 + k] = state_covariance[k];
+    inputs[7] = measurement_noise;
+    inputs[8] = process_noise;
+    outputs[0] = updated_state[0];
+    outputs[1] = updated_state[1];
+    for (int k = 0; k < 4; k++) outputs[2 + k] = updated_covariance[k];
+}
+
+inline void shadow_call(const double* inputs, double* outputs) {
+    kalman_filter(inputs, inputs[2], inputs + 3, inputs[7], inputs[8], outputs, outputs + 2);
+}
+
+} // namespace kalman_filter
+
+#endif // KALMAN_FILTER_SHADOW_H
@@ -0,0 +1,23 @@
+#ifndef KALMAN_FILTER_SHADOW_TOLERANCE_H
+#define KALMAN_FILTER_SHADOW_TOLERANCE_H
+
+// The test vectors' tolerance for shadow comparisons of kalman_filter()
+// (kalman_filter_shadow.h; hand-written, header-only, ships in the package).
+// Reads JSON through runtime/shadow_tolerance.h, so it also needs
+// nlohmann_json; include it where the vector file is read, not next to
+// the live path.
+
+#include <string>
+
+#include "shadow_tolerance.h"
+
+namespace kalman_filter {
+
+// The global_tolerance of a test-vector file (test_vectors/nominal.json)
+inline runtime::ShadowTolerance shadow_tolerance(const std::string& vector_file) {
+    return runtime::read_shadow_tolerance(vector_file);
+}
+
+} // namespace kalman_filter
+
+#endif // KALMAN_FILTER_SHADOW_TOLERANCE_H
@@ -0,0 +1,69 @@
+#ifndef KALMAN_FILTER_STRIDED_H
+#define KALMAN_FILTER_STRIDED_H
+
+// kalman_filter() over a measurement sequence on strided views
+// (hand-written, header-only, ships in the package and needs
+// algorithm_runtime for runtime/strided_span.h).
+//
+// Runs one track through a sequence of measurements, reading them from
+// and writing the estimates to fields of interleaved records in place:
+//
+//   struct Sample { double t, z, position, velocity; };
+//   double state[2] = ..., P[4] = ...;
+//   kalman_filter::kalman_filter_sequence(state, P, runtime::field(frame, &Sample::z), R, Q,
+//                                         runtime::field(frame, &Sample::position),
+//                                         runtime::field(frame, &Sample::velocity));
+//
+// Each step is one kalman_filter() call, so the estimates are
+// bit-identical to chaining the calls by hand (or to Stream in
+// kalman_filter_wrappers.h).
+
+#include <array>
+#include <stdexcept>
+
+#include "kalman_filter.h"
+#include "strided_span.h"
+
+namespace kalman_filter {
+
+// state and state_covariance are the track before the first measurement
+// and are updated in place to the track after the last one, ready for the
+// next frame. position[k] and velocity[k] receive the estimate after
+// measurement[k], and covariance[i][k] element i of its covariance; an
+// empty view skips that output.
+inline void kalman_filter_sequence(
+    double state[2],
+    double state_covariance[4],
+    runtime::StridedSpan<const double> measurement,
+    double measurement_noise,
+    double process_noise,
+    runtime::StridedSpan<double> position,
+    runtime::StridedSpan<double> velocity = {},
+    const std::array<runtime::StridedSpan<double>, 4>& covariance = {})
+{
+    const size_t n = measurement.size();
+    bool sized = (position.empty() || position.size() == n) && (velocity.empty() || velocity.size() == n);
+    for (const auto& c : covariance) sized = sized && (c.empty() || c.size() == n);
+    if (!sized) {
+        throw std::invalid_argument("kalman_filter_sequence: position, velocity and covariance must be "
+                                    "empty or the size of measurement");
+    }
+    double updated_state[2];
+    double updated_covariance[4];
+    for (size_t k = 0; k < n; k++) {
+        kalman_filter(state, measurement[k], state_covariance, measurement_noise, process_noise,
+                      updated_state, updated_covariance);
+        state[0] = updated_state[0];
+        state[1] = updated_state[1];
+        for (int i = 0; i < 4; i++) state_covariance[i] = updated_covariance[i];
+        if (!position.empty()) position[k] = state[0];
+        if (!velocity.empty()) velocity[k] = state[1];
+        for (int i = 0; i < 4; i++) {
+            if (!covariance[i].empty()) covariance[i][k] = state_covariance[i];
+        }
+    }
+}
+
+} // namespace kalman_filter
+
+#endif // KALMAN_FILTER_STRIDED_H
@@ -0,0 +1,123 @@
+#ifndef KALMAN_FILTER_UD_H
+#define KALMAN_FILTER_UD_H
+
+// Square-root (UD-factorized) form of kalman_filter() (hand-written,
+// header-only, ships in the package).
+//
+// The generated step carries the covariance P itself and rebuilds it with
+// the Joseph form, a difference of large terms when P is large against R.
+// In double that cancellation is harmless. In float, with P0 = 1000 as in
+// high_uncertainty_initial, it can leave P indefinite, and the filter then
+// diverges. This form carries the factors of
+//
+//   P = U D U'   with   U = [1 u; 0 1],   D = diag(d1, d2)
+//
+// instead. The time update is the closed-form 2x2 modified weighted
+// Gram-Schmidt step, and the measurement update is Bierman's. Each new d
+// is a sum or a ratio of nonnegative terms, so d1, d2 >= 0 holds in any
+// precision and P = U D U' stays positive semidefinite by construction.
+// That makes float tracks safe, at twice the vector width of double (see
+// kalman_filter_ud_batch() in kalman_filter_batch.h).
+//
+// Same model as the generated code: F = [1 1; 0 1], H = [1 0], Q added to
+// both diagonals. In double the results agree with kalman_filter() to the
+// test vectors' tolerance, but not bit for bit.
+//
+// Keep tracks in factored form between steps:
+//
+//   kalman_filter::ud_factor(P0, d1, u, d2);
+//   for (each measurement z)
+//       kalman_filter::kalman_filter_ud_step(x0, x1, d1, u, d2, z, R, Q);
+//   kalman_filter::ud_to_covariance(d1, u, d2, P);
+//
+// kalman_filter_ud() does all three for one step, with the signature of
+// the generated function.
+
+namespace kalman_filter {
+
+// a / b, or 0 where b == 0 (a covariance with a zero variance). Also
+// works lane-wise on GCC vector types.
+template <class V>
+inline V ud_divide(V a, V b) {
+    return b != 0 ? a / b : V{};
+}
+
+// Factors a symmetric positive semidefinite covariance [P11, P12, P21, P22]
+// (the generated code's flattened layout). The off-diagonals are averaged.
+template <typename T>
+inline void ud_factor(const T state_covariance[4], T& d1, T& u, T& d2) {
+    T p12 = (state_covariance[1] + state_covariance[2]) * T(0.5);
+    d2 = state_covariance[3];
+    u = ud_divide(p12, d2);
+    d1 = state_covariance[0] - u * p12;
+    if (d1 < T(0)) d1 = T(0);  // rounding on a (near-)singular P
+}
+
+// P = U D U', flattened as [P11, P12, P21, P22]
+template <typename T>
+inline void ud_to_covariance(T d1, T u, T d2, T state_covariance[4]) {
+    T p12 = u * d2;
+    state_covariance[0] = d1 + u * p12;
+    state_covariance[1] = p12;
+    state_covariance[2] = p12;
+    state_covariance[3] = d2;
+}
+
+// One predict-update step on factored covariance, in place. V is float,
+// double or a GCC vector of either (the batch kernels call it one vector
+// of tracks at a time).
+template <class V>
+inline void kalman_filter_ud_step(V& position, V& velocity, V& d1, V& u, V& d2, V measurement,
+                                  V measurement_noise, V process_noise) {
+    const V q = process_noise;
+    const V r = measurement_noise;
+
+    // --- Predict: F U = [1 w; 0 1], then Q ---
+    V w = u + 1;
+    V x_pred0 = position + velocity;
+    V x_pred1 = velocity;
+    V dp2 = d2 + q;
+    V up = ud_divide(w * d2, dp2);
+    V dp1 = (d1 + q) + (w * up) * q;  // w * up = w^2 d2 / dp2 >= 0
+
+    // --- Update (Bierman, h = [1 0]) ---
+    V y = measurement - x_pred0;
+    V a1 = r + dp1;
+    V b1 = dp1 + (dp2 * up) * up;  // H P H' = S - r
+    V b2 = dp2 * up;
+    V S = a1 + (b2 * up);
+    V K0 = ud_divide(b1, S);
+    V K1 = ud_divide(b2, S);
+    position = x_pred0 + K0 * y;
+    velocity = x_pred1 + K1 * y;
+
+    d1 = ud_divide(dp1 * r, a1);
+    u = ud_divide(up * r, a1);
+    d2 = ud_divide(dp2 * a1, S);
+}
+
+// kalman_filter() in square-root form: factor, step, reconstruct. T is
+// double or float.
+template <typename T>
+inline void kalman_filter_ud(
+    const T state[2],
+    T measurement,
+    const T state_covariance[4],
+    T measurement_noise,
+    T process_noise,
+    T updated_state[2],
+    T updated_covariance[4])
+{
+    T d1, u, d2;
+    ud_factor(state_covariance, d1, u, d2);
+    T position = state[0];
+    T velocity = state[1];
+    kalman_filter_ud_step(position, velocity, d1, u, d2, measurement, measurement_noise, process_noise);
+    updated_state[0] = position;
+    updated_state[1] = velocity;
+    ud_to_covariance(d1, u, d2, updated_covariance);
+}
+
+} // namespace kalman_filter
+
+#endif // KALMAN_FILTER_UD_H
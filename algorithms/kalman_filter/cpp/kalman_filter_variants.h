@@ -0,0 +1,172 @@
+#ifndef KALMAN_FILTER_VARIANTS_H
+#define KALMAN_FILTER_VARIANTS_H
+
+// Candidate kernel variants of kalman_filter for error analysis.
+//
+// Each variant computes the same step as generated/kalman_filter.cpp with a
+// different rounding behaviour. The analyzer (ulp_kalman_filter) measures
+// them against the long double reference before any of them is adopted.
+
+#include <cmath>
+#include <tuple>
+#include <type_traits>
+
+#include "kalman_filter_reference.h"
+#include "kalman_filter_ud.h"
+#include "variants.h"
+
+namespace kalman_filter {
+
+// What the generated code becomes when a*b + c is contracted into fused
+// multiply-adds (-mfma -ffp-contract=fast).
+inline void kalman_filter_fma(
+    const double state[2],
+    double measurement,
+    const double state_covariance[4],
+    double measurement_noise,
+    double process_noise,
+    double updated_state[2],
+    double updated_covariance[4])
+{
+    double P11 = state_covariance[0];
+    double P12 = state_covariance[1];
+    double P21 = state_covariance[2];
+    double P22 = state_covariance[3];
+
+    // --- Predict (additions only, nothing to contract) ---
+    double x_pred0 = state[0] + state[1];
+    double x_pred1 = state[1];
+
+    double Pp11 = (P11 + P21) + (P12 + P22) + process_noise;
+    double Pp12 = (P12 + P22);
+    double Pp21 = (P21 + P22);
+    double Pp22 = P22 + process_noise;
+
+    // --- Update ---
+    double y = measurement - x_pred0;
+    double S = Pp11 + measurement_noise;
+    double K0 = Pp11 / S;
+    double K1 = Pp21 / S;
+
+    updated_state[0] = std::fma(K0, y, x_pred0);
+    updated_state[1] = std::fma(K1, y, x_pred1);
+
+    // Joseph form
+    double ikh00 = 1.0 - K0;
+    double ikh10 = -K1;
+
+    double A00 = ikh00 * Pp11;
+    double A01 = ikh00 * Pp12;
+    double A10 = std::fma(ikh10, Pp11, Pp21);
+    double A11 = std::fma(ikh10, Pp12, Pp22);
+
+    double P_up11 = A00 * ikh00;
+    double P_up12 = std::fma(A00, ikh10, A01);
+    double P_up21 = A10 * ikh00;
+    double P_up22 = std::fma(A10, ikh10, A11);
+
+    updated_covariance[0] = std::fma(K0 * measurement_noise, K0, P_up11);
+    updated_covariance[1] = std::fma(K0 * measurement_noise, K1, P_up12);
+    updated_covariance[2] = std::fma(K1 * measurement_noise, K0, P_up21);
+    updated_covariance[3] = std::fma(K1 * measurement_noise, K1, P_up22);
+}
+
+struct FmaVariant {
+    using Scalar = double;
+    static constexpr const char* kName = "fma";
+    static constexpr const char* kDescription = "Generated operation order with multiply-adds fused";
+
+    static void Invoke(const harness::Values& in, harness::Values& out) {
+        kalman_filter_fma(in[0].data(), in[1][0], in[2].data(), in[3][0], in[4][0],
+                          out[0].data(), out[1].data());
+    }
+};
+
+// The generated step with the gain's two divisions by S strength-reduced
+// to one reciprocal and two multiplies (what -freciprocal-math does, and
+// what kalman_filter_fixed<R, Q>() deliberately does not do).
+inline void kalman_filter_reciprocal(
+    const double state[2],
+    double measurement,
+    const double state_covariance[4],
+    double measurement_noise,
+    double process_noise,
+    double updated_state[2],
+    double updated_covariance[4])
+{
+    double P11 = state_covariance[0];
+    double P12 = state_covariance[1];
+    double P21 = state_covariance[2];
+    double P22 = state_covariance[3];
+
+    double x_pred0 = state[0] + state[1];
+    double x_pred1 = state[1];
+
+    double Pp11 = (P11 + P21) + (P12 + P22) + process_noise;
+    double Pp12 = (P12 + P22);
+    double Pp21 = (P21 + P22);
+    double Pp22 = P22 + process_noise;
+
+    double y = measurement - x_pred0;
+    double S = Pp11 + measurement_noise;
+    double inv_S = 1.0 / S;
+    double K0 = Pp11 * inv_S;
+    double K1 = Pp21 * inv_S;
+
+    updated_state[0] = x_pred0 + K0 * y;
+    updated_state[1] = x_pred1 + K1 * y;
+
+    double ikh00 = 1.0 - K0;
+    double ikh10 = -K1;
+
+    double A00 = ikh00 * Pp11;
+    double A01 = ikh00 * Pp12;
+    double A10 = ikh10 * Pp11 + Pp21;
+    double A11 = ikh10 * Pp12 + Pp22;
+
+    updated_covariance[0] = A00 * ikh00 + K0 * measurement_noise * K0;
+    updated_covariance[1] = (A00 * ikh10 + A01) + K0 * measurement_noise * K1;
+    updated_covariance[2] = A10 * ikh00 + K1 * measurement_noise * K0;
+    updated_covariance[3] = (A10 * ikh10 + A11) + K1 * measurement_noise * K1;
+}
+
+struct ReciprocalVariant {
+    using Scalar = double;
+    static constexpr const char* kName = "reciprocal";
+    static constexpr const char* kDescription = "Kalman gain through one reciprocal of S";
+
+    static void Invoke(const harness::Values& in, harness::Values& out) {
+        kalman_filter_reciprocal(in[0].data(), in[1][0], in[2].data(), in[3][0], in[4][0],
+                                 out[0].data(), out[1].data());
+    }
+};
+
+// Square-root (UD) form in T (kalman_filter_ud.h): different operations,
+// so compare its error rather than its bits.
+template <typename T>
+struct UdVariant {
+    using Scalar = T;
+    static constexpr const char* kName = std::is_same<T, float>::value ? "ud_float" : "ud";
+    static constexpr const char* kDescription = "Square-root (UD-factorized) covariance update";
+
+    static void Invoke(const harness::Values& in, harness::Values& out) {
+        T state[2] = {T(in[0][0]), T(in[0][1])};
+        T cov[4] = {T(in[2][0]), T(in[2][1]), T(in[2][2]), T(in[2][3])};
+        T new_state[2], new_cov[4];
+        kalman_filter_ud<T>(state, T(in[1][0]), cov, T(in[3][0]), T(in[4][0]), new_state, new_cov);
+        out[0].assign(new_state, new_state + 2);
+        out[1].assign(new_cov, new_cov + 4);
+    }
+};
+
+using Variants = std::tuple<
+    harness::GeneratedVariant<Signature>,
+    FmaVariant,
+    ReciprocalVariant,
+    harness::PrecisionVariant<Reference, float>,
+    UdVariant<double>,
+    UdVariant<float>>;
+
+} // namespace kalman_filter
+
+#endif // KALMAN_FILTER_VARIANTS_H
@@ -5,22 +5,43 @@
  * Reads the same JSON test vectors used by the MATLAB test harness,
  * runs the generated C++ function, and validates outputs within tolerance.
  *
- * Also writes cpp_outputs.json for equivalence comparison with MATLAB.
+ * Input/output mapping comes from kalman_filter_signature.h; loading, parallel
+ * execution and output collection are shared (harness/). The vectors are
+ * embedded at build time (kalman_filter_test_vectors.h); set HARNESS_VECTORS to a
+ * JSON directory or .tvb file to run other vectors ad hoc.
+ *
+ * Every execution path in kalman_filter_paths.h (batch, threaded, each SIMD
+ * kernel) must match the scalar function bit for bit; the path x case
+ * matrix is written next to cpp_outputs.json, which is kept for
+ * equivalence comparison with MATLAB.
  */
 
 #include <gtest/gtest.h>
-#include <nlohmann/json.hpp>
-#include <filesystem>
-#include <fstream>
-#include <string>
-#include <vector>
-#include <cmath>
 
-// Generated header from MATLAB Coder
-#include "kalman_filter.h"
-
-using json = nlohmann::json;
-namespace fs = std::filesystem;
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+#include "embedded_vectors.h"
+#include "gtest_harness.h"
+#include "kalman_filter_consistency.h"
+#include "kalman_filter_fixed.h"
+#include "kalman_filter_mht.h"
+#include "kalman_filter_packed.h"
+#include "kalman_filter_paths.h"
+#include "kalman_filter_plugin.h"
+#include "kalman_filter_shadow.h"
+#include "kalman_filter_shadow_tolerance.h"
+#include "kalman_filter_signature.h"
+#include "kalman_filter_strided.h"
+#include "kalman_filter_test_vectors.h"
+#include "kalman_filter_ud.h"
+#include "plugin_host.h"
 
 #ifndef TEST_VECTORS_DIR
 #error "TEST_VECTORS_DIR must be defined at compile time"
@@ -30,176 +51,664 @@ namespace fs = std::filesystem;
 #define OUTPUT_DIR "."
 #endif
 
-// ---- Test case data structure ----
+using Signature = kalman_filter::Signature;
 
-struct TestCase {
-    std::string name;
-    std::string description;
-
-    // Inputs
-    std::vector<double> state;           // 2x1
-    double measurement;
-    std::vector<double> state_covariance; // 4x1 (flattened 2x2)
-    double measurement_noise;
-    double process_noise;
+static std::vector<harness::TestCase> LoadCases() {
+    return harness::LoadSelectedVectors<Signature>(
+        kalman_filter::embedded::kCases, kalman_filter::embedded::kCaseCount);
+}
 
-    // Expected outputs
-    std::vector<double> expected_state;       // 2x1
-    std::vector<double> expected_covariance;  // 4x1
+// ---- Parameterized test ----
 
-    // Tolerance
-    double abs_tolerance;
-};
+using KalmanFilterTest = harness::VectorTest<Signature>;
 
-// For Google Test to print test case names
-std::string TestCaseName(const ::testing::TestParamInfo<TestCase>& info) {
-    return info.param.name;
+TEST_P(KalmanFilterTest, MatchesExpectedOutput) {
+    CheckExpectedOutput();
 }
 
-// ---- Load test vectors from JSON ----
+INSTANTIATE_TEST_SUITE_P(
+    TestVectors,
+    KalmanFilterTest,
+    ::testing::ValuesIn(LoadCases()),
+    harness::TestCaseName
+);
 
-std::vector<TestCase> LoadTestVectors(const std::string& dir) {
-    std::vector<TestCase> cases;
+// ---- Loading and execution paths ----
 
-    for (const auto& entry : fs::directory_iterator(dir)) {
-        if (entry.path().extension() != ".json") continue;
-        if (entry.path().filename() == "schema.json") continue;
+TEST(KalmanFilterHarness, EmbeddedMatchesJson) {
+    harness::ExpectSameCases(
+        harness::LoadTestVectors<Signature>(TEST_VECTORS_DIR),
+        harness::LoadEmbeddedVectors<Signature>(kalman_filter::embedded::kCases, kalman_filter::embedded::kCaseCount));
+}
 
-        std::ifstream f(entry.path());
-        if (!f.is_open()) continue;
+TEST(KalmanFilterHarness, ParallelMatchesSerial) {
+    harness::ExpectParallelMatchesSerial<Signature>(TEST_VECTORS_DIR);
+}
 
-        json data = json::parse(f);
+TEST(KalmanFilterHarness, BinaryRoundTrip) {
+    harness::ExpectBinaryRoundTrip<Signature>(TEST_VECTORS_DIR, OUTPUT_DIR);
+}
 
-        // Global tolerance defaults
-        double global_abs_tol = 1e-10;
-        if (data.contains("global_tolerance") &&
-            data["global_tolerance"].contains("absolute")) {
-            global_abs_tol = data["global_tolerance"]["absolute"].get<double>();
-        }
+TEST(KalmanFilterHarness, StreamingMatchesBulk) {
+    harness::ExpectStreamingMatchesBulk<Signature>(TEST_VECTORS_DIR);
+}
 
-        for (const auto& tc : data["test_cases"]) {
-            TestCase t;
-            t.name = tc["name"].get<std::string>();
-            t.description = tc.value("description", "");
-
-            // Parse inputs
-            t.state = tc["inputs"]["state"].get<std::vector<double>>();
-            t.measurement = tc["inputs"]["measurement"].get<double>();
-            t.state_covariance = tc["inputs"]["state_covariance"].get<std::vector<double>>();
-            t.measurement_noise = tc["inputs"]["measurement_noise"].get<double>();
-            t.process_noise = tc["inputs"]["process_noise"].get<double>();
-
-            // Parse expected outputs
-            t.expected_state = tc["expected_output"]["updated_state"].get<std::vector<double>>();
-            t.expected_covariance = tc["expected_output"]["updated_covariance"].get<std::vector<double>>();
-
-            // Per-case tolerance overrides global
-            t.abs_tolerance = global_abs_tol;
-            if (tc.contains("tolerance") && tc["tolerance"].contains("absolute")) {
-                t.abs_tolerance = tc["tolerance"]["absolute"].get<double>();
-            }
-
-            cases.push_back(t);
-        }
+// ---- Execution paths (scalar, batch sizes, threads, SIMD kernels, SoA wrappers) ----
+
+TEST(KalmanFilterHarness, AllExecutionPathsMatchScalar) {
+    harness::ExpectAllPathsEquivalent<Signature>(kalman_filter::ExecutionPaths(), LoadCases(), OUTPUT_DIR);
+}
+
+// The load-time pick is the widest kernel this build and CPU support
+TEST(KalmanFilterHarness, BatchKernelIsWidestSupported) {
+    using kalman_filter::BatchIsa;
+    BatchIsa selected = kalman_filter::batch_isa();
+    std::cout << "kalman_filter_batch kernel: " << kalman_filter::batch_isa_name(selected) << "\n";
+    EXPECT_TRUE(kalman_filter::batch_isa_supported(selected));
+    EXPECT_TRUE(kalman_filter::batch_isa_supported(BatchIsa::Portable));
+    for (int i = static_cast<int>(selected) + 1; i <= static_cast<int>(BatchIsa::Avx512); i++) {
+        EXPECT_FALSE(kalman_filter::batch_isa_supported(static_cast<BatchIsa>(i)));
+        EXPECT_FALSE(kalman_filter::set_batch_isa(static_cast<BatchIsa>(i)));
     }
+    EXPECT_EQ(kalman_filter::batch_isa(), selected);
+}
 
-    return cases;
+// ---- Startup calibration (kalman_filter_batch.h) ----
+
+// Measures, switches kernel, caches; the second call only reads the cache
+TEST(KalmanFilterHarness, CalibrationPicksSupportedKernelAndCaches) {
+    const kalman_filter::BatchIsa selected = kalman_filter::batch_isa();
+    const std::string cache = std::string(OUTPUT_DIR) + "/kalman_filter_batch_calibration.tsv";
+
+    kalman_filter::BatchTuning measured = kalman_filter::calibrate_batch(cache.c_str(), true);
+    std::cout << "calibrated: " << kalman_filter::batch_isa_name(measured.isa) << ", batch "
+              << measured.batch_size << ", " << measured.threads << " thread(s)\n";
+    EXPECT_FALSE(measured.from_cache);
+    EXPECT_TRUE(kalman_filter::batch_isa_supported(measured.isa));
+    EXPECT_EQ(kalman_filter::batch_isa(), measured.isa);
+    EXPECT_GT(measured.batch_size, 0);
+    EXPECT_GE(measured.threads, 1);
+
+    kalman_filter::BatchTuning cached = kalman_filter::calibrate_batch(cache.c_str());
+    EXPECT_TRUE(cached.from_cache);
+    EXPECT_EQ(cached.isa, measured.isa);
+    EXPECT_EQ(cached.batch_size, measured.batch_size);
+    EXPECT_EQ(cached.threads, measured.threads);
+
+    kalman_filter::set_batch_isa(selected);
 }
 
-// ---- Parameterized test ----
+// ---- Generated wrappers (kalman_filter_wrappers.h) ----
+
+// Stream feeds updated_state/updated_covariance back into the next step
+TEST(KalmanFilterHarness, StreamMatchesChainedCalls) {
+    auto cases = LoadCases();
+    const harness::Values& first = cases.front().inputs;
+    double state[2] = {first[0][0], first[0][1]};
+    double cov[4] = {first[2][0], first[2][1], first[2][2], first[2][3]};
+    kalman_filter::Stream stream(state, cov);
+    for (const auto& tc : cases) {
+        const harness::Values& v = tc.inputs;
+        double next_state[2], next_cov[4];
+        kalman_filter::kalman_filter(state, v[1][0], cov, v[3][0], v[4][0], next_state, next_cov);
+        std::copy(next_state, next_state + 2, state);
+        std::copy(next_cov, next_cov + 4, cov);
+        stream.step(v[1][0], v[3][0], v[4][0]);
+        for (int k = 0; k < 2; k++) EXPECT_EQ(stream.state()[k], state[k]) << tc.name;
+        for (int k = 0; k < 4; k++) EXPECT_EQ(stream.state_covariance()[k], cov[k]) << tc.name;
+    }
+}
 
-class KalmanFilterTest : public ::testing::TestWithParam<TestCase> {};
+// ---- Compile-time constants (kalman_filter_fixed.h) ----
 
-TEST_P(KalmanFilterTest, MatchesExpectedOutput) {
-    const auto& tc = GetParam();
+struct FixedR { static constexpr double value = 0.25; };
+struct FixedQ { static constexpr double value = 0.01; };
 
-    // Prepare input arrays
-    double state[2] = {tc.state[0], tc.state[1]};
-    double cov[4] = {tc.state_covariance[0], tc.state_covariance[1],
-                     tc.state_covariance[2], tc.state_covariance[3]};
+TEST(KalmanFilterHarness, FixedMatchesRuntime) {
+    for (const auto& tc : LoadCases()) {
+        const harness::Values& v = tc.inputs;
+        double state[2], cov[4], fixed_state[2], fixed_cov[4];
+        kalman_filter::kalman_filter(v[0].data(), v[1][0], v[2].data(), FixedR::value, FixedQ::value, state, cov);
+        kalman_filter::kalman_filter_fixed<FixedR, FixedQ>(v[0].data(), v[1][0], v[2].data(), fixed_state, fixed_cov);
+        EXPECT_EQ(0, std::memcmp(state, fixed_state, sizeof state)) << tc.name;
+        EXPECT_EQ(0, std::memcmp(cov, fixed_cov, sizeof cov)) << tc.name;
+    }
+}
 
-    // Output arrays
-    double updated_state[2] = {0.0, 0.0};
-    double updated_cov[4] = {0.0, 0.0, 0.0, 0.0};
+// ---- Packed covariance (kalman_filter_packed.h) ----
 
-    // Call generated C++ function
-    // NOTE: The exact function signature depends on MATLAB Coder output.
-    // You may need to adjust this call to match the generated API.
-    kalman_filter::kalman_filter(state, tc.measurement, cov,
-                                tc.measurement_noise, tc.process_noise,
-                                updated_state, updated_cov);
+// Random symmetric positive definite [P11, P12, P21, P22]
+static void RandomCovariance(std::mt19937& rng, double cov[4]) {
+    std::uniform_real_distribution<double> variance(1e-3, 1e3), correlation(-0.99, 0.99);
+    double v1 = variance(rng), v2 = variance(rng);
+    cov[0] = v1;
+    cov[1] = cov[2] = correlation(rng) * std::sqrt(v1 * v2);
+    cov[3] = v2;
+}
 
-    // Validate state output
-    for (size_t i = 0; i < tc.expected_state.size(); i++) {
-        EXPECT_NEAR(updated_state[i], tc.expected_state[i], tc.abs_tolerance)
-            << "State mismatch at index " << i
-            << " in test case: " << tc.name;
+TEST(KalmanFilterHarness, PackedMatchesScalarUpperTriangle) {
+    std::vector<harness::Values> inputs;
+    for (const auto& tc : LoadCases()) inputs.push_back(tc.inputs);
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> value(-10, 10), noise(1e-4, 10);
+    for (int k = 0; k < 100; k++) {
+        harness::Values v = {{value(rng), value(rng)}, {value(rng)}, std::vector<double>(4),
+                             {noise(rng)}, {noise(rng) / 100}};
+        RandomCovariance(rng, v[2].data());
+        inputs.push_back(v);
+    }
+    for (const harness::Values& v : inputs) {
+        double state[2], cov[4], packed[3], packed_state[2], packed_out[3], unpacked[4];
+        kalman_filter::kalman_filter(v[0].data(), v[1][0], v[2].data(), v[3][0], v[4][0], state, cov);
+        kalman_filter::pack_covariance(v[2].data(), packed);
+        kalman_filter::kalman_filter_packed(v[0].data(), v[1][0], packed, v[3][0], v[4][0],
+                                            packed_state, packed_out);
+        EXPECT_EQ(0, std::memcmp(state, packed_state, sizeof state));
+        EXPECT_EQ(cov[0], packed_out[0]);
+        EXPECT_EQ(cov[1], packed_out[1]);
+        EXPECT_EQ(cov[3], packed_out[2]);
+        kalman_filter::unpack_covariance(packed_out, unpacked);
+        EXPECT_EQ(unpacked[1], unpacked[2]);
+        EXPECT_NEAR(unpacked[2], cov[2], 1e-12 * (cov[0] + cov[3]));  // P21 rounds like P12
     }
+}
 
-    // Validate covariance output
-    for (size_t i = 0; i < tc.expected_covariance.size(); i++) {
-        EXPECT_NEAR(updated_cov[i], tc.expected_covariance[i], tc.abs_tolerance)
-            << "Covariance mismatch at index " << i
-            << " in test case: " << tc.name;
+// Every kernel gives each track kalman_filter_packed()
+TEST(KalmanFilterHarness, PackedBatchMatchesScalarOnEveryKernel) {
+    using kalman_filter::BatchIsa;
+    const BatchIsa selected = kalman_filter::batch_isa();
+    const int n = 37;  // full vectors plus a remainder on every ISA
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> value(-10, 10), noise(1e-4, 10);
+    std::vector<double> x0(n), x1(n), p11(n), p12(n), p22(n), z(n), r(n), q(n);
+    std::vector<double> e0(n), e1(n), e11(n), e12(n), e22(n);
+    for (int i = 0; i < n; i++) {
+        double cov[4], packed[3], state[2] = {value(rng), value(rng)}, next[2];
+        RandomCovariance(rng, cov);
+        kalman_filter::pack_covariance(cov, packed);
+        x0[i] = state[0];
+        x1[i] = state[1];
+        p11[i] = packed[0];
+        p12[i] = packed[1];
+        p22[i] = packed[2];
+        z[i] = value(rng);
+        r[i] = noise(rng);
+        q[i] = noise(rng) / 100;
+        kalman_filter::kalman_filter_packed(state, z[i], packed, r[i], q[i], next, packed);
+        e0[i] = next[0];
+        e1[i] = next[1];
+        e11[i] = packed[0];
+        e12[i] = packed[1];
+        e22[i] = packed[2];
+    }
+    for (int k = 0; k <= static_cast<int>(BatchIsa::Avx512); k++) {
+        BatchIsa isa = static_cast<BatchIsa>(k);
+        if (!kalman_filter::set_batch_isa(isa)) continue;
+        std::vector<double> a0 = x0, a1 = x1, a11 = p11, a12 = p12, a22 = p22;
+        kalman_filter::kalman_filter_batch_packed(n, a0.data(), a1.data(), a11.data(), a12.data(),
+                                                  a22.data(), z.data(), r.data(), q.data());
+        EXPECT_EQ(a0, e0) << kalman_filter::batch_isa_name(isa);
+        EXPECT_EQ(a1, e1) << kalman_filter::batch_isa_name(isa);
+        EXPECT_EQ(a11, e11) << kalman_filter::batch_isa_name(isa);
+        EXPECT_EQ(a12, e12) << kalman_filter::batch_isa_name(isa);
+        EXPECT_EQ(a22, e22) << kalman_filter::batch_isa_name(isa);
     }
+    kalman_filter::set_batch_isa(selected);
 }
 
-INSTANTIATE_TEST_SUITE_P(
-    TestVectors,
-    KalmanFilterTest,
-    ::testing::ValuesIn(LoadTestVectors(TEST_VECTORS_DIR)),
-    TestCaseName
-);
+// Chained steps stay within rounding of the four-value Stream
+TEST(KalmanFilterHarness, PackedStreamFollowsStream) {
+    for (const auto& tc : LoadCases()) {
+        const harness::Values& v = tc.inputs;
+        double packed[3], cov[4];
+        kalman_filter::pack_covariance(v[2].data(), packed);
+        kalman_filter::Stream stream(v[0].data(), v[2].data());
+        kalman_filter::PackedStream packed_stream(v[0].data(), packed);
+        for (int k = 0; k < 200; k++) {
+            double z = v[1][0] + 0.5 * k;
+            stream.step(z, v[3][0], v[4][0]);
+            packed_stream.step(z, v[3][0], v[4][0]);
+        }
+        packed_stream.covariance(cov);
+        const double* state = stream.state();
+        const double* expected = stream.state_covariance();
+        for (int e = 0; e < 2; e++) {
+            EXPECT_NEAR(packed_stream.state()[e], state[e], 1e-9 * std::fabs(state[e])) << tc.name;
+        }
+        for (int e = 0; e < 4; e++) EXPECT_NEAR(cov[e], expected[e], 1e-9 * std::fabs(expected[e])) << tc.name;
+    }
+}
 
-// ---- Write outputs for equivalence comparison ----
+// ---- Square-root form (kalman_filter_ud.h) ----
 
-class OutputCollector : public ::testing::EmptyTestEventListener {
-public:
-    json outputs = json::array();
+TEST(KalmanFilterHarness, UdMatchesExpectedOutput) {
+    for (const auto& tc : LoadCases()) {
+        const harness::Values& v = tc.inputs;
+        harness::Values out = {harness::Values::value_type(2), harness::Values::value_type(4)};
+        kalman_filter::kalman_filter_ud(v[0].data(), v[1][0], v[2].data(), v[3][0], v[4][0],
+                                        out[0].data(), out[1].data());
+        harness::ExpectOutputsNear<Signature>(tc, out);
+    }
+}
 
-    void OnTestEnd(const ::testing::TestInfo& test_info) override {
-        // Record actual outputs for each test case
-        // This is a simplified version — the full implementation would
-        // re-run the algorithm and capture outputs
+// Restores the selected kernel when it goes out of scope, including on a
+// failed ASSERT's early return
+struct BatchIsaRestorer {
+    kalman_filter::BatchIsa selected = kalman_filter::batch_isa();
+    ~BatchIsaRestorer() { kalman_filter::set_batch_isa(selected); }
+};
+
+// Every kernel, in both precisions, gives each track kalman_filter_ud_step()
+template <typename T>
+static void ExpectUdBatchMatchesStep(kalman_filter::BatchIsa isa) {
+    const int n = 37;  // full vectors plus a remainder on every ISA
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<T> value(-10, 10), variance(T(1e-3), T(1e3));
+    std::vector<T> x0(n), x1(n), d1(n), u(n), d2(n), z(n), r(n), q(n);
+    for (int i = 0; i < n; i++) {
+        x0[i] = value(rng);
+        x1[i] = value(rng);
+        z[i] = value(rng);
+        u[i] = value(rng) / 10;
+        d1[i] = variance(rng);
+        d2[i] = variance(rng);
+        r[i] = variance(rng);
+        q[i] = variance(rng) / 1000;
     }
+    q[0] = 0;
+    d2[1] = 0;  // a zero variance takes the guarded divisions
+
+    std::vector<T> e0 = x0, e1 = x1, ed1 = d1, eu = u, ed2 = d2;
+    for (int i = 0; i < n; i++) {
+        kalman_filter::kalman_filter_ud_step(e0[i], e1[i], ed1[i], eu[i], ed2[i], z[i], r[i], q[i]);
+    }
+    BatchIsaRestorer restore;
+    ASSERT_TRUE(kalman_filter::set_batch_isa(isa));
+    kalman_filter::kalman_filter_ud_batch(n, x0.data(), x1.data(), d1.data(), u.data(), d2.data(),
+                                          z.data(), r.data(), q.data());
+    for (int i = 0; i < n; i++) {
+        EXPECT_EQ(x0[i], e0[i]) << kalman_filter::batch_isa_name(isa) << " track " << i;
+        EXPECT_EQ(x1[i], e1[i]) << kalman_filter::batch_isa_name(isa) << " track " << i;
+        EXPECT_EQ(d1[i], ed1[i]) << kalman_filter::batch_isa_name(isa) << " track " << i;
+        EXPECT_EQ(u[i], eu[i]) << kalman_filter::batch_isa_name(isa) << " track " << i;
+        EXPECT_EQ(d2[i], ed2[i]) << kalman_filter::batch_isa_name(isa) << " track " << i;
+    }
+}
+
+TEST(KalmanFilterHarness, UdBatchMatchesStepOnEveryKernel) {
+    using kalman_filter::BatchIsa;
+    for (int i = 0; i <= static_cast<int>(BatchIsa::Avx512); i++) {
+        BatchIsa isa = static_cast<BatchIsa>(i);
+        if (!kalman_filter::batch_isa_supported(isa)) continue;
+        ExpectUdBatchMatchesStep<double>(isa);
+        ExpectUdBatchMatchesStep<float>(isa);
+    }
+}
+
+// P0 = 1000 against R = 1e-6: the float Joseph form goes indefinite on the
+// first update. Factored float tracks stay definite and follow the
+// generated double filter.
+TEST(KalmanFilterHarness, UdFloatStaysPositiveDefiniteOverLongRun) {
+    const int n = 16, steps = 20000;
+    const double R = 1e-6, Q = 1e-6, P0[4] = {1000.0, 0.0, 0.0, 1000.0};
+    std::vector<float> x0(n, 0.0f), x1(n, 0.0f), d1(n), u(n), d2(n), z(n);
+    std::vector<float> r(n, float(R)), q(n, float(Q));
+    std::vector<std::array<double, 2>> state(n, {0.0, 0.0});
+    std::vector<std::array<double, 4>> cov(n, {P0[0], P0[1], P0[2], P0[3]});
+    const float P0f[4] = {float(P0[0]), float(P0[1]), float(P0[2]), float(P0[3])};
+    for (int i = 0; i < n; i++) kalman_filter::ud_factor(P0f, d1[i], u[i], d2[i]);
+
+    std::mt19937 rng(1);
+    std::normal_distribution<double> noise(0.0, std::sqrt(R));
+    for (int k = 0; k < steps; k++) {
+        for (int i = 0; i < n; i++) {
+            double zi = noise(rng);
+            z[i] = float(zi);
+            std::array<double, 2> s;
+            std::array<double, 4> p;
+            kalman_filter::kalman_filter(state[i].data(), zi, cov[i].data(), R, Q, s.data(), p.data());
+            state[i] = s;
+            cov[i] = p;
+        }
+        kalman_filter::kalman_filter_ud_batch(n, x0.data(), x1.data(), d1.data(), u.data(), d2.data(),
+                                              z.data(), r.data(), q.data());
+        for (int i = 0; i < n; i++) {
+            ASSERT_GT(d1[i], 0.0f) << "step " << k << " track " << i;
+            ASSERT_GT(d2[i], 0.0f) << "step " << k << " track " << i;
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        float p[4];
+        kalman_filter::ud_to_covariance(d1[i], u[i], d2[i], p);
+        for (int e = 0; e < 4; e++) EXPECT_NEAR(p[e], cov[i][e], 1e-5 * std::fabs(cov[i][e])) << i;
+        EXPECT_NEAR(x0[i], state[i][0], 1e-5 * std::sqrt(cov[i][0])) << i;
+        EXPECT_NEAR(x1[i], state[i][1], 1e-5 * std::sqrt(cov[i][3])) << i;
+    }
+}
+
+// ---- Strided views (kalman_filter_strided.h) ----
+
+struct Sample {
+    double t;
+    double z;
+    double position;
+    double velocity;
 };
 
-// Write cpp_outputs.json after all tests complete
-class CppOutputWriter : public ::testing::Environment {
-public:
-    void TearDown() override {
-        // Re-run all test cases and write actual outputs for equivalence check
-        auto cases = LoadTestVectors(TEST_VECTORS_DIR);
-        json outputs = json::array();
-
-        for (const auto& tc : cases) {
-            double state[2] = {tc.state[0], tc.state[1]};
-            double cov[4] = {tc.state_covariance[0], tc.state_covariance[1],
-                             tc.state_covariance[2], tc.state_covariance[3]};
-            double updated_state[2] = {0.0, 0.0};
-            double updated_cov[4] = {0.0, 0.0, 0.0, 0.0};
-
-            kalman_filter::kalman_filter(state, tc.measurement, cov,
-                                        tc.measurement_noise, tc.process_noise,
-                                        updated_state, updated_cov);
-
-            json result;
-            result["test_name"] = tc.name;
-            result["actual_updated_state"] = {updated_state[0], updated_state[1]};
-            result["actual_updated_covariance"] = {updated_cov[0], updated_cov[1],
-                                                    updated_cov[2], updated_cov[3]};
-            result["tolerance"] = tc.abs_tolerance;
-            outputs.push_back(result);
+TEST(KalmanFilterHarness, SequenceMatchesStream) {
+    for (const auto& tc : LoadCases()) {
+        const harness::Values& v = tc.inputs;
+        std::vector<Sample> frame(64);
+        for (size_t k = 0; k < frame.size(); k++) frame[k] = {0.1 * k, v[1][0] + 0.5 * k, 0.0, 0.0};
+
+        kalman_filter::Stream stream(v[0].data(), v[2].data());
+        double state[2] = {v[0][0], v[0][1]};
+        double cov[4] = {v[2][0], v[2][1], v[2][2], v[2][3]};
+        // Row-major [n, 4] covariances: element i of step k at covs[4 * k + i]
+        std::vector<double> covs(4 * frame.size());
+        std::array<runtime::StridedSpan<double>, 4> cov_views;
+        for (int i = 0; i < 4; i++) cov_views[i] = {covs.data() + i, frame.size(), 4 * sizeof(double)};
+        kalman_filter::kalman_filter_sequence(state, cov, runtime::field(frame, &Sample::z), v[3][0], v[4][0],
+                                              runtime::field(frame, &Sample::position),
+                                              runtime::field(frame, &Sample::velocity), cov_views);
+        for (size_t k = 0; k < frame.size(); k++) {
+            stream.step(frame[k].z, v[3][0], v[4][0]);
+            EXPECT_EQ(frame[k].position, stream.state()[0]) << tc.name << " step " << k;
+            EXPECT_EQ(frame[k].velocity, stream.state()[1]) << tc.name << " step " << k;
+            EXPECT_EQ(0, std::memcmp(&covs[4 * k], stream.state_covariance(), 4 * sizeof(double)))
+                << tc.name << " step " << k;
         }
+        EXPECT_EQ(0, std::memcmp(state, stream.state(), sizeof state)) << tc.name;
+        EXPECT_EQ(0, std::memcmp(cov, stream.state_covariance(), sizeof cov)) << tc.name;
+    }
+    double state[2] = {0, 0}, cov[4] = {1, 0, 0, 1};
+    std::vector<double> z(4), position(3);
+    EXPECT_THROW(kalman_filter::kalman_filter_sequence(state, cov, z, 0.1, 0.01, position),
+                 std::invalid_argument);
+}
 
-        // Write to output directory
-        fs::path output_dir(OUTPUT_DIR);
-        fs::create_directories(output_dir);
-        std::ofstream f(output_dir / "cpp_outputs.json");
-        f << outputs.dump(2);
+// ---- Multiple-hypothesis tracking (kalman_filter_mht.h) ----
+
+TEST(KalmanFilterHarness, LikelihoodBatchIsGatedAndSameOnEveryKernel) {
+    const int n = 37;
+    const double x = 2.0, S = 0.5, gate = 9.0;
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> spread(-6.0, 10.0);
+    std::vector<double> z(n), expected(n);
+    for (int i = 0; i < n; i++) {
+        z[i] = spread(rng);
+        double y = z[i] - x;
+        double d2 = (y * y) / S;
+        expected[i] = d2 <= gate ? -0.5 * std::log(2.0 * M_PI * S) - 0.5 * d2
+                                 : -std::numeric_limits<double>::infinity();
     }
-};
 
-// Register the output writer
+    using kalman_filter::BatchIsa;
+    const BatchIsa selected = kalman_filter::batch_isa();
+    for (int k = 0; k <= static_cast<int>(BatchIsa::Avx512); k++) {
+        BatchIsa isa = static_cast<BatchIsa>(k);
+        if (!kalman_filter::set_batch_isa(isa)) continue;
+        std::vector<double> ll(n);
+        kalman_filter::kalman_filter_likelihood_batch(n, z.data(), x, S, gate, ll.data());
+        for (int i = 0; i < n; i++) {
+            EXPECT_EQ(ll[i], expected[i]) << kalman_filter::batch_isa_name(isa) << " measurement " << i;
+        }
+    }
+    kalman_filter::set_batch_isa(selected);
+}
+
+TEST(KalmanFilterHarness, MhtKeepsAmbiguousBranchesUntilResolved) {
+    kalman_filter::MhtOptions options;
+    options.measurement_noise = 0.25;
+    const double x0[2] = {0.0, 1.0}, P0[4] = {1.0, 0.0, 0.0, 0.1};
+
+    // Two measurements either side of the prediction: both branches and
+    // the miss survive the k best assignments, but not with k = 1
+    const double z[2] = {0.8, 1.3};
+    kalman_filter::MhtTracker mht(options);
+    mht.add_track(x0, P0);
+    mht.scan(z, 2);
+    EXPECT_EQ(mht.hypotheses(0), 3);
+    EXPECT_EQ(mht.best(0).measurement, 0);
+
+    options.global_hypotheses = 1;
+    kalman_filter::MhtTracker greedy(options);
+    greedy.add_track(x0, P0);
+    greedy.scan(z, 2);
+    EXPECT_EQ(greedy.hypotheses(0), 1);
+    EXPECT_EQ(greedy.best(0).measurement, 0);
+
+    // The branch that later measurements confirm wins, and N-scan pruning
+    // commits to it
+    for (int k = 2; k <= 6; k++) {
+        double next = 1.3 + (k - 1);
+        mht.scan(&next, 1);
+    }
+    kalman_filter::MhtEstimate e = mht.best(0);
+    EXPECT_EQ(e.measurement, 0);
+    EXPECT_NEAR(e.state[0], 6.3, 0.2);
+    EXPECT_THROW(mht.best(1), std::out_of_range);
+    options.detection_probability = 1.0;
+    EXPECT_THROW(kalman_filter::MhtTracker{options}, std::invalid_argument);
+}
+
+// Two targets crossing in clutter with missed detections: the best
+// hypotheses stay on the targets, the trees stay bounded and the pool
+// stops growing once it holds the trees' working set
+TEST(KalmanFilterHarness, MhtFollowsCrossingTargetsInClutter) {
+    kalman_filter::MhtOptions options;
+    options.measurement_noise = 0.25;
+    options.process_noise = 0.01;
+    options.detection_probability = 0.9;
+    options.clutter_density = 4.0 / 180.0;
+    options.pool_nodes = 16;
+    kalman_filter::MhtTracker mht(options);
+    const double P0[4] = {4.0, 0.0, 0.0, 1.0};
+    const double truth0[2] = {0.0, 1.0}, truth1[2] = {60.0, -1.0};
+    mht.add_track(truth0, P0);
+    mht.add_track(truth1, P0);
+
+    std::mt19937 rng(11);
+    std::normal_distribution<double> noise(0.0, 0.5);
+    std::uniform_real_distribution<double> clutter(-40.0, 140.0), draw(0.0, 1.0);
+    const int scans = 80;
+    const int cap = options.hypotheses_per_track;
+    for (int k = 1; k <= scans; k++) {
+        std::vector<double> z;
+        for (const double* truth : {truth0, truth1}) {
+            if (draw(rng) < options.detection_probability) z.push_back(truth[0] + truth[1] * k + noise(rng));
+        }
+        for (int c = 0; c < 4; c++) z.push_back(clutter(rng));
+        std::shuffle(z.begin(), z.end(), rng);
+        mht.scan(z.data(), static_cast<int>(z.size()));
+
+        for (int t = 0; t < 2; t++) {
+            const double* truth = t == 0 ? truth0 : truth1;
+            kalman_filter::MhtEstimate e = mht.best(t);
+            ASSERT_NEAR(e.state[0], truth[0] + truth[1] * k, 4.0) << "scan " << k << " track " << t;
+            ASSERT_LE(mht.hypotheses(t), cap);
+        }
+        // Each tree: the root plus at most `cap` nodes per level below it
+        ASSERT_LE(mht.nodes(), 2u * (1 + cap * options.scan_depth)) << "scan " << k;
+    }
+    for (int t = 0; t < 2; t++) {
+        const double* truth = t == 0 ? truth0 : truth1;
+        EXPECT_NEAR(mht.best(t).state[1], truth[1], 0.2) << t;
+    }
+    // Thousands of nodes created over the run, all from a few slabs
+    EXPECT_LE(mht.node_capacity(), 16u + 32 + 64 + 128);
+}
+
+// ---- Monte Carlo consistency (kalman_filter_consistency.h) ----
+
+TEST(KalmanFilterHarness, ConsistencyOfMatchedModel) {
+    kalman_filter::ConsistencyOptions opts;
+    opts.runs = 2000;
+    opts.steps = 100;
+    kalman_filter::ConsistencyReport r = kalman_filter::RunConsistency(opts);
+    EXPECT_NEAR(r.mean_nees, 2.0, 0.05);
+    EXPECT_NEAR(r.mean_nis, 1.0, 0.05);
+    EXPECT_TRUE(r.consistent) << "NEES in bounds " << r.nees_in_bounds << ", NIS " << r.nis_in_bounds;
+}
+
+// A filter that underestimates the process noise is overconfident
+TEST(KalmanFilterHarness, ConsistencyDetectsMismatchedNoise) {
+    kalman_filter::ConsistencyOptions opts;
+    opts.runs = 500;
+    opts.steps = 100;
+    opts.truth_process_noise = 10.0 * opts.process_noise;
+    kalman_filter::ConsistencyReport r = kalman_filter::RunConsistency(opts);
+    EXPECT_GT(r.mean_nees, r.nees_upper);
+    EXPECT_FALSE(r.consistent);
+}
+
+TEST(KalmanFilterHarness, ConsistencyDoesNotDependOnThreads) {
+    kalman_filter::ConsistencyOptions opts;
+    opts.runs = 300;  // a partial last block
+    opts.steps = 50;
+    opts.block = 64;
+    opts.threads = 1;
+    kalman_filter::ConsistencyReport serial = kalman_filter::RunConsistency(opts);
+    opts.threads = 3;
+    kalman_filter::ConsistencyReport parallel = kalman_filter::RunConsistency(opts);
+    EXPECT_EQ(serial.nees, parallel.nees);
+    EXPECT_EQ(serial.nis, parallel.nis);
+}
+
+// The consistency tool serves cached reports through this round trip
+TEST(KalmanFilterHarness, ConsistencyReportJsonRoundTrip) {
+    kalman_filter::ConsistencyOptions opts;
+    opts.runs = 64;
+    opts.steps = 20;
+    kalman_filter::ConsistencyReport r = kalman_filter::RunConsistency(opts);
+    nlohmann::json j = nlohmann::json::parse(kalman_filter::ConsistencyReportToJson(r, opts).dump());
+    kalman_filter::ConsistencyReport back = kalman_filter::ConsistencyReportFromJson(j);
+    EXPECT_EQ(back.runs, r.runs);
+    EXPECT_EQ(back.steps, r.steps);
+    EXPECT_EQ(back.nees, r.nees);
+    EXPECT_EQ(back.nis, r.nis);
+    EXPECT_EQ(back.mean_nees, r.mean_nees);
+    EXPECT_EQ(back.nis_upper, r.nis_upper);
+    EXPECT_EQ(back.nees_in_bounds, r.nees_in_bounds);
+    EXPECT_EQ(back.consistent, r.consistent);
+}
+
+// ---- Shadow execution (kalman_filter_shadow.h) ----
+
+// The flattened call is the vector fields in order, and shadow_call() is
+// the function itself
+TEST(KalmanFilterHarness, ShadowCallMatchesFunction) {
+    for (const auto& tc : LoadCases()) {
+        double in[kalman_filter::kShadowInputs], live[kalman_filter::kShadowOutputs];
+        harness::Values out = harness::Run<Signature>(tc.inputs);
+        kalman_filter::shadow_pack(tc.inputs[0].data(), tc.inputs[1][0], tc.inputs[2].data(), tc.inputs[3][0],
+                                   tc.inputs[4][0], out[0].data(), out[1].data(), in, live);
+        std::vector<double> flat;
+        for (const auto& field : tc.inputs) flat.insert(flat.end(), field.begin(), field.end());
+        EXPECT_EQ(flat, std::vector<double>(in, in + kalman_filter::kShadowInputs)) << tc.name;
+
+        double shadow[kalman_filter::kShadowOutputs];
+        kalman_filter::shadow_call(in, shadow);
+        EXPECT_EQ(0, std::memcmp(shadow, live, sizeof shadow)) << tc.name;
+    }
+}
+
+TEST(KalmanFilterHarness, ShadowOfSameBuildAgreesAndPerturbedDiverges) {
+    runtime::ShadowOptions opts;
+    opts.sample_fraction = 1.0;
+    opts.budget_ns = 0;
+    opts.tolerance = kalman_filter::shadow_tolerance(std::string(TEST_VECTORS_DIR) + "/nominal.json");
+    EXPECT_EQ(opts.tolerance.absolute, 1e-10);
+    EXPECT_EQ(opts.tolerance.relative, 1e-8);
+
+    kalman_filter::ShadowRunner same(kalman_filter::shadow_call, opts);
+    kalman_filter::ShadowRunner perturbed(
+        [](const double* in, double* out) {
+            kalman_filter::shadow_call(in, out);
+            out[kalman_filter::kShadowOutputs - 1] += 1e-3;
+        },
+        opts);
+    auto cases = LoadCases();
+    for (const auto& tc : cases) {
+        harness::Values out = harness::Run<Signature>(tc.inputs);
+        auto fill = [&](double* in, double* live) {
+            kalman_filter::shadow_pack(tc.inputs[0].data(), tc.inputs[1][0], tc.inputs[2].data(), tc.inputs[3][0],
+                                       tc.inputs[4][0], out[0].data(), out[1].data(), in, live);
+        };
+        same.Offer(fill);
+        perturbed.Offer(fill);
+    }
+    same.Stop();
+    perturbed.Stop();
+    EXPECT_TRUE(same.report().agrees());
+    EXPECT_EQ(same.report().compared, cases.size());
+    EXPECT_EQ(perturbed.report().diverged, cases.size());
+    EXPECT_EQ(perturbed.report().worst_output, static_cast<int>(kalman_filter::kShadowOutputs) - 1);
+}
+
+// ---- Plugin (kalman_filter_plugin.h) ----
+
+#ifdef PLUGIN_PATH
+
+// Every vector through a table's call, bit-compared with the generated function
+static bool TableMatchesVectors(const kalman_filter_plugin& t) {
+    for (const auto& tc : LoadCases()) {
+        harness::Values out = harness::Run<Signature>(tc.inputs);
+        double state[2], cov[4];
+        t.call(tc.inputs[0].data(), tc.inputs[1][0], tc.inputs[2].data(), tc.inputs[3][0], tc.inputs[4][0],
+               state, cov);
+        if (std::memcmp(state, out[0].data(), sizeof state) != 0 || std::memcmp(cov, out[1].data(), sizeof cov) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST(KalmanFilterHarness, PluginLoadsWarmsUpAndRollsBack) {
+    runtime::PluginHost<kalman_filter::Plugin> host;
+    EXPECT_EQ(&host.table(), kalman_filter::Plugin::Builtin());
+    EXPECT_TRUE(TableMatchesVectors(host.table()));
+
+    int warmed = 0;
+    ASSERT_TRUE(host.Load(PLUGIN_PATH, [&](const kalman_filter_plugin& t) {
+        warmed++;
+        return TableMatchesVectors(t);
+    })) << host.error();
+    EXPECT_EQ(warmed, 1);
+    // The plugin's own copy of the algorithm, not the one linked here
+    EXPECT_NE(&host.table(), kalman_filter::Plugin::Builtin());
+    EXPECT_NE(host.table().call, kalman_filter::Plugin::Builtin()->call);
+    EXPECT_EQ(host.version(), kalman_filter::Plugin::Builtin()->info.version);
+    EXPECT_TRUE(TableMatchesVectors(host.table()));
+
+    // soa() through the plugin matches the linked wrapper
+    const int n = 3;
+    double state[2 * n] = {0, 1, 2, 0.5, 0, -1}, z[n] = {0.3, 1.2, -4}, P[4 * n], R[n] = {1, 2, 3}, Q[n] = {0.1, 0.1, 0.2};
+    for (int k = 0; k < 4 * n; k++) P[k] = (k / n == 0 || k / n == 3) ? 1.0 + k % n : 0.1;
+    double s1[2 * n], c1[4 * n], s2[2 * n], c2[4 * n];
+    host.table().soa(n, state, z, P, R, Q, s1, c1);
+    kalman_filter::kalman_filter_soa(n, state, z, P, R, Q, s2, c2);
+    EXPECT_EQ(0, std::memcmp(s1, s2, sizeof s1));
+    EXPECT_EQ(0, std::memcmp(c1, c2, sizeof c1));
+
+    ASSERT_TRUE(host.Rollback());
+    EXPECT_EQ(&host.table(), kalman_filter::Plugin::Builtin());
+}
+
+TEST(KalmanFilterHarness, PluginRejectsFailedWarmUpAndOtherLibraries) {
+    runtime::PluginHost<kalman_filter::Plugin> host;
+    EXPECT_FALSE(host.Load(PLUGIN_PATH, [](const kalman_filter_plugin&) { return false; }));
+    EXPECT_NE(host.error().find("warm-up"), std::string::npos) << host.error();
+    EXPECT_FALSE(host.Load("libm.so.6"));  // loads, but has no entry symbol
+    EXPECT_NE(host.error().find(kalman_filter::Plugin::kSymbol), std::string::npos) << host.error();
+    EXPECT_FALSE(host.Load(std::string(PLUGIN_PATH) + ".missing"));
+    EXPECT_EQ(&host.table(), kalman_filter::Plugin::Builtin());
+    EXPECT_EQ(host.swaps(), 0u);
+}
+
+#endif // PLUGIN_PATH
+
+// ---- Write outputs for equivalence comparison ----
+
 testing::Environment* const output_env =
-    testing::AddGlobalTestEnvironment(new CppOutputWriter);
+    harness::RegisterOutputWriter<Signature>(LoadCases, OUTPUT_DIR);
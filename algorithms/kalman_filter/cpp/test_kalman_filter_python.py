@@ -0,0 +1,159 @@
+#!/usr/bin/env python3
+"""
+test_kalman_filter_python.py
+
+Tests for the kalman_filter extension module (kalman_filter_python.cpp).
+Registered with ctest by cmake/PythonModule.cmake, which puts the built
+module on PYTHONPATH. Uses array.array and memoryview so it runs without
+NumPy; the NumPy cases are skipped when it is not installed.
+"""
+
+import array
+import threading
+import unittest
+
+import kalman_filter as kf
+
+try:
+    import numpy
+except ImportError:
+    numpy = None
+
+
+def reference_step(x, z, p, r, q):
+    """Same arithmetic as the generated kalman_filter()."""
+    xp = [x[0] + x[1], x[1]]
+    pp = [p[0] + p[2] + p[1] + p[3] + q, p[1] + p[3], p[2] + p[3], p[3] + q]
+    s = pp[0] + r
+    k = [pp[0] / s, pp[2] / s]
+    y = z - xp[0]
+    x_new = [xp[0] + k[0] * y, xp[1] + k[1] * y]
+    p_new = [(1 - k[0]) * pp[0], (1 - k[0]) * pp[1], pp[2] - k[1] * pp[0], pp[3] - k[1] * pp[1]]
+    return x_new, p_new
+
+
+def doubles(values):
+    return array.array("d", values)
+
+
+class ScalarTest(unittest.TestCase):
+    def test_matches_reference(self):
+        x, p = [1.0, 0.5], [2.0, 0.1, 0.1, 1.0]
+        state, cov = kf.kalman_filter(x, 1.7, p, 0.5, 0.01)
+        ref_x, ref_p = reference_step(x, 1.7, p, 0.5, 0.01)
+        for got, want in zip(list(state) + list(cov), ref_x + ref_p):
+            self.assertAlmostEqual(got, want, places=12)
+
+    def test_accepts_buffers_and_keywords(self):
+        state, cov = kf.kalman_filter(state=doubles([0, 0]), measurement=1.0,
+                                      state_covariance=doubles([10, 0, 0, 10]),
+                                      measurement_noise=1.0, process_noise=0.1)
+        self.assertEqual(len(state), 2)
+        self.assertEqual(len(cov), 4)
+
+    def test_rejects_bad_input(self):
+        with self.assertRaises(ValueError):
+            kf.kalman_filter([0.0], 1.0, [1, 0, 0, 1], 1.0, 0.1)
+        with self.assertRaises(TypeError):
+            kf.kalman_filter(array.array("f", [0, 0]), 1.0, [1, 0, 0, 1], 1.0, 0.1)
+
+
+class BatchTest(unittest.TestCase):
+    def make_tracks(self, n):
+        return [doubles([0.1 * i for i in range(n)]), doubles([0.01 * i for i in range(n)]),
+                doubles([10.0] * n), doubles([0.0] * n), doubles([0.0] * n), doubles([10.0] * n)]
+
+    def test_updates_in_place_like_scalar(self):
+        n = 37
+        tracks = self.make_tracks(n)
+        z = doubles([0.3 * i - 2 for i in range(n)])
+        r, q = doubles([1.0] * n), doubles([0.05] * n)
+        expected = [kf.kalman_filter([tracks[0][i], tracks[1][i]], z[i],
+                                     [tracks[2][i], tracks[3][i], tracks[4][i], tracks[5][i]], r[i], q[i])
+                    for i in range(n)]
+        self.assertIsNone(kf.kalman_filter_batch(*tracks, z, r, q))
+        for i, (state, cov) in enumerate(expected):
+            self.assertEqual([tracks[0][i], tracks[1][i]], list(state))
+            self.assertEqual([tracks[k][i] for k in range(2, 6)], list(cov))
+
+    def test_state_must_be_writable(self):
+        tracks = self.make_tracks(4)
+        tracks[0] = memoryview(doubles([0.0] * 4)).toreadonly()
+        with self.assertRaises(TypeError):
+            kf.kalman_filter_batch(*tracks, [0.0] * 4, [1.0] * 4, [0.1] * 4)
+        tracks[0] = [0.0] * 4  # a list cannot be updated in place either
+        with self.assertRaises(TypeError):
+            kf.kalman_filter_batch(*tracks, [0.0] * 4, [1.0] * 4, [0.1] * 4)
+
+    def test_lengths_must_match(self):
+        tracks = self.make_tracks(4)
+        with self.assertRaises(ValueError):
+            kf.kalman_filter_batch(*tracks, [0.0] * 3, [1.0] * 4, [0.1] * 4)
+
+
+class SequenceTest(unittest.TestCase):
+    def test_matches_stepping(self):
+        z = [0.5 * k + (-1) ** k for k in range(100)]
+        states, covs = kf.kalman_filter_sequence([0, 0], [10, 0, 0, 10], z, 1.0, 0.01)
+        states, covs = memoryview(states).cast("B").cast("d"), memoryview(covs).cast("B").cast("d")
+        x, p = [0.0, 0.0], [10.0, 0.0, 0.0, 10.0]
+        for k in range(100):
+            x, p = kf.kalman_filter(x, z[k], p, 1.0, 0.01)
+            self.assertEqual(list(x), list(states[2 * k:2 * k + 2]))
+            self.assertEqual(list(p), list(covs[4 * k:4 * k + 4]))
+
+    def test_fills_given_outputs(self):
+        n = 10
+        out_states, out_covs = doubles([0.0] * 2 * n), doubles([0.0] * 4 * n)
+        states, covs = kf.kalman_filter_sequence([0, 0], [1, 0, 0, 1], [1.0] * n, 1.0, 0.01,
+                                                 states=out_states, covariances=out_covs)
+        self.assertIs(states, out_states)
+        self.assertIs(covs, out_covs)
+        self.assertNotEqual(out_states[0], 0.0)
+        with self.assertRaises(ValueError):
+            kf.kalman_filter_sequence([0, 0], [1, 0, 0, 1], [1.0] * n, 1.0, 0.01, states=doubles([0.0] * n))
+
+    def test_threads_run_concurrently_and_agree(self):
+        z = doubles([float(k % 17) for k in range(20000)])
+        expected = kf.kalman_filter_sequence([0, 0], [10, 0, 0, 10], z, 1.0, 0.01)
+        results = [None] * 4
+
+        def run(i):
+            results[i] = kf.kalman_filter_sequence([0, 0], [10, 0, 0, 10], z, 1.0, 0.01)
+
+        threads = [threading.Thread(target=run, args=(i,)) for i in range(4)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        for states, covs in results:
+            self.assertEqual(bytes(states), bytes(expected[0]))
+            self.assertEqual(bytes(covs), bytes(expected[1]))
+
+
+@unittest.skipIf(numpy is None, "NumPy not installed")
+class NumpyTest(unittest.TestCase):
+    def test_arrays_are_used_in_place(self):
+        n = 8
+        position, velocity = numpy.zeros(n), numpy.ones(n)
+        cov = [numpy.full(n, 10.0), numpy.zeros(n), numpy.zeros(n), numpy.full(n, 10.0)]
+        kf.kalman_filter_batch(position, velocity, *cov, numpy.arange(n, dtype=float),
+                               numpy.ones(n), numpy.full(n, 0.1))
+        self.assertTrue(numpy.all(position[1:] != 0))
+
+    def test_sequence_returns_ndarrays(self):
+        states, covs = kf.kalman_filter_sequence(numpy.zeros(2), numpy.eye(2).ravel(),
+                                                 numpy.linspace(0, 1, 50), 1.0, 0.01)
+        self.assertIsInstance(states, numpy.ndarray)
+        self.assertEqual(states.shape, (50, 2))
+        self.assertEqual(covs.shape, (50, 4))
+
+    def test_rejects_strided_and_float32(self):
+        with self.assertRaises(TypeError):
+            kf.kalman_filter_sequence([0, 0], [1, 0, 0, 1], numpy.zeros(20)[::2], 1.0, 0.01)
+        with self.assertRaises(TypeError):
+            kf.kalman_filter_sequence([0, 0], [1, 0, 0, 1], numpy.zeros(10, dtype=numpy.float32), 1.0, 0.01)
+
+
+if __name__ == "__main__":
+    unittest.main(verbosity=2)
@@ -1,4 +1,5 @@
 from conan import ConanFile
+from conan.errors import ConanInvalidConfiguration
 from conan.tools.cmake import CMake, CMakeToolchain, CMakeDeps, cmake_layout
 import os
 
@@ -8,6 +9,13 @@ class LowPassFilterConan(ConanFile):
     license = "Proprietary"
     description = "Low-pass filter algorithm (auto-generated from MATLAB via MATLAB Coder)"
     settings = "os", "compiler", "build_type", "arch"
+    # header_only=True ships <name>_inline.h (definitions marked inline)
+    # instead of the static library, so callers can inline the kernel.
+    # pgo=True builds the library profile-guided: instrumented build, a
+    # bench_<name> training run over the test vectors (plus PGO_REPLAY_LOG
+    # if set), then a rebuild with the profile and LTO
+    options = {"header_only": [True, False], "pgo": [True, False]}
+    default_options = {"header_only": False, "pgo": False}
     exports_sources = "CMakeLists.txt", "*.cpp", "*.h"
 
     def set_version(self):
@@ -21,6 +29,10 @@ class LowPassFilterConan(ConanFile):
         else:
             self.version = "0.0.0"
 
+    def validate(self):
+        if self.options.header_only and self.options.pgo:
+            raise ConanInvalidConfiguration("header_only and pgo are exclusive")
+
     def requirements(self):
         self.test_requires("gtest/1.14.0")
         self.requires("nlohmann_json/3.11.3")
@@ -33,26 +45,72 @@ class LowPassFilterConan(ConanFile):
             os.path.join(os.path.dirname(__file__), "..", "generated"),
         )
         tc.variables["GENERATED_DIR"] = generated_dir
+        # The wrappers are written from algorithm.yaml by a shared CMake module
+        tc.variables["ALGORITHM_YAML"] = os.environ.get(
+            "ALGORITHM_YAML",
+            os.path.join(os.path.dirname(__file__), "..", "algorithm.yaml"),
+        )
+        tc.variables["CMAKE_MODULES_DIR"] = os.environ.get(
+            "CMAKE_MODULES_DIR",
+            os.path.join(os.path.dirname(__file__), "..", "..", "..", "cmake"),
+        )
+        # calibrate_batch() is built on runtime/batch_calibration.h
+        tc.variables["RUNTIME_DIR"] = os.environ.get(
+            "RUNTIME_DIR",
+            os.path.join(os.path.dirname(__file__), "..", "..", "..", "runtime"),
+        )
         tc.variables["BUILD_TESTING"] = False  # Tests run separately in CI
+        tc.variables["BUILD_PYTHON_BINDINGS"] = False  # C++ package only
+        tc.variables["HEADER_ONLY"] = bool(self.options.header_only)
+        if self.options.pgo:
+            # The training run needs the harness and test vectors, which
+            # live outside the exported sources
+            repo_root = os.path.join(os.path.dirname(__file__), "..", "..", "..")
+            tc.variables["HARNESS_DIR"] = os.environ.get(
+                "HARNESS_DIR", os.path.join(repo_root, "harness")
+            )
+            tc.variables["TEST_VECTORS_DIR"] = os.environ.get(
+                "TEST_VECTORS_DIR",
+                os.path.join(os.path.dirname(__file__), "..", "test_vectors"),
+            )
         tc.generate()
 
         deps = CMakeDeps(self)
         deps.generate()
 
+    def package_id(self):
+        # The header-only package is the same for every compiler and arch
+        if self.info.options.header_only:
+            self.info.clear()
+
     def layout(self):
         cmake_layout(self)
 
     def build(self):
         cmake = CMake(self)
+        if self.options.pgo:
+            profile_dir = os.path.join(self.build_folder, "pgo_profile")
+            cmake.configure(variables={"PGO_MODE": "generate", "PGO_PROFILE_DIR": profile_dir})
+            cmake.build()
+            bench = os.path.join(self.build_folder, f"bench_{self.name}")
+            replay = os.environ.get("PGO_REPLAY_LOG", "")
+            replay_args = f' --replay "{replay}"' if replay and os.path.exists(replay) else ""
+            self.run(f'"{bench}" --min-time 0.05 --repeats 1{replay_args}')
+            cmake.configure(variables={"PGO_MODE": "use", "PGO_PROFILE_DIR": profile_dir})
+            cmake.build()
+            return
         cmake.configure()
-        cmake.build()
+        if not self.options.header_only:
+            cmake.build()
 
     def package(self):
         cmake = CMake(self)
         cmake.install()
 
     def package_info(self):
-        self.cpp_info.libs = [self.name]
+        self.cpp_info.libs = [] if self.options.header_only else [self.name]
+        if not self.options.header_only and self.settings.os in ("Linux", "FreeBSD"):
+            self.cpp_info.system_libs = ["pthread"]  # <name>_soa_parallel()
         self.cpp_info.includedirs = [
             os.path.join("include", self.name)
         ]
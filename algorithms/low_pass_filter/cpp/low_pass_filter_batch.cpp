@@ -0,0 +1,128 @@
+#include "low_pass_filter_batch.h"
+
+#include <atomic>
+
+#include "low_pass_filter_batch_kernels.h"
+
+namespace low_pass_filter {
+
+namespace kernels {
+
+// Same expression as generated/low_pass_filter.cpp, one sample row at a time
+void batch_portable(
+    const double input_signal[],
+    const double alpha[],
+    int n,
+    int channels,
+    double output_signal[])
+{
+    if (n <= 0) return;
+
+    for (int c = 0; c < channels; c++) {
+        output_signal[c] = input_signal[c];
+    }
+
+    for (int k = 1; k < n; k++) {
+        const double* in = input_signal + k * channels;
+        const double* prev = output_signal + (k - 1) * channels;
+        double* out = output_signal + k * channels;
+        for (int c = 0; c < channels; c++) {
+            out[c] = alpha[c] * in[c] + (1.0 - alpha[c]) * prev[c];
+        }
+    }
+}
+
+} // namespace kernels
+
+// ---- Dispatch ----
+
+namespace {
+
+struct KernelEntry {
+    BatchIsa isa;
+    const char* name;
+    kernels::BatchFn fn;  // nullptr when not built for this target
+};
+
+#if defined(BATCH_X86_KERNELS)
+const KernelEntry kKernels[] = {
+    {BatchIsa::Portable, "portable", kernels::batch_portable},
+    {BatchIsa::Sse2, "sse2", kernels::batch_sse2},
+    {BatchIsa::Avx2, "avx2", kernels::batch_avx2},
+    {BatchIsa::Avx512, "avx512", kernels::batch_avx512},
+};
+#else
+const KernelEntry kKernels[] = {
+    {BatchIsa::Portable, "portable", kernels::batch_portable},
+    {BatchIsa::Sse2, "sse2", nullptr},
+    {BatchIsa::Avx2, "avx2", nullptr},
+    {BatchIsa::Avx512, "avx512", nullptr},
+};
+#endif
+
+bool CpuSupports(BatchIsa isa) {
+#if defined(BATCH_X86_KERNELS)
+    // May run from a static initializer, before libgcc has probed the CPU
+    __builtin_cpu_init();
+    switch (isa) {
+        case BatchIsa::Portable: return true;
+        case BatchIsa::Sse2: return __builtin_cpu_supports("sse2");
+        case BatchIsa::Avx2: return __builtin_cpu_supports("avx2");
+        case BatchIsa::Avx512: return __builtin_cpu_supports("avx512f");
+    }
+    return false;
+#else
+    return isa == BatchIsa::Portable;
+#endif
+}
+
+const KernelEntry& Entry(BatchIsa isa) {
+    return kKernels[static_cast<int>(isa)];
+}
+
+const KernelEntry* Best() {
+    for (int i = static_cast<int>(BatchIsa::Avx512); i > 0; i--) {
+        if (batch_isa_supported(static_cast<BatchIsa>(i))) return &kKernels[i];
+    }
+    return &kKernels[0];
+}
+
+std::atomic<const KernelEntry*>& Selected() {
+    static std::atomic<const KernelEntry*> selected{Best()};
+    return selected;
+}
+
+// Resolve when the library is loaded rather than on the first batch
+[[maybe_unused]] const bool kResolvedAtLoad = (Selected(), true);
+
+} // namespace
+
+BatchIsa batch_isa() {
+    return Selected().load(std::memory_order_relaxed)->isa;
+}
+
+const char* batch_isa_name(BatchIsa isa) {
+    return Entry(isa).name;
+}
+
+bool batch_isa_supported(BatchIsa isa) {
+    return Entry(isa).fn != nullptr && CpuSupports(isa);
+}
+
+bool set_batch_isa(BatchIsa isa) {
+    if (!batch_isa_supported(isa)) return false;
+    Selected().store(&Entry(isa), std::memory_order_relaxed);
+    return true;
+}
+
+void low_pass_filter_batch(
+    const double input_signal[],
+    const double alpha[],
+    int n,
+    int channels,
+    double output_signal[])
+{
+    Selected().load(std::memory_order_relaxed)->fn(input_signal, alpha, n, channels, output_signal);
+}
+
+} // namespace low_pass_filter
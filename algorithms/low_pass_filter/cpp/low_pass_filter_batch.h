@@ -0,0 +1,68 @@
+#ifndef LOW_PASS_FILTER_BATCH_H
+#define LOW_PASS_FILTER_BATCH_H
+
+// Batch API for low_pass_filter (hand-written, ships in the package).
+//
+// Filters `channels` independent signals of n samples each, stored
+// channel-interleaved (sample k of channel c at [k * channels + c]). Every
+// channel gets exactly the result of the scalar low_pass_filter() — the
+// equivalence matrix in the C++ tests checks this bit for bit.
+//
+// The library carries SSE2, AVX2 and AVX-512 builds of the batch kernel
+// (x86-64 only, vectorized across channels) and picks the widest one the
+// CPU supports when it is loaded, so a package built for generic x86-64
+// still uses the host's vector units. batch_isa() reports the choice.
+
+namespace low_pass_filter {
+
+// Inputs:
+//   input_signal[n * channels] - interleaved samples
+//   alpha[channels]            - smoothing factor per channel
+//   n                          - samples per channel
+//   channels                   - number of channels
+// Outputs:
+//   output_signal[n * channels] - interleaved filtered samples
+void low_pass_filter_batch(
+    const double input_signal[],
+    const double alpha[],
+    int n,
+    int channels,
+    double output_signal[]);
+
+// Kernel builds behind low_pass_filter_batch(), narrowest first
+enum class BatchIsa { Portable, Sse2, Avx2, Avx512 };
+
+// Kernel in use by this process
+BatchIsa batch_isa();
+
+// "portable", "sse2", "avx2" or "avx512"
+const char* batch_isa_name(BatchIsa isa);
+
+// Whether this build contains `isa` and the CPU can run it
+bool batch_isa_supported(BatchIsa isa);
+
+// Switch kernels (tests, benchmarks). Returns false and keeps the current
+// kernel if `isa` is not supported. Not meant to race with running batches.
+bool set_batch_isa(BatchIsa isa);
+
+// Kernel, batch size and worker count chosen for this machine
+struct BatchTuning {
+    BatchIsa isa;
+    int batch_size;   // channels per low_pass_filter_batch() call
+    int threads;      // workers, each over a contiguous slice of the table
+    bool from_cache;  // read from the cache rather than measured
+};
+
+// Optional startup calibration. Times the kernels this CPU supports, then
+// batch sizes, then worker counts on a synthetic table of 64-sample
+// channels (a fraction of a second), switches to the fastest kernel and
+// returns the choice. The decision is cached per CPU model in `cache_path`,
+// so later startups only read the file: "" means
+// $MATLAB_ALGORITHMS_CALIBRATION_CACHE or
+// ~/.cache/matlab_algorithms/batch_calibration.tsv, nullptr means no cache.
+// recalibrate = true measures even on a cache hit.
+BatchTuning calibrate_batch(const char* cache_path = "", bool recalibrate = false);
+
+} // namespace low_pass_filter
+
+#endif // LOW_PASS_FILTER_BATCH_H
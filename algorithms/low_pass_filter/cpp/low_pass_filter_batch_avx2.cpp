@@ -0,0 +1,21 @@
+// AVX2 kernel for low_pass_filter_batch(), 4 channels per vector. Built
+// with the ISA's -m flag and -ffp-contract=off; only called once the CPU
+// check in low_pass_filter_batch.cpp has passed.
+
+#include "low_pass_filter_batch_kernels.h"
+
+namespace low_pass_filter {
+namespace kernels {
+
+void batch_avx2(
+    const double input_signal[],
+    const double alpha[],
+    int n,
+    int channels,
+    double output_signal[])
+{
+    BatchKernel<Vec4d>(input_signal, alpha, n, channels, output_signal);
+}
+
+} // namespace kernels
+} // namespace low_pass_filter
@@ -0,0 +1,81 @@
+#ifndef LOW_PASS_FILTER_BATCH_KERNELS_H
+#define LOW_PASS_FILTER_BATCH_KERNELS_H
+
+// Instruction-set-specific kernels behind low_pass_filter_batch()
+// (internal, not installed).
+//
+// Each low_pass_filter_batch_<isa>.cpp is compiled with its own -m flags
+// and -ffp-contract=off, and instantiates BatchKernel with a vector of that
+// ISA's width. The recursion runs down the samples, so the vectors span
+// channels: each sample row is computed a vector of channels at a time with
+// the expression of generated/low_pass_filter.cpp and no fused
+// multiply-add, so every channel rounds exactly like the scalar function.
+
+#include <cstring>
+
+namespace low_pass_filter {
+namespace kernels {
+
+using BatchFn = void (*)(const double input_signal[], const double alpha[], int n, int channels,
+                         double output_signal[]);
+
+void batch_portable(const double input_signal[], const double alpha[], int n, int channels,
+                    double output_signal[]);
+void batch_sse2(const double input_signal[], const double alpha[], int n, int channels,
+                double output_signal[]);
+void batch_avx2(const double input_signal[], const double alpha[], int n, int channels,
+                double output_signal[]);
+void batch_avx512(const double input_signal[], const double alpha[], int n, int channels,
+                  double output_signal[]);
+
+typedef double Vec2d __attribute__((vector_size(16)));
+typedef double Vec4d __attribute__((vector_size(32)));
+typedef double Vec8d __attribute__((vector_size(64)));
+
+// Internal linkage: every kernel TU gets its own copy compiled for its ISA,
+// so the linker can never hand an AVX-512 instantiation to the SSE2 path.
+namespace {
+
+template <class V>
+inline V Load(const double* p) {
+    V v;
+    std::memcpy(&v, p, sizeof(V));
+    return v;
+}
+
+template <class V>
+inline void Store(double* p, V v) {
+    std::memcpy(p, &v, sizeof(V));
+}
+
+template <class V>
+inline void BatchKernel(const double input_signal[], const double alpha[], int n, int channels,
+                        double output_signal[]) {
+    constexpr int kLanes = sizeof(V) / sizeof(double);
+    if (n <= 0) return;
+
+    for (int c = 0; c < channels; c++) {
+        output_signal[c] = input_signal[c];
+    }
+
+    for (int k = 1; k < n; k++) {
+        const double* in = input_signal + k * channels;
+        const double* prev = output_signal + (k - 1) * channels;
+        double* out = output_signal + k * channels;
+        int c = 0;
+        for (; c + kLanes <= channels; c += kLanes) {
+            V a = Load<V>(alpha + c);
+            Store(out + c, a * Load<V>(in + c) + (1.0 - a) * Load<V>(prev + c));
+        }
+        for (; c < channels; c++) {
+            out[c] = alpha[c] * in[c] + (1.0 - alpha[c]) * prev[c];
+        }
+    }
+}
+
+} // namespace
+
+} // namespace kernels
+} // namespace low_pass_filter
+
+#endif // LOW_PASS_FILTER_BATCH_KERNELS_H
@@ -0,0 +1,58 @@
+#include "low_pass_filter_batch.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "batch_calibration.h"
+
+namespace low_pass_filter {
+
+// calibrate_batch(): the measurement itself is runtime::CalibrateBatch()
+// (runtime/batch_calibration.h); this file supplies the kernel candidates
+// and a synthetic channel table to run them on.
+BatchTuning calibrate_batch(const char* cache_path, bool recalibrate)
+{
+    std::vector<BatchIsa> isas;
+    std::vector<std::string> names;
+    for (BatchIsa isa : {BatchIsa::Portable, BatchIsa::Sse2, BatchIsa::Avx2, BatchIsa::Avx512}) {
+        if (!batch_isa_supported(isa)) continue;
+        isas.push_back(isa);
+        names.push_back(batch_isa_name(isa));
+    }
+
+    runtime::CalibrationOptions opts;
+    opts.cache_path = cache_path ? cache_path : "-";
+    opts.recalibrate = recalibrate;
+    // Elements are channels of kSamples samples; a batch call filters
+    // `batch` of them, interleaved in their own block of the table
+    constexpr int kSamples = 64;
+    opts.table_elements = 8192;
+
+    runtime::CalibrationResult r;
+    if (!runtime::LookupCalibration("low_pass_filter", names, opts, &r)) {
+        const size_t n = opts.table_elements;
+        std::vector<double> input(n * kSamples), output(n * kSamples), alpha(n);
+        for (size_t i = 0; i < input.size(); i++) input[i] = static_cast<double>(i % 17) - 8.0;
+        for (size_t c = 0; c < n; c++) alpha[c] = 0.05 + 0.9 * static_cast<double>(c % 10) / 10.0;
+
+        auto run = [&](int isa, int batch, size_t begin, size_t end) {
+            set_batch_isa(isas[isa]);
+            for (size_t c = begin; c < end; c += batch) {
+                int count = static_cast<int>(std::min<size_t>(batch, end - c));
+                low_pass_filter_batch(&input[c * kSamples], &alpha[c], kSamples, count,
+                                      &output[c * kSamples]);
+            }
+        };
+        r = runtime::CalibrateBatch("low_pass_filter", names, run, opts);
+    }
+
+    BatchTuning tuning{batch_isa(), r.batch_size, r.threads, r.from_cache};
+    for (size_t i = 0; i < isas.size(); i++) {
+        if (names[i] == r.isa) tuning.isa = isas[i];
+    }
+    set_batch_isa(tuning.isa);
+    return tuning;
+}
+
+} // namespace low_pass_filter
@@ -0,0 +1,38 @@
+#ifndef LOW_PASS_FILTER_FIXED_H
+#define LOW_PASS_FILTER_FIXED_H
+
+// low_pass_filter() with the smoothing factor fixed at compile time
+// (hand-written, header-only, ships in the package).
+//
+// Alpha is a type carrying the constant, e.g.
+//
+//   struct Alpha { static constexpr double value = 0.2; };
+//   low_pass_filter::low_pass_filter_fixed<Alpha>(in, n, out);
+//
+// (C++17 does not allow double template arguments.) (1.0 - alpha) is
+// folded at compile time, which saves a subtraction per sample. The
+// result is bit-identical to low_pass_filter(in, Alpha::value, n, out).
+
+namespace low_pass_filter {
+
+template <class Alpha>
+inline void low_pass_filter_fixed(
+    const double input_signal[],
+    int n,
+    double output_signal[])
+{
+    constexpr double alpha = Alpha::value;
+    constexpr double retain = 1.0 - alpha;
+
+    if (n <= 0) return;
+
+    output_signal[0] = input_signal[0];
+
+    for (int k = 1; k < n; k++) {
+        output_signal[k] = alpha * input_signal[k] + retain * output_signal[k - 1];
+    }
+}
+
+} // namespace low_pass_filter
+
+#endif // LOW_PASS_FILTER_FIXED_H
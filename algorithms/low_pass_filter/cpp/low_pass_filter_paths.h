@@ -0,0 +1,126 @@
+#ifndef LOW_PASS_FILTER_PATHS_H
+#define LOW_PASS_FILTER_PATHS_H
+
+// Execution paths of low_pass_filter for the equivalence matrix: the scalar
+// function, low_pass_filter_batch() at several channel counts, and batches
+// spread over 1..N threads, repeated for each SIMD kernel build the CPU
+// supports, plus the generated SoA wrappers.
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "equivalence_matrix.h"
+#include "low_pass_filter_batch.h"
+#include "low_pass_filter_signature.h"
+#include "low_pass_filter_wrappers.h"
+#include "worker_pool.h"
+
+namespace low_pass_filter {
+
+// Test cases -> interleaved channels -> low_pass_filter_batch(). Shorter
+// signals are zero-padded to the longest; the filter is causal, so the
+// padding cannot affect their first samples.
+struct BatchAdapter {
+    // Native batch layout; Call() may run repeatedly (the benchmark does)
+    struct Packed {
+        int n = 0;
+        int channels = 0;
+        harness::BatchArray input, alpha, output;
+
+        void Call() {
+            low_pass_filter_batch(input.data(), alpha.data(), n, channels, output.data());
+        }
+    };
+
+    static Packed Pack(const std::vector<const harness::Values*>& in) {
+        Packed p;
+        p.channels = static_cast<int>(in.size());
+        size_t n = 0;
+        for (const auto* v : in) n = std::max(n, (*v)[0].size());
+        p.n = static_cast<int>(n);
+
+        p.input.assign(n * in.size(), 0.0);
+        p.output.assign(n * in.size(), 0.0);
+        p.alpha.resize(in.size());
+        for (size_t c = 0; c < in.size(); c++) {
+            const harness::Values& v = *in[c];
+            for (size_t k = 0; k < v[0].size(); k++) p.input[k * in.size() + c] = v[0][k];
+            p.alpha[c] = v[1][0];
+        }
+        return p;
+    }
+
+    static void Unpack(const Packed& p, std::vector<harness::Values*>& out) {
+        for (size_t c = 0; c < out.size(); c++) {
+            std::vector<double>& r = (*out[c])[0];
+            for (size_t k = 0; k < r.size(); k++) r[k] = p.output[k * out.size() + c];
+        }
+    }
+
+    static void Run(const std::vector<const harness::Values*>& in, std::vector<harness::Values*>& out) {
+        Packed p = Pack(in);
+        p.Call();
+        Unpack(p, out);
+    }
+};
+
+// Same layout through the generated low_pass_filter_soa() (Threads == 0)
+// or low_pass_filter_soa_parallel()
+template <int Threads, bool Pooled = false>
+struct SoaAdapter {
+    struct Packed : BatchAdapter::Packed {
+        void Call() {
+            if (Threads == 0) {
+                low_pass_filter_soa(channels, input.data(), alpha.data(), n, output.data());
+            } else if (Pooled) {
+                // One pool per harness thread, kept across calls
+                thread_local runtime::WorkerPool pool(Threads);
+                low_pass_filter_soa_parallel(channels, input.data(), alpha.data(), n, output.data(), pool);
+            } else {
+                low_pass_filter_soa_parallel(channels, input.data(), alpha.data(), n, output.data(), Threads);
+            }
+        }
+    };
+
+    static Packed Pack(const std::vector<const harness::Values*>& in) { return {BatchAdapter::Pack(in)}; }
+
+    static void Unpack(const Packed& p, std::vector<harness::Values*>& out) { BatchAdapter::Unpack(p, out); }
+
+    static void Run(const std::vector<const harness::Values*>& in, std::vector<harness::Values*>& out) {
+        Packed p = Pack(in);
+        p.Call();
+        Unpack(p, out);
+    }
+};
+
+// Unprefixed batch paths use the kernel picked at load time; the
+// "<isa>/" paths repeat them with each kernel this CPU can run pinned.
+inline std::vector<harness::ExecutionPath> ExecutionPaths() {
+    auto paths = harness::StandardPaths<Signature, BatchAdapter>();
+    const BatchIsa selected = batch_isa();
+    for (BatchIsa isa : {BatchIsa::Portable, BatchIsa::Sse2, BatchIsa::Avx2, BatchIsa::Avx512}) {
+        if (!batch_isa_supported(isa)) continue;
+        std::string prefix = std::string(batch_isa_name(isa)) + "/";
+        for (auto& path : harness::StandardPaths<Signature, BatchAdapter>(prefix)) {
+            paths.push_back(harness::ScopedPath(
+                std::move(path), [isa] { set_batch_isa(isa); }, [selected] { set_batch_isa(selected); }));
+        }
+    }
+
+    // Generated wrappers (low_pass_filter_wrappers.h) over the same cases; the
+    // parallel wrapper splits each call over 3 threads, started per call or
+    // kept in a runtime::WorkerPool
+    for (auto& path : harness::StandardPaths<Signature, SoaAdapter<0>>("soa/")) {
+        paths.push_back(std::move(path));
+    }
+    for (size_t b : {3, 64}) {
+        paths.push_back(harness::BatchPath<Signature, SoaAdapter<3>>(b, "soa_parallel/"));
+        paths.push_back(harness::BatchPath<Signature, SoaAdapter<3, true>>(b, "soa_pool/"));
+    }
+    return paths;
+}
+
+} // namespace low_pass_filter
+
+#endif // LOW_PASS_FILTER_PATHS_H
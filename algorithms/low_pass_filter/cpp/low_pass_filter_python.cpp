@@ -0,0 +1,116 @@
+/**
+ * Python bindings for low_pass_filter (hand-written; built as the
+ * `low_pass_filter` extension module by cmake/PythonModule.cmake).
+ *
+ *   low_pass_filter(input_signal, alpha, out=None) -> output_signal[n]
+ *       one signal
+ *   low_pass_filter_batch(input_signal, alpha, out=None) -> output[n, channels]
+ *       len(alpha) channels, interleaved (an (n, channels) C-order array)
+ *   batch_isa() -> "portable" | "sse2" | "avx2" | "avx512"
+ *
+ * Arrays are used in place (python/python_buffer.h) and the GIL is
+ * released while C++ runs, so Python threads can filter concurrently.
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include "low_pass_filter.h"
+#include "low_pass_filter_batch.h"
+#include "python_buffer.h"
+
+namespace {
+
+using python_buffer::DoubleArray;
+
+// `out` when given (filled in place, returned as given), else a new array
+PyObject* Output(PyObject* out_obj, std::initializer_list<Py_ssize_t> shape, Py_ssize_t size, DoubleArray& out) {
+    if (out_obj == Py_None) return python_buffer::NewArray(shape, out, "out");
+    if (!out.Parse(out_obj, "out", true) || !python_buffer::CheckSize(out, size)) return nullptr;
+    Py_INCREF(out_obj);
+    return out_obj;
+}
+
+PyObject* LowPassFilter(PyObject*, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"input_signal", "alpha", "out", nullptr};
+    PyObject *input_obj, *out_obj = Py_None;
+    double alpha;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "Od|O", const_cast<char**>(keywords), &input_obj, &alpha,
+                                     &out_obj)) {
+        return nullptr;
+    }
+    DoubleArray input, out;
+    if (!input.Parse(input_obj, "input_signal", false) || !python_buffer::CheckIntSize(input.size())) {
+        return nullptr;
+    }
+    const Py_ssize_t n = input.size();
+    PyObject* result = Output(out_obj, {n}, n, out);
+    if (!result) return nullptr;
+    Py_BEGIN_ALLOW_THREADS
+    low_pass_filter::low_pass_filter(input.data(), alpha, static_cast<int>(n), out.data());
+    Py_END_ALLOW_THREADS
+    return result;
+}
+
+PyObject* LowPassFilterBatch(PyObject*, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"input_signal", "alpha", "out", nullptr};
+    PyObject *input_obj, *alpha_obj, *out_obj = Py_None;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|O", const_cast<char**>(keywords), &input_obj, &alpha_obj,
+                                     &out_obj)) {
+        return nullptr;
+    }
+    DoubleArray input, alpha, out;
+    if (!input.Parse(input_obj, "input_signal", false) || !alpha.Parse(alpha_obj, "alpha", false)) {
+        return nullptr;
+    }
+    const Py_ssize_t channels = alpha.size();
+    if (channels == 0 || input.size() % channels != 0) {
+        PyErr_Format(PyExc_ValueError, "input_signal has %zd elements, not a multiple of len(alpha) = %zd",
+                     input.size(), channels);
+        return nullptr;
+    }
+    const Py_ssize_t n = input.size() / channels;
+    if (!python_buffer::CheckIntSize(n) || !python_buffer::CheckIntSize(channels)) return nullptr;
+    PyObject* result = Output(out_obj, {n, channels}, input.size(), out);
+    if (!result) return nullptr;
+    Py_BEGIN_ALLOW_THREADS
+    low_pass_filter::low_pass_filter_batch(input.data(), alpha.data(), static_cast<int>(n),
+                                           static_cast<int>(channels), out.data());
+    Py_END_ALLOW_THREADS
+    return result;
+}
+
+PyObject* BatchIsa(PyObject*, PyObject*) {
+    return PyUnicode_FromString(low_pass_filter::batch_isa_name(low_pass_filter::batch_isa()));
+}
+
+PyMethodDef kMethods[] = {
+    {"low_pass_filter", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(LowPassFilter)),
+     METH_VARARGS | METH_KEYWORDS,
+     "low_pass_filter(input_signal, alpha, out=None) -> output_signal\n\n"
+     "Filters one signal. Pass out to fill an existing array."},
+    {"low_pass_filter_batch", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(LowPassFilterBatch)),
+     METH_VARARGS | METH_KEYWORDS,
+     "low_pass_filter_batch(input_signal, alpha, out=None) -> output[n, channels]\n\n"
+     "Filters len(alpha) channels stored interleaved, i.e. an (n, channels)\n"
+     "C-order array. Pass out to fill an existing array."},
+    {"batch_isa", BatchIsa, METH_NOARGS, "Kernel used by low_pass_filter_batch()."},
+    {nullptr, nullptr, 0, nullptr},
+};
+
+PyModuleDef kModule = {
+    PyModuleDef_HEAD_INIT,
+    "low_pass_filter",  // m_name
+    // m_doc
+    "low_pass_filter bindings: float64 arrays in place, GIL released during the C++ calls.",
+    -1,  // m_size
+    kMethods,  // m_methods
+    nullptr,  // m_slots
+    nullptr,  // m_traverse
+    nullptr,  // m_clear
+    nullptr,  // m_free
+};
+
+} // namespace
+
+PyMODINIT_FUNC PyInit_low_pass_filter() { return PyModule_Create(&kModule); }
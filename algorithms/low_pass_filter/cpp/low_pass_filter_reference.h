@@ -0,0 +1,54 @@
+#ifndef LOW_PASS_FILTER_REFERENCE_H
+#define LOW_PASS_FILTER_REFERENCE_H
+
+// Precision-generic transcription of generated/low_pass_filter.cpp.
+//
+// Same operations in the same order as the generated code, evaluated in T.
+// With T = long double it is the high-precision reference for the fuzz
+// engine; other instantiations (e.g. float) model reduced-precision builds.
+
+#include <vector>
+
+#include "algorithm_harness.h"
+#include "low_pass_filter_signature.h"
+
+namespace low_pass_filter {
+
+template <typename T>
+void low_pass_filter_reference(
+    const T input_signal[],
+    T alpha,
+    int n,
+    T output_signal[])
+{
+    if (n <= 0) return;
+
+    output_signal[0] = input_signal[0];
+
+    for (int k = 1; k < n; k++) {
+        output_signal[k] = alpha * input_signal[k] + (T(1) - alpha) * output_signal[k - 1];
+    }
+}
+
+// Reference descriptor for the fuzz engine and error analyzer (same field
+// layout as Signature).
+struct Reference {
+    using Signature = low_pass_filter::Signature;
+
+    static void Invoke(const harness::Values& in, harness::WideValues& out) {
+        Evaluate<long double>(in, out);
+    }
+
+    // Evaluate in T (outputs must be sized, e.g. by harness::ResizeOutputs)
+    template <typename T>
+    static void Evaluate(const harness::Values& in, std::vector<std::vector<T>>& out) {
+        thread_local std::vector<T> input;
+        input.assign(in[0].begin(), in[0].end());
+        low_pass_filter_reference<T>(input.data(), T(in[1][0]),
+                                     static_cast<int>(input.size()), out[0].data());
+    }
+};
+
+} // namespace low_pass_filter
+
+#endif // LOW_PASS_FILTER_REFERENCE_H
@@ -0,0 +1,51 @@
+#ifndef LOW_PASS_FILTER_STRIDED_H
+#define LOW_PASS_FILTER_STRIDED_H
+
+// low_pass_filter() on strided views (hand-written, header-only, ships in
+// the package and needs algorithm_runtime for runtime/strided_span.h).
+//
+// Filters one field of interleaved records in place, with no gather into
+// a temporary array and no scatter back:
+//
+//   struct Sample { double t, raw, filtered; };
+//   low_pass_filter::low_pass_filter(runtime::field(frame, &Sample::raw), alpha,
+//                                    runtime::field(frame, &Sample::filtered));
+//
+// The output may be the input's own view, which filters the field in
+// place. Contiguous views go straight to the generated function; strided
+// ones run its recurrence in the same operation order, so the result is
+// bit-identical either way.
+
+#include <stdexcept>
+
+#include "low_pass_filter.h"
+#include "strided_span.h"
+
+namespace low_pass_filter {
+
+inline void low_pass_filter(
+    runtime::StridedSpan<const double> input_signal,
+    double alpha,
+    runtime::StridedSpan<double> output_signal)
+{
+    if (output_signal.size() != input_signal.size()) {
+        throw std::invalid_argument("low_pass_filter: output_signal and input_signal differ in size");
+    }
+    const size_t n = input_signal.size();
+    if (n == 0) return;
+    if (input_signal.contiguous() && output_signal.contiguous()) {
+        low_pass_filter(input_signal.data(), alpha, static_cast<int>(n), output_signal.data());
+        return;
+    }
+
+    double previous = input_signal[0];
+    output_signal[0] = previous;
+    for (size_t k = 1; k < n; k++) {
+        previous = alpha * input_signal[k] + (1.0 - alpha) * previous;
+        output_signal[k] = previous;
+    }
+}
+
+} // namespace low_pass_filter
+
+#endif // LOW_PASS_FILTER_STRIDED_H
@@ -0,0 +1,94 @@
+#ifndef LOW_PASS_FILTER_VARIANTS_H
+#define LOW_PASS_FILTER_VARIANTS_H
+
+// Candidate kernel variants of low_pass_filter for error analysis.
+//
+// Each variant computes the same recurrence as generated/low_pass_filter.cpp
+// with a different rounding behaviour. The analyzer (ulp_low_pass_filter)
+// measures them against the long double reference before any of them is
+// adopted.
+
+#include <cmath>
+#include <tuple>
+
+#include "low_pass_filter_reference.h"
+#include "variants.h"
+
+namespace low_pass_filter {
+
+// The recurrence with alpha * x[k] + c * y[k-1] fused into one multiply-add.
+inline void low_pass_filter_fma(const double input_signal[], double alpha, int n, double output_signal[]) {
+    if (n <= 0) return;
+
+    output_signal[0] = input_signal[0];
+
+    double c = 1.0 - alpha;
+    for (int k = 1; k < n; k++) {
+        output_signal[k] = std::fma(alpha, input_signal[k], c * output_signal[k - 1]);
+    }
+}
+
+// Four outputs per step from y[k-1] alone (the lookahead form a SIMD
+// kernel uses), with c = 1 - alpha:
+//
+//   y[k+j] = c^(j+1) y[k-1] + sum_{i<=j} c^(j-i) alpha x[k+i]
+//
+// Mathematically identical to the recurrence; rounding differs because
+// the sums are reassociated.
+inline void low_pass_filter_block4(const double input_signal[], double alpha, int n, double output_signal[]) {
+    if (n <= 0) return;
+
+    output_signal[0] = input_signal[0];
+
+    double c1 = 1.0 - alpha;
+    double c2 = c1 * c1;
+    double c3 = c2 * c1;
+    double c4 = c2 * c2;
+
+    int k = 1;
+    for (; k + 3 < n; k += 4) {
+        double p = output_signal[k - 1];
+        double a0 = alpha * input_signal[k];
+        double a1 = alpha * input_signal[k + 1];
+        double a2 = alpha * input_signal[k + 2];
+        double a3 = alpha * input_signal[k + 3];
+
+        output_signal[k] = a0 + c1 * p;
+        output_signal[k + 1] = a1 + c1 * a0 + c2 * p;
+        output_signal[k + 2] = a2 + c1 * a1 + c2 * a0 + c3 * p;
+        output_signal[k + 3] = a3 + c1 * a2 + c2 * a1 + c3 * a0 + c4 * p;
+    }
+    for (; k < n; k++) {
+        output_signal[k] = alpha * input_signal[k] + c1 * output_signal[k - 1];
+    }
+}
+
+struct FmaVariant {
+    using Scalar = double;
+    static constexpr const char* kName = "fma";
+    static constexpr const char* kDescription = "Recurrence with the multiply-add fused";
+
+    static void Invoke(const harness::Values& in, harness::Values& out) {
+        low_pass_filter_fma(in[0].data(), in[1][0], static_cast<int>(in[0].size()), out[0].data());
+    }
+};
+
+struct Block4Variant {
+    using Scalar = double;
+    static constexpr const char* kName = "block4";
+    static constexpr const char* kDescription = "Four-sample lookahead (SIMD-reassociated) recurrence";
+
+    static void Invoke(const harness::Values& in, harness::Values& out) {
+        low_pass_filter_block4(in[0].data(), in[1][0], static_cast<int>(in[0].size()), out[0].data());
+    }
+};
+
+using Variants = std::tuple<
+    harness::GeneratedVariant<Signature>,
+    FmaVariant,
+    Block4Variant,
+    harness::PrecisionVariant<Reference, float>>;
+
+} // namespace low_pass_filter
+
+#endif // LOW_PASS_FILTER_VARIANTS_H
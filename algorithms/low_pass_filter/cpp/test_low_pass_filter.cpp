@@ -5,22 +5,34 @@
  * Reads the same JSON test vectors used by the MATLAB test harness,
  * runs the generated C++ function, and validates outputs within tolerance.
  *
- * Also writes cpp_outputs.json for equivalence comparison with MATLAB.
+ * Input/output mapping comes from low_pass_filter_signature.h; loading, parallel
+ * execution and output collection are shared (harness/). The vectors are
+ * embedded at build time (low_pass_filter_test_vectors.h); set HARNESS_VECTORS to a
+ * JSON directory or .tvb file to run other vectors ad hoc.
+ *
+ * Every execution path in low_pass_filter_paths.h (batch, threaded, each SIMD
+ * kernel) must match the scalar function bit for bit; the path x case
+ * matrix is written next to cpp_outputs.json, which is kept for
+ * equivalence comparison with MATLAB.
  */
 
 #include <gtest/gtest.h>
-#include <nlohmann/json.hpp>
-#include <filesystem>
-#include <fstream>
-#include <string>
-#include <vector>
-#include <cmath>
-
-// Generated header from MATLAB Coder
-#include "low_pass_filter.h"
 
-using json = nlohmann::json;
-namespace fs = std::filesystem;
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+#include "embedded_vectors.h"
+#include "fuzz_engine.h"
+#include "gtest_harness.h"
+#include "low_pass_filter_fixed.h"
+#include "low_pass_filter_paths.h"
+#include "low_pass_filter_plugin.h"
+#include "low_pass_filter_signature.h"
+#include "low_pass_filter_strided.h"
+#include "low_pass_filter_test_vectors.h"
+#include "plugin_host.h"
 
 #ifndef TEST_VECTORS_DIR
 #error "TEST_VECTORS_DIR must be defined at compile time"
@@ -30,134 +42,200 @@ namespace fs = std::filesystem;
 #define OUTPUT_DIR "."
 #endif
 
-// ---- Test case data structure ----
-
-struct TestCase {
-    std::string name;
-    std::string description;
+using Signature = low_pass_filter::Signature;
 
-    // Inputs
-    std::vector<double> input_signal;
-    double alpha;
+static std::vector<harness::TestCase> LoadCases() {
+    return harness::LoadSelectedVectors<Signature>(
+        low_pass_filter::embedded::kCases, low_pass_filter::embedded::kCaseCount);
+}
 
-    // Expected outputs
-    std::vector<double> expected_output_signal;
+// ---- Parameterized test ----
 
-    // Tolerance
-    double abs_tolerance;
-};
+using LowPassFilterTest = harness::VectorTest<Signature>;
 
-// For Google Test to print test case names
-std::string TestCaseName(const ::testing::TestParamInfo<TestCase>& info) {
-    return info.param.name;
+TEST_P(LowPassFilterTest, MatchesExpectedOutput) {
+    CheckExpectedOutput();
 }
 
-// ---- Load test vectors from JSON ----
-
-std::vector<TestCase> LoadTestVectors(const std::string& dir) {
-    std::vector<TestCase> cases;
-
-    for (const auto& entry : fs::directory_iterator(dir)) {
-        if (entry.path().extension() != ".json") continue;
-        if (entry.path().filename() == "schema.json") continue;
+INSTANTIATE_TEST_SUITE_P(
+    TestVectors,
+    LowPassFilterTest,
+    ::testing::ValuesIn(LoadCases()),
+    harness::TestCaseName
+);
 
-        std::ifstream f(entry.path());
-        if (!f.is_open()) continue;
+// ---- Loading and execution paths ----
 
-        json data = json::parse(f);
+TEST(LowPassFilterHarness, EmbeddedMatchesJson) {
+    harness::ExpectSameCases(
+        harness::LoadTestVectors<Signature>(TEST_VECTORS_DIR),
+        harness::LoadEmbeddedVectors<Signature>(low_pass_filter::embedded::kCases, low_pass_filter::embedded::kCaseCount));
+}
 
-        // Global tolerance defaults
-        double global_abs_tol = 1e-10;
-        if (data.contains("global_tolerance") &&
-            data["global_tolerance"].contains("absolute")) {
-            global_abs_tol = data["global_tolerance"]["absolute"].get<double>();
-        }
+TEST(LowPassFilterHarness, ParallelMatchesSerial) {
+    harness::ExpectParallelMatchesSerial<Signature>(TEST_VECTORS_DIR);
+}
 
-        for (const auto& tc : data["test_cases"]) {
-            TestCase t;
-            t.name = tc["name"].get<std::string>();
-            t.description = tc.value("description", "");
+TEST(LowPassFilterHarness, BinaryRoundTrip) {
+    harness::ExpectBinaryRoundTrip<Signature>(TEST_VECTORS_DIR, OUTPUT_DIR);
+}
 
-            // Parse inputs
-            t.input_signal = tc["inputs"]["input_signal"].get<std::vector<double>>();
-            t.alpha = tc["inputs"]["alpha"].get<double>();
+TEST(LowPassFilterHarness, StreamingMatchesBulk) {
+    harness::ExpectStreamingMatchesBulk<Signature>(TEST_VECTORS_DIR);
+}
 
-            // Parse expected outputs
-            t.expected_output_signal = tc["expected_output"]["output_signal"].get<std::vector<double>>();
+// ---- Execution paths (scalar, batch sizes, threads, SIMD kernels, SoA wrappers) ----
 
-            // Per-case tolerance overrides global
-            t.abs_tolerance = global_abs_tol;
-            if (tc.contains("tolerance") && tc["tolerance"].contains("absolute")) {
-                t.abs_tolerance = tc["tolerance"]["absolute"].get<double>();
-            }
+TEST(LowPassFilterHarness, AllExecutionPathsMatchScalar) {
+    harness::ExpectAllPathsEquivalent<Signature>(low_pass_filter::ExecutionPaths(), LoadCases(), OUTPUT_DIR);
+}
 
-            cases.push_back(t);
-        }
+// The load-time pick is the widest kernel this build and CPU support
+TEST(LowPassFilterHarness, BatchKernelIsWidestSupported) {
+    using low_pass_filter::BatchIsa;
+    BatchIsa selected = low_pass_filter::batch_isa();
+    std::cout << "low_pass_filter_batch kernel: " << low_pass_filter::batch_isa_name(selected) << "\n";
+    EXPECT_TRUE(low_pass_filter::batch_isa_supported(selected));
+    EXPECT_TRUE(low_pass_filter::batch_isa_supported(BatchIsa::Portable));
+    for (int i = static_cast<int>(selected) + 1; i <= static_cast<int>(BatchIsa::Avx512); i++) {
+        EXPECT_FALSE(low_pass_filter::batch_isa_supported(static_cast<BatchIsa>(i)));
+        EXPECT_FALSE(low_pass_filter::set_batch_isa(static_cast<BatchIsa>(i)));
     }
+    EXPECT_EQ(low_pass_filter::batch_isa(), selected);
+}
 
-    return cases;
+// ---- Startup calibration (low_pass_filter_batch.h) ----
+
+// Measures, switches kernel, caches; the second call only reads the cache
+TEST(LowPassFilterHarness, CalibrationPicksSupportedKernelAndCaches) {
+    const low_pass_filter::BatchIsa selected = low_pass_filter::batch_isa();
+    const std::string cache = std::string(OUTPUT_DIR) + "/low_pass_filter_batch_calibration.tsv";
+
+    low_pass_filter::BatchTuning measured = low_pass_filter::calibrate_batch(cache.c_str(), true);
+    std::cout << "calibrated: " << low_pass_filter::batch_isa_name(measured.isa) << ", batch "
+              << measured.batch_size << ", " << measured.threads << " thread(s)\n";
+    EXPECT_FALSE(measured.from_cache);
+    EXPECT_TRUE(low_pass_filter::batch_isa_supported(measured.isa));
+    EXPECT_EQ(low_pass_filter::batch_isa(), measured.isa);
+    EXPECT_GT(measured.batch_size, 0);
+    EXPECT_GE(measured.threads, 1);
+
+    low_pass_filter::BatchTuning cached = low_pass_filter::calibrate_batch(cache.c_str());
+    EXPECT_TRUE(cached.from_cache);
+    EXPECT_EQ(cached.isa, measured.isa);
+    EXPECT_EQ(cached.batch_size, measured.batch_size);
+    EXPECT_EQ(cached.threads, measured.threads);
+
+    low_pass_filter::set_batch_isa(selected);
 }
 
-// ---- Parameterized test ----
+// ---- Compile-time constants (low_pass_filter_fixed.h) ----
 
-class LowPassFilterTest : public ::testing::TestWithParam<TestCase> {};
+struct FixedAlpha { static constexpr double value = 0.3; };
 
-TEST_P(LowPassFilterTest, MatchesExpectedOutput) {
-    const auto& tc = GetParam();
-    int n = static_cast<int>(tc.input_signal.size());
+TEST(LowPassFilterHarness, FixedMatchesRuntime) {
+    for (const auto& tc : LoadCases()) {
+        const std::vector<double>& in = tc.inputs[0];
+        int n = static_cast<int>(in.size());
+        std::vector<double> out(in.size()), fixed_out(in.size());
+        low_pass_filter::low_pass_filter(in.data(), FixedAlpha::value, n, out.data());
+        low_pass_filter::low_pass_filter_fixed<FixedAlpha>(in.data(), n, fixed_out.data());
+        EXPECT_EQ(0, std::memcmp(out.data(), fixed_out.data(), out.size() * sizeof(double))) << tc.name;
+    }
+}
 
-    // Allocate output buffer
-    std::vector<double> output_signal(n, 0.0);
+// ---- Strided views (low_pass_filter_strided.h) ----
 
-    // Call generated C++ function
-    low_pass_filter::low_pass_filter(
-        tc.input_signal.data(), tc.alpha, n, output_signal.data());
+// An interleaved record, with a field of another type in between
+struct Sample {
+    double raw;
+    float gain;
+    double filtered;
+};
 
-    // Validate output
-    for (int i = 0; i < n; i++) {
-        EXPECT_NEAR(output_signal[i], tc.expected_output_signal[i], tc.abs_tolerance)
-            << "Output mismatch at index " << i
-            << " in test case: " << tc.name;
+TEST(LowPassFilterHarness, StridedMatchesContiguous) {
+    for (const auto& tc : LoadCases()) {
+        const std::vector<double>& in = tc.inputs[0];
+        const double alpha = tc.inputs[1][0];
+        std::vector<double> out(in.size());
+        low_pass_filter::low_pass_filter(in.data(), alpha, static_cast<int>(in.size()), out.data());
+
+        std::vector<Sample> frame(in.size());
+        for (size_t k = 0; k < in.size(); k++) frame[k] = {in[k], 1.0f, 0.0};
+        low_pass_filter::low_pass_filter(runtime::field(frame, &Sample::raw), alpha,
+                                         runtime::field(frame, &Sample::filtered));
+        for (size_t k = 0; k < in.size(); k++) {
+            EXPECT_EQ(frame[k].filtered, out[k]) << tc.name << " sample " << k;
+            EXPECT_EQ(frame[k].raw, in[k]) << tc.name << " sample " << k;
+        }
+
+        // In place, strided and contiguous
+        low_pass_filter::low_pass_filter(runtime::field(frame, &Sample::raw), alpha,
+                                         runtime::field(frame, &Sample::raw));
+        std::vector<double> signal = in;
+        low_pass_filter::low_pass_filter(signal, alpha, signal);
+        for (size_t k = 0; k < in.size(); k++) {
+            EXPECT_EQ(frame[k].raw, out[k]) << tc.name << " sample " << k;
+            EXPECT_EQ(signal[k], out[k]) << tc.name << " sample " << k;
+        }
     }
+    std::vector<double> a(4), b(3);
+    EXPECT_THROW(low_pass_filter::low_pass_filter(a, 0.5, b), std::invalid_argument);
 }
 
-INSTANTIATE_TEST_SUITE_P(
-    TestVectors,
-    LowPassFilterTest,
-    ::testing::ValuesIn(LoadTestVectors(TEST_VECTORS_DIR)),
-    TestCaseName
-);
+// ---- Fuzz comparison (harness/fuzz_engine.h) ----
+
+// A reference that overflows to infinity only matches the same infinity
+TEST(LowPassFilterHarness, FuzzComparisonFailsFiniteAgainstInfiniteReference) {
+    const long double inf = std::numeric_limits<long double>::infinity();
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    harness::FuzzOptions opts;
+    harness::Values actual = {{1.0, double(inf), nan, 1e300, -double(inf)}};
+    harness::WideValues ref = {{1.0L, inf, static_cast<long double>(nan), inf, inf}};
+    std::vector<double> max_abs(1, 0.0), max_rel(1, 0.0);
+
+    harness::ErrorSample worst = harness::CompareToReference<Signature>(actual, ref, opts, &max_abs, &max_rel);
+    EXPECT_EQ(worst.excess, std::numeric_limits<double>::infinity());
+    EXPECT_EQ(worst.element, 3u);  // the first mismatch: finite against inf
+    EXPECT_EQ(max_abs[0], std::numeric_limits<double>::infinity());
+
+    // Same infinity and NaN on both sides are exact
+    actual[0].resize(3);
+    ref[0].resize(3);
+    worst = harness::CompareToReference<Signature>(actual, ref, opts);
+    EXPECT_EQ(worst.excess, 0.0);
+}
 
-// ---- Write outputs for equivalence comparison ----
+// ---- Plugin (low_pass_filter_plugin.h) ----
 
-class CppOutputWriter : public ::testing::Environment {
-public:
-    void TearDown() override {
-        auto cases = LoadTestVectors(TEST_VECTORS_DIR);
-        json outputs = json::array();
+#ifdef PLUGIN_PATH
 
+// Loaded plugin gives the generated function's results, bit for bit
+TEST(LowPassFilterHarness, PluginMatchesBuiltinAndRollsBack) {
+    runtime::PluginHost<low_pass_filter::Plugin> host;
+    auto cases = LoadCases();
+    auto matches = [&](const low_pass_filter_plugin& t) {
         for (const auto& tc : cases) {
-            int n = static_cast<int>(tc.input_signal.size());
-            std::vector<double> output_signal(n, 0.0);
-
-            low_pass_filter::low_pass_filter(
-                tc.input_signal.data(), tc.alpha, n, output_signal.data());
-
-            json result;
-            result["test_name"] = tc.name;
-            result["actual_output_signal"] = output_signal;
-            result["tolerance"] = tc.abs_tolerance;
-            outputs.push_back(result);
+            harness::Values out = harness::Run<Signature>(tc.inputs);
+            std::vector<double> result(out[0].size());
+            t.call(tc.inputs[0].data(), tc.inputs[1][0], static_cast<int>(tc.inputs[0].size()), result.data());
+            if (!result.empty() && std::memcmp(result.data(), out[0].data(), result.size() * sizeof(double)) != 0) {
+                return false;
+            }
         }
+        return true;
+    };
+    ASSERT_TRUE(host.Load(PLUGIN_PATH, matches)) << host.error();
+    EXPECT_NE(&host.table(), low_pass_filter::Plugin::Builtin());
+    EXPECT_EQ(host.version(), low_pass_filter::Plugin::Builtin()->info.version);
+    EXPECT_TRUE(matches(host.table()));
+    ASSERT_TRUE(host.Rollback());
+    EXPECT_EQ(&host.table(), low_pass_filter::Plugin::Builtin());
+}
 
-        // Write to output directory
-        fs::path output_dir(OUTPUT_DIR);
-        fs::create_directories(output_dir);
-        std::ofstream f(output_dir / "cpp_outputs.json");
-        f << outputs.dump(2);
-    }
-};
+#endif // PLUGIN_PATH
+
+// ---- Write outputs for equivalence comparison ----
 
-// Register the output writer
 testing::Environment* const output_env =
-    testing::AddGlobalTestEnvironment(new CppOutputWriter);
+    harness::RegisterOutputWriter<Signature>(LoadCases, OUTPUT_DIR);
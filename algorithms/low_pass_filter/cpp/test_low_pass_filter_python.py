@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+"""
+test_low_pass_filter_python.py
+
+Tests for the low_pass_filter extension module (low_pass_filter_python.cpp).
+Registered with ctest by cmake/PythonModule.cmake, which puts the built
+module on PYTHONPATH. Uses array.array and memoryview so it runs without
+NumPy; the NumPy cases are skipped when it is not installed.
+"""
+
+import array
+import threading
+import unittest
+
+import low_pass_filter as lpf
+
+try:
+    import numpy
+except ImportError:
+    numpy = None
+
+
+def reference(signal, alpha):
+    """Same arithmetic as the generated low_pass_filter()."""
+    out = []
+    for k, x in enumerate(signal):
+        out.append(x if k == 0 else alpha * x + (1.0 - alpha) * out[-1])
+    return out
+
+
+def doubles(values):
+    return array.array("d", values)
+
+
+class SignalTest(unittest.TestCase):
+    def test_matches_reference(self):
+        signal = [((7 * k) % 11) - 5.0 for k in range(200)]
+        self.assertEqual(list(lpf.low_pass_filter(signal, 0.3)), reference(signal, 0.3))
+        self.assertEqual(list(lpf.low_pass_filter(doubles(signal), 0.3)), reference(signal, 0.3))
+
+    def test_fills_given_output(self):
+        out = doubles([0.0] * 5)
+        self.assertIs(lpf.low_pass_filter(input_signal=[1, 2, 3, 4, 5], alpha=0.5, out=out), out)
+        self.assertEqual(list(out), reference([1, 2, 3, 4, 5], 0.5))
+        with self.assertRaises(ValueError):
+            lpf.low_pass_filter([1, 2, 3], 0.5, out=doubles([0.0] * 2))
+        with self.assertRaises(TypeError):
+            lpf.low_pass_filter([1, 2, 3], 0.5, out=[0.0] * 3)
+
+    def test_empty_signal(self):
+        self.assertEqual(len(lpf.low_pass_filter([], 0.5)), 0)
+
+    def test_threads_agree(self):
+        signal = doubles([float(k % 13) for k in range(100000)])
+        expected = bytes(lpf.low_pass_filter(signal, 0.2))
+        results = [None] * 4
+
+        def run(i):
+            results[i] = bytes(lpf.low_pass_filter(signal, 0.2))
+
+        threads = [threading.Thread(target=run, args=(i,)) for i in range(4)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        self.assertEqual(results, [expected] * 4)
+
+
+class BatchTest(unittest.TestCase):
+    def test_channels_match_single_signal(self):
+        n, channels = 50, 7
+        alpha = [0.1 + 0.1 * c for c in range(channels)]
+        interleaved = doubles([float((k * 3 + c) % 9) for k in range(n) for c in range(channels)])
+        out = lpf.low_pass_filter_batch(interleaved, alpha)
+        flat = memoryview(out).cast("B").cast("d")
+        self.assertEqual(len(flat), n * channels)
+        for c in range(channels):
+            channel = [interleaved[k * channels + c] for k in range(n)]
+            self.assertEqual([flat[k * channels + c] for k in range(n)], reference(channel, alpha[c]))
+
+    def test_length_must_be_a_multiple_of_channels(self):
+        with self.assertRaises(ValueError):
+            lpf.low_pass_filter_batch([1.0] * 10, [0.5] * 3)
+        with self.assertRaises(ValueError):
+            lpf.low_pass_filter_batch([1.0] * 10, [])
+
+
+@unittest.skipIf(numpy is None, "NumPy not installed")
+class NumpyTest(unittest.TestCase):
+    def test_batch_keeps_the_table_shape(self):
+        table = numpy.random.default_rng(1).normal(size=(100, 16))
+        out = lpf.low_pass_filter_batch(table, numpy.full(16, 0.25))
+        self.assertIsInstance(out, numpy.ndarray)
+        self.assertEqual(out.shape, (100, 16))
+        numpy.testing.assert_array_equal(out[:, 3], lpf.low_pass_filter(numpy.ascontiguousarray(table[:, 3]), 0.25))
+
+    def test_rejects_non_contiguous_columns(self):
+        table = numpy.zeros((100, 16))
+        with self.assertRaises(TypeError):
+            lpf.low_pass_filter(table[:, 3], 0.25)
+
+
+if __name__ == "__main__":
+    unittest.main(verbosity=2)
@@ -0,0 +1,127 @@
+#include "pid_controller_batch.h"
+
+#include <atomic>
+
+#include "pid_controller.h"
+#include "pid_controller_batch_kernels.h"
+
+namespace pid_controller {
+
+namespace kernels {
+
+void batch_portable(
+    int n,
+    const double error[],
+    double integral[],
+    double prev_error[],
+    const double kp[],
+    const double ki[],
+    const double kd[],
+    const double dt[],
+    double output[])
+{
+    for (int i = 0; i < n; i++) {
+        pid_controller(error[i], integral[i], prev_error[i], kp[i], ki[i], kd[i], dt[i],
+                       &output[i], &integral[i], &prev_error[i]);
+    }
+}
+
+} // namespace kernels
+
+// ---- Dispatch ----
+
+namespace {
+
+struct KernelEntry {
+    BatchIsa isa;
+    const char* name;
+    kernels::BatchFn fn;  // nullptr when not built for this target
+};
+
+#if defined(BATCH_X86_KERNELS)
+const KernelEntry kKernels[] = {
+    {BatchIsa::Portable, "portable", kernels::batch_portable},
+    {BatchIsa::Sse2, "sse2", kernels::batch_sse2},
+    {BatchIsa::Avx2, "avx2", kernels::batch_avx2},
+    {BatchIsa::Avx512, "avx512", kernels::batch_avx512},
+};
+#else
+const KernelEntry kKernels[] = {
+    {BatchIsa::Portable, "portable", kernels::batch_portable},
+    {BatchIsa::Sse2, "sse2", nullptr},
+    {BatchIsa::Avx2, "avx2", nullptr},
+    {BatchIsa::Avx512, "avx512", nullptr},
+};
+#endif
+
+bool CpuSupports(BatchIsa isa) {
+#if defined(BATCH_X86_KERNELS)
+    // May run from a static initializer, before libgcc has probed the CPU
+    __builtin_cpu_init();
+    switch (isa) {
+        case BatchIsa::Portable: return true;
+        case BatchIsa::Sse2: return __builtin_cpu_supports("sse2");
+        case BatchIsa::Avx2: return __builtin_cpu_supports("avx2");
+        case BatchIsa::Avx512: return __builtin_cpu_supports("avx512f");
+    }
+    return false;
+#else
+    return isa == BatchIsa::Portable;
+#endif
+}
+
+const KernelEntry& Entry(BatchIsa isa) {
+    return kKernels[static_cast<int>(isa)];
+}
+
+const KernelEntry* Best() {
+    for (int i = static_cast<int>(BatchIsa::Avx512); i > 0; i--) {
+        if (batch_isa_supported(static_cast<BatchIsa>(i))) return &kKernels[i];
+    }
+    return &kKernels[0];
+}
+
+std::atomic<const KernelEntry*>& Selected() {
+    static std::atomic<const KernelEntry*> selected{Best()};
+    return selected;
+}
+
+// Resolve when the library is loaded rather than on the first batch
+[[maybe_unused]] const bool kResolvedAtLoad = (Selected(), true);
+
+} // namespace
+
+BatchIsa batch_isa() {
+    return Selected().load(std::memory_order_relaxed)->isa;
+}
+
+const char* batch_isa_name(BatchIsa isa) {
+    return Entry(isa).name;
+}
+
+bool batch_isa_supported(BatchIsa isa) {
+    return Entry(isa).fn != nullptr && CpuSupports(isa);
+}
+
+bool set_batch_isa(BatchIsa isa) {
+    if (!batch_isa_supported(isa)) return false;
+    Selected().store(&Entry(isa), std::memory_order_relaxed);
+    return true;
+}
+
+void pid_controller_batch(
+    int n,
+    const double error[],
+    double integral[],
+    double prev_error[],
+    const double kp[],
+    const double ki[],
+    const double kd[],
+    const double dt[],
+    double output[])
+{
+    Selected().load(std::memory_order_relaxed)->fn(n, error, integral, prev_error, kp, ki, kd, dt,
+                                                   output);
+}
+
+} // namespace pid_controller
@@ -0,0 +1,72 @@
+#ifndef PID_CONTROLLER_BATCH_H
+#define PID_CONTROLLER_BATCH_H
+
+// Batch API for pid_controller (hand-written, ships in the package).
+//
+// Runs one control step for n independent loops stored as a structure of
+// arrays; the integral and previous-error state is updated in place. Every
+// loop gets exactly the result of the scalar pid_controller() — the
+// equivalence matrix in the C++ tests checks this bit for bit.
+//
+// The library carries SSE2, AVX2 and AVX-512 builds of the batch kernel
+// (x86-64 only) and picks the widest one the CPU supports when it is
+// loaded, so a package built for generic x86-64 still uses the host's
+// vector units. batch_isa() reports the choice.
+
+namespace pid_controller {
+
+// Inputs (arrays of n elements):
+//   error              - current error per loop
+//   kp, ki, kd, dt     - gains and time step per loop
+// Inputs/outputs (arrays of n elements, updated in place):
+//   integral           - accumulated integral (new_integral on return)
+//   prev_error         - previous error (new_prev_error on return)
+// Outputs (arrays of n elements):
+//   output             - control output per loop
+void pid_controller_batch(
+    int n,
+    const double error[],
+    double integral[],
+    double prev_error[],
+    const double kp[],
+    const double ki[],
+    const double kd[],
+    const double dt[],
+    double output[]);
+
+// Kernel builds behind pid_controller_batch(), narrowest first
+enum class BatchIsa { Portable, Sse2, Avx2, Avx512 };
+
+// Kernel in use by this process
+BatchIsa batch_isa();
+
+// "portable", "sse2", "avx2" or "avx512"
+const char* batch_isa_name(BatchIsa isa);
+
+// Whether this build contains `isa` and the CPU can run it
+bool batch_isa_supported(BatchIsa isa);
+
+// Switch kernels (tests, benchmarks). Returns false and keeps the current
+// kernel if `isa` is not supported. Not meant to race with running batches.
+bool set_batch_isa(BatchIsa isa);
+
+// Kernel, batch size and worker count chosen for this machine
+struct BatchTuning {
+    BatchIsa isa;
+    int batch_size;   // loops per pid_controller_batch() call
+    int threads;      // workers, each over a contiguous slice of the table
+    bool from_cache;  // read from the cache rather than measured
+};
+
+// Optional startup calibration. Times the kernels this CPU supports, then
+// batch sizes, then worker counts on a synthetic loop table (a fraction of
+// a second), switches to the fastest kernel and returns the choice. The
+// decision is cached per CPU model in `cache_path`, so later startups only
+// read the file: "" means $MATLAB_ALGORITHMS_CALIBRATION_CACHE or
+// ~/.cache/matlab_algorithms/batch_calibration.tsv, nullptr means no cache.
+// recalibrate = true measures even on a cache hit.
+BatchTuning calibrate_batch(const char* cache_path = "", bool recalibrate = false);
+
+} // namespace pid_controller
+
+#endif // PID_CONTROLLER_BATCH_H
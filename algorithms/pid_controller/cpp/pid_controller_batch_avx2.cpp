@@ -0,0 +1,25 @@
+// AVX2 kernel for pid_controller_batch(), 4 loops per vector. Built with
+// the ISA's -m flag and -ffp-contract=off; only called once the CPU check
+// in pid_controller_batch.cpp has passed.
+
+#include "pid_controller_batch_kernels.h"
+
+namespace pid_controller {
+namespace kernels {
+
+void batch_avx2(
+    int n,
+    const double error[],
+    double integral[],
+    double prev_error[],
+    const double kp[],
+    const double ki[],
+    const double kd[],
+    const double dt[],
+    double output[])
+{
+    BatchKernel<Vec4d>(n, error, integral, prev_error, kp, ki, kd, dt, output);
+}
+
+} // namespace kernels
+} // namespace pid_controller
@@ -0,0 +1,83 @@
+#ifndef PID_CONTROLLER_BATCH_KERNELS_H
+#define PID_CONTROLLER_BATCH_KERNELS_H
+
+// Instruction-set-specific kernels behind pid_controller_batch() (internal,
+// not installed).
+//
+// Each pid_controller_batch_<isa>.cpp is compiled with its own -m flags and
+// -ffp-contract=off, and instantiates BatchKernel with a vector of that
+// ISA's width. The vector body repeats the operations of
+// generated/pid_controller.cpp in the same order with no fused
+// multiply-add, so every lane rounds exactly like the scalar function; the
+// remainder calls the scalar function itself. If the generated code
+// changes, the equivalence matrix in the C++ tests fails until this is
+// updated.
+
+#include <cstring>
+
+namespace pid_controller {
+namespace kernels {
+
+using BatchFn = void (*)(int n, const double error[], double integral[], double prev_error[],
+                         const double kp[], const double ki[], const double kd[],
+                         const double dt[], double output[]);
+
+void batch_portable(int n, const double error[], double integral[], double prev_error[],
+                    const double kp[], const double ki[], const double kd[], const double dt[],
+                    double output[]);
+void batch_sse2(int n, const double error[], double integral[], double prev_error[],
+                const double kp[], const double ki[], const double kd[], const double dt[],
+                double output[]);
+void batch_avx2(int n, const double error[], double integral[], double prev_error[],
+                const double kp[], const double ki[], const double kd[], const double dt[],
+                double output[]);
+void batch_avx512(int n, const double error[], double integral[], double prev_error[],
+                  const double kp[], const double ki[], const double kd[], const double dt[],
+                  double output[]);
+
+typedef double Vec2d __attribute__((vector_size(16)));
+typedef double Vec4d __attribute__((vector_size(32)));
+typedef double Vec8d __attribute__((vector_size(64)));
+
+// Internal linkage: every kernel TU gets its own copy compiled for its ISA,
+// so the linker can never hand an AVX-512 instantiation to the SSE2 path.
+namespace {
+
+template <class V>
+inline V Load(const double* p) {
+    V v;
+    std::memcpy(&v, p, sizeof(V));
+    return v;
+}
+
+template <class V>
+inline void Store(double* p, V v) {
+    std::memcpy(p, &v, sizeof(V));
+}
+
+template <class V>
+inline void BatchKernel(int n, const double error[], double integral[], double prev_error[],
+                        const double kp[], const double ki[], const double kd[],
+                        const double dt[], double output[]) {
+    constexpr int kLanes = sizeof(V) / sizeof(double);
+    int i = 0;
+    for (; i + kLanes <= n; i += kLanes) {
+        V e = Load<V>(error + i);
+        V step = Load<V>(dt + i);
+        V new_integral = Load<V>(integral + i) + e * step;
+        V derivative = (e - Load<V>(prev_error + i)) / step;
+        Store(output + i, Load<V>(kp + i) * e + Load<V>(ki + i) * new_integral +
+                              Load<V>(kd + i) * derivative);
+        Store(integral + i, new_integral);
+        Store(prev_error + i, e);
+    }
+    batch_portable(n - i, error + i, integral + i, prev_error + i, kp + i, ki + i, kd + i, dt + i,
+                   output + i);
+}
+
+} // namespace
+
+} // namespace kernels
+} // namespace pid_controller
+
+#endif // PID_CONTROLLER_BATCH_KERNELS_H
@@ -0,0 +1,55 @@
+#include "pid_controller_batch.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "batch_calibration.h"
+
+namespace pid_controller {
+
+// calibrate_batch(): the measurement itself is runtime::CalibrateBatch()
+// (runtime/batch_calibration.h); this file supplies the kernel candidates
+// and a synthetic loop table to run them on.
+BatchTuning calibrate_batch(const char* cache_path, bool recalibrate)
+{
+    std::vector<BatchIsa> isas;
+    std::vector<std::string> names;
+    for (BatchIsa isa : {BatchIsa::Portable, BatchIsa::Sse2, BatchIsa::Avx2, BatchIsa::Avx512}) {
+        if (!batch_isa_supported(isa)) continue;
+        isas.push_back(isa);
+        names.push_back(batch_isa_name(isa));
+    }
+
+    runtime::CalibrationOptions opts;
+    opts.cache_path = cache_path ? cache_path : "-";
+    opts.recalibrate = recalibrate;
+
+    runtime::CalibrationResult r;
+    if (!runtime::LookupCalibration("pid_controller", names, opts, &r)) {
+        // Loops with a fixed error; integrators evolve in place across passes
+        const size_t n = opts.table_elements;
+        std::vector<double> error(n), integral(n, 0.0), prev_error(n, 0.0), output(n);
+        std::vector<double> kp(n, 1.0), ki(n, 0.1), kd(n, 0.05), dt(n, 0.01);
+        for (size_t i = 0; i < n; i++) error[i] = static_cast<double>(i % 21) - 10.0;
+
+        auto run = [&](int isa, int batch, size_t begin, size_t end) {
+            set_batch_isa(isas[isa]);
+            for (size_t i = begin; i < end; i += batch) {
+                int count = static_cast<int>(std::min<size_t>(batch, end - i));
+                pid_controller_batch(count, &error[i], &integral[i], &prev_error[i], &kp[i], &ki[i],
+                                     &kd[i], &dt[i], &output[i]);
+            }
+        };
+        r = runtime::CalibrateBatch("pid_controller", names, run, opts);
+    }
+
+    BatchTuning tuning{batch_isa(), r.batch_size, r.threads, r.from_cache};
+    for (size_t i = 0; i < isas.size(); i++) {
+        if (names[i] == r.isa) tuning.isa = isas[i];
+    }
+    set_batch_isa(tuning.isa);
+    return tuning;
+}
+
+} // namespace pid_controller
@@ -0,0 +1,46 @@
+#ifndef PID_CONTROLLER_FIXED_H
+#define PID_CONTROLLER_FIXED_H
+
+// pid_controller() with gains and time step fixed at compile time
+// (hand-written, header-only, ships in the package).
+//
+// Each parameter is a type carrying the constant, e.g.
+//
+//   struct Kp { static constexpr double value = 2.0; };
+//   ...
+//   struct Dt { static constexpr double value = 0.125; };
+//   pid_controller::pid_controller_fixed<Kp, Ki, Kd, Dt>(e, integral, prev, &u, &integral, &prev);
+//
+// (C++17 does not allow double template arguments.) The operations are the
+// generated code's in the same order, so the result is bit-identical to
+// pid_controller(e, integral, prev, Kp::value, ..., Dt::value, ...). When
+// 1 / dt is exact (dt a power of two) the compiler replaces the derivative's
+// division by a multiplication; otherwise the division stays, since a
+// rounded reciprocal would change the result (ReciprocalVariant in
+// pid_controller_variants.h measures by how much).
+
+namespace pid_controller {
+
+template <class Kp, class Ki, class Kd, class Dt>
+inline void pid_controller_fixed(
+    double error,
+    double integral,
+    double prev_error,
+    double* output,
+    double* new_integral,
+    double* new_prev_error)
+{
+    constexpr double kp = Kp::value;
+    constexpr double ki = Ki::value;
+    constexpr double kd = Kd::value;
+    constexpr double dt = Dt::value;
+
+    *new_integral = integral + error * dt;
+    double derivative = (error - prev_error) / dt;
+    *output = kp * error + ki * (*new_integral) + kd * derivative;
+    *new_prev_error = error;
+}
+
+} // namespace pid_controller
+
+#endif // PID_CONTROLLER_FIXED_H
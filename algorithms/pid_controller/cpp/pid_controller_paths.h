@@ -0,0 +1,131 @@
+#ifndef PID_CONTROLLER_PATHS_H
+#define PID_CONTROLLER_PATHS_H
+
+// Execution paths of pid_controller for the equivalence matrix: the scalar
+// function, pid_controller_batch() at several batch sizes, and batches
+// spread over 1..N threads, repeated for each SIMD kernel build the CPU
+// supports, plus the generated SoA wrappers.
+
+#include <string>
+#include <vector>
+
+#include "equivalence_matrix.h"
+#include "pid_controller_batch.h"
+#include "pid_controller_signature.h"
+#include "pid_controller_wrappers.h"
+#include "worker_pool.h"
+
+namespace pid_controller {
+
+// Test cases -> structure of arrays -> pid_controller_batch()
+struct BatchAdapter {
+    // Native batch layout; Call() may run repeatedly (the benchmark does)
+    struct Packed {
+        int n = 0;
+        harness::BatchArray error, integral, prev_error, kp, ki, kd, dt, output;
+
+        void Call() {
+            pid_controller_batch(n, error.data(), integral.data(), prev_error.data(), kp.data(),
+                                 ki.data(), kd.data(), dt.data(), output.data());
+        }
+    };
+
+    static Packed Pack(const std::vector<const harness::Values*>& in) {
+        Packed p;
+        p.n = static_cast<int>(in.size());
+        for (auto* a : {&p.error, &p.integral, &p.prev_error, &p.kp, &p.ki, &p.kd, &p.dt, &p.output}) {
+            a->resize(in.size());
+        }
+        for (size_t i = 0; i < in.size(); i++) {
+            const harness::Values& v = *in[i];
+            p.error[i] = v[0][0];
+            p.integral[i] = v[1][0];
+            p.prev_error[i] = v[2][0];
+            p.kp[i] = v[3][0];
+            p.ki[i] = v[4][0];
+            p.kd[i] = v[5][0];
+            p.dt[i] = v[6][0];
+        }
+        return p;
+    }
+
+    static void Unpack(const Packed& p, std::vector<harness::Values*>& out) {
+        for (size_t i = 0; i < out.size(); i++) {
+            harness::Values& r = *out[i];
+            r[0] = {p.output[i]};
+            r[1] = {p.integral[i]};
+            r[2] = {p.prev_error[i]};
+        }
+    }
+
+    static void Run(const std::vector<const harness::Values*>& in, std::vector<harness::Values*>& out) {
+        Packed p = Pack(in);
+        p.Call();
+        Unpack(p, out);
+    }
+};
+
+// Same layout through the generated pid_controller_soa() (Threads == 0) or
+// pid_controller_soa_parallel(), with the state arrays updated in place
+template <int Threads, bool Pooled = false>
+struct SoaAdapter {
+    struct Packed : BatchAdapter::Packed {
+        void Call() {
+            if (Threads == 0) {
+                pid_controller_soa(n, error.data(), integral.data(), prev_error.data(), kp.data(), ki.data(),
+                                   kd.data(), dt.data(), output.data(), integral.data(), prev_error.data());
+            } else if (Pooled) {
+                // One pool per harness thread, kept across calls
+                thread_local runtime::WorkerPool pool(Threads);
+                pid_controller_soa_parallel(n, error.data(), integral.data(), prev_error.data(), kp.data(),
+                                            ki.data(), kd.data(), dt.data(), output.data(), integral.data(),
+                                            prev_error.data(), pool);
+            } else {
+                pid_controller_soa_parallel(n, error.data(), integral.data(), prev_error.data(), kp.data(),
+                                            ki.data(), kd.data(), dt.data(), output.data(), integral.data(),
+                                            prev_error.data(), Threads);
+            }
+        }
+    };
+
+    static Packed Pack(const std::vector<const harness::Values*>& in) { return {BatchAdapter::Pack(in)}; }
+
+    static void Unpack(const Packed& p, std::vector<harness::Values*>& out) { BatchAdapter::Unpack(p, out); }
+
+    static void Run(const std::vector<const harness::Values*>& in, std::vector<harness::Values*>& out) {
+        Packed p = Pack(in);
+        p.Call();
+        Unpack(p, out);
+    }
+};
+
+// Unprefixed batch paths use the kernel picked at load time; the
+// "<isa>/" paths repeat them with each kernel this CPU can run pinned.
+inline std::vector<harness::ExecutionPath> ExecutionPaths() {
+    auto paths = harness::StandardPaths<Signature, BatchAdapter>();
+    const BatchIsa selected = batch_isa();
+    for (BatchIsa isa : {BatchIsa::Portable, BatchIsa::Sse2, BatchIsa::Avx2, BatchIsa::Avx512}) {
+        if (!batch_isa_supported(isa)) continue;
+        std::string prefix = std::string(batch_isa_name(isa)) + "/";
+        for (auto& path : harness::StandardPaths<Signature, BatchAdapter>(prefix)) {
+            paths.push_back(harness::ScopedPath(
+                std::move(path), [isa] { set_batch_isa(isa); }, [selected] { set_batch_isa(selected); }));
+        }
+    }
+
+    // Generated wrappers (pid_controller_wrappers.h) over the same cases; the
+    // parallel wrapper splits each call over 3 threads, started per call or
+    // kept in a runtime::WorkerPool
+    for (auto& path : harness::StandardPaths<Signature, SoaAdapter<0>>("soa/")) {
+        paths.push_back(std::move(path));
+    }
+    for (size_t b : {3, 64}) {
+        paths.push_back(harness::BatchPath<Signature, SoaAdapter<3>>(b, "soa_parallel/"));
+        paths.push_back(harness::BatchPath<Signature, SoaAdapter<3, true>>(b, "soa_pool/"));
+    }
+    return paths;
+}
+
+} // namespace pid_controller
+
+#endif // PID_CONTROLLER_PATHS_H
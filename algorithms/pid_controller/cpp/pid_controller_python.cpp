@@ -0,0 +1,138 @@
+/**
+ * Python bindings for pid_controller (hand-written; built as the
+ * `pid_controller` extension module by cmake/PythonModule.cmake).
+ *
+ *   pid_controller(error, integral, prev_error, kp, ki, kd, dt)
+ *       -> (output, new_integral, new_prev_error)
+ *   pid_controller_batch(error, integral, prev_error, kp, ki, kd, dt, out=None)
+ *       -> output[n]; one step for n loops, integral and prev_error
+ *       updated in place (pid_controller_batch())
+ *   pid_controller_sequence(errors, integral, prev_error, kp, ki, kd, dt, out=None)
+ *       -> (outputs[n], integral, prev_error), one loop over an error series
+ *       (pid_controller_trace() in pid_controller_strided.h)
+ *   batch_isa() -> "portable" | "sse2" | "avx2" | "avx512"
+ *
+ * Arrays are used in place (python/python_buffer.h) and the GIL is
+ * released while C++ runs, so Python threads can run loops concurrently.
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include "pid_controller.h"
+#include "pid_controller_batch.h"
+#include "pid_controller_strided.h"
+#include "python_buffer.h"
+
+namespace {
+
+using python_buffer::DoubleArray;
+
+// `out` when given (filled in place, returned as given), else a new array
+PyObject* Output(PyObject* out_obj, Py_ssize_t n, DoubleArray& out) {
+    if (out_obj == Py_None) return python_buffer::NewArray({n}, out, "out");
+    if (!out.Parse(out_obj, "out", true) || !python_buffer::CheckSize(out, n)) return nullptr;
+    Py_INCREF(out_obj);
+    return out_obj;
+}
+
+PyObject* PidController(PyObject*, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"error", "integral", "prev_error", "kp", "ki", "kd", "dt", nullptr};
+    double error, integral, prev_error, kp, ki, kd, dt;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "ddddddd", const_cast<char**>(keywords), &error, &integral,
+                                     &prev_error, &kp, &ki, &kd, &dt)) {
+        return nullptr;
+    }
+    double output, new_integral, new_prev_error;
+    Py_BEGIN_ALLOW_THREADS
+    pid_controller::pid_controller(error, integral, prev_error, kp, ki, kd, dt, &output, &new_integral,
+                                   &new_prev_error);
+    Py_END_ALLOW_THREADS
+    return Py_BuildValue("(ddd)", output, new_integral, new_prev_error);
+}
+
+PyObject* PidControllerBatch(PyObject*, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"error", "integral", "prev_error", "kp", "ki", "kd", "dt", "out", nullptr};
+    PyObject* objs[7];
+    PyObject* out_obj = Py_None;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OOOOOOO|O", const_cast<char**>(keywords), &objs[0],
+                                     &objs[1], &objs[2], &objs[3], &objs[4], &objs[5], &objs[6], &out_obj)) {
+        return nullptr;
+    }
+    DoubleArray a[7], out;
+    for (int i = 0; i < 7; i++) {
+        if (!a[i].Parse(objs[i], keywords[i], i == 1 || i == 2)) return nullptr;  // state in place
+    }
+    if (!python_buffer::CheckSameSize({&a[0], &a[1], &a[2], &a[3], &a[4], &a[5], &a[6]}) ||
+        !python_buffer::CheckIntSize(a[0].size())) {
+        return nullptr;
+    }
+    const Py_ssize_t n = a[0].size();
+    PyObject* result = Output(out_obj, n, out);
+    if (!result) return nullptr;
+    Py_BEGIN_ALLOW_THREADS
+    pid_controller::pid_controller_batch(static_cast<int>(n), a[0].data(), a[1].data(), a[2].data(), a[3].data(),
+                                         a[4].data(), a[5].data(), a[6].data(), out.data());
+    Py_END_ALLOW_THREADS
+    return result;
+}
+
+PyObject* PidControllerSequence(PyObject*, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"errors", "integral", "prev_error", "kp", "ki", "kd", "dt", "out", nullptr};
+    PyObject *errors_obj, *out_obj = Py_None;
+    double integral, prev_error, kp, ki, kd, dt;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "Odddddd|O", const_cast<char**>(keywords), &errors_obj,
+                                     &integral, &prev_error, &kp, &ki, &kd, &dt, &out_obj)) {
+        return nullptr;
+    }
+    DoubleArray errors, out;
+    if (!errors.Parse(errors_obj, "errors", false)) return nullptr;
+    const Py_ssize_t n = errors.size();
+    PyObject* result = Output(out_obj, n, out);
+    if (!result) return nullptr;
+    // Same size as errors, so pid_controller_trace() does not throw
+    Py_BEGIN_ALLOW_THREADS
+    pid_controller::pid_controller_trace({errors.data(), static_cast<size_t>(n)}, integral, prev_error, kp, ki,
+                                         kd, dt, {out.data(), static_cast<size_t>(n)});
+    Py_END_ALLOW_THREADS
+    return Py_BuildValue("(Ndd)", result, integral, prev_error);
+}
+
+PyObject* BatchIsa(PyObject*, PyObject*) {
+    return PyUnicode_FromString(pid_controller::batch_isa_name(pid_controller::batch_isa()));
+}
+
+PyMethodDef kMethods[] = {
+    {"pid_controller", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(PidController)),
+     METH_VARARGS | METH_KEYWORDS,
+     "pid_controller(error, integral, prev_error, kp, ki, kd, dt)\n"
+     "-> (output, new_integral, new_prev_error)\n\nOne control step."},
+    {"pid_controller_batch", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(PidControllerBatch)),
+     METH_VARARGS | METH_KEYWORDS,
+     "pid_controller_batch(error, integral, prev_error, kp, ki, kd, dt, out=None) -> output\n\n"
+     "One step for n independent loops. integral and prev_error are updated in place."},
+    {"pid_controller_sequence", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(PidControllerSequence)),
+     METH_VARARGS | METH_KEYWORDS,
+     "pid_controller_sequence(errors, integral, prev_error, kp, ki, kd, dt, out=None)\n"
+     "-> (outputs, integral, prev_error)\n\n"
+     "Runs one loop over an error series and returns its outputs and final state."},
+    {"batch_isa", BatchIsa, METH_NOARGS, "Kernel used by pid_controller_batch()."},
+    {nullptr, nullptr, 0, nullptr},
+};
+
+PyModuleDef kModule = {
+    PyModuleDef_HEAD_INIT,
+    "pid_controller",  // m_name
+    // m_doc
+    "pid_controller bindings: float64 arrays in place, GIL released during the C++ calls.",
+    -1,  // m_size
+    kMethods,  // m_methods
+    nullptr,  // m_slots
+    nullptr,  // m_traverse
+    nullptr,  // m_clear
+    nullptr,  // m_free
+};
+
+} // namespace
+
+PyMODINIT_FUNC PyInit_pid_controller() { return PyModule_Create(&kModule); }
@@ -0,0 +1,56 @@
+#ifndef PID_CONTROLLER_REFERENCE_H
+#define PID_CONTROLLER_REFERENCE_H
+
+// Precision-generic transcription of generated/pid_controller.cpp.
+//
+// Same operations in the same order as the generated code, evaluated in T.
+// With T = long double it is the high-precision reference for the fuzz
+// engine; other instantiations (e.g. float) model reduced-precision builds.
+
+#include <vector>
+
+#include "algorithm_harness.h"
+#include "pid_controller_signature.h"
+
+namespace pid_controller {
+
+template <typename T>
+void pid_controller_reference(
+    T error,
+    T integral,
+    T prev_error,
+    T kp,
+    T ki,
+    T kd,
+    T dt,
+    T* output,
+    T* new_integral,
+    T* new_prev_error)
+{
+    *new_integral = integral + error * dt;
+    T derivative = (error - prev_error) / dt;
+    *output = kp * error + ki * (*new_integral) + kd * derivative;
+    *new_prev_error = error;
+}
+
+// Reference descriptor for the fuzz engine and error analyzer (same field
+// layout as Signature).
+struct Reference {
+    using Signature = pid_controller::Signature;
+
+    static void Invoke(const harness::Values& in, harness::WideValues& out) {
+        Evaluate<long double>(in, out);
+    }
+
+    // Evaluate in T (outputs must be sized, e.g. by harness::ResizeOutputs)
+    template <typename T>
+    static void Evaluate(const harness::Values& in, std::vector<std::vector<T>>& out) {
+        pid_controller_reference<T>(T(in[0][0]), T(in[1][0]), T(in[2][0]), T(in[3][0]),
+                                    T(in[4][0]), T(in[5][0]), T(in[6][0]),
+                                    &out[0][0], &out[1][0], &out[2][0]);
+    }
+};
+
+} // namespace pid_controller
+
+#endif // PID_CONTROLLER_REFERENCE_H
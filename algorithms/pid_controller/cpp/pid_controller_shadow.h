@@ -0,0 +1,59 @@
+#ifndef PID_CONTROLLER_SHADOW_H
+#define PID_CONTROLLER_SHADOW_H
+
+// pid_controller() calls for shadow execution of a candidate version
+// (runtime/shadow_runner.h; hand-written, header-only, ships in the
+// package and needs algorithm_runtime).
+//
+// A call is flattened to 7 inputs and 3 outputs in the test-vector field
+// order:
+//
+//   inputs   error, integral, prev_error, kp, ki, kd, dt
+//   outputs  output, new_integral, new_prev_error
+//
+// On the live path, after the live call:
+//
+//   shadow.Offer([&](double* in, double* live) {
+//       pid_controller::shadow_pack(e, i, p, kp, ki, kd, dt, u, new_i, new_p, in, live);
+//   });
+//
+// shadow_call() runs this build on a flattened call; it is the candidate
+// when this build is the version on trial, loaded next to the live one.
+// The comparison tolerance of the test vectors is read by
+// shadow_tolerance() in pid_controller_shadow_tolerance.h, kept apart so this
+// header stays free of JSON parsing.
+
+#include "pid_controller.h"
+#include "shadow_runner.h"
+
+namespace pid_controller {
+
+constexpr size_t kShadowInputs = 7;
+constexpr size_t kShadowOutputs = 3;
+
+using ShadowRunner = runtime::ShadowRunner<kShadowInputs, kShadowOutputs>;
+
+inline void shadow_pack(double error, double integral, double prev_error,
+                        double kp, double ki, double kd, double dt,
+                        double output, double new_integral, double new_prev_error,
+                        double* inputs, double* outputs) {
+    inputs[0] = error;
+    inputs[1] = integral;
+    inputs[2] = prev_error;
+    inputs[3] = kp;
+    inputs[4] = ki;
+    inputs[5] = kd;
+    inputs[6] = dt;
+    outputs[0] = output;
+    outputs[1] = new_integral;
+    outputs[2] = new_prev_error;
+}
+
+inline void shadow_call(const double* inputs, double* outputs) {
+    pid_controller(inputs[0], inputs[1], inputs[2], inputs[3], inputs[4], inputs[5], inputs[6],
+                   &outputs[0], &outputs[1], &outputs[2]);
+}
+
+} // namespace pid_controller
+
+#endif // PID_CONTROLLER_SHADOW_H
@@ -0,0 +1,23 @@
+#ifndef PID_CONTROLLER_SHADOW_TOLERANCE_H
+#define PID_CONTROLLER_SHADOW_TOLERANCE_H
+
+// The test vectors' tolerance for shadow comparisons of pid_controller()
+// (pid_controller_shadow.h; hand-written, header-only, ships in the package).
+// Reads JSON through runtime/shadow_tolerance.h, so it also needs
+// nlohmann_json; include it where the vector file is read, not next to
+// the live path.
+
+#include <string>
+
+#include "shadow_tolerance.h"
+
+namespace pid_controller {
+
+// The global_tolerance of a test-vector file (test_vectors/nominal.json)
+inline runtime::ShadowTolerance shadow_tolerance(const std::string& vector_file) {
+    return runtime::read_shadow_tolerance(vector_file);
+}
+
+} // namespace pid_controller
+
+#endif // PID_CONTROLLER_SHADOW_TOLERANCE_H
@@ -0,0 +1,57 @@
+#ifndef PID_CONTROLLER_STRIDED_H
+#define PID_CONTROLLER_STRIDED_H
+
+// pid_controller() over an error trace on strided views (hand-written,
+// header-only, ships in the package and needs algorithm_runtime for
+// runtime/strided_span.h).
+//
+// Runs one loop through a trace of errors, reading them from and writing
+// the control outputs to fields of interleaved records in place:
+//
+//   struct Sample { double t, error, control; };
+//   pid_controller::pid_controller_trace(runtime::field(frame, &Sample::error), integral,
+//                                        prev_error, kp, ki, kd, dt,
+//                                        runtime::field(frame, &Sample::control));
+//
+// Each step is one pid_controller() call, so the outputs are
+// bit-identical to chaining the calls by hand (or to Stream in
+// pid_controller_wrappers.h). The output may be the error's own view.
+
+#include <stdexcept>
+
+#include "pid_controller.h"
+#include "strided_span.h"
+
+namespace pid_controller {
+
+// integral and prev_error are the loop state before the first error and
+// are updated in place to the state after the last one, ready for the
+// next frame. output[k] receives the control for error[k].
+inline void pid_controller_trace(
+    runtime::StridedSpan<const double> error,
+    double& integral,
+    double& prev_error,
+    double kp,
+    double ki,
+    double kd,
+    double dt,
+    runtime::StridedSpan<double> output)
+{
+    if (output.size() != error.size()) {
+        throw std::invalid_argument("pid_controller_trace: output and error differ in size");
+    }
+    for (size_t k = 0; k < error.size(); k++) {
+        double control;
+        double new_integral;
+        double new_prev_error;
+        pid_controller(error[k], integral, prev_error, kp, ki, kd, dt, &control, &new_integral,
+                       &new_prev_error);
+        integral = new_integral;
+        prev_error = new_prev_error;
+        output[k] = control;
+    }
+}
+
+} // namespace pid_controller
+
+#endif // PID_CONTROLLER_STRIDED_H
@@ -0,0 +1,89 @@
+#ifndef PID_CONTROLLER_VARIANTS_H
+#define PID_CONTROLLER_VARIANTS_H
+
+// Candidate kernel variants of pid_controller for error analysis.
+//
+// Each variant computes the same step as generated/pid_controller.cpp with
+// a different rounding behaviour. The analyzer (ulp_pid_controller)
+// measures them against the long double reference.
+
+#include <cmath>
+#include <tuple>
+
+#include "pid_controller_reference.h"
+#include "variants.h"
+
+namespace pid_controller {
+
+// The generated step with its multiply-adds fused.
+inline void pid_controller_fma(
+    double error,
+    double integral,
+    double prev_error,
+    double kp,
+    double ki,
+    double kd,
+    double dt,
+    double* output,
+    double* new_integral,
+    double* new_prev_error)
+{
+    *new_integral = std::fma(error, dt, integral);
+    double derivative = (error - prev_error) / dt;
+    *output = std::fma(kd, derivative, std::fma(ki, *new_integral, kp * error));
+    *new_prev_error = error;
+}
+
+struct FmaVariant {
+    using Scalar = double;
+    static constexpr const char* kName = "fma";
+    static constexpr const char* kDescription = "Generated operation order with multiply-adds fused";
+
+    static void Invoke(const harness::Values& in, harness::Values& out) {
+        pid_controller_fma(in[0][0], in[1][0], in[2][0], in[3][0], in[4][0], in[5][0], in[6][0],
+                           &out[0][0], &out[1][0], &out[2][0]);
+    }
+};
+
+// The generated step with the derivative's division by dt replaced by a
+// multiply with 1 / dt, as a compiler would do for a constant dt under
+// -freciprocal-math. Exact only when dt is a power of two.
+inline void pid_controller_reciprocal(
+    double error,
+    double integral,
+    double prev_error,
+    double kp,
+    double ki,
+    double kd,
+    double dt,
+    double* output,
+    double* new_integral,
+    double* new_prev_error)
+{
+    double inv_dt = 1.0 / dt;
+    *new_integral = integral + error * dt;
+    double derivative = (error - prev_error) * inv_dt;
+    *output = kp * error + ki * (*new_integral) + kd * derivative;
+    *new_prev_error = error;
+}
+
+struct ReciprocalVariant {
+    using Scalar = double;
+    static constexpr const char* kName = "reciprocal";
+    static constexpr const char* kDescription = "Derivative through a multiply by 1 / dt";
+
+    static void Invoke(const harness::Values& in, harness::Values& out) {
+        pid_controller_reciprocal(in[0][0], in[1][0], in[2][0], in[3][0], in[4][0], in[5][0], in[6][0],
+                                  &out[0][0], &out[1][0], &out[2][0]);
+    }
+};
+
+using Variants = std::tuple<
+    harness::GeneratedVariant<Signature>,
+    FmaVariant,
+    ReciprocalVariant,
+    harness::PrecisionVariant<Reference, float>>;
+
+} // namespace pid_controller
+
+#endif // PID_CONTROLLER_VARIANTS_H
@@ -5,22 +5,34 @@
  * Reads the same JSON test vectors used by the MATLAB test harness,
  * runs the generated C++ function, and validates outputs within tolerance.
  *
- * Also writes cpp_outputs.json for equivalence comparison with MATLAB.
+ * Input/output mapping comes from pid_controller_signature.h; loading, parallel
+ * execution and output collection are shared (harness/). The vectors are
+ * embedded at build time (pid_controller_test_vectors.h); set HARNESS_VECTORS to a
+ * JSON directory or .tvb file to run other vectors ad hoc.
+ *
+ * Every execution path in pid_controller_paths.h (batch, threaded, each SIMD
+ * kernel) must match the scalar function bit for bit; the path x case
+ * matrix is written next to cpp_outputs.json, which is kept for
+ * equivalence comparison with MATLAB.
  */
 
 #include <gtest/gtest.h>
-#include <nlohmann/json.hpp>
-#include <filesystem>
-#include <fstream>
-#include <string>
-#include <vector>
-#include <cmath>
-
-// Generated header from MATLAB Coder
-#include "pid_controller.h"
 
-using json = nlohmann::json;
-namespace fs = std::filesystem;
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+#include "embedded_vectors.h"
+#include "gtest_harness.h"
+#include "pid_controller_fixed.h"
+#include "pid_controller_paths.h"
+#include "pid_controller_plugin.h"
+#include "pid_controller_shadow.h"
+#include "pid_controller_shadow_tolerance.h"
+#include "pid_controller_signature.h"
+#include "pid_controller_strided.h"
+#include "pid_controller_test_vectors.h"
+#include "plugin_host.h"
 
 #ifndef TEST_VECTORS_DIR
 #error "TEST_VECTORS_DIR must be defined at compile time"
@@ -30,157 +42,260 @@ namespace fs = std::filesystem;
 #define OUTPUT_DIR "."
 #endif
 
-// ---- Test case data structure ----
+using Signature = pid_controller::Signature;
 
-struct TestCase {
-    std::string name;
-    std::string description;
+static std::vector<harness::TestCase> LoadCases() {
+    return harness::LoadSelectedVectors<Signature>(
+        pid_controller::embedded::kCases, pid_controller::embedded::kCaseCount);
+}
 
-    // Inputs
-    double error;
-    double integral;
-    double prev_error;
-    double kp;
-    double ki;
-    double kd;
-    double dt;
-
-    // Expected outputs
-    double expected_output;
-    double expected_new_integral;
-    double expected_new_prev_error;
-
-    // Tolerance
-    double abs_tolerance;
-};
+// ---- Parameterized test ----
+
+using PidControllerTest = harness::VectorTest<Signature>;
 
-// For Google Test to print test case names
-std::string TestCaseName(const ::testing::TestParamInfo<TestCase>& info) {
-    return info.param.name;
+TEST_P(PidControllerTest, MatchesExpectedOutput) {
+    CheckExpectedOutput();
 }
 
-// ---- Load test vectors from JSON ----
+INSTANTIATE_TEST_SUITE_P(
+    TestVectors,
+    PidControllerTest,
+    ::testing::ValuesIn(LoadCases()),
+    harness::TestCaseName
+);
 
-std::vector<TestCase> LoadTestVectors(const std::string& dir) {
-    std::vector<TestCase> cases;
+// ---- Loading and execution paths ----
 
-    for (const auto& entry : fs::directory_iterator(dir)) {
-        if (entry.path().extension() != ".json") continue;
-        if (entry.path().filename() == "schema.json") continue;
+TEST(PidControllerHarness, EmbeddedMatchesJson) {
+    harness::ExpectSameCases(
+        harness::LoadTestVectors<Signature>(TEST_VECTORS_DIR),
+        harness::LoadEmbeddedVectors<Signature>(pid_controller::embedded::kCases, pid_controller::embedded::kCaseCount));
+}
 
-        std::ifstream f(entry.path());
-        if (!f.is_open()) continue;
+TEST(PidControllerHarness, ParallelMatchesSerial) {
+    harness::ExpectParallelMatchesSerial<Signature>(TEST_VECTORS_DIR);
+}
 
-        json data = json::parse(f);
+TEST(PidControllerHarness, BinaryRoundTrip) {
+    harness::ExpectBinaryRoundTrip<Signature>(TEST_VECTORS_DIR, OUTPUT_DIR);
+}
 
-        // Global tolerance defaults
-        double global_abs_tol = 1e-10;
-        if (data.contains("global_tolerance") &&
-            data["global_tolerance"].contains("absolute")) {
-            global_abs_tol = data["global_tolerance"]["absolute"].get<double>();
-        }
+TEST(PidControllerHarness, StreamingMatchesBulk) {
+    harness::ExpectStreamingMatchesBulk<Signature>(TEST_VECTORS_DIR);
+}
 
-        for (const auto& tc : data["test_cases"]) {
-            TestCase t;
-            t.name = tc["name"].get<std::string>();
-            t.description = tc.value("description", "");
-
-            // Parse inputs
-            t.error = tc["inputs"]["error"].get<double>();
-            t.integral = tc["inputs"]["integral"].get<double>();
-            t.prev_error = tc["inputs"]["prev_error"].get<double>();
-            t.kp = tc["inputs"]["kp"].get<double>();
-            t.ki = tc["inputs"]["ki"].get<double>();
-            t.kd = tc["inputs"]["kd"].get<double>();
-            t.dt = tc["inputs"]["dt"].get<double>();
-
-            // Parse expected outputs
-            t.expected_output = tc["expected_output"]["output"].get<double>();
-            t.expected_new_integral = tc["expected_output"]["new_integral"].get<double>();
-            t.expected_new_prev_error = tc["expected_output"]["new_prev_error"].get<double>();
-
-            // Per-case tolerance overrides global
-            t.abs_tolerance = global_abs_tol;
-            if (tc.contains("tolerance") && tc["tolerance"].contains("absolute")) {
-                t.abs_tolerance = tc["tolerance"]["absolute"].get<double>();
-            }
+// ---- Execution paths (scalar, batch sizes, threads, SIMD kernels, SoA wrappers) ----
 
-            cases.push_back(t);
-        }
+TEST(PidControllerHarness, AllExecutionPathsMatchScalar) {
+    harness::ExpectAllPathsEquivalent<Signature>(pid_controller::ExecutionPaths(), LoadCases(), OUTPUT_DIR);
+}
+
+// The load-time pick is the widest kernel this build and CPU support
+TEST(PidControllerHarness, BatchKernelIsWidestSupported) {
+    using pid_controller::BatchIsa;
+    BatchIsa selected = pid_controller::batch_isa();
+    std::cout << "pid_controller_batch kernel: " << pid_controller::batch_isa_name(selected) << "\n";
+    EXPECT_TRUE(pid_controller::batch_isa_supported(selected));
+    EXPECT_TRUE(pid_controller::batch_isa_supported(BatchIsa::Portable));
+    for (int i = static_cast<int>(selected) + 1; i <= static_cast<int>(BatchIsa::Avx512); i++) {
+        EXPECT_FALSE(pid_controller::batch_isa_supported(static_cast<BatchIsa>(i)));
+        EXPECT_FALSE(pid_controller::set_batch_isa(static_cast<BatchIsa>(i)));
     }
+    EXPECT_EQ(pid_controller::batch_isa(), selected);
+}
 
-    return cases;
+// ---- Startup calibration (pid_controller_batch.h) ----
+
+// Measures, switches kernel, caches; the second call only reads the cache
+TEST(PidControllerHarness, CalibrationPicksSupportedKernelAndCaches) {
+    const pid_controller::BatchIsa selected = pid_controller::batch_isa();
+    const std::string cache = std::string(OUTPUT_DIR) + "/pid_controller_batch_calibration.tsv";
+
+    pid_controller::BatchTuning measured = pid_controller::calibrate_batch(cache.c_str(), true);
+    std::cout << "calibrated: " << pid_controller::batch_isa_name(measured.isa) << ", batch "
+              << measured.batch_size << ", " << measured.threads << " thread(s)\n";
+    EXPECT_FALSE(measured.from_cache);
+    EXPECT_TRUE(pid_controller::batch_isa_supported(measured.isa));
+    EXPECT_EQ(pid_controller::batch_isa(), measured.isa);
+    EXPECT_GT(measured.batch_size, 0);
+    EXPECT_GE(measured.threads, 1);
+
+    pid_controller::BatchTuning cached = pid_controller::calibrate_batch(cache.c_str());
+    EXPECT_TRUE(cached.from_cache);
+    EXPECT_EQ(cached.isa, measured.isa);
+    EXPECT_EQ(cached.batch_size, measured.batch_size);
+    EXPECT_EQ(cached.threads, measured.threads);
+
+    pid_controller::set_batch_isa(selected);
 }
 
-// ---- Parameterized test ----
+// ---- Generated wrappers (pid_controller_wrappers.h) ----
+
+// Stream feeds new_integral/new_prev_error back into the next step
+TEST(PidControllerHarness, StreamMatchesChainedCalls) {
+    auto cases = LoadCases();
+    double integral = cases.front().inputs[1][0];
+    double prev_error = cases.front().inputs[2][0];
+    pid_controller::Stream stream(integral, prev_error);
+    for (const auto& tc : cases) {
+        const harness::Values& v = tc.inputs;
+        double output, next_integral, next_prev_error;
+        pid_controller::pid_controller(v[0][0], integral, prev_error, v[3][0], v[4][0], v[5][0], v[6][0],
+                                       &output, &next_integral, &next_prev_error);
+        integral = next_integral;
+        prev_error = next_prev_error;
+        stream.step(v[0][0], v[3][0], v[4][0], v[5][0], v[6][0]);
+        EXPECT_EQ(stream.output(), output) << tc.name;
+        EXPECT_EQ(stream.integral(), integral) << tc.name;
+        EXPECT_EQ(stream.prev_error(), prev_error) << tc.name;
+    }
+}
 
-class PidControllerTest : public ::testing::TestWithParam<TestCase> {};
+// ---- Compile-time constants (pid_controller_fixed.h) ----
+
+struct FixedKp { static constexpr double value = 2.0; };
+struct FixedKi { static constexpr double value = 0.5; };
+struct FixedKd { static constexpr double value = 0.1; };
+struct FixedDt { static constexpr double value = 0.01; };
+struct FixedDtPow2 { static constexpr double value = 0.125; };  // division becomes a multiply
+
+template <class Dt>
+void ExpectFixedMatchesRuntime(const std::vector<harness::TestCase>& cases) {
+    for (const auto& tc : cases) {
+        const harness::Values& v = tc.inputs;
+        double r[3], f[3];
+        pid_controller::pid_controller(v[0][0], v[1][0], v[2][0], FixedKp::value, FixedKi::value, FixedKd::value,
+                                       Dt::value, &r[0], &r[1], &r[2]);
+        pid_controller::pid_controller_fixed<FixedKp, FixedKi, FixedKd, Dt>(v[0][0], v[1][0], v[2][0],
+                                                                             &f[0], &f[1], &f[2]);
+        EXPECT_EQ(0, std::memcmp(r, f, sizeof r)) << tc.name << " dt=" << Dt::value;
+    }
+}
 
-TEST_P(PidControllerTest, MatchesExpectedOutput) {
-    const auto& tc = GetParam();
+TEST(PidControllerHarness, FixedMatchesRuntime) {
+    auto cases = LoadCases();
+    ExpectFixedMatchesRuntime<FixedDt>(cases);
+    ExpectFixedMatchesRuntime<FixedDtPow2>(cases);
+}
 
-    // Output variables
-    double output = 0.0;
-    double new_integral = 0.0;
-    double new_prev_error = 0.0;
+// ---- Strided views (pid_controller_strided.h) ----
 
-    // Call generated C++ function
-    pid_controller::pid_controller(
-        tc.error, tc.integral, tc.prev_error,
-        tc.kp, tc.ki, tc.kd, tc.dt,
-        &output, &new_integral, &new_prev_error);
+struct Sample {
+    double t;
+    double error;
+    double control;
+};
 
-    // Validate outputs
-    EXPECT_NEAR(output, tc.expected_output, tc.abs_tolerance)
-        << "Output mismatch in test case: " << tc.name;
-    EXPECT_NEAR(new_integral, tc.expected_new_integral, tc.abs_tolerance)
-        << "Integral mismatch in test case: " << tc.name;
-    EXPECT_NEAR(new_prev_error, tc.expected_new_prev_error, tc.abs_tolerance)
-        << "Prev error mismatch in test case: " << tc.name;
+TEST(PidControllerHarness, TraceMatchesStream) {
+    for (const auto& tc : LoadCases()) {
+        const harness::Values& v = tc.inputs;
+        std::vector<Sample> frame(64);
+        for (size_t k = 0; k < frame.size(); k++) frame[k] = {0.1 * k, v[0][0] - 0.05 * k, 0.0};
+
+        pid_controller::Stream stream(v[1][0], v[2][0]);
+        double integral = v[1][0], prev_error = v[2][0];
+        pid_controller::pid_controller_trace(runtime::field(frame, &Sample::error), integral, prev_error,
+                                             v[3][0], v[4][0], v[5][0], v[6][0],
+                                             runtime::field(frame, &Sample::control));
+        for (size_t k = 0; k < frame.size(); k++) {
+            stream.step(frame[k].error, v[3][0], v[4][0], v[5][0], v[6][0]);
+            EXPECT_EQ(frame[k].control, stream.output()) << tc.name << " step " << k;
+        }
+        EXPECT_EQ(integral, stream.integral()) << tc.name;
+        EXPECT_EQ(prev_error, stream.prev_error()) << tc.name;
+    }
+    std::vector<double> error(4), output(3);
+    double integral = 0.0, prev_error = 0.0;
+    EXPECT_THROW(pid_controller::pid_controller_trace(error, integral, prev_error, 1, 0, 0, 0.1, output),
+                 std::invalid_argument);
 }
 
-INSTANTIATE_TEST_SUITE_P(
-    TestVectors,
-    PidControllerTest,
-    ::testing::ValuesIn(LoadTestVectors(TEST_VECTORS_DIR)),
-    TestCaseName
-);
+// ---- Shadow execution (pid_controller_shadow.h) ----
+
+// The flattened call is the vector fields in order, and shadow_call() is
+// the function itself
+TEST(PidControllerHarness, ShadowCallMatchesFunction) {
+    for (const auto& tc : LoadCases()) {
+        double in[pid_controller::kShadowInputs], live[pid_controller::kShadowOutputs];
+        harness::Values out = harness::Run<Signature>(tc.inputs);
+        const harness::Values& v = tc.inputs;
+        pid_controller::shadow_pack(v[0][0], v[1][0], v[2][0], v[3][0], v[4][0], v[5][0], v[6][0],
+                                    out[0][0], out[1][0], out[2][0], in, live);
+        std::vector<double> flat;
+        for (const auto& field : tc.inputs) flat.insert(flat.end(), field.begin(), field.end());
+        EXPECT_EQ(flat, std::vector<double>(in, in + pid_controller::kShadowInputs)) << tc.name;
+
+        double shadow[pid_controller::kShadowOutputs];
+        pid_controller::shadow_call(in, shadow);
+        EXPECT_EQ(0, std::memcmp(shadow, live, sizeof shadow)) << tc.name;
+    }
+}
 
-// ---- Write outputs for equivalence comparison ----
+TEST(PidControllerHarness, ShadowOfSameBuildAgreesAndPerturbedDiverges) {
+    runtime::ShadowOptions opts;
+    opts.sample_fraction = 1.0;
+    opts.budget_ns = 0;
+    opts.tolerance = pid_controller::shadow_tolerance(std::string(TEST_VECTORS_DIR) + "/nominal.json");
+    EXPECT_EQ(opts.tolerance.absolute, 1e-10);
+    EXPECT_EQ(opts.tolerance.relative, 1e-8);
+
+    pid_controller::ShadowRunner same(pid_controller::shadow_call, opts);
+    pid_controller::ShadowRunner perturbed(
+        [](const double* in, double* out) {
+            pid_controller::shadow_call(in, out);
+            out[pid_controller::kShadowOutputs - 1] += 1e-3;
+        },
+        opts);
+    auto cases = LoadCases();
+    for (const auto& tc : cases) {
+        harness::Values out = harness::Run<Signature>(tc.inputs);
+        auto fill = [&](double* in, double* live) {
+            const harness::Values& v = tc.inputs;
+            pid_controller::shadow_pack(v[0][0], v[1][0], v[2][0], v[3][0], v[4][0], v[5][0], v[6][0],
+                                        out[0][0], out[1][0], out[2][0], in, live);
+        };
+        same.Offer(fill);
+        perturbed.Offer(fill);
+    }
+    same.Stop();
+    perturbed.Stop();
+    EXPECT_TRUE(same.report().agrees());
+    EXPECT_EQ(same.report().compared, cases.size());
+    EXPECT_EQ(perturbed.report().diverged, cases.size());
+    EXPECT_EQ(perturbed.report().worst_output, static_cast<int>(pid_controller::kShadowOutputs) - 1);
+}
+
+// ---- Plugin (pid_controller_plugin.h) ----
 
-class CppOutputWriter : public ::testing::Environment {
-public:
-    void TearDown() override {
-        auto cases = LoadTestVectors(TEST_VECTORS_DIR);
-        json outputs = json::array();
+#ifdef PLUGIN_PATH
 
+// Loaded plugin gives the generated function's results, bit for bit
+TEST(PidControllerHarness, PluginMatchesBuiltinAndRollsBack) {
+    runtime::PluginHost<pid_controller::Plugin> host;
+    auto cases = LoadCases();
+    auto matches = [&](const pid_controller_plugin& t) {
         for (const auto& tc : cases) {
-            double output = 0.0;
-            double new_integral = 0.0;
-            double new_prev_error = 0.0;
-
-            pid_controller::pid_controller(
-                tc.error, tc.integral, tc.prev_error,
-                tc.kp, tc.ki, tc.kd, tc.dt,
-                &output, &new_integral, &new_prev_error);
-
-            json result;
-            result["test_name"] = tc.name;
-            result["actual_output"] = output;
-            result["actual_new_integral"] = new_integral;
-            result["actual_new_prev_error"] = new_prev_error;
-            result["tolerance"] = tc.abs_tolerance;
-            outputs.push_back(result);
+            harness::Values out = harness::Run<Signature>(tc.inputs);
+            double result[3];
+            t.call(tc.inputs[0][0], tc.inputs[1][0], tc.inputs[2][0], tc.inputs[3][0], tc.inputs[4][0],
+                   tc.inputs[5][0], tc.inputs[6][0], &result[0], &result[1], &result[2]);
+            for (int k = 0; k < 3; k++) {
+                if (std::memcmp(&result[k], &out[k][0], sizeof(double)) != 0) return false;
+            }
         }
+        return true;
+    };
+    ASSERT_TRUE(host.Load(PLUGIN_PATH, matches)) << host.error();
+    EXPECT_NE(&host.table(), pid_controller::Plugin::Builtin());
+    EXPECT_EQ(host.version(), pid_controller::Plugin::Builtin()->info.version);
+    EXPECT_TRUE(matches(host.table()));
+    ASSERT_TRUE(host.Rollback());
+    EXPECT_EQ(&host.table(), pid_controller::Plugin::Builtin());
+}
 
-        // Write to output directory
-        fs::path output_dir(OUTPUT_DIR);
-        fs::create_directories(output_dir);
-        std::ofstream f(output_dir / "cpp_outputs.json");
-        f << outputs.dump(2);
-    }
-};
+#endif // PLUGIN_PATH
+
+// ---- Write outputs for equivalence comparison ----
 
-// Register the output writer
 testing::Environment* const output_env =
-    testing::AddGlobalTestEnvironment(new CppOutputWriter);
+    harness::RegisterOutputWriter<Signature>(LoadCases, OUTPUT_DIR);
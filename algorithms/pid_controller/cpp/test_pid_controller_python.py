@@ -0,0 +1,109 @@
+#!/usr/bin/env python3
+"""
+test_pid_controller_python.py
+
+Tests for the pid_controller extension module (pid_controller_python.cpp).
+Registered with ctest by cmake/PythonModule.cmake, which puts the built
+module on PYTHONPATH. Uses array.array and memoryview so it runs without
+NumPy; the NumPy cases are skipped when it is not installed.
+"""
+
+import array
+import threading
+import unittest
+
+import pid_controller as pid
+
+try:
+    import numpy
+except ImportError:
+    numpy = None
+
+
+def reference(error, integral, prev_error, kp, ki, kd, dt):
+    """Same arithmetic as the generated pid_controller()."""
+    new_integral = integral + error * dt
+    derivative = (error - prev_error) / dt
+    return kp * error + ki * new_integral + kd * derivative, new_integral, error
+
+
+def doubles(values):
+    return array.array("d", values)
+
+
+class ScalarTest(unittest.TestCase):
+    def test_matches_reference(self):
+        args = (0.7, 0.2, 0.5, 1.0, 0.1, 0.05, 0.01)
+        self.assertEqual(pid.pid_controller(*args), reference(*args))
+        self.assertEqual(pid.pid_controller(error=0.7, integral=0.2, prev_error=0.5,
+                                            kp=1.0, ki=0.1, kd=0.05, dt=0.01), reference(*args))
+
+
+class BatchTest(unittest.TestCase):
+    def test_updates_state_in_place_like_scalar(self):
+        n = 29
+        error = doubles([0.1 * i - 1 for i in range(n)])
+        integral, prev_error = doubles([0.01 * i for i in range(n)]), doubles([0.0] * n)
+        gains = [doubles([1.0] * n), doubles([0.1] * n), doubles([0.05] * n), doubles([0.1] * n)]
+        expected = [reference(error[i], integral[i], prev_error[i], *(g[i] for g in gains)) for i in range(n)]
+        out = pid.pid_controller_batch(error, integral, prev_error, *gains)
+        for i, (output, new_integral, new_prev_error) in enumerate(expected):
+            self.assertEqual(out[i], output)
+            self.assertEqual(integral[i], new_integral)
+            self.assertEqual(prev_error[i], new_prev_error)
+
+    def test_fills_given_output(self):
+        out = doubles([0.0] * 3)
+        state = [doubles([0.0] * 3), doubles([0.0] * 3)]
+        self.assertIs(pid.pid_controller_batch([1, 2, 3], *state, [1] * 3, [0] * 3, [0] * 3, [1] * 3, out), out)
+        self.assertEqual(list(out), [1.0, 2.0, 3.0])
+
+    def test_rejects_bad_input(self):
+        with self.assertRaises(ValueError):
+            pid.pid_controller_batch([1, 2], doubles([0] * 3), doubles([0] * 3), [1] * 3, [0] * 3, [0] * 3, [1] * 3)
+        with self.assertRaises(TypeError):  # state must be updatable in place
+            pid.pid_controller_batch([1] * 3, [0] * 3, doubles([0] * 3), [1] * 3, [0] * 3, [0] * 3, [1] * 3)
+
+
+class SequenceTest(unittest.TestCase):
+    def test_matches_stepping(self):
+        errors = [((5 * k) % 7) - 3.0 for k in range(300)]
+        outputs, integral, prev_error = pid.pid_controller_sequence(errors, 0.0, 0.0, 1.0, 0.1, 0.05, 0.1)
+        i, p = 0.0, 0.0
+        for k, e in enumerate(errors):
+            output, i, p = reference(e, i, p, 1.0, 0.1, 0.05, 0.1)
+            self.assertEqual(outputs[k], output)
+        self.assertEqual((integral, prev_error), (i, p))
+
+    def test_threads_agree(self):
+        errors = doubles([float(k % 11) for k in range(100000)])
+        expected = pid.pid_controller_sequence(errors, 0.0, 0.0, 1.0, 0.1, 0.05, 0.1)
+        results = [None] * 4
+
+        def run(i):
+            results[i] = pid.pid_controller_sequence(errors, 0.0, 0.0, 1.0, 0.1, 0.05, 0.1)
+
+        threads = [threading.Thread(target=run, args=(i,)) for i in range(4)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        for outputs, integral, prev_error in results:
+            self.assertEqual(bytes(outputs), bytes(expected[0]))
+            self.assertEqual((integral, prev_error), expected[1:])
+
+
+@unittest.skipIf(numpy is None, "NumPy not installed")
+class NumpyTest(unittest.TestCase):
+    def test_batch_on_ndarrays(self):
+        n = 64
+        integral, prev_error = numpy.zeros(n), numpy.zeros(n)
+        out = pid.pid_controller_batch(numpy.ones(n), integral, prev_error, numpy.ones(n),
+                                       numpy.full(n, 0.5), numpy.zeros(n), numpy.full(n, 0.1))
+        self.assertIsInstance(out, numpy.ndarray)
+        numpy.testing.assert_array_equal(integral, numpy.full(n, 0.1))
+        numpy.testing.assert_allclose(out, numpy.full(n, 1.05))
+
+
+if __name__ == "__main__":
+    unittest.main(verbosity=2)
@@ -0,0 +1,185 @@
+# AlgorithmBundle.cmake
+#
+# Dependency ordering and the combined "all algorithms" library.
+#
+# Usage:
+#   read_algorithm_dependencies(<algorithm_dir> <out_var>)
+#   order_algorithms(<out_var> <algo_dir>...)
+#   add_algorithm_bundle(<target> ALGORITHMS <algo>...)
+#
+# read_algorithm_dependencies() returns the `dependencies:` list of
+# <algorithm_dir>/algorithm.yaml (flow `[a, b]` or block `- a` style).
+# order_algorithms() sorts algorithm directories (relative to the current
+# source dir) so every algorithm comes after the ones it depends on, and
+# fails on unknown dependencies and cycles.
+#
+# add_algorithm_bundle() builds one static library from the sources of the
+# given per-algorithm targets, which must be listed in dependency order.
+# The generated sources are compiled as a single unity translation unit,
+# so calls between algorithms can be inlined; the hand-written cpp/
+# sources (batch dispatch, per-ISA kernels with their own -m flags) stay
+# separate translation units. Everything is compiled with LTO where the
+# toolchain supports it, as fat objects so non-LTO consumers still link.
+# It also writes <target>.h, which includes every algorithm's headers
+# (scalar, batch, compile-time-constant and generated wrappers).
+
+include(CheckIPOSupported)
+
+# read_algorithm_dependencies(<algorithm_dir> <out_var>)
+function(read_algorithm_dependencies algorithm_dir out_var)
+    set(_deps "")
+    set(_yaml "${algorithm_dir}/algorithm.yaml")
+    if(EXISTS "${_yaml}")
+        file(STRINGS "${_yaml}" _lines)
+        set(_in_block FALSE)
+        foreach(_line IN LISTS _lines)
+            if(_line MATCHES "^dependencies:[ \t]*(.*)$")
+                string(REGEX REPLACE "#.*$" "" _rest "${CMAKE_MATCH_1}")
+                string(STRIP "${_rest}" _rest)
+                if(_rest MATCHES "^\\[(.*)\\]$")
+                    string(REPLACE "," ";" _items "${CMAKE_MATCH_1}")
+                    foreach(_item IN LISTS _items)
+                        string(REGEX REPLACE "[\"' \t]" "" _item "${_item}")
+                        if(_item)
+                            list(APPEND _deps "${_item}")
+                        endif()
+                    endforeach()
+                else()
+                    set(_in_block TRUE)
+                endif()
+            elseif(_in_block)
+                if(_line MATCHES "^[ \t]+-[ \t]*([^ \t#]+)")
+                    string(REGEX REPLACE "[\"']" "" _item "${CMAKE_MATCH_1}")
+                    list(APPEND _deps "${_item}")
+                elseif(NOT _line MATCHES "^[ \t]*(#.*)?$")
+                    set(_in_block FALSE)
+                endif()
+            endif()
+        endforeach()
+    endif()
+    set(${out_var} "${_deps}" PARENT_SCOPE)
+endfunction()
+
+# order_algorithms(<out_var> <algo_dir>...)
+function(order_algorithms out_var)
+    set(_known ${ARGN})
+    foreach(_algo IN LISTS _known)
+        read_algorithm_dependencies("${CMAKE_CURRENT_SOURCE_DIR}/${_algo}" _deps_${_algo})
+        foreach(_dep IN LISTS _deps_${_algo})
+            if(NOT _dep IN_LIST _known)
+                message(FATAL_ERROR "${_algo}/algorithm.yaml: unknown dependency '${_dep}'")
+            endif()
+        endforeach()
+    endforeach()
+
+    # Repeatedly take every algorithm whose dependencies are all placed
+    set(_ordered "")
+    set(_pending ${_known})
+    while(_pending)
+        set(_ready "")
+        foreach(_algo IN LISTS _pending)
+            set(_ok TRUE)
+            foreach(_dep IN LISTS _deps_${_algo})
+                if(NOT _dep IN_LIST _ordered)
+                    set(_ok FALSE)
+                endif()
+            endforeach()
+            if(_ok)
+                list(APPEND _ready ${_algo})
+            endif()
+        endforeach()
+        if(NOT _ready)
+            message(FATAL_ERROR "Dependency cycle between algorithms: ${_pending}")
+        endif()
+        list(APPEND _ordered ${_ready})
+        list(REMOVE_ITEM _pending ${_ready})
+    endwhile()
+    set(${out_var} "${_ordered}" PARENT_SCOPE)
+endfunction()
+
+# add_algorithm_bundle(<target> ALGORITHMS <algo>...)
+function(add_algorithm_bundle target)
+    cmake_parse_arguments(ARG "" "" "ALGORITHMS" ${ARGN})
+
+    set(_unity_sources "")
+    set(_own_sources "")
+    set(_include_dirs "")
+    set(_definitions "")
+    set(_link_libraries "")
+    set(_umbrella "")
+    foreach(_algo IN LISTS ARG_ALGORITHMS)
+        get_target_property(_dir ${_algo} SOURCE_DIR)
+        get_target_property(_sources ${_algo} SOURCES)
+        foreach(_src IN LISTS _sources)
+            get_filename_component(_path "${_src}" ABSOLUTE BASE_DIR "${_dir}")
+            get_filename_component(_src_dir "${_path}" DIRECTORY)
+            if(_src_dir STREQUAL _dir)
+                # Keep the per-file flags set in the algorithm's directory
+                get_source_file_property(_options "${_path}" DIRECTORY "${_dir}" COMPILE_OPTIONS)
+                if(_options)
+                    set_source_files_properties("${_path}" PROPERTIES COMPILE_OPTIONS "${_options}")
+                endif()
+                set_source_files_properties("${_path}" PROPERTIES SKIP_UNITY_BUILD_INCLUSION ON)
+                list(APPEND _own_sources "${_path}")
+            else()
+                list(APPEND _unity_sources "${_path}")
+            endif()
+        endforeach()
+
+        get_target_property(_incs ${_algo} INCLUDE_DIRECTORIES)
+        list(APPEND _include_dirs ${_incs})
+        get_target_property(_libs ${_algo} LINK_LIBRARIES)
+        foreach(_lib IN LISTS _libs)
+            if(_lib AND NOT _lib IN_LIST ARG_ALGORITHMS)
+                list(APPEND _link_libraries ${_lib})
+            endif()
+        endforeach()
+        get_target_property(_defs ${_algo} COMPILE_DEFINITIONS)
+        if(_defs)
+            list(APPEND _definitions ${_defs})
+        endif()
+        string(APPEND _umbrella "#include \"${_algo}.h\"\n#include \"${_algo}_batch.h\"\n"
+                                "#include \"${_algo}_fixed.h\"\n#include \"${_algo}_wrappers.h\"\n")
+    endforeach()
+    list(REMOVE_DUPLICATES _include_dirs)
+    list(REMOVE_DUPLICATES _definitions)
+    list(REMOVE_DUPLICATES _link_libraries)
+
+    # Unity order is source order, i.e. dependencies first
+    add_library(${target} STATIC ${_unity_sources} ${_own_sources})
+    target_include_directories(${target} PUBLIC ${_include_dirs})
+    target_compile_definitions(${target} PRIVATE ${_definitions})
+    # Imported targets the algorithms link (Threads::Threads) are scoped to
+    # their own directories
+    find_package(Threads REQUIRED)
+    target_link_libraries(${target} PRIVATE ${_link_libraries})
+    set_target_properties(${target} PROPERTIES
+        CXX_STANDARD 17
+        POSITION_INDEPENDENT_CODE ON
+        UNITY_BUILD ON
+        UNITY_BUILD_BATCH_SIZE 0
+    )
+
+    check_ipo_supported(RESULT _ipo OUTPUT _ipo_error LANGUAGES CXX)
+    if(_ipo)
+        set_target_properties(${target} PROPERTIES INTERPROCEDURAL_OPTIMIZATION ON)
+        if(CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+            target_compile_options(${target} PRIVATE -ffat-lto-objects)
+        endif()
+    else()
+        message(STATUS "${target}: LTO not supported, unity build only (${_ipo_error})")
+    endif()
+
+    string(TOUPPER "${target}" _guard)
+    set(_header "${CMAKE_CURRENT_BINARY_DIR}/${target}/${target}.h")
+    set(_content "// ${target}.h — written by AlgorithmBundle.cmake. Do not edit.\n\n")
+    string(APPEND _content "#ifndef ${_guard}_H\n#define ${_guard}_H\n\n${_umbrella}\n#endif // ${_guard}_H\n")
+    if(EXISTS "${_header}")
+        file(READ "${_header}" _previous)
+    endif()
+    if(NOT "${_content}" STREQUAL "${_previous}")
+        file(WRITE "${_header}" "${_content}")
+    endif()
+    target_include_directories(${target} PUBLIC "${CMAKE_CURRENT_BINARY_DIR}/${target}")
+    set_target_properties(${target} PROPERTIES PUBLIC_HEADER "${_header}")
+endfunction()
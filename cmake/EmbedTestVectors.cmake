@@ -0,0 +1,207 @@
+# EmbedTestVectors.cmake
+#
+# Converts an algorithm's JSON test vectors into a C++ header of constexpr
+# arrays, so test binaries start without directory iteration or JSON parsing.
+#
+# Usage (script mode, normally driven by embed_test_vectors() below):
+#   cmake -DVECTORS_DIR=<dir> -DOUTPUT=<header> -DALGO_NAME=<name>
+#         -P EmbedTestVectors.cmake
+#
+# The header defines, in namespace <ALGO_NAME>::embedded:
+#   constexpr harness::EmbeddedCase kCases[];
+#   constexpr size_t kCaseCount;
+# (types from harness/embedded_vectors.h). Numbers are copied verbatim with
+# 17 significant digits, so embedded values are bit-identical to the JSON path.
+
+# ---- Function mode: add the generation step to a test target ----
+
+if(NOT CMAKE_SCRIPT_MODE_FILE)
+    set(_EMBED_TEST_VECTORS_SCRIPT "${CMAKE_CURRENT_LIST_FILE}")
+
+    # embed_test_vectors(<target> <algo_name> <vectors_dir>)
+    function(embed_test_vectors target algo_name vectors_dir)
+        file(GLOB _vector_files CONFIGURE_DEPENDS "${vectors_dir}/*.json")
+        set(_out_dir "${CMAKE_CURRENT_BINARY_DIR}/embedded_vectors")
+        set(_header "${_out_dir}/${algo_name}_test_vectors.h")
+
+        add_custom_command(
+            OUTPUT "${_header}"
+            COMMAND ${CMAKE_COMMAND}
+                -DVECTORS_DIR=${vectors_dir}
+                -DOUTPUT=${_header}
+                -DALGO_NAME=${algo_name}
+                -P "${_EMBED_TEST_VECTORS_SCRIPT}"
+            DEPENDS ${_vector_files} "${_EMBED_TEST_VECTORS_SCRIPT}"
+            COMMENT "Embedding ${algo_name} test vectors"
+            VERBATIM
+        )
+        target_sources(${target} PRIVATE "${_header}")
+        target_include_directories(${target} PRIVATE "${_out_dir}")
+    endfunction()
+
+    return()
+endif()
+
+# ---- Script mode: JSON -> header ----
+
+foreach(_var VECTORS_DIR OUTPUT ALGO_NAME)
+    if(NOT DEFINED ${_var})
+        message(FATAL_ERROR "EmbedTestVectors: ${_var} must be set")
+    endif()
+endforeach()
+
+# Append `values` (a JSON scalar or flat array) as a constexpr double array.
+# Sets <out_count> in the caller to the element count.
+function(_emit_doubles json_text symbol out_count)
+    string(JSON _type TYPE "${json_text}")
+    set(_values "")
+    set(_count 0)
+    if(_type STREQUAL "NUMBER")
+        set(_values "${json_text}")
+        set(_count 1)
+    elseif(_type STREQUAL "ARRAY")
+        string(JSON _len LENGTH "${json_text}")
+        if(_len GREATER 0)
+            math(EXPR _last "${_len} - 1")
+            foreach(_i RANGE ${_last})
+                string(JSON _elem_type TYPE "${json_text}" ${_i})
+                if(NOT _elem_type STREQUAL "NUMBER")
+                    message(FATAL_ERROR "EmbedTestVectors: ${symbol} has a non-numeric element")
+                endif()
+                string(JSON _v GET "${json_text}" ${_i})
+                list(APPEND _values "${_v}")
+            endforeach()
+        endif()
+        set(_count ${_len})
+    else()
+        message(FATAL_ERROR "EmbedTestVectors: ${symbol} must be a number or flat array, got ${_type}")
+    endif()
+
+    if(_count EQUAL 0)
+        # Zero-length arrays are ill-formed; keep a placeholder with count 0
+        set(_values "0.0")
+    endif()
+    list(JOIN _values ", " _joined)
+    string(APPEND _body "constexpr double ${symbol}[] = {${_joined}};\n")
+    set(_body "${_body}" PARENT_SCOPE)
+    set(${out_count} ${_count} PARENT_SCOPE)
+endfunction()
+
+# Emit one EmbeddedField table for the members of a JSON object.
+function(_emit_fields json_obj prefix table_symbol out_count)
+    string(JSON _n LENGTH "${json_obj}")
+    set(_entries "")
+    if(_n GREATER 0)
+        math(EXPR _last "${_n} - 1")
+        foreach(_k RANGE ${_last})
+            string(JSON _key MEMBER "${json_obj}" ${_k})
+            string(JSON _val GET "${json_obj}" "${_key}")
+            _emit_doubles("${_val}" "${prefix}_${_key}" _cnt)
+            list(APPEND _entries "    {\"${_key}\", ${prefix}_${_key}, ${_cnt}},")
+        endforeach()
+    endif()
+    list(JOIN _entries "\n" _joined)
+    string(APPEND _body "constexpr harness::EmbeddedField ${table_symbol}[] = {\n${_joined}\n};\n")
+    set(_body "${_body}" PARENT_SCOPE)
+    set(${out_count} ${_n} PARENT_SCOPE)
+endfunction()
+
+file(GLOB _files "${VECTORS_DIR}/*.json")
+list(SORT _files)
+
+set(_body "")
+set(_case_table "")
+set(_case_index 0)
+
+foreach(_file ${_files})
+    get_filename_component(_fname "${_file}" NAME)
+    if(_fname STREQUAL "schema.json")
+        continue()
+    endif()
+
+    file(READ "${_file}" _json)
+
+    # Global tolerance defaults (same rules and default as the JSON loader)
+    set(_global_tol "1e-10")
+    string(JSON _gt ERROR_VARIABLE _err GET "${_json}" global_tolerance absolute)
+    if(NOT _err)
+        set(_global_tol "${_gt}")
+    endif()
+
+    string(JSON _n_cases LENGTH "${_json}" test_cases)
+    if(_n_cases EQUAL 0)
+        continue()
+    endif()
+    math(EXPR _last_case "${_n_cases} - 1")
+
+    foreach(_c RANGE ${_last_case})
+        string(JSON _tc GET "${_json}" test_cases ${_c})
+        string(JSON _name GET "${_tc}" name)
+        string(JSON _desc ERROR_VARIABLE _err GET "${_tc}" description)
+        if(_err)
+            set(_desc "")
+        endif()
+
+        set(_tol "${_global_tol}")
+        string(JSON _t ERROR_VARIABLE _err GET "${_tc}" tolerance absolute)
+        if(NOT _err)
+            set(_tol "${_t}")
+        endif()
+
+        string(JSON _out_type TYPE "${_tc}" expected_output)
+        if(NOT _out_type STREQUAL "OBJECT")
+            message(FATAL_ERROR
+                "EmbedTestVectors: ${_fname}:${_name}: expected_output must be an object of named outputs")
+        endif()
+
+        set(_prefix "kCase${_case_index}")
+        string(APPEND _body "\n// ${_fname}: ${_name}\n")
+        string(JSON _inputs GET "${_tc}" inputs)
+        _emit_fields("${_inputs}" "${_prefix}_in" "${_prefix}_inputs" _n_in)
+        string(JSON _outputs GET "${_tc}" expected_output)
+        _emit_fields("${_outputs}" "${_prefix}_out" "${_prefix}_outputs" _n_out)
+
+        # Appended as a string (not a list) so descriptions may contain ';'
+        string(APPEND _case_table
+            "    {\"${_name}\", R\"mtc(${_desc})mtc\", ${_tol}, ${_prefix}_inputs, ${_n_in}, ${_prefix}_outputs, ${_n_out}},\n")
+        math(EXPR _case_index "${_case_index} + 1")
+    endforeach()
+endforeach()
+
+if(_case_index EQUAL 0)
+    message(FATAL_ERROR "EmbedTestVectors: no test cases found in ${VECTORS_DIR}")
+endif()
+
+string(TOUPPER "${ALGO_NAME}" _guard)
+
+set(_header "// Generated by cmake/EmbedTestVectors.cmake from ${VECTORS_DIR} — do not edit.
+
+#ifndef ${_guard}_TEST_VECTORS_H
+#define ${_guard}_TEST_VECTORS_H
+
+#include <cstddef>
+
+#include \"embedded_vectors.h\"
+
+namespace ${ALGO_NAME} {
+namespace embedded {
+${_body}
+constexpr harness::EmbeddedCase kCases[] = {
+${_case_table}};
+
+constexpr size_t kCaseCount = ${_case_index};
+
+} // namespace embedded
+} // namespace ${ALGO_NAME}
+
+#endif // ${_guard}_TEST_VECTORS_H
+")
+
+# Only touch the output when it changes, so dependents do not rebuild needlessly
+set(_existing "")
+if(EXISTS "${OUTPUT}")
+    file(READ "${OUTPUT}" _existing)
+endif()
+if(NOT _existing STREQUAL _header)
+    file(WRITE "${OUTPUT}" "${_header}")
+endif()
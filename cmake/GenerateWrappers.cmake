@@ -0,0 +1,727 @@
+# GenerateWrappers.cmake
+#
+# Writes throughput wrappers around an algorithm's generated entry point
+# from the `signature:` section of its algorithm.yaml:
+#
+#   <algo>_soa()           the entry point over `count` elements stored as a
+#                          structure of arrays
+#   <algo>_soa_range()     elements [begin, end) of an <algo>_soa() call
+#   <algo>_soa_parallel()  the same, split over std::threads started per
+#                          call, or over a caller-owned executor that keeps
+#                          its threads (runtime::WorkerPool)
+#   <algo>::Stream         holds the state between calls, for signatures
+#                          whose outputs feed back into inputs ("-> input")
+#   <algo>_plugin          the entry point and <algo>_soa() as a table of
+#                          function pointers in the plugin C ABI
+#                          (runtime/algorithm_plugin.h), exported by
+#                          <algo>_plugin_v1() and described for
+#                          runtime::PluginHost by <algo>::Plugin
+#   <algo>::Signature      the descriptor the table-driven test harness
+#                          (harness/algorithm_harness.h) runs the entry
+#                          point through; build-tree only, not installed
+#
+# Signature lines are "- <in|out> [int|double|float] <name>[<dim>] [-> <input>]"
+# in C++ parameter order. <dim> is a fixed length or the name of an int
+# input holding a sequence length; the type defaults to double. A sequence
+# also carries its upper bound, on at least one array of that length, as
+# "<name>[<dim> <= <max>]" (the bound of its coder.typeof in
+# codegen_config.m).
+#
+# The plugin table records the package version from the VERSION file next
+# to algorithm.yaml (0.0.0 if there is none) and the signature as text, which
+# a host compares with its own before switching to a plugin.
+#
+# Before writing anything, the signature is checked against the parameter
+# names in the generated header, so a stale signature fails at configure
+# time rather than as a compile error in the wrappers.
+#
+# Usage (function mode, from cpp/CMakeLists.txt):
+#   generate_algorithm_wrappers(<algo_name> <algorithm_yaml> <generated_dir> <output_dir>)
+#   # Sets WRAPPER_SOURCES, WRAPPER_HEADERS and PLUGIN_SOURCE in the caller's scope;
+#   # <algo>_signature.h is written next to them but is not in WRAPPER_HEADERS
+#
+# Usage (script mode, from scripts/run_codegen.sh):
+#   cmake -DALGO_NAME=<name> -DALGORITHM_YAML=<yaml> -DGENERATED_DIR=<dir>
+#         -DOUTPUT_DIR=<dir> -P GenerateWrappers.cmake
+#
+# Files are rewritten only when their content changes.
+
+# Script mode runs without a project; pin the policies the functions rely on
+if(CMAKE_SCRIPT_MODE_FILE)
+    cmake_minimum_required(VERSION 3.20)
+endif()
+
+# _wrappers_write(<path> <content>)
+function(_wrappers_write path content)
+    if(EXISTS "${path}")
+        file(READ "${path}" _previous)
+        if("${_previous}" STREQUAL "${content}")
+            return()
+        endif()
+    endif()
+    file(WRITE "${path}" "${content}")
+endfunction()
+
+# _wrappers_join(<out_var> <separator> <items>...)
+function(_wrappers_join out_var separator)
+    set(_result "")
+    set(_first TRUE)
+    foreach(_item IN LISTS ARGN)
+        if(_first)
+            set(_result "${_item}")
+            set(_first FALSE)
+        else()
+            string(APPEND _result "${separator}${_item}")
+        endif()
+    endforeach()
+    set(${out_var} "${_result}" PARENT_SCOPE)
+endfunction()
+
+# generate_algorithm_wrappers(<algo_name> <algorithm_yaml> <generated_dir> <output_dir>)
+function(generate_algorithm_wrappers algo_name algorithm_yaml generated_dir output_dir)
+    if(NOT EXISTS "${algorithm_yaml}")
+        message(FATAL_ERROR "GenerateWrappers: ${algorithm_yaml} not found")
+    endif()
+
+    # ---- Parse algorithm.yaml ----
+    file(STRINGS "${algorithm_yaml}" _lines)
+    set(_entry "${algo_name}")
+    set(_params "")
+    set(_in_signature FALSE)
+    foreach(_line IN LISTS _lines)
+        if(_line MATCHES "^matlab_entry_point:[ \t]*\"?([A-Za-z_][A-Za-z0-9_]*)")
+            set(_entry "${CMAKE_MATCH_1}")
+        endif()
+        if(_line MATCHES "^signature:")
+            set(_in_signature TRUE)
+        elseif(_in_signature)
+            string(REGEX REPLACE "#.*$" "" _line "${_line}")
+            if(_line MATCHES "^[ \t]*$")
+                continue()
+            elseif(NOT _line MATCHES "^[ \t]")
+                set(_in_signature FALSE)
+                continue()
+            endif()
+            if(NOT _line MATCHES "^[ \t]+-[ \t]*(in|out)[ \t]+(int[ \t]+|double[ \t]+|float[ \t]+)?([A-Za-z_][A-Za-z0-9_]*)(\\[([A-Za-z0-9_]+)([ \t]*<=[ \t]*([0-9]+))?\\])?([ \t]*->[ \t]*([A-Za-z_][A-Za-z0-9_]*))?[ \t]*$")
+                message(FATAL_ERROR "GenerateWrappers: cannot parse signature line in ${algorithm_yaml}:\n  ${_line}")
+            endif()
+            set(_p "${CMAKE_MATCH_3}")
+            list(APPEND _params ${_p})
+            set(_dir_${_p} "${CMAKE_MATCH_1}")
+            string(STRIP "${CMAKE_MATCH_2}" _type)
+            if(NOT _type)
+                set(_type double)
+            endif()
+            set(_type_${_p} "${_type}")
+            set(_dim_${_p} "${CMAKE_MATCH_5}")
+            set(_max_${_p} "${CMAKE_MATCH_7}")
+            set(_fb_${_p} "${CMAKE_MATCH_9}")
+        endif()
+    endforeach()
+    if(NOT _params)
+        message(FATAL_ERROR "GenerateWrappers: ${algorithm_yaml} has no signature: section")
+    endif()
+
+    # ---- Classify parameters ----
+    # kind: length (int input sizing a sequence), scalar, fixed, sequence
+    set(_lengths "")
+    foreach(_p IN LISTS _params)
+        if(NOT "${_dim_${_p}}" STREQUAL "" AND NOT _dim_${_p} MATCHES "^[0-9]+$")
+            list(APPEND _lengths ${_dim_${_p}})
+        endif()
+    endforeach()
+    set(_has_stream FALSE)
+    foreach(_p IN LISTS _params)
+        if(_p IN_LIST _lengths)
+            if(NOT _dir_${_p} STREQUAL "in" OR NOT _type_${_p} STREQUAL "int" OR NOT "${_dim_${_p}}" STREQUAL "")
+                message(FATAL_ERROR "GenerateWrappers: sequence length '${_p}' must be a scalar int input")
+            endif()
+            set(_kind_${_p} length)
+        elseif("${_dim_${_p}}" STREQUAL "")
+            set(_kind_${_p} scalar)
+        elseif(_dim_${_p} MATCHES "^[0-9]+$")
+            set(_kind_${_p} fixed)
+        else()
+            if(NOT _dim_${_p} IN_LIST _params)
+                message(FATAL_ERROR "GenerateWrappers: '${_p}[${_dim_${_p}}]' names an unknown length input")
+            endif()
+            set(_kind_${_p} sequence)
+        endif()
+        if(NOT "${_fb_${_p}}" STREQUAL "")
+            set(_t "${_fb_${_p}}")
+            if(NOT _dir_${_p} STREQUAL "out" OR NOT _t IN_LIST _params OR NOT _dir_${_t} STREQUAL "in")
+                message(FATAL_ERROR "GenerateWrappers: '${_p} -> ${_t}' must map an output to an input")
+            endif()
+            if(NOT _type_${_p} STREQUAL _type_${_t} OR NOT "${_dim_${_p}}" STREQUAL "${_dim_${_t}}")
+                message(FATAL_ERROR "GenerateWrappers: '${_p}' and '${_t}' differ in type or shape")
+            endif()
+            if(NOT _dim_${_p} MATCHES "^[0-9]*$")
+                message(FATAL_ERROR "GenerateWrappers: sequence state ('${_p} -> ${_t}') is not supported")
+            endif()
+            set(_state_${_t} TRUE)
+            set(_has_stream TRUE)
+        endif()
+    endforeach()
+
+    # ---- Check against the generated header ----
+    set(_header "${generated_dir}/${algo_name}.h")
+    if(EXISTS "${_header}")
+        file(READ "${_header}" _decl)
+        if(NOT _decl MATCHES "[ \t\n*&]${_entry}[ \t\n]*\\(([^)]*)\\)")
+            message(FATAL_ERROR "GenerateWrappers: ${_entry}() not declared in ${_header}")
+        endif()
+        string(REPLACE "," ";" _decl_params "${CMAKE_MATCH_1}")
+        set(_decl_names "")
+        foreach(_d IN LISTS _decl_params)
+            if(_d MATCHES "([A-Za-z_][A-Za-z0-9_]*)[ \t\n]*(\\[[^]]*\\])?[ \t\n]*$")
+                list(APPEND _decl_names "${CMAKE_MATCH_1}")
+            endif()
+        endforeach()
+        if(NOT "${_decl_names}" STREQUAL "${_params}")
+            message(FATAL_ERROR "GenerateWrappers: signature in ${algorithm_yaml} does not match ${_header}\n"
+                                "  algorithm.yaml: ${_params}\n  header:         ${_decl_names}")
+        endif()
+    endif()
+
+    # ---- Structure-of-arrays pieces ----
+    set(_soa_params "int count")
+    set(_forward "count")
+    set(_locals "")
+    set(_gather "")
+    set(_call "")
+    set(_scatter "")
+    foreach(_p IN LISTS _params)
+        set(_t "${_type_${_p}}")
+        set(_n "${_dim_${_p}}")
+        set(_k "${_kind_${_p}}")
+        list(APPEND _forward "${_p}")
+        if(_k STREQUAL "length")
+            list(APPEND _soa_params "int ${_p}")
+            list(APPEND _call "${_p}")
+            continue()
+        endif()
+        if(_dir_${_p} STREQUAL "in")
+            list(APPEND _soa_params "const ${_t} ${_p}[]")
+        else()
+            list(APPEND _soa_params "${_t} ${_p}[]")
+        endif()
+
+        if(_k STREQUAL "fixed")
+            string(APPEND _locals "    ${_t} ${_p}_v[${_n}];\n")
+            list(APPEND _call "${_p}_v")
+        elseif(_k STREQUAL "sequence")
+            string(APPEND _locals "    std::vector<${_t}> ${_p}_v(${_n});\n")
+            list(APPEND _call "${_p}_v.data()")
+        elseif(_dir_${_p} STREQUAL "out")
+            list(APPEND _call "&${_p}[i]")
+        else()
+            list(APPEND _call "${_p}[i]")
+        endif()
+
+        if(NOT _k STREQUAL "scalar")
+            if(_dir_${_p} STREQUAL "in")
+                string(APPEND _gather "        for (int k = 0; k < ${_n}; k++) ${_p}_v[k] = ${_p}[k * count + i];\n")
+            else()
+                string(APPEND _scatter "        for (int k = 0; k < ${_n}; k++) ${_p}[k * count + i] = ${_p}_v[k];\n")
+            endif()
+        endif()
+    endforeach()
+    # The range function takes `count` only when an array is indexed with it
+    set(_range_params ${_soa_params})
+    set(_range_forward ${_forward})
+    if("${_gather}${_scatter}" STREQUAL "")
+        list(REMOVE_AT _range_params 0)
+        list(REMOVE_AT _range_forward 0)
+    endif()
+    _wrappers_join(_soa_decl ",\n    " ${_soa_params})
+    _wrappers_join(_range_decl ",\n    " ${_range_params})
+    _wrappers_join(_forward ", " ${_forward})
+    _wrappers_join(_range_forward ", " ${_range_forward})
+    _wrappers_join(_call ", " ${_call})
+
+    # Scalar outputs are written through &out[i] after every input of
+    # element i has been read, so each one may alias its "->" input too.
+    set(_alias_note "")
+    foreach(_p IN LISTS _params)
+        if(NOT "${_fb_${_p}}" STREQUAL "")
+            list(APPEND _alias_note "${_p} -> ${_fb_${_p}}")
+        endif()
+    endforeach()
+
+    # ---- Streaming state pieces ----
+    set(_stream_decl "")
+    set(_stream_def "")
+    if(_has_stream)
+        set(_ctor_params "")
+        set(_ctor_body "")
+        set(_step_params "")
+        set(_step_locals "")
+        set(_step_call "")
+        set(_step_feedback "")
+        set(_accessors "")
+        set(_members "")
+        set(_state_names "")
+        foreach(_p IN LISTS _params)
+            set(_t "${_type_${_p}}")
+            set(_n "${_dim_${_p}}")
+            set(_k "${_kind_${_p}}")
+            if(_state_${_p})
+                list(APPEND _state_names "${_p}")
+                if(_k STREQUAL "fixed")
+                    list(APPEND _ctor_params "const ${_t} ${_p}[${_n}]")
+                    string(APPEND _ctor_body "    std::copy(${_p}, ${_p} + ${_n}, ${_p}_);\n")
+                    string(APPEND _members "    ${_t} ${_p}_[${_n}];\n")
+                    string(APPEND _accessors "    const ${_t}* ${_p}() const { return ${_p}_; }\n")
+                else()
+                    list(APPEND _ctor_params "${_t} ${_p}")
+                    string(APPEND _ctor_body "    ${_p}_ = ${_p};\n")
+                    string(APPEND _members "    ${_t} ${_p}_;\n")
+                    string(APPEND _accessors "    ${_t} ${_p}() const { return ${_p}_; }\n")
+                endif()
+                list(APPEND _step_call "${_p}_")
+            elseif(_dir_${_p} STREQUAL "in")
+                if(_k STREQUAL "fixed")
+                    list(APPEND _step_params "const ${_t} ${_p}[${_n}]")
+                elseif(_k STREQUAL "sequence")
+                    list(APPEND _step_params "const ${_t} ${_p}[]")
+                else()
+                    list(APPEND _step_params "${_t} ${_p}")
+                endif()
+                list(APPEND _step_call "${_p}")
+            elseif(NOT "${_fb_${_p}}" STREQUAL "")
+                # Fed back after the call: the entry point may read its
+                # state inputs after writing outputs
+                if(_k STREQUAL "fixed")
+                    string(APPEND _step_locals "    ${_t} ${_p}_v[${_n}];\n")
+                    list(APPEND _step_call "${_p}_v")
+                    string(APPEND _step_feedback
+                        "    std::copy(${_p}_v, ${_p}_v + ${_n}, ${_fb_${_p}}_);\n")
+                else()
+                    string(APPEND _step_locals "    ${_t} ${_p}_v;\n")
+                    list(APPEND _step_call "&${_p}_v")
+                    string(APPEND _step_feedback "    ${_fb_${_p}}_ = ${_p}_v;\n")
+                endif()
+            else()
+                if(_k STREQUAL "fixed")
+                    string(APPEND _members "    ${_t} ${_p}_[${_n}] = {};\n")
+                    string(APPEND _accessors "    const ${_t}* ${_p}() const { return ${_p}_; }\n")
+                    list(APPEND _step_call "${_p}_")
+                elseif(_k STREQUAL "sequence")
+                    string(APPEND _members "    std::vector<${_t}> ${_p}_;\n")
+                    string(APPEND _accessors "    const ${_t}* ${_p}() const { return ${_p}_.data(); }\n")
+                    string(APPEND _step_locals "    ${_p}_.resize(${_n});\n")
+                    list(APPEND _step_call "${_p}_.data()")
+                else()
+                    string(APPEND _members "    ${_t} ${_p}_ = 0;\n")
+                    string(APPEND _accessors "    ${_t} ${_p}() const { return ${_p}_; }\n")
+                    list(APPEND _step_call "&${_p}_")
+                endif()
+            endif()
+        endforeach()
+        _wrappers_join(_ctor_params ", " ${_ctor_params})
+        _wrappers_join(_step_params ", " ${_step_params})
+        _wrappers_join(_step_call ", " ${_step_call})
+        _wrappers_join(_state_names ", " ${_state_names})
+
+        string(CONCAT _stream_decl
+            "\n"
+            "// One ${_entry}() call per step(), with the state (${_state_names})\n"
+            "// carried from each call's outputs to the next call's inputs.\n"
+            "class Stream {\n"
+            "public:\n"
+            "    Stream(${_ctor_params});\n"
+            "\n"
+            "    void step(${_step_params});\n"
+            "\n"
+            "${_accessors}"
+            "\n"
+            "private:\n"
+            "${_members}"
+            "};\n")
+        string(CONCAT _stream_def
+            "\n"
+            "Stream::Stream(${_ctor_params})\n"
+            "{\n"
+            "${_ctor_body}"
+            "}\n"
+            "\n"
+            "void Stream::step(${_step_params})\n"
+            "{\n"
+            "${_step_locals}"
+            "    ${_entry}(${_step_call});\n"
+            "${_step_feedback}"
+            "}\n")
+    endif()
+
+    # ---- Plugin table pieces ----
+    get_filename_component(_yaml_dir "${algorithm_yaml}" DIRECTORY)
+    set(_version "0.0.0")
+    if(EXISTS "${_yaml_dir}/VERSION")
+        file(STRINGS "${_yaml_dir}/VERSION" _version LIMIT_COUNT 1)
+        string(STRIP "${_version}" _version)
+    endif()
+    set(_entry_params "")
+    set(_signature_text "")
+    foreach(_p IN LISTS _params)
+        set(_t "${_type_${_p}}")
+        set(_n "${_dim_${_p}}")
+        set(_k "${_kind_${_p}}")
+        if(_k STREQUAL "fixed" OR _k STREQUAL "sequence")
+            if(_k STREQUAL "fixed")
+                set(_decl "${_t} ${_p}[${_n}]")
+            else()
+                set(_decl "${_t} ${_p}[]")
+            endif()
+            if(_dir_${_p} STREQUAL "in")
+                set(_decl "const ${_decl}")
+            endif()
+            list(APPEND _signature_text "${_dir_${_p}} ${_t} ${_p}[${_n}]")
+        else()
+            if(_dir_${_p} STREQUAL "in")
+                set(_decl "${_t} ${_p}")
+            else()
+                set(_decl "${_t}* ${_p}")
+            endif()
+            list(APPEND _signature_text "${_dir_${_p}} ${_t} ${_p}")
+        endif()
+        list(APPEND _entry_params "${_decl}")
+    endforeach()
+    _wrappers_join(_entry_params ",\n        " ${_entry_params})
+    _wrappers_join(_signature_text "; " ${_signature_text})
+    _wrappers_join(_soa_members ",\n        " ${_soa_params})
+
+    # ---- Harness descriptor pieces ----
+    # Length inputs are not fields (the harness passes the length of the
+    # first sequence input of that dim); a sequence's bound may be given on
+    # any array of the same dim.
+    foreach(_p IN LISTS _params)
+        if(NOT "${_max_${_p}}" STREQUAL "")
+            if(NOT _kind_${_p} STREQUAL "sequence")
+                message(FATAL_ERROR "GenerateWrappers: '${_p}' has a bound but no sequence length")
+            endif()
+            set(_bound_${_dim_${_p}} "${_max_${_p}}")
+        endif()
+    endforeach()
+    set(_in_index 0)
+    foreach(_p IN LISTS _params)
+        if(_dir_${_p} STREQUAL "in" AND NOT _kind_${_p} STREQUAL "length")
+            if(_kind_${_p} STREQUAL "sequence" AND NOT DEFINED _first_${_dim_${_p}})
+                set(_first_${_dim_${_p}} ${_in_index})
+            endif()
+            math(EXPR _in_index "${_in_index} + 1")
+        endif()
+    endforeach()
+    set(_sig_inputs "")
+    set(_sig_outputs "")
+    set(_invoke_args "")
+    set(_in_index 0)
+    set(_out_index 0)
+    foreach(_p IN LISTS _params)
+        set(_t "${_type_${_p}}")
+        set(_n "${_dim_${_p}}")
+        set(_k "${_kind_${_p}}")
+        if(_k STREQUAL "length")
+            if(NOT DEFINED _first_${_p})
+                message(FATAL_ERROR "GenerateWrappers: no sequence input is sized by '${_p}'")
+            endif()
+            list(APPEND _invoke_args "static_cast<int>(in[${_first_${_p}}].size())")
+            continue()
+        endif()
+        if(NOT _k STREQUAL "scalar" AND NOT _t STREQUAL "double")
+            message(FATAL_ERROR "GenerateWrappers: the test harness holds doubles; '${_p}' is a ${_t} array")
+        endif()
+        if(_k STREQUAL "sequence")
+            if(NOT DEFINED _bound_${_n})
+                message(FATAL_ERROR "GenerateWrappers: sequence '${_p}[${_n}]' needs a bound, as in '${_p}[${_n} <= 1024]'")
+            endif()
+            if(_dir_${_p} STREQUAL "in")
+                set(_field "harness::Sequence(\"${_p}\", ${_bound_${_n}})")
+            elseif(DEFINED _first_${_n})
+                set(_field "harness::Sequence(\"${_p}\", ${_bound_${_n}}, /*length_of=*/${_first_${_n}})")
+            else()
+                message(FATAL_ERROR "GenerateWrappers: output '${_p}[${_n}]' follows no input sized by '${_n}'")
+            endif()
+        elseif(_k STREQUAL "fixed")
+            set(_field "harness::Fixed(\"${_p}\", ${_n})")
+        else()
+            set(_field "harness::Scalar(\"${_p}\")")
+        endif()
+        if(_dir_${_p} STREQUAL "in")
+            string(APPEND _sig_inputs "        ${_field},\n")
+            if(NOT _k STREQUAL "scalar")
+                list(APPEND _invoke_args "in[${_in_index}].data()")
+            elseif(_t STREQUAL "double")
+                list(APPEND _invoke_args "in[${_in_index}][0]")
+            else()
+                list(APPEND _invoke_args "static_cast<${_t}>(in[${_in_index}][0])")
+            endif()
+            math(EXPR _in_index "${_in_index} + 1")
+        else()
+            if(_k STREQUAL "scalar" AND NOT _t STREQUAL "double")
+                message(FATAL_ERROR "GenerateWrappers: the test harness holds doubles; output '${_p}' is a ${_t}")
+            endif()
+            string(APPEND _sig_outputs "        ${_field},\n")
+            if(_k STREQUAL "scalar")
+                list(APPEND _invoke_args "&out[${_out_index}][0]")
+            else()
+                list(APPEND _invoke_args "out[${_out_index}].data()")
+            endif()
+            math(EXPR _out_index "${_out_index} + 1")
+        endif()
+    endforeach()
+    _wrappers_join(_invoke_args ", " ${_invoke_args})
+
+    # ---- Emit ----
+    string(TOUPPER "${algo_name}" _guard)
+    set(_alias_text "")
+    if(_alias_note)
+        _wrappers_join(_alias_note ", " ${_alias_note})
+        set(_alias_text "// A state output may share its array with the input it feeds back into,\n// which updates the state in place: ${_alias_note}.\n")
+    endif()
+
+    string(CONCAT _h
+        "// ${algo_name}_wrappers.h — written by cmake/GenerateWrappers.cmake from the\n"
+        "// signature in algorithm.yaml. Do not edit.\n"
+        "//\n"
+        "// Structure-of-arrays layout: component k of element i is at\n"
+        "// x[k * count + i]; scalars are x[i]. Sequence lengths are shared by all\n"
+        "// elements. Every element gets exactly the result of ${_entry}().\n"
+        "${_alias_text}"
+        "\n"
+        "#ifndef ${_guard}_WRAPPERS_H\n"
+        "#define ${_guard}_WRAPPERS_H\n"
+        "\n")
+    string(APPEND _h "#include <algorithm>\n")
+    if(_stream_decl MATCHES "std::vector")
+        string(APPEND _h "#include <vector>\n")
+    endif()
+    string(CONCAT _h "${_h}"
+        "\n"
+        "namespace ${algo_name} {\n"
+        "\n"
+        "// ${_entry}() for each of `count` elements\n"
+        "void ${_entry}_soa(\n"
+        "    ${_soa_decl});\n"
+        "\n"
+        "// ${_entry}() for elements [begin, end) of ${_entry}_soa()'s arrays\n"
+        "void ${_entry}_soa_range(\n"
+        "    int begin,\n"
+        "    int end,\n"
+        "    ${_range_decl});\n"
+        "\n"
+        "// ${_entry}_soa() split into contiguous ranges over `threads` threads\n"
+        "// (0: one per hardware thread), started and joined on every call. For\n"
+        "// repeated calls, pass an executor that keeps its threads instead.\n"
+        "void ${_entry}_soa_parallel(\n"
+        "    ${_soa_decl},\n"
+        "    int threads = 0);\n"
+        "\n"
+        "// ${_entry}_soa() split into executor.size() contiguous ranges (the\n"
+        "// same as with that many threads) and run on a caller-owned executor\n"
+        "// such as runtime::WorkerPool (runtime/worker_pool.h):\n"
+        "// executor.run(tasks, fn) calls fn(t) once for each t in [0, tasks) and\n"
+        "// returns when all calls have finished.\n"
+        "template <class Executor>\n"
+        "void ${_entry}_soa_parallel(\n"
+        "    ${_soa_decl},\n"
+        "    Executor& executor)\n"
+        "{\n"
+        "    const int tasks = std::max(1, std::min(executor.size(), count));\n"
+        "    auto bound = [&](int t) { return static_cast<int>(static_cast<long long>(count) * t / tasks); };\n"
+        "    executor.run(tasks, [&](int t) {\n"
+        "        ${_entry}_soa_range(bound(t), bound(t + 1), ${_range_forward});\n"
+        "    });\n"
+        "}\n"
+        "${_stream_decl}"
+        "\n"
+        "} // namespace ${algo_name}\n"
+        "\n"
+        "#endif // ${_guard}_WRAPPERS_H\n")
+
+    string(CONCAT _cpp
+        "// ${algo_name}_wrappers.cpp — written by cmake/GenerateWrappers.cmake from the\n"
+        "// signature in algorithm.yaml. Do not edit.\n"
+        "\n"
+        "#include \"${algo_name}_wrappers.h\"\n"
+        "\n"
+        "#include <algorithm>\n"
+        "#include <thread>\n"
+        "#include <vector>\n"
+        "\n"
+        "#include \"${algo_name}.h\"\n"
+        "\n"
+        "namespace ${algo_name} {\n"
+        "\n"
+        "void ${_entry}_soa_range(\n"
+        "    int begin,\n"
+        "    int end,\n"
+        "    ${_range_decl})\n"
+        "{\n"
+        "${_locals}"
+        "    for (int i = begin; i < end; i++) {\n"
+        "${_gather}"
+        "        ${_entry}(${_call});\n"
+        "${_scatter}"
+        "    }\n"
+        "}\n"
+        "\n"
+        "void ${_entry}_soa(\n"
+        "    ${_soa_decl})\n"
+        "{\n"
+        "    ${_entry}_soa_range(0, count, ${_range_forward});\n"
+        "}\n"
+        "\n"
+        "void ${_entry}_soa_parallel(\n"
+        "    ${_soa_decl},\n"
+        "    int threads)\n"
+        "{\n"
+        "    if (threads <= 0) threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));\n"
+        "    threads = std::max(1, std::min(threads, count));\n"
+        "    auto bound = [&](int t) { return static_cast<int>(static_cast<long long>(count) * t / threads); };\n"
+        "\n"
+        "    std::vector<std::thread> workers;\n"
+        "    for (int t = 1; t < threads; t++) {\n"
+        "        workers.emplace_back([=] { ${_entry}_soa_range(bound(t), bound(t + 1), ${_range_forward}); });\n"
+        "    }\n"
+        "    ${_entry}_soa_range(0, bound(1), ${_range_forward});\n"
+        "    for (auto& w : workers) w.join();\n"
+        "}\n"
+        "${_stream_def}"
+        "\n"
+        "} // namespace ${algo_name}\n")
+
+    string(CONCAT _signature_h
+        "// ${algo_name}_signature.h — written by cmake/GenerateWrappers.cmake from the\n"
+        "// signature in algorithm.yaml. Do not edit.\n"
+        "//\n"
+        "// Signature descriptor for the table-driven test harness\n"
+        "// (harness/algorithm_harness.h). Field order and names are the entry\n"
+        "// point's parameters, which match the JSON test vectors; sequence\n"
+        "// lengths are taken from the input arrays rather than passed as fields.\n"
+        "\n"
+        "#ifndef ${_guard}_SIGNATURE_H\n"
+        "#define ${_guard}_SIGNATURE_H\n"
+        "\n"
+        "#include <array>\n"
+        "\n"
+        "#include \"algorithm_harness.h\"\n"
+        "#include \"${algo_name}.h\"\n"
+        "\n"
+        "namespace ${algo_name} {\n"
+        "\n"
+        "struct Signature {\n"
+        "    static constexpr const char* kName = \"${algo_name}\";\n"
+        "\n"
+        "    static constexpr std::array<harness::Field, ${_in_index}> kInputs = {{\n"
+        "${_sig_inputs}"
+        "    }};\n"
+        "\n"
+        "    static constexpr std::array<harness::Field, ${_out_index}> kOutputs = {{\n"
+        "${_sig_outputs}"
+        "    }};\n"
+        "\n"
+        "    static void Invoke(const harness::Values& in, harness::Values& out) {\n"
+        "        ${_entry}(${_invoke_args});\n"
+        "    }\n"
+        "};\n"
+        "\n"
+        "} // namespace ${algo_name}\n"
+        "\n"
+        "#endif // ${_guard}_SIGNATURE_H\n")
+
+    string(CONCAT _plugin_h
+        "/*\n"
+        " * ${algo_name}_plugin.h — written by cmake/GenerateWrappers.cmake from the\n"
+        " * signature in algorithm.yaml. Do not edit.\n"
+        " *\n"
+        " * Function table of the ${algo_name} plugin (lib${algo_name}_plugin.so) in the\n"
+        " * C ABI of runtime/algorithm_plugin.h. This build's table is also linked\n"
+        " * into the library, so runtime::PluginHost<${algo_name}::Plugin>\n"
+        " * (runtime/plugin_host.h) starts from it and swaps in other versions.\n"
+        " */\n"
+        "\n"
+        "#ifndef ${_guard}_PLUGIN_H\n"
+        "#define ${_guard}_PLUGIN_H\n"
+        "\n"
+        "#include \"algorithm_plugin.h\"\n"
+        "\n"
+        "#define ${_guard}_PLUGIN_SIGNATURE \"${_signature_text}\"\n"
+        "\n"
+        "#ifdef __cplusplus\n"
+        "extern \"C\" {\n"
+        "#endif\n"
+        "\n"
+        "typedef struct ${algo_name}_plugin {\n"
+        "    algorithm_plugin_info info;\n"
+        "    /* ${_entry}() */\n"
+        "    void (*call)(\n"
+        "        ${_entry_params});\n"
+        "    /* ${_entry}_soa(): the entry point over `count` elements */\n"
+        "    void (*soa)(\n"
+        "        ${_soa_members});\n"
+        "} ${algo_name}_plugin;\n"
+        "\n"
+        "/* Entry symbol: the table of this build */\n"
+        "ALGORITHM_PLUGIN_EXPORT const ${algo_name}_plugin* ALGORITHM_PLUGIN_ENTRY(${algo_name})(void);\n"
+        "\n"
+        "#ifdef __cplusplus\n"
+        "} /* extern \"C\" */\n"
+        "\n"
+        "namespace ${algo_name} {\n"
+        "\n"
+        "// ${algo_name}_plugin for runtime::PluginHost\n"
+        "struct Plugin {\n"
+        "    using Table = ${algo_name}_plugin;\n"
+        "    static constexpr const char* kName = \"${algo_name}\";\n"
+        "    static constexpr const char* kSymbol = ALGORITHM_PLUGIN_ENTRY_NAME(${algo_name});\n"
+        "    static constexpr const char* kSignature = ${_guard}_PLUGIN_SIGNATURE;\n"
+        "    static const Table* Builtin() { return ALGORITHM_PLUGIN_ENTRY(${algo_name})(); }\n"
+        "};\n"
+        "\n"
+        "} // namespace ${algo_name}\n"
+        "#endif\n"
+        "\n"
+        "#endif /* ${_guard}_PLUGIN_H */\n")
+
+    string(CONCAT _plugin_cpp
+        "// ${algo_name}_plugin.cpp — written by cmake/GenerateWrappers.cmake from the\n"
+        "// signature in algorithm.yaml. Do not edit.\n"
+        "\n"
+        "#include \"${algo_name}_plugin.h\"\n"
+        "\n"
+        "#include \"${algo_name}.h\"\n"
+        "#include \"${algo_name}_wrappers.h\"\n"
+        "\n"
+        "extern \"C\" const ${algo_name}_plugin* ALGORITHM_PLUGIN_ENTRY(${algo_name})(void)\n"
+        "{\n"
+        "    static const ${algo_name}_plugin table = {\n"
+        "        {ALGORITHM_PLUGIN_ABI_VERSION, sizeof(${algo_name}_plugin), \"${algo_name}\", \"${_version}\",\n"
+        "         ${_guard}_PLUGIN_SIGNATURE},\n"
+        "        ${algo_name}::${_entry},\n"
+        "        ${algo_name}::${_entry}_soa,\n"
+        "    };\n"
+        "    return &table;\n"
+        "}\n")
+
+    file(MAKE_DIRECTORY "${output_dir}")
+    _wrappers_write("${output_dir}/${algo_name}_wrappers.h" "${_h}")
+    _wrappers_write("${output_dir}/${algo_name}_wrappers.cpp" "${_cpp}")
+    _wrappers_write("${output_dir}/${algo_name}_plugin.h" "${_plugin_h}")
+    _wrappers_write("${output_dir}/${algo_name}_plugin.cpp" "${_plugin_cpp}")
+    _wrappers_write("${output_dir}/${algo_name}_signature.h" "${_signature_h}")
+    set(WRAPPER_SOURCES "${output_dir}/${algo_name}_wrappers.cpp" "${output_dir}/${algo_name}_plugin.cpp" PARENT_SCOPE)
+    set(WRAPPER_HEADERS "${output_dir}/${algo_name}_wrappers.h" "${output_dir}/${algo_name}_plugin.h" PARENT_SCOPE)
+    set(PLUGIN_SOURCE "${output_dir}/${algo_name}_plugin.cpp" PARENT_SCOPE)
+endfunction()
+
+# ---- Script mode ----
+
+if(CMAKE_SCRIPT_MODE_FILE AND CMAKE_SCRIPT_MODE_FILE STREQUAL CMAKE_CURRENT_LIST_FILE)
+    foreach(_var ALGO_NAME ALGORITHM_YAML GENERATED_DIR OUTPUT_DIR)
+        if(NOT DEFINED ${_var})
+            message(FATAL_ERROR "GenerateWrappers.cmake: -D${_var}=... is required")
+        endif()
+    endforeach()
+    generate_algorithm_wrappers("${ALGO_NAME}" "${ALGORITHM_YAML}" "${GENERATED_DIR}" "${OUTPUT_DIR}")
+    message(STATUS "Wrappers written to ${OUTPUT_DIR}")
+endif()
@@ -0,0 +1,63 @@
+# HarnessTools.cmake
+#
+# Builds the generic harness command-line tools (harness/tools/<tool>_main.cpp)
+# for one algorithm. Tools include the algorithm's <algo>_reference.h
+# (Signature and Reference descriptors), <algo>_variants.h (kernel variants)
+# and/or <algo>_paths.h (batch adapter) through the ALGORITHM_*_HEADER
+# definitions.
+#
+# Usage:
+#   add_harness_tool(<tool> <algo_name> <vectors_dir> [INLINE] [LIBRARIES <lib>...])
+#
+# Creates the executable target <tool>_<algo_name>. With INLINE the tool is
+# built against the header-only variant instead (target <algo_name>_inline,
+# <algo_name>_inline.h force-included) as <tool>_<algo_name>_inline.
+# Expects HARNESS_DIR to point at the shared harness/ directory, RUNTIME_DIR
+# at runtime/ (header-only helpers the harness uses) and WRAPPERS_DIR at the
+# output of GenerateWrappers.cmake (the generated <algo>_signature.h).
+
+# add_harness_tool(<tool> <algo_name> <vectors_dir> [INLINE] [LIBRARIES <lib>...])
+function(add_harness_tool tool algo_name vectors_dir)
+    cmake_parse_arguments(ARG "INLINE" "" "LIBRARIES" ${ARGN})
+
+    if(NOT DEFINED HARNESS_DIR OR NOT DEFINED RUNTIME_DIR OR NOT DEFINED WRAPPERS_DIR)
+        message(FATAL_ERROR "add_harness_tool: HARNESS_DIR, RUNTIME_DIR and WRAPPERS_DIR must be set")
+    endif()
+
+    set(_target ${tool}_${algo_name})
+    set(_library ${algo_name})
+    if(ARG_INLINE)
+        set(_target ${_target}_inline)
+        set(_library ${algo_name}_inline)
+    endif()
+
+    add_executable(${_target} "${HARNESS_DIR}/tools/${tool}_main.cpp")
+    target_link_libraries(${_target} PRIVATE
+        ${_library}
+        nlohmann_json::nlohmann_json
+        Threads::Threads
+        ${CMAKE_DL_LIBS}
+        ${ARG_LIBRARIES}
+    )
+    target_include_directories(${_target} PRIVATE
+        ${CMAKE_CURRENT_SOURCE_DIR}
+        ${HARNESS_DIR}
+        ${RUNTIME_DIR}
+        ${WRAPPERS_DIR}
+    )
+    target_compile_definitions(${_target} PRIVATE
+        ALGORITHM_REFERENCE_HEADER="${algo_name}_reference.h"
+        ALGORITHM_VARIANTS_HEADER="${algo_name}_variants.h"
+        ALGORITHM_PATHS_HEADER="${algo_name}_paths.h"
+        ALGORITHM_NAMESPACE=${algo_name}
+        TEST_VECTORS_DIR="${vectors_dir}"
+    )
+    if(ARG_INLINE)
+        target_compile_options(${_target} PRIVATE -include ${algo_name}_inline.h)
+    endif()
+    # Exported symbols let tools name code sites via dladdr()
+    set_target_properties(${_target} PROPERTIES
+        CXX_STANDARD 17
+        ENABLE_EXPORTS ON
+    )
+endfunction()
@@ -0,0 +1,55 @@
+# PythonModule.cmake
+#
+# Builds an algorithm's Python extension module from its hand-written
+# cpp/<algo>_python.cpp (CPython C API and buffer protocol, no binding
+# library; shared helpers in python/python_buffer.h) and registers its
+# Python test, cpp/test_<algo>_python.py.
+#
+# Usage:
+#   add_algorithm_python_module(<algo_name>)
+#
+# Creates the MODULE target python_<algo_name>, written as
+# ${CMAKE_BINARY_DIR}/python/<algo_name><ext-suffix> so one PYTHONPATH
+# entry covers every algorithm built in the tree. Does nothing when the
+# algorithm has no <algo>_python.cpp or the Python development files are
+# not found. Expects PYTHON_DIR to point at the shared python/ directory and
+# RUNTIME_DIR at runtime/ (the *_strided.h loops the bindings call use
+# runtime/strided_span.h).
+
+# add_algorithm_python_module(<algo_name>)
+function(add_algorithm_python_module algo_name)
+    if(NOT DEFINED PYTHON_DIR OR NOT DEFINED RUNTIME_DIR)
+        message(FATAL_ERROR "add_algorithm_python_module: PYTHON_DIR and RUNTIME_DIR must be set")
+    endif()
+
+    set(_source "${CMAKE_CURRENT_SOURCE_DIR}/${algo_name}_python.cpp")
+    if(NOT EXISTS "${_source}")
+        return()
+    endif()
+
+    find_package(Python3 COMPONENTS Interpreter Development.Module)
+    if(NOT Python3_Development.Module_FOUND)
+        message(STATUS "Python development files not found: skipping the ${algo_name} module")
+        return()
+    endif()
+
+    set(_target python_${algo_name})
+    set(_output_dir "${CMAKE_BINARY_DIR}/python")
+    Python3_add_library(${_target} MODULE WITH_SOABI "${_source}")
+    target_link_libraries(${_target} PRIVATE ${algo_name})
+    target_include_directories(${_target} PRIVATE ${PYTHON_DIR} ${RUNTIME_DIR})
+    set_target_properties(${_target} PROPERTIES
+        CXX_STANDARD 17
+        OUTPUT_NAME ${algo_name}
+        LIBRARY_OUTPUT_DIRECTORY "${_output_dir}"
+        CXX_VISIBILITY_PRESET hidden
+    )
+
+    set(_test "${CMAKE_CURRENT_SOURCE_DIR}/test_${algo_name}_python.py")
+    if(BUILD_TESTING AND EXISTS "${_test}")
+        add_test(NAME python_${algo_name} COMMAND Python3::Interpreter "${_test}")
+        set_tests_properties(python_${algo_name} PROPERTIES
+            ENVIRONMENT "PYTHONPATH=${_output_dir}"
+        )
+    endif()
+endfunction()
@@ -9,14 +9,22 @@ class SensorPipelineApp(ConanFile):
     description = "Example application chaining kalman_filter, low_pass_filter, and pid_controller"
     settings = "os", "compiler", "build_type", "arch"
     exports_sources = "CMakeLists.txt", "src/*"
+    # bundle=True uses the combined matlab_algorithms package
+    options = {"bundle": [True, False]}
+    default_options = {"bundle": False}
 
     def requirements(self):
+        self.requires("algorithm_runtime/[>=0.1.0]")  # frame_arena.h, workload.h, shadow_runner.h, plugin_host.h
+        if self.options.bundle:
+            self.requires("matlab_algorithms/[>=0.1.0]")
+            return
         self.requires("kalman_filter/[>=0.1.0]")
         self.requires("low_pass_filter/[>=0.1.0]")
         self.requires("pid_controller/[>=0.1.0]")
 
     def generate(self):
         tc = CMakeToolchain(self)
+        tc.variables["USE_ALGORITHM_BUNDLE"] = bool(self.options.bundle)
         tc.generate()
 
         deps = CMakeDeps(self)
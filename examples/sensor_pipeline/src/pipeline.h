@@ -0,0 +1,127 @@
+/**
+ * Per-sensor processing chain of the example pipeline, shared by the
+ * demo (main.cpp) and the soak test (soak.cpp) so both exercise the same
+ * ingest path:
+ *
+ *   frame of raw samples -> low_pass_filter -> kalman_filter -> pid_controller
+ *
+ * A SensorChannel keeps one sensor's filter and controller state between
+ * frames; ingest() processes one frame. attach_shadow() hands a sample of
+ * its Kalman and PID calls to shadow runners (runtime/shadow_runner.h),
+ * which replay them through a candidate version off the live path.
+ *
+ * ingest() calls the linked algorithms directly by default. Pass a
+ * PluginAlgorithms to call through plugin tables instead
+ * (runtime/plugin_host.h): read the tables once per frame, and a version
+ * swapped in meanwhile takes over at the next frame, channel state intact.
+ */
+
+#ifndef SENSOR_PIPELINE_PIPELINE_H
+#define SENSOR_PIPELINE_PIPELINE_H
+
+#include "kalman_filter.h"
+#include "kalman_filter_plugin.h"
+#include "kalman_filter_shadow.h"
+#include "low_pass_filter.h"
+#include "low_pass_filter_plugin.h"
+#include "pid_controller.h"
+#include "pid_controller_plugin.h"
+#include "pid_controller_shadow.h"
+
+struct PipelineConfig {
+    double alpha = 0.3;              // low-pass smoothing
+    double measurement_noise = 2.0;  // Kalman R
+    double process_noise = 0.1;      // Kalman Q
+    double kp = 1.0, ki = 0.1, kd = 0.05;
+    double dt = 0.1;                 // seconds per sample
+};
+
+// The algorithms as linked into this program
+struct LinkedAlgorithms {
+    static constexpr auto low_pass = low_pass_filter::low_pass_filter;
+    static constexpr auto kalman = kalman_filter::kalman_filter;
+    static constexpr auto pid = pid_controller::pid_controller;
+};
+
+// The algorithms through plugin tables, e.g. runtime::PluginHost::table()
+struct PluginAlgorithms {
+    const low_pass_filter_plugin* low_pass_table;
+    const kalman_filter_plugin* kalman_table;
+    const pid_controller_plugin* pid_table;
+
+    template <class... Args> void low_pass(Args... args) const { low_pass_table->call(args...); }
+    template <class... Args> void kalman(Args... args) const { kalman_table->call(args...); }
+    template <class... Args> void pid(Args... args) const { pid_table->call(args...); }
+};
+
+class SensorChannel {
+public:
+    explicit SensorChannel(const PipelineConfig& config) : config_(config) {}
+
+    // Offer calls to these runners (either may be null). A runner has one
+    // producer, so channels sharing one must be ingested on one thread.
+    void attach_shadow(kalman_filter::ShadowRunner* kalman, pid_controller::ShadowRunner* pid) {
+        kf_shadow_ = kalman;
+        pid_shadow_ = pid;
+    }
+
+    // One frame of n samples. raw and reference are inputs; filtered,
+    // estimate and control receive the low-pass output, the Kalman
+    // position estimate and the PID output per sample.
+    template <class Algorithms = LinkedAlgorithms>
+    void ingest(const double* raw, const double* reference, int n,
+                double* filtered, double* estimate, double* control,
+                const Algorithms& algorithms = Algorithms()) {
+        algorithms.low_pass(raw, config_.alpha, n, filtered);
+
+        for (int i = 0; i < n; i++) {
+            double updated_state[2];
+            double updated_cov[4];
+            algorithms.kalman(
+                kf_state_, filtered[i], kf_cov_,
+                config_.measurement_noise, config_.process_noise,
+                updated_state, updated_cov);
+            if (kf_shadow_) {
+                kf_shadow_->Offer([&](double* in, double* live) {
+                    kalman_filter::shadow_pack(kf_state_, filtered[i], kf_cov_, config_.measurement_noise,
+                                               config_.process_noise, updated_state, updated_cov, in, live);
+                });
+            }
+
+            // PID controller: track the reference trajectory
+            double error = reference[i] - updated_state[0];
+            double new_integral;
+            double new_prev_error;
+            algorithms.pid(
+                error, pid_integral_, pid_prev_error_,
+                config_.kp, config_.ki, config_.kd, config_.dt,
+                &control[i], &new_integral, &new_prev_error);
+            if (pid_shadow_) {
+                pid_shadow_->Offer([&](double* in, double* live) {
+                    pid_controller::shadow_pack(error, pid_integral_, pid_prev_error_, config_.kp, config_.ki,
+                                                config_.kd, config_.dt, control[i], new_integral,
+                                                new_prev_error, in, live);
+                });
+            }
+            estimate[i] = updated_state[0];
+
+            // Carry state forward
+            kf_state_[0] = updated_state[0];
+            kf_state_[1] = updated_state[1];
+            for (int k = 0; k < 4; k++) kf_cov_[k] = updated_cov[k];
+            pid_integral_   = new_integral;
+            pid_prev_error_ = new_prev_error;
+        }
+    }
+
+private:
+    PipelineConfig config_;
+    double kf_state_[2] = {0.0, 0.0};           // [position, velocity]
+    double kf_cov_[4]   = {10.0, 0.0, 0.0, 10.0}; // initial uncertainty
+    double pid_integral_   = 0.0;
+    double pid_prev_error_ = 0.0;
+    kalman_filter::ShadowRunner* kf_shadow_ = nullptr;
+    pid_controller::ShadowRunner* pid_shadow_ = nullptr;
+};
+
+#endif // SENSOR_PIPELINE_PIPELINE_H
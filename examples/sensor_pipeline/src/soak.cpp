@@ -0,0 +1,522 @@
+/**
+ * Sensor Pipeline Soak Test
+ *
+ * Feeds the pipeline (pipeline.h, the same ingest path as sensor_pipeline)
+ * in real time from N emulated sensors and watches it for as long as you
+ * let it run:
+ *
+ *   generator thread  -- frames at each sensor's scheduled arrival time
+ *                        (runtime::ArrivalSchedule: rate, jitter, bursts),
+ *                        data from runtime::GenerateSignals(), into the
+ *                        ring of worker (sensor % workers); a full ring
+ *                        drops the frame
+ *   worker threads    -- SensorChannel::ingest() per frame, latency from the
+ *                        frame's scheduled arrival to the end of processing
+ *
+ * Every --interval seconds it prints frames arrived, processed and
+ * dropped, the backlog still queued, latency percentiles and RSS; a
+ * backlog or RSS that keeps growing means the pipeline is not keeping up
+ * or is leaking. Latency counts from the scheduled time, so a generator
+ * that falls behind shows up as latency rather than hiding it.
+ *
+ * --shadow-fraction F shadows that fraction of each worker's Kalman and
+ * PID calls (runtime/shadow_runner.h) on low-priority threads, optionally
+ * pinned with --shadow-cpu. The candidate here is this build itself, so
+ * the run measures what shadowing costs the live path and must report no
+ * divergence; a pipeline trialling a new version passes that version's
+ * shadow_call() instead.
+ *
+ * --swap-plugins DIR makes the workers call the algorithms through
+ * runtime::PluginHost tables. At --swap-at seconds (default: half way), a
+ * control thread loads lib<algo>_plugin.so for each algorithm from DIR.
+ * It warms each one up against the live version, then switches it in
+ * between frames while the sensors keep arriving. The report intervals
+ * around the swap show what the switch cost. A plugin that fails to load
+ * or to warm up is rejected, and the live version stays in place.
+ *
+ * Usage: sensor_soak [--sensors N] [--rate HZ] [--frame SAMPLES] [--jitter J]
+ *                    [--burst-prob P] [--burst-len L] [--duration S]
+ *                    [--interval S] [--workers W] [--queue FRAMES] [--seed S]
+ *                    [--csv PATH] [--max-p99-ms MS]
+ *                    [--shadow-fraction F] [--shadow-cpu CPU] [--shadow-budget-ns NS]
+ *                    [--swap-plugins DIR] [--swap-at S]
+ *
+ * Exit status: 0 if no frame was dropped, p99 latency stayed within
+ * --max-p99-ms (when given), no shadowed call diverged and every plugin
+ * swap went through, 1 otherwise, 2 on usage errors.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "load_generator.h"
+#include "pipeline.h"
+#include "plugin_host.h"
+#include "workload.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct SoakOptions {
+    int sensors = 16;
+    int frame = 20;             // samples per frame
+    int workers = 1;
+    int queue = 1024;           // frames per worker ring
+    double duration = 10.0;     // seconds
+    double interval = 1.0;      // seconds between reports
+    double max_p99_ms = 0.0;    // 0: no limit
+    uint64_t seed = 42;
+    runtime::LoadProfile profile;
+    std::string csv_path;
+    runtime::ShadowOptions shadow;  // sample_fraction 0: no shadowing
+    std::string swap_dir;           // empty: call the linked algorithms
+    double swap_at = -1.0;          // seconds; < 0: half way
+};
+
+// The tables the workers call through with --swap-plugins
+struct PluginHosts {
+    runtime::PluginHost<low_pass_filter::Plugin> low_pass;
+    runtime::PluginHost<kalman_filter::Plugin> kalman;
+    runtime::PluginHost<pid_controller::Plugin> pid;
+
+    // Read once per frame
+    PluginAlgorithms tables() const { return {&low_pass.table(), &kalman.table(), &pid.table()}; }
+};
+
+// One frame in flight; slots are reused, so the vectors only allocate the
+// first time a slot is filled
+struct Frame {
+    int sensor = 0;
+    Clock::time_point due;
+    std::vector<double> raw;
+    std::vector<double> reference;
+};
+
+struct Worker {
+    Worker(size_t queue, const runtime::ShadowOptions& shadow) : ring(queue) {
+        if (shadow.sample_fraction > 0) {
+            kalman_shadow = std::make_unique<kalman_filter::ShadowRunner>(kalman_filter::shadow_call, shadow);
+            pid_shadow = std::make_unique<pid_controller::ShadowRunner>(pid_controller::shadow_call, shadow);
+        }
+    }
+    runtime::SpscRing<Frame> ring;
+    std::atomic<uint64_t> processed{0};
+    double checksum = 0.0;  // keeps the outputs observable
+    std::unique_ptr<kalman_filter::ShadowRunner> kalman_shadow;  // fed by this worker only
+    std::unique_ptr<pid_controller::ShadowRunner> pid_shadow;
+    std::thread thread;
+};
+
+void RunWorker(Worker& w, int index, const SoakOptions& opts, const PipelineConfig& config,
+               const PluginHosts* plugins, runtime::LatencyHistogram& latency, const std::atomic<bool>& stop) {
+    // Sensors index, index + workers, ... belong to this worker
+    std::vector<SensorChannel> channels;
+    for (int s = index; s < opts.sensors; s += opts.workers) {
+        channels.emplace_back(config);
+        channels.back().attach_shadow(w.kalman_shadow.get(), w.pid_shadow.get());
+    }
+    std::vector<double> filtered(opts.frame), estimate(opts.frame), control(opts.frame);
+
+    int idle = 0;
+    for (;;) {
+        Frame* f = w.ring.front();
+        if (!f) {
+            if (stop.load(std::memory_order_acquire) && !w.ring.front()) break;
+            if (++idle < 64) std::this_thread::yield();
+            else std::this_thread::sleep_for(std::chrono::microseconds(50));
+            continue;
+        }
+        idle = 0;
+        SensorChannel& channel = channels[f->sensor / opts.workers];
+        if (plugins) {
+            channel.ingest(f->raw.data(), f->reference.data(), opts.frame, filtered.data(), estimate.data(),
+                           control.data(), plugins->tables());
+        } else {
+            channel.ingest(f->raw.data(), f->reference.data(), opts.frame, filtered.data(), estimate.data(),
+                           control.data());
+        }
+        w.checksum += control[opts.frame - 1];
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - f->due).count();
+        latency.record(ns > 0 ? static_cast<uint64_t>(ns) : 0);
+        w.ring.pop();
+        w.processed.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void PrintUsage(const char* argv0) {
+    std::fprintf(stderr,
+                 "Usage: %s [--sensors N] [--rate HZ] [--frame SAMPLES] [--jitter J]\n"
+                 "       [--burst-prob P] [--burst-len L] [--duration S] [--interval S]\n"
+                 "       [--workers W] [--queue FRAMES] [--seed S] [--csv PATH] [--max-p99-ms MS]\n"
+                 "       [--shadow-fraction F] [--shadow-cpu CPU] [--shadow-budget-ns NS]\n"
+                 "       [--swap-plugins DIR] [--swap-at S]\n",
+                 argv0);
+}
+
+SoakOptions ParseArgs(int argc, char** argv) {
+    SoakOptions opts;
+    opts.shadow.sample_fraction = 0.0;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) throw std::invalid_argument("missing value for " + arg);
+        std::string value = argv[++i];
+        if (arg == "--sensors") opts.sensors = std::stoi(value);
+        else if (arg == "--rate") opts.profile.rate_hz = std::stod(value);
+        else if (arg == "--frame") opts.frame = std::stoi(value);
+        else if (arg == "--jitter") opts.profile.jitter = std::stod(value);
+        else if (arg == "--burst-prob") opts.profile.burst_probability = std::stod(value);
+        else if (arg == "--burst-len") opts.profile.burst_length = std::stoi(value);
+        else if (arg == "--duration") opts.duration = std::stod(value);
+        else if (arg == "--interval") opts.interval = std::stod(value);
+        else if (arg == "--workers") opts.workers = std::stoi(value);
+        else if (arg == "--queue") opts.queue = std::stoi(value);
+        else if (arg == "--seed") opts.seed = std::stoull(value);
+        else if (arg == "--csv") opts.csv_path = value;
+        else if (arg == "--max-p99-ms") opts.max_p99_ms = std::stod(value);
+        else if (arg == "--shadow-fraction") opts.shadow.sample_fraction = std::stod(value);
+        else if (arg == "--shadow-cpu") opts.shadow.cpu = std::stoi(value);
+        else if (arg == "--shadow-budget-ns") opts.shadow.budget_ns = std::stoull(value);
+        else if (arg == "--swap-plugins") opts.swap_dir = value;
+        else if (arg == "--swap-at") opts.swap_at = std::stod(value);
+        else throw std::invalid_argument("unknown option " + arg);
+    }
+    if (opts.sensors < 1 || opts.frame < 1 || opts.workers < 1 || opts.queue < 1)
+        throw std::invalid_argument("--sensors, --frame, --workers and --queue must be positive");
+    if (!(opts.profile.rate_hz > 0) || !(opts.duration > 0) || !(opts.interval > 0))
+        throw std::invalid_argument("--rate, --duration and --interval must be positive");
+    if (opts.profile.jitter < 0 || opts.profile.jitter > 1)
+        throw std::invalid_argument("--jitter must be in [0, 1]");
+    if (opts.profile.burst_length < 1) throw std::invalid_argument("--burst-len must be positive");
+    if (opts.shadow.sample_fraction < 0 || opts.shadow.sample_fraction > 1)
+        throw std::invalid_argument("--shadow-fraction must be in [0, 1]");
+    if (!opts.swap_dir.empty()) {
+        if (opts.swap_at < 0) opts.swap_at = opts.duration / 2;
+        if (opts.swap_at >= opts.duration) throw std::invalid_argument("--swap-at must be before --duration");
+    }
+    return opts;
+}
+
+// Warm-up of a candidate: the same synthetic frames through two fresh
+// channels, one on the live tables and one on the candidate's; the
+// outputs must agree within the test vectors' default tolerance
+bool WarmUp(const PluginAlgorithms& live, const PluginAlgorithms& candidate, const PipelineConfig& config,
+            int frame) {
+    const int frames = 256;
+    runtime::ChannelSpec spec;
+    spec.amplitude = 5.0;
+    spec.noise_stddev = 0.9;
+    std::vector<double> raw(frame), reference(frame);
+    std::vector<double> out_live(3 * frame), out_candidate(3 * frame);
+    SensorChannel a(config), b(config);
+    runtime::ShadowTolerance tol;
+    for (int j = 0; j < frames; j++) {
+        runtime::GenerateSignals(raw.data(), reference.data(), frame, 1, config.dt, &spec, 7,
+                                 static_cast<uint64_t>(j) * frame);
+        a.ingest(raw.data(), reference.data(), frame, &out_live[0], &out_live[frame], &out_live[2 * frame], live);
+        b.ingest(raw.data(), reference.data(), frame, &out_candidate[0], &out_candidate[frame],
+                 &out_candidate[2 * frame], candidate);
+        for (size_t k = 0; k < out_live.size(); k++) {
+            double l = out_live[k], c = out_candidate[k];
+            if (!(std::fabs(c - l) <= tol.absolute + tol.relative * std::fabs(l)) && !(std::isnan(c) && std::isnan(l)))
+                return false;
+        }
+    }
+    return true;
+}
+
+// Outcome of one algorithm's swap
+struct SwapResult {
+    std::string algorithm, from, to, error;
+    bool ok = false;
+    double at_s = 0.0, took_ms = 0.0;
+};
+
+// Loads, warms up and switches in each algorithm's plugin from dir, one
+// after the other, on the calling (control) thread
+std::vector<SwapResult> SwapPlugins(PluginHosts& hosts, const std::string& dir, const PipelineConfig& config,
+                                    int frame, Clock::time_point start) {
+    std::vector<SwapResult> results;
+    auto swap = [&](auto& host, const char* algorithm, auto replace) {
+        SwapResult r;
+        r.algorithm = algorithm;
+        r.from = host.version();
+        auto t0 = Clock::now();
+        r.at_s = std::chrono::duration<double>(t0 - start).count();
+        std::string path = dir + "/lib" + algorithm + "_plugin.so";
+        r.ok = host.Load(path, [&](const auto& table) {
+            PluginAlgorithms live = hosts.tables(), candidate = live;
+            replace(candidate, &table);
+            return WarmUp(live, candidate, config, frame);
+        });
+        r.took_ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        r.to = host.version();
+        if (!r.ok) r.error = host.error();
+        results.push_back(r);
+    };
+    swap(hosts.low_pass, "low_pass_filter",
+         [](PluginAlgorithms& a, const low_pass_filter_plugin* t) { a.low_pass_table = t; });
+    swap(hosts.kalman, "kalman_filter",
+         [](PluginAlgorithms& a, const kalman_filter_plugin* t) { a.kalman_table = t; });
+    swap(hosts.pid, "pid_controller",
+         [](PluginAlgorithms& a, const pid_controller_plugin* t) { a.pid_table = t; });
+    return results;
+}
+
+double Micros(uint64_t ns) { return static_cast<double>(ns) / 1e3; }
+double Megabytes(size_t bytes) { return static_cast<double>(bytes) / (1 << 20); }
+
+// Sums the workers' shadow reports for one algorithm and prints them;
+// returns the number of divergent calls
+template <class Report>
+uint64_t PrintShadow(const char* algorithm, const std::vector<Report>& reports) {
+    Report total;
+    for (const Report& r : reports) {
+        total.calls += r.calls;
+        total.sampled += r.sampled;
+        total.dropped += r.dropped;
+        total.over_budget += r.over_budget;
+        total.compared += r.compared;
+        total.diverged += r.diverged;
+        total.max_abs_error = std::max(total.max_abs_error, r.max_abs_error);
+        total.offer_ns.merge(r.offer_ns);
+    }
+    std::printf("%-19s %llu of %llu calls compared, %llu diverged (max |error| %.3g), "
+                "%llu dropped, %llu over budget; offer p99 %.2f us, max %.2f us\n",
+                ("Shadow " + std::string(algorithm) + ":").c_str(), static_cast<unsigned long long>(total.compared),
+                static_cast<unsigned long long>(total.calls), static_cast<unsigned long long>(total.diverged),
+                total.max_abs_error, static_cast<unsigned long long>(total.dropped),
+                static_cast<unsigned long long>(total.over_budget), Micros(total.offer_ns.percentile(0.99)),
+                Micros(total.offer_ns.max()));
+    return total.diverged;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        if (std::string(argv[i]) == "--help" || std::string(argv[i]) == "-h") {
+            PrintUsage(argv[0]);
+            return 0;
+        }
+    }
+    SoakOptions opts;
+    try {
+        opts = ParseArgs(argc, argv);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "sensor_soak: %s\n", e.what());
+        PrintUsage(argv[0]);
+        return 2;
+    }
+
+    FILE* csv = nullptr;
+    if (!opts.csv_path.empty()) {
+        csv = std::fopen(opts.csv_path.c_str(), "w");
+        if (!csv) {
+            std::fprintf(stderr, "sensor_soak: cannot write %s\n", opts.csv_path.c_str());
+            return 2;
+        }
+        std::fprintf(csv, "elapsed_s,frames,processed,dropped,backlog,p50_us,p99_us,p999_us,max_us,rss_mb\n");
+    }
+
+    // Each sensor samples frame times per period; the pipeline runs at that rate
+    PipelineConfig config;
+    config.dt = 1.0 / (opts.profile.rate_hz * opts.frame);
+    runtime::ChannelSpec spec;
+    spec.amplitude = 5.0;
+    spec.frequency = 0.5;
+    spec.noise_stddev = 0.9;
+
+    runtime::LatencyHistogram latency;
+    std::atomic<bool> stop{false};
+    std::unique_ptr<PluginHosts> plugins;
+    if (!opts.swap_dir.empty()) plugins = std::make_unique<PluginHosts>();
+    std::vector<std::unique_ptr<Worker>> workers;
+    for (int w = 0; w < opts.workers; w++) workers.push_back(std::make_unique<Worker>(opts.queue, opts.shadow));
+    for (int w = 0; w < opts.workers; w++) {
+        workers[w]->thread = std::thread(RunWorker, std::ref(*workers[w]), w, std::cref(opts), std::cref(config),
+                                         plugins.get(), std::ref(latency), std::cref(stop));
+    }
+
+    std::printf("Soak: %d sensors x %.1f Hz x %d samples, jitter %.2f, bursts %.3f x %d, "
+                "%d workers, queue %d, %.0f s\n",
+                opts.sensors, opts.profile.rate_hz, opts.frame, opts.profile.jitter,
+                opts.profile.burst_probability, opts.profile.burst_length, opts.workers, opts.queue,
+                opts.duration);
+    std::printf("%8s  %9s  %9s  %7s  %7s  %9s  %9s  %9s  %9s  %8s\n", "elapsed", "frames", "processed",
+                "dropped", "backlog", "p50 us", "p99 us", "p99.9 us", "max us", "RSS MB");
+
+    // Generator: always emit the sensor whose next frame is due first
+    std::vector<runtime::ArrivalSchedule> schedules;
+    using Due = std::pair<double, int>;  // (arrival seconds, sensor)
+    std::priority_queue<Due, std::vector<Due>, std::greater<Due>> next;
+    for (int s = 0; s < opts.sensors; s++) {
+        schedules.emplace_back(opts.profile, opts.seed, static_cast<uint64_t>(s));
+        next.push({schedules[s].Next(), s});
+    }
+
+    const Clock::time_point start = Clock::now();
+    auto at = [&](double seconds) {
+        return start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+    };
+
+    // Control thread: the plugin swap, off the generator and the workers
+    std::vector<SwapResult> swaps;
+    std::thread swapper;
+    if (plugins) {
+        swapper = std::thread([&] {
+            std::this_thread::sleep_until(at(opts.swap_at));
+            swaps = SwapPlugins(*plugins, opts.swap_dir, config, opts.frame, start);
+        });
+    }
+    uint64_t frames = 0, dropped = 0, interval_frames = 0, interval_dropped = 0, last_processed = 0;
+    uint64_t worst_p99 = 0;
+    size_t first_rss = 0, last_rss = 0, first_backlog = 0, last_backlog = 0;
+    int intervals = 0;
+    runtime::LatencyHistogram::Snapshot overall;
+
+    auto report = [&](double elapsed) {
+        uint64_t processed = 0;
+        size_t backlog = 0;
+        for (auto& w : workers) {
+            processed += w->processed.load(std::memory_order_relaxed);
+            backlog += w->ring.size();
+        }
+        auto snap = latency.drain();
+        overall.merge(snap);
+        size_t rss = runtime::resident_set_bytes();
+        if (intervals++ == 0) first_rss = rss, first_backlog = backlog;
+        last_rss = rss, last_backlog = backlog;
+        worst_p99 = std::max(worst_p99, snap.percentile(0.99));
+
+        std::printf("%7.1fs  %9llu  %9llu  %7llu  %7zu  %9.1f  %9.1f  %9.1f  %9.1f  %8.1f\n", elapsed,
+                    static_cast<unsigned long long>(interval_frames),
+                    static_cast<unsigned long long>(processed - last_processed),
+                    static_cast<unsigned long long>(interval_dropped), backlog,
+                    Micros(snap.percentile(0.5)), Micros(snap.percentile(0.99)),
+                    Micros(snap.percentile(0.999)), Micros(snap.max()), Megabytes(rss));
+        std::fflush(stdout);
+        if (csv) {
+            std::fprintf(csv, "%.3f,%llu,%llu,%llu,%zu,%.1f,%.1f,%.1f,%.1f,%.2f\n", elapsed,
+                         static_cast<unsigned long long>(interval_frames),
+                         static_cast<unsigned long long>(processed - last_processed),
+                         static_cast<unsigned long long>(interval_dropped), backlog,
+                         Micros(snap.percentile(0.5)), Micros(snap.percentile(0.99)),
+                         Micros(snap.percentile(0.999)), Micros(snap.max()), Megabytes(rss));
+            std::fflush(csv);
+        }
+        last_processed = processed;
+        interval_frames = 0;
+        interval_dropped = 0;
+    };
+
+    double next_report = opts.interval;
+    for (;;) {
+        auto [t, s] = next.top();
+        // Report intervals that end before the next arrival
+        while (next_report <= t && next_report <= opts.duration) {
+            std::this_thread::sleep_until(at(next_report));
+            report(next_report);
+            next_report += opts.interval;
+        }
+        if (t >= opts.duration) break;
+        next.pop();
+
+        std::this_thread::sleep_until(at(t));
+        uint64_t j = schedules[s].frames() - 1;  // frame index of this arrival
+        Worker& w = *workers[s % opts.workers];
+        if (Frame* f = w.ring.begin_push()) {
+            f->sensor = s;
+            f->due = at(t);
+            f->raw.resize(opts.frame);
+            f->reference.resize(opts.frame);
+            runtime::GenerateSignals(f->raw.data(), f->reference.data(), opts.frame, 1, config.dt, &spec,
+                                     opts.seed + static_cast<uint64_t>(s),
+                                     j * static_cast<uint64_t>(opts.frame));
+            w.ring.commit_push();
+        } else {
+            dropped++;
+            interval_dropped++;
+        }
+        frames++;
+        interval_frames++;
+        next.push({schedules[s].Next(), s});
+    }
+    if (next_report - opts.interval < opts.duration) {  // partial last interval
+        std::this_thread::sleep_until(at(opts.duration));
+        report(opts.duration);
+    }
+
+    if (swapper.joinable()) swapper.join();
+    stop.store(true, std::memory_order_release);
+    double checksum = 0.0;
+    std::vector<kalman_filter::ShadowRunner::Report> kalman_shadow;
+    std::vector<pid_controller::ShadowRunner::Report> pid_shadow;
+    for (auto& w : workers) {
+        w->thread.join();
+        checksum += w->checksum;
+        if (w->kalman_shadow) {
+            w->kalman_shadow->Stop();
+            w->pid_shadow->Stop();
+            kalman_shadow.push_back(w->kalman_shadow->report());
+            pid_shadow.push_back(w->pid_shadow->report());
+        }
+    }
+    overall.merge(latency.drain());  // frames still queued at the end
+    if (csv) std::fclose(csv);
+
+    const bool over_latency = opts.max_p99_ms > 0 && Micros(worst_p99) > opts.max_p99_ms * 1e3;
+    std::printf("\n============================================================\n");
+    std::printf("SOAK SUMMARY: sensor_pipeline\n");
+    std::printf("============================================================\n");
+    std::printf("Frames:             %llu arrived, %llu dropped (%.3f%%)\n",
+                static_cast<unsigned long long>(frames), static_cast<unsigned long long>(dropped),
+                frames ? 100.0 * dropped / frames : 0.0);
+    std::printf("Latency:            p50 %.1f us, p99 %.1f us, p99.9 %.1f us, max %.1f us (worst interval p99 %.1f us)\n",
+                Micros(overall.percentile(0.5)), Micros(overall.percentile(0.99)),
+                Micros(overall.percentile(0.999)), Micros(overall.max()), Micros(worst_p99));
+    std::printf("Backlog:            %zu -> %zu frames (first -> last interval)\n", first_backlog, last_backlog);
+    std::printf("RSS:                %.1f -> %.1f MB (first -> last interval)\n",
+                Megabytes(first_rss), Megabytes(last_rss));
+    std::printf("Checksum:           %.6g\n", checksum);
+    uint64_t diverged = 0;
+    if (opts.shadow.sample_fraction > 0) {
+        diverged += PrintShadow("kalman_filter", kalman_shadow);
+        diverged += PrintShadow("pid_controller", pid_shadow);
+    }
+    int rejected = 0;
+    for (const SwapResult& r : swaps) {
+        if (r.ok) {
+            std::printf("%-19s %s -> %s at %.2f s, load and warm-up %.1f ms\n",
+                        ("Swap " + r.algorithm + ":").c_str(), r.from.c_str(), r.to.c_str(), r.at_s, r.took_ms);
+        } else {
+            std::printf("%-19s rejected at %.2f s, %s stays live: %s\n", ("Swap " + r.algorithm + ":").c_str(),
+                        r.at_s, r.from.c_str(), r.error.c_str());
+            rejected++;
+        }
+    }
+    std::printf("============================================================\n");
+
+    if (dropped > 0 || over_latency || diverged > 0 || rejected > 0) {
+        std::fprintf(stderr, "\nSOAK FAILED: %llu frames dropped%s%s%s\n", static_cast<unsigned long long>(dropped),
+                     over_latency ? ", p99 latency over --max-p99-ms" : "",
+                     diverged > 0 ? ", shadow candidate diverged" : "",
+                     rejected > 0 ? ", plugin swap rejected" : "");
+        return 1;
+    }
+    std::printf("\nSOAK PASSED\n");
+    return 0;
+}
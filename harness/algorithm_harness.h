@@ -0,0 +1,413 @@
+#ifndef HARNESS_ALGORITHM_HARNESS_H
+#define HARNESS_ALGORITHM_HARNESS_H
+
+// Table-driven test harness shared by every algorithm.
+//
+// Each algorithm describes its generated function with a signature
+// descriptor (<name>_signature.h, written by cmake/GenerateWrappers.cmake
+// from the signature in algorithm.yaml):
+//
+//   struct Signature {
+//       static constexpr const char* kName = "kalman_filter";
+//       static constexpr std::array<harness::Field, N> kInputs  = {...};
+//       static constexpr std::array<harness::Field, M> kOutputs = {...};
+//       static void Invoke(const harness::Values& in, harness::Values& out);
+//   };
+//
+// The field lists mirror the -args of codegen_config.m, in the same order
+// and with the same names as the JSON test vectors. Everything else —
+// JSON loading, the binary vector format, streaming, parallel execution
+// and output collection — is generic and lives in this header.
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace harness {
+
+// ---- Signature descriptor ----
+
+enum class Shape {
+    Scalar,    // single double (MATLAB scalar)
+    Fixed,     // fixed-size array of `size` doubles
+    Sequence,  // variable-length array; outputs take their length from input `length_of`
+};
+
+struct Field {
+    const char* name;
+    Shape shape;
+    int size;       // element count for Fixed, upper bound for Sequence, 1 for Scalar
+    int length_of;  // Sequence outputs: index of the input whose length they share
+};
+
+constexpr Field Scalar(const char* name) { return {name, Shape::Scalar, 1, -1}; }
+constexpr Field Fixed(const char* name, int size) { return {name, Shape::Fixed, size, -1}; }
+constexpr Field Sequence(const char* name, int max_size, int length_of = -1) {
+    return {name, Shape::Sequence, max_size, length_of};
+}
+
+// One vector of doubles per field, in descriptor order. Scalars hold one element.
+using Values = std::vector<std::vector<double>>;
+
+// Same layout in extended precision, for high-precision reference outputs.
+using WideValues = std::vector<std::vector<long double>>;
+
+// Used when neither the case nor the file specifies an absolute tolerance
+constexpr double kDefaultAbsTolerance = 1e-10;
+
+struct TestCase {
+    std::string name;
+    std::string description;
+    Values inputs;
+    Values expected;
+    double abs_tolerance = kDefaultAbsTolerance;
+};
+
+// ---- Field helpers ----
+
+// Throws if `count` elements do not fit the field's declared shape.
+inline void CheckFieldSize(const Field& field, size_t count, const std::string& case_name) {
+    bool size_ok = field.shape == Shape::Scalar ? count == 1
+        : field.shape == Shape::Fixed ? static_cast<int>(count) == field.size
+        : static_cast<int>(count) <= field.size;
+    if (!size_ok) {
+        throw std::runtime_error("Field '" + std::string(field.name) + "' in test case '" +
+                                 case_name + "' has " + std::to_string(count) +
+                                 " elements, signature expects " +
+                                 (field.shape == Shape::Sequence ? "at most " : "") +
+                                 std::to_string(field.size));
+    }
+}
+
+inline std::vector<double> ParseField(const Field& field, const nlohmann::json& value,
+                                      const std::string& case_name) {
+    std::vector<double> out;
+    if (field.shape == Shape::Scalar) {
+        out.push_back(value.get<double>());
+        return out;
+    }
+    out = value.get<std::vector<double>>();
+    CheckFieldSize(field, out.size(), case_name);
+    return out;
+}
+
+inline nlohmann::json FieldToJson(const Field& field, const std::vector<double>& value) {
+    if (field.shape == Shape::Scalar) return value.at(0);
+    return value;
+}
+
+// Size output buffers for the given inputs, reusing existing capacity.
+template <class Sig, class T>
+void ResizeOutputs(const Values& inputs, std::vector<std::vector<T>>& out) {
+    out.resize(Sig::kOutputs.size());
+    for (size_t i = 0; i < Sig::kOutputs.size(); i++) {
+        const Field& f = Sig::kOutputs[i];
+        size_t n = f.shape == Shape::Sequence && f.length_of >= 0
+            ? inputs[f.length_of].size()
+            : static_cast<size_t>(f.size);
+        out[i].assign(n, T(0));
+    }
+}
+
+// Allocate zeroed output buffers sized for the given inputs.
+template <class Sig, class T = double>
+std::vector<std::vector<T>> AllocateOutputs(const Values& inputs) {
+    std::vector<std::vector<T>> out;
+    ResizeOutputs<Sig>(inputs, out);
+    return out;
+}
+
+template <class Sig>
+Values Run(const Values& inputs) {
+    Values out = AllocateOutputs<Sig>(inputs);
+    Sig::Invoke(inputs, out);
+    return out;
+}
+
+// ---- JSON loading ----
+
+template <class Sig>
+TestCase ParseTestCase(const nlohmann::json& tc, double global_abs_tol) {
+    TestCase t;
+    t.name = tc["name"].get<std::string>();
+    t.description = tc.value("description", "");
+
+    for (const Field& f : Sig::kInputs) {
+        t.inputs.push_back(ParseField(f, tc["inputs"][f.name], t.name));
+    }
+    for (const Field& f : Sig::kOutputs) {
+        t.expected.push_back(ParseField(f, tc["expected_output"][f.name], t.name));
+    }
+
+    // Per-case tolerance overrides global
+    t.abs_tolerance = global_abs_tol;
+    if (tc.contains("tolerance") && tc["tolerance"].contains("absolute")) {
+        t.abs_tolerance = tc["tolerance"]["absolute"].get<double>();
+    }
+    return t;
+}
+
+// JSON vector files in `dir`, sorted so every run sees cases in the same order.
+inline std::vector<std::filesystem::path> VectorFiles(const std::string& dir) {
+    std::vector<std::filesystem::path> files;
+    for (const auto& entry : std::filesystem::directory_iterator(dir)) {
+        if (entry.path().extension() != ".json") continue;
+        if (entry.path().filename() == "schema.json") continue;
+        files.push_back(entry.path());
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+// Streaming path: parse one vector file at a time and hand each case to
+// `fn`, so memory is bounded by the largest single file.
+template <class Sig>
+void ForEachTestVector(const std::string& dir, const std::function<void(TestCase&&)>& fn) {
+    for (const auto& path : VectorFiles(dir)) {
+        std::ifstream f(path);
+        if (!f.is_open()) continue;
+
+        nlohmann::json data = nlohmann::json::parse(f);
+
+        // Global tolerance defaults
+        double global_abs_tol = kDefaultAbsTolerance;
+        if (data.contains("global_tolerance") &&
+            data["global_tolerance"].contains("absolute")) {
+            global_abs_tol = data["global_tolerance"]["absolute"].get<double>();
+        }
+
+        for (const auto& tc : data["test_cases"]) {
+            fn(ParseTestCase<Sig>(tc, global_abs_tol));
+        }
+    }
+}
+
+template <class Sig>
+std::vector<TestCase> LoadTestVectors(const std::string& dir) {
+    std::vector<TestCase> cases;
+    ForEachTestVector<Sig>(dir, [&](TestCase&& tc) { cases.push_back(std::move(tc)); });
+    return cases;
+}
+
+// ---- Replay logs ----
+//
+// Recorded production calls, JSON Lines: one {"inputs": {<field>: value}}
+// object per line with the test-vector field names. Other keys (timestamps,
+// source tags) are ignored. Replayed cases have no expected output.
+
+template <class Sig>
+std::vector<TestCase> LoadReplayLog(const std::string& path) {
+    std::ifstream f(path);
+    if (!f.is_open()) throw std::runtime_error("Cannot open replay log " + path);
+
+    std::vector<TestCase> cases;
+    std::string line;
+    for (size_t line_no = 1; std::getline(f, line); line_no++) {
+        if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+        nlohmann::json record = nlohmann::json::parse(line);
+        TestCase t;
+        t.name = "replay_" + std::to_string(line_no);
+        for (const Field& field : Sig::kInputs) {
+            t.inputs.push_back(ParseField(field, record.at("inputs").at(field.name), t.name));
+        }
+        cases.push_back(std::move(t));
+    }
+    return cases;
+}
+
+// ---- Binary vector format ----
+//
+// Little-endian, native double layout:
+//   header: "MTCV" | u32 version | u32 name_len | name
+//           | u32 n_inputs | u32 n_outputs
+//   case:   u32 name_len | name | f64 abs_tolerance
+//           | per field (inputs, then expected outputs): u32 count | f64[count]
+//
+// The header carries the algorithm name and field counts so a file written
+// for one algorithm is rejected by another.
+
+constexpr char kBinaryMagic[4] = {'M', 'T', 'C', 'V'};
+constexpr uint32_t kBinaryVersion = 1;
+
+namespace detail {
+
+inline void WriteU32(std::ostream& os, uint32_t v) {
+    os.write(reinterpret_cast<const char*>(&v), sizeof(v));
+}
+
+inline void WriteString(std::ostream& os, const std::string& s) {
+    WriteU32(os, static_cast<uint32_t>(s.size()));
+    os.write(s.data(), static_cast<std::streamsize>(s.size()));
+}
+
+inline void WriteDoubles(std::ostream& os, const std::vector<double>& v) {
+    WriteU32(os, static_cast<uint32_t>(v.size()));
+    os.write(reinterpret_cast<const char*>(v.data()),
+             static_cast<std::streamsize>(v.size() * sizeof(double)));
+}
+
+inline bool ReadU32(std::istream& is, uint32_t& v) {
+    return static_cast<bool>(is.read(reinterpret_cast<char*>(&v), sizeof(v)));
+}
+
+inline bool ReadString(std::istream& is, std::string& s) {
+    uint32_t n = 0;
+    if (!ReadU32(is, n)) return false;
+    s.resize(n);
+    return static_cast<bool>(is.read(&s[0], n));
+}
+
+inline bool ReadDoubles(std::istream& is, std::vector<double>& v) {
+    uint32_t n = 0;
+    if (!ReadU32(is, n)) return false;
+    v.resize(n);
+    return static_cast<bool>(
+        is.read(reinterpret_cast<char*>(v.data()), static_cast<std::streamsize>(n * sizeof(double))));
+}
+
+} // namespace detail
+
+template <class Sig>
+void WriteBinaryVectors(const std::string& path, const std::vector<TestCase>& cases) {
+    std::ofstream os(path, std::ios::binary);
+    if (!os) throw std::runtime_error("Cannot open binary vector file for writing: " + path);
+
+    os.write(kBinaryMagic, sizeof(kBinaryMagic));
+    detail::WriteU32(os, kBinaryVersion);
+    detail::WriteString(os, Sig::kName);
+    detail::WriteU32(os, static_cast<uint32_t>(Sig::kInputs.size()));
+    detail::WriteU32(os, static_cast<uint32_t>(Sig::kOutputs.size()));
+
+    for (const auto& tc : cases) {
+        detail::WriteString(os, tc.name);
+        os.write(reinterpret_cast<const char*>(&tc.abs_tolerance), sizeof(double));
+        for (const auto& v : tc.inputs) detail::WriteDoubles(os, v);
+        for (const auto& v : tc.expected) detail::WriteDoubles(os, v);
+    }
+}
+
+// Streaming reader for the binary format: holds one case at a time.
+template <class Sig>
+class BinaryVectorReader {
+public:
+    explicit BinaryVectorReader(const std::string& path) : is_(path, std::ios::binary) {
+        if (!is_) throw std::runtime_error("Cannot open binary vector file: " + path);
+
+        char magic[4];
+        uint32_t version = 0, n_in = 0, n_out = 0;
+        std::string name;
+        if (!is_.read(magic, sizeof(magic)) ||
+            !std::equal(magic, magic + 4, kBinaryMagic) ||
+            !detail::ReadU32(is_, version) || version != kBinaryVersion ||
+            !detail::ReadString(is_, name) ||
+            !detail::ReadU32(is_, n_in) || !detail::ReadU32(is_, n_out)) {
+            throw std::runtime_error("Not a binary test vector file: " + path);
+        }
+        if (name != Sig::kName || n_in != Sig::kInputs.size() || n_out != Sig::kOutputs.size()) {
+            throw std::runtime_error("Binary vector file " + path + " was written for '" + name +
+                                     "', not '" + Sig::kName + "'");
+        }
+    }
+
+    bool Next(TestCase& tc) {
+        if (!detail::ReadString(is_, tc.name)) return false;
+        if (!is_.read(reinterpret_cast<char*>(&tc.abs_tolerance), sizeof(double))) {
+            throw std::runtime_error("Truncated binary vector file (case '" + tc.name + "')");
+        }
+        tc.description.clear();
+        tc.inputs.resize(Sig::kInputs.size());
+        tc.expected.resize(Sig::kOutputs.size());
+        for (auto& v : tc.inputs) {
+            if (!detail::ReadDoubles(is_, v)) throw std::runtime_error("Truncated binary vector file");
+        }
+        for (auto& v : tc.expected) {
+            if (!detail::ReadDoubles(is_, v)) throw std::runtime_error("Truncated binary vector file");
+        }
+        return true;
+    }
+
+private:
+    std::ifstream is_;
+};
+
+template <class Sig>
+std::vector<TestCase> LoadBinaryVectors(const std::string& path) {
+    std::vector<TestCase> cases;
+    BinaryVectorReader<Sig> reader(path);
+    TestCase tc;
+    while (reader.Next(tc)) cases.push_back(tc);
+    return cases;
+}
+
+// ---- Parallel execution ----
+
+// Worker count: HARNESS_THREADS if set, otherwise the hardware concurrency.
+inline unsigned DefaultThreadCount() {
+    if (const char* env = std::getenv("HARNESS_THREADS")) {
+        int n = std::atoi(env);
+        if (n > 0) return static_cast<unsigned>(n);
+    }
+    unsigned hw = std::thread::hardware_concurrency();
+    return hw == 0 ? 1 : hw;
+}
+
+// Call fn(i) for i in [0, n) on up to `threads` workers. Indices are handed
+// out through a shared counter, so uneven case sizes balance naturally.
+inline void ParallelFor(size_t n, unsigned threads, const std::function<void(size_t)>& fn) {
+    threads = std::max(1u, std::min<unsigned>(threads, static_cast<unsigned>(n)));
+    if (threads <= 1) {
+        for (size_t i = 0; i < n; i++) fn(i);
+        return;
+    }
+    std::atomic<size_t> next{0};
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    for (unsigned t = 0; t < threads; t++) {
+        workers.emplace_back([&] {
+            for (size_t i = next++; i < n; i = next++) fn(i);
+        });
+    }
+    for (auto& w : workers) w.join();
+}
+
+// Run every case through the generated function; results are in case order.
+template <class Sig>
+std::vector<Values> RunAll(const std::vector<TestCase>& cases, unsigned threads = DefaultThreadCount()) {
+    std::vector<Values> results(cases.size());
+    ParallelFor(cases.size(), threads, [&](size_t i) { results[i] = Run<Sig>(cases[i].inputs); });
+    return results;
+}
+
+// ---- Output collection for the equivalence check ----
+
+// One cpp_outputs.json record per case: {"test_name", "actual_<output>"..., "tolerance"}.
+template <class Sig>
+nlohmann::json OutputsToJson(const std::vector<TestCase>& cases, const std::vector<Values>& results) {
+    nlohmann::json outputs = nlohmann::json::array();
+    for (size_t i = 0; i < cases.size(); i++) {
+        nlohmann::json result;
+        result["test_name"] = cases[i].name;
+        for (size_t o = 0; o < Sig::kOutputs.size(); o++) {
+            const Field& f = Sig::kOutputs[o];
+            result[std::string("actual_") + f.name] = FieldToJson(f, results[i][o]);
+        }
+        result["tolerance"] = cases[i].abs_tolerance;
+        outputs.push_back(result);
+    }
+    return outputs;
+}
+
+} // namespace harness
+
+#endif // HARNESS_ALGORITHM_HARNESS_H
@@ -0,0 +1,207 @@
+#ifndef HARNESS_BENCHMARK_H
+#define HARNESS_BENCHMARK_H
+
+// Throughput measurement for an algorithm's execution paths.
+//
+// A workload is a list of input sets (test vectors, replay log records,
+// fuzz samples). Each repeat runs the whole workload until at least
+// min_seconds have passed and records nanoseconds per element: one scalar
+// call, or one track/channel/loop of a batch call. The best repeat is the
+// headline figure; the median shows how noisy the machine was.
+//
+// Outputs and batch layouts are prepared up front; the scalar figure still
+// includes the signature adapter's argument unpacking.
+//
+// Where the kernel exposes hardware counters (perf_event_open; not in most
+// VMs or containers) each result also carries data-TLB load misses per
+// element, which is what BenchTable() compares across page sizes.
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "algorithm_harness.h"
+#include "large_buffer.h"
+
+namespace harness {
+
+struct BenchOptions {
+    double min_seconds = 0.2;  // per repeat
+    int repeats = 5;
+};
+
+struct BenchResult {
+    std::string path;
+    size_t elements = 0;    // per workload pass
+    uint64_t passes = 0;    // over all repeats
+    double best_ns = 0.0;   // per element
+    double median_ns = 0.0;
+    double dtlb_misses = -1.0;  // per element over all passes; < 0 without a counter
+};
+
+namespace detail {
+
+// User-space dTLB load-miss counter for this thread; inert when the
+// kernel, the VM or perf_event_paranoid does not allow it.
+class TlbMissCounter {
+public:
+    TlbMissCounter() {
+#if defined(__linux__)
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+    ~TlbMissCounter() {
+#if defined(__linux__)
+        if (fd_ >= 0) close(fd_);
+#endif
+    }
+    TlbMissCounter(const TlbMissCounter&) = delete;
+    TlbMissCounter& operator=(const TlbMissCounter&) = delete;
+
+    bool available() const { return fd_ >= 0; }
+
+    void Start() {
+#if defined(__linux__)
+        if (fd_ < 0) return;
+        ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+
+    // Misses since Start(), or -1
+    double Stop() {
+#if defined(__linux__)
+        if (fd_ < 0) return -1.0;
+        ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+        uint64_t count = 0;
+        if (read(fd_, &count, sizeof(count)) == static_cast<ssize_t>(sizeof(count))) {
+            return static_cast<double>(count);
+        }
+#endif
+        return -1.0;
+    }
+
+private:
+    int fd_ = -1;
+};
+
+template <class Pass>
+BenchResult TimePasses(const std::string& path, size_t elements, const BenchOptions& opts,
+                       Pass&& pass) {
+    using Clock = std::chrono::steady_clock;
+    BenchResult r;
+    r.path = path;
+    r.elements = elements;
+
+    pass();  // warm-up: page faults, kernel dispatch, caches
+    TlbMissCounter tlb;
+    tlb.Start();
+    std::vector<double> samples;
+    for (int rep = 0; rep < std::max(1, opts.repeats); rep++) {
+        uint64_t n = 0;
+        double elapsed = 0.0;
+        auto start = Clock::now();
+        do {
+            pass();
+            n++;
+            elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        } while (elapsed < opts.min_seconds);
+        samples.push_back(elapsed * 1e9 / (static_cast<double>(n) * std::max<size_t>(elements, 1)));
+        r.passes += n;
+    }
+    double misses = tlb.Stop();
+    if (misses >= 0.0) {
+        r.dtlb_misses = misses / (static_cast<double>(r.passes) * std::max<size_t>(elements, 1));
+    }
+    std::sort(samples.begin(), samples.end());
+    r.best_ns = samples.front();
+    r.median_ns = samples[samples.size() / 2];
+    return r;
+}
+
+} // namespace detail
+
+// One Sig::Invoke per workload entry.
+template <class Sig>
+BenchResult BenchScalar(const std::vector<TestCase>& workload, const BenchOptions& opts) {
+    std::vector<Values> out(workload.size());
+    for (size_t i = 0; i < workload.size(); i++) ResizeOutputs<Sig>(workload[i].inputs, out[i]);
+    return detail::TimePasses("scalar", workload.size(), opts, [&] {
+        for (size_t i = 0; i < workload.size(); i++) Sig::Invoke(workload[i].inputs, out[i]);
+    });
+}
+
+// Workload packed once into batch calls of `batch_size` entries, then only
+// the batch API calls timed (Batch::Packed::Call, see equivalence_matrix.h).
+// Stateful batches (filter state, integrators) keep evolving across passes
+// like a running system.
+template <class Batch>
+BenchResult BenchBatch(const std::vector<TestCase>& workload, size_t batch_size,
+                       const BenchOptions& opts, const std::string& prefix = "") {
+    std::vector<typename Batch::Packed> chunks;
+    for (size_t j = 0; j < workload.size(); j += batch_size) {
+        size_t count = std::min(batch_size, workload.size() - j);
+        std::vector<const Values*> in;
+        for (size_t k = j; k < j + count; k++) in.push_back(&workload[k].inputs);
+        chunks.push_back(Batch::Pack(in));
+    }
+    return detail::TimePasses(prefix + "batch/" + std::to_string(batch_size), workload.size(), opts,
+                              [&] {
+                                  for (auto& chunk : chunks) chunk.Call();
+                              });
+}
+
+// The workload cycled to `elements` entries and packed into one batch
+// call -- a track table far larger than the caches, so every pass streams
+// it from memory -- with its arrays allocated under the given huge page
+// policy. Comparing HugePages::None with Transparent/Explicit shows what
+// the page size costs in TLB misses and time.
+template <class Batch>
+BenchResult BenchTable(const std::vector<TestCase>& workload, size_t elements,
+                       runtime::HugePages huge_pages, const BenchOptions& opts) {
+    std::vector<const Values*> in(elements);
+    for (size_t i = 0; i < elements; i++) in[i] = &workload[i % workload.size()].inputs;
+
+    runtime::LargeBufferOptions& defaults = runtime::large_buffer_defaults();
+    const runtime::LargeBufferOptions saved = defaults;
+    defaults.huge_pages = huge_pages;
+    typename Batch::Packed table = Batch::Pack(in);
+    defaults = saved;
+    in = {};
+
+    return detail::TimePasses(std::string("table/") + runtime::huge_pages_name(huge_pages), elements,
+                              opts, [&] { table.Call(); });
+}
+
+inline nlohmann::json BenchResultToJson(const BenchResult& r) {
+    nlohmann::json j = {{"path", r.path},
+                        {"elements_per_pass", r.elements},
+                        {"passes", r.passes},
+                        {"best_ns_per_element", r.best_ns},
+                        {"median_ns_per_element", r.median_ns}};
+    if (r.dtlb_misses >= 0.0) j["dtlb_misses_per_element"] = r.dtlb_misses;
+    return j;
+}
+
+} // namespace harness
+
+#endif // HARNESS_BENCHMARK_H
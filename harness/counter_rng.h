@@ -0,0 +1,83 @@
+#ifndef HARNESS_COUNTER_RNG_H
+#define HARNESS_COUNTER_RNG_H
+
+// Counter-based random numbers (Philox4x32-10, Salmon et al., SC'11).
+//
+// Every draw is a pure function of (key, counter), so a fuzz case or a
+// Monte Carlo realization is reproducible from its seed and index alone,
+// no matter which thread generated it or in what order.
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+#include "philox.h"
+
+namespace harness {
+
+// The generator itself lives in runtime/philox.h, shared with the
+// workload generator (runtime/workload.h)
+using runtime::Philox4x32;
+using runtime::PhiloxCounter;
+using runtime::PhiloxKey;
+using runtime::SameBlock;
+using runtime::ToUnitDouble;
+
+// Random stream for one (seed, stream) pair — e.g. one fuzz case. Draws
+// come from consecutive counter blocks, four 32-bit words per block.
+class CounterRng {
+public:
+    CounterRng(uint64_t seed, uint64_t stream)
+        : key_{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)},
+          stream_(stream) {}
+
+    uint32_t NextU32() {
+        if (used_ == 4) Refill();
+        return block_[used_++];
+    }
+
+    // Uniform in [0, 1)
+    double NextUniform() {
+        uint32_t hi = NextU32();
+        return ToUnitDouble(hi, NextU32());
+    }
+
+    double Uniform(double lo, double hi) { return lo + (hi - lo) * NextUniform(); }
+
+    // Log-uniform in [lo, hi]; both bounds must be positive
+    double LogUniform(double lo, double hi) {
+        return std::exp(Uniform(std::log(lo), std::log(hi)));
+    }
+
+    // Uniform integer in [lo, hi]
+    int UniformInt(int lo, int hi) {
+        uint64_t span = static_cast<uint64_t>(hi - lo) + 1;
+        return lo + static_cast<int>((static_cast<uint64_t>(NextU32()) * span) >> 32);
+    }
+
+    // Standard normal (Box–Muller)
+    double Normal() {
+        double u1 = 1.0 - NextUniform();  // (0, 1]
+        double u2 = NextUniform();
+        return std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * u2);
+    }
+
+private:
+    void Refill() {
+        block_ = Philox4x32({static_cast<uint32_t>(block_index_), static_cast<uint32_t>(block_index_ >> 32),
+                             static_cast<uint32_t>(stream_), static_cast<uint32_t>(stream_ >> 32)},
+                            key_);
+        block_index_++;
+        used_ = 0;
+    }
+
+    PhiloxKey key_;
+    uint64_t stream_;
+    uint64_t block_index_ = 0;
+    PhiloxCounter block_{};
+    int used_ = 4;
+};
+
+} // namespace harness
+
+#endif // HARNESS_COUNTER_RNG_H
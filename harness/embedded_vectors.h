@@ -0,0 +1,101 @@
+#ifndef HARNESS_EMBEDDED_VECTORS_H
+#define HARNESS_EMBEDDED_VECTORS_H
+
+// Test vectors compiled into the test binary.
+//
+// cmake/EmbedTestVectors.cmake turns test_vectors/*.json into constexpr
+// tables of these types at build time, so the default test run does no
+// filesystem iteration or JSON parsing. LoadSelectedVectors() keeps the
+// JSON and binary paths available for ad-hoc runs via HARNESS_VECTORS.
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "algorithm_harness.h"
+
+namespace harness {
+
+struct EmbeddedField {
+    const char* name;
+    const double* data;
+    size_t size;
+};
+
+struct EmbeddedCase {
+    const char* name;
+    const char* description;
+    double abs_tolerance;
+    const EmbeddedField* inputs;
+    size_t n_inputs;
+    const EmbeddedField* outputs;
+    size_t n_outputs;
+};
+
+namespace detail {
+
+inline const EmbeddedField* FindEmbeddedField(const EmbeddedField* fields, size_t n, const char* name) {
+    for (size_t i = 0; i < n; i++) {
+        if (std::strcmp(fields[i].name, name) == 0) return &fields[i];
+    }
+    return nullptr;
+}
+
+template <size_t N>
+Values EmbeddedToValues(const std::array<Field, N>& sig_fields, const EmbeddedField* fields,
+                        size_t n, const char* case_name, const char* kind) {
+    Values values;
+    values.reserve(N);
+    for (const Field& f : sig_fields) {
+        const EmbeddedField* e = FindEmbeddedField(fields, n, f.name);
+        if (e == nullptr) {
+            throw std::runtime_error(std::string("Embedded test case '") + case_name + "' has no " +
+                                     kind + " '" + f.name + "'");
+        }
+        CheckFieldSize(f, e->size, case_name);
+        values.emplace_back(e->data, e->data + e->size);
+    }
+    return values;
+}
+
+} // namespace detail
+
+// Map embedded cases onto the signature's field order.
+template <class Sig>
+std::vector<TestCase> LoadEmbeddedVectors(const EmbeddedCase* cases, size_t n) {
+    std::vector<TestCase> out;
+    out.reserve(n);
+    for (size_t i = 0; i < n; i++) {
+        const EmbeddedCase& ec = cases[i];
+        TestCase t;
+        t.name = ec.name;
+        t.description = ec.description;
+        t.abs_tolerance = ec.abs_tolerance;
+        t.inputs = detail::EmbeddedToValues(Sig::kInputs, ec.inputs, ec.n_inputs, ec.name, "input");
+        t.expected = detail::EmbeddedToValues(Sig::kOutputs, ec.outputs, ec.n_outputs, ec.name, "output");
+        out.push_back(std::move(t));
+    }
+    return out;
+}
+
+// Embedded vectors by default. For ad-hoc runs, HARNESS_VECTORS may name a
+// directory of JSON vectors or a binary .tvb file to use instead.
+template <class Sig>
+std::vector<TestCase> LoadSelectedVectors(const EmbeddedCase* cases, size_t n) {
+    const char* override_path = std::getenv("HARNESS_VECTORS");
+    if (override_path == nullptr || *override_path == '\0') {
+        return LoadEmbeddedVectors<Sig>(cases, n);
+    }
+    if (std::filesystem::is_directory(override_path)) {
+        return LoadTestVectors<Sig>(override_path);
+    }
+    return LoadBinaryVectors<Sig>(override_path);
+}
+
+} // namespace harness
+
+#endif // HARNESS_EMBEDDED_VECTORS_H
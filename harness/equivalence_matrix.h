@@ -0,0 +1,287 @@
+#ifndef HARNESS_EQUIVALENCE_MATRIX_H
+#define HARNESS_EQUIVALENCE_MATRIX_H
+
+// Cross-path equivalence matrix.
+//
+// Every execution path an algorithm ships (scalar, batch at several sizes,
+// each ISA level, threaded) runs every test case, and each cell of the
+// path x case matrix records whether the result is within the case's
+// tolerance of the expected output and whether it is bit-identical to the
+// MATLAB-validated scalar function.
+//
+// Batch paths process the case list cycled to batch_size x case_count
+// entries, so every case lands in several lane positions (vector body and
+// remainder) and every copy must agree.
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "algorithm_harness.h"
+#include "large_buffer.h"
+
+namespace harness {
+
+// One way of executing the algorithm. `run` returns results for the cases
+// repeated any whole number of times: entry j belongs to case j % n.
+struct ExecutionPath {
+    std::string name;
+    bool bitwise = true;  // must reproduce the scalar function bit for bit
+    std::function<std::vector<Values>(const std::vector<TestCase>&)> run;
+};
+
+// Per-algorithm batch adapters look like:
+//
+//   struct BatchAdapter {
+//       struct Packed { ...; void Call(); };  // the batch API's own layout
+//       static Packed Pack(const std::vector<const Values*>& in);
+//       static void Unpack(const Packed& p, std::vector<Values*>& out);
+//       // Pack, call once, unpack into the (pre-sized) outputs
+//       static void Run(const std::vector<const Values*>& in, std::vector<Values*>& out);
+//   };
+//
+// Packed arrays are BatchArrays, so big batches (the benchmark's track
+// table) get huge pages and local-node placement per
+// runtime::large_buffer_defaults(); small ones are plain aligned blocks.
+using BatchArray = std::vector<double, runtime::LargeBufferAllocator<double>>;
+
+template <class Sig>
+ExecutionPath ScalarPath() {
+    return {"scalar", true, [](const std::vector<TestCase>& cases) { return RunAll<Sig>(cases, 1); }};
+}
+
+namespace detail {
+
+// Run `entries` (indices into cases) through Batch in one call.
+template <class Sig, class Batch>
+void RunBatchChunk(const std::vector<TestCase>& cases, const size_t* entries, size_t count,
+                   std::vector<Values>& results, size_t first_result) {
+    std::vector<const Values*> in(count);
+    std::vector<Values*> out(count);
+    for (size_t k = 0; k < count; k++) {
+        const Values& inputs = cases[entries[k]].inputs;
+        in[k] = &inputs;
+        out[k] = &results[first_result + k];
+        ResizeOutputs<Sig>(inputs, *out[k]);
+    }
+    Batch::Run(in, out);
+}
+
+inline std::vector<size_t> CycledEntries(size_t n_cases, size_t copies) {
+    std::vector<size_t> entries(n_cases * copies);
+    for (size_t j = 0; j < entries.size(); j++) entries[j] = j % n_cases;
+    return entries;
+}
+
+} // namespace detail
+
+// Calls of `batch_size` entries each, on one thread.
+template <class Sig, class Batch>
+ExecutionPath BatchPath(size_t batch_size, const std::string& prefix = "") {
+    return {prefix + "batch/" + std::to_string(batch_size), true,
+            [batch_size](const std::vector<TestCase>& cases) {
+                auto entries = detail::CycledEntries(cases.size(), batch_size);
+                std::vector<Values> results(entries.size());
+                for (size_t j = 0; j < entries.size(); j += batch_size) {
+                    size_t count = std::min(batch_size, entries.size() - j);
+                    detail::RunBatchChunk<Sig, Batch>(cases, &entries[j], count, results, j);
+                }
+                return results;
+            }};
+}
+
+// Batches of `batch_size` entries spread over `threads` workers.
+template <class Sig, class Batch>
+ExecutionPath ThreadedPath(unsigned threads, size_t batch_size, const std::string& prefix = "") {
+    return {prefix + "threads/" + std::to_string(threads), true,
+            [threads, batch_size](const std::vector<TestCase>& cases) {
+                // Enough entries that every worker gets several batches
+                size_t copies = std::max<size_t>(batch_size, 4 * threads);
+                auto entries = detail::CycledEntries(cases.size(), copies);
+                std::vector<Values> results(entries.size());
+                size_t n_chunks = (entries.size() + batch_size - 1) / batch_size;
+                ParallelFor(n_chunks, threads, [&](size_t c) {
+                    size_t j = c * batch_size;
+                    size_t count = std::min(batch_size, entries.size() - j);
+                    detail::RunBatchChunk<Sig, Batch>(cases, &entries[j], count, results, j);
+                });
+                return results;
+            }};
+}
+
+// Batch sizes around common vector widths (1, 2, 4, 8 lanes) and their
+// remainders; thread counts 1..max(4, DefaultThreadCount()).
+inline std::vector<size_t> DefaultBatchSizes() { return {1, 2, 3, 4, 7, 8, 9, 16, 33, 64}; }
+
+template <class Sig, class Batch>
+std::vector<ExecutionPath> StandardPaths(const std::string& prefix = "") {
+    std::vector<ExecutionPath> paths;
+    if (prefix.empty()) paths.push_back(ScalarPath<Sig>());
+    for (size_t b : DefaultBatchSizes()) paths.push_back(BatchPath<Sig, Batch>(b, prefix));
+    unsigned max_threads = std::max(4u, DefaultThreadCount());
+    for (unsigned t = 1; t <= max_threads; t++) paths.push_back(ThreadedPath<Sig, Batch>(t, 8, prefix));
+    return paths;
+}
+
+// `path` with `enter` run before and `leave` after it, e.g. to pin a
+// runtime-dispatched kernel for the duration of the path.
+inline ExecutionPath ScopedPath(ExecutionPath path, std::function<void()> enter,
+                                std::function<void()> leave) {
+    auto run = std::move(path.run);
+    path.run = [run, enter, leave](const std::vector<TestCase>& cases) {
+        enter();
+        struct Leave {
+            const std::function<void()>& fn;
+            ~Leave() { fn(); }
+        } on_exit{leave};
+        return run(cases);
+    };
+    return path;
+}
+
+// ---- Matrix ----
+
+struct MatrixCell {
+    bool pass = true;           // every copy within the case tolerance of expected
+    bool bitwise = true;        // every copy bit-identical to the scalar result
+    double max_abs_error = 0.0;          // vs expected_output
+    double max_diff_from_scalar = 0.0;
+};
+
+struct MatrixRow {
+    std::string path;
+    bool bitwise_required = true;
+    std::vector<MatrixCell> cells;  // one per case
+
+    bool AllPass() const {
+        return std::all_of(cells.begin(), cells.end(), [](const MatrixCell& c) { return c.pass; });
+    }
+    bool AllBitwise() const {
+        return std::all_of(cells.begin(), cells.end(), [](const MatrixCell& c) { return c.bitwise; });
+    }
+    bool Ok() const { return AllPass() && (!bitwise_required || AllBitwise()); }
+};
+
+struct EquivalenceMatrix {
+    std::vector<std::string> cases;
+    std::vector<MatrixRow> rows;
+
+    bool Ok() const {
+        return std::all_of(rows.begin(), rows.end(), [](const MatrixRow& r) { return r.Ok(); });
+    }
+};
+
+namespace detail {
+
+// Bitwise comparison (so -0.0 vs 0.0 and NaN payloads count as differences)
+inline bool SameBits(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+} // namespace detail
+
+template <class Sig>
+EquivalenceMatrix BuildEquivalenceMatrix(const std::vector<ExecutionPath>& paths,
+                                         const std::vector<TestCase>& cases) {
+    EquivalenceMatrix m;
+    for (const auto& tc : cases) m.cases.push_back(tc.name);
+    std::vector<Values> scalar = RunAll<Sig>(cases, 1);
+
+    for (const auto& path : paths) {
+        MatrixRow row;
+        row.path = path.name;
+        row.bitwise_required = path.bitwise;
+        row.cells.resize(cases.size());
+
+        std::vector<Values> results = cases.empty() ? std::vector<Values>() : path.run(cases);
+        if (!cases.empty() && results.size() % cases.size() != 0) {
+            throw std::runtime_error("Path " + path.name + " returned a partial result set");
+        }
+
+        for (size_t j = 0; j < results.size(); j++) {
+            size_t i = j % cases.size();
+            const TestCase& tc = cases[i];
+            MatrixCell& cell = row.cells[i];
+            for (size_t o = 0; o < Sig::kOutputs.size(); o++) {
+                const auto& actual = results[j][o];
+                if (actual.size() != tc.expected[o].size() || actual.size() != scalar[i][o].size()) {
+                    cell.pass = cell.bitwise = false;
+                    continue;
+                }
+                for (size_t e = 0; e < actual.size(); e++) {
+                    double err = std::fabs(actual[e] - tc.expected[o][e]);
+                    if (!(err <= tc.abs_tolerance)) cell.pass = false;
+                    cell.max_abs_error = std::max(cell.max_abs_error, err);
+                    if (!detail::SameBits(actual[e], scalar[i][o][e])) {
+                        cell.bitwise = false;
+                        cell.max_diff_from_scalar =
+                            std::max(cell.max_diff_from_scalar, std::fabs(actual[e] - scalar[i][o][e]));
+                    }
+                }
+            }
+        }
+        m.rows.push_back(std::move(row));
+    }
+    return m;
+}
+
+// Text grid: '=' bit-identical to scalar, '~' within tolerance only,
+// 'X' outside tolerance.
+inline std::string FormatEquivalenceMatrix(const EquivalenceMatrix& m, const char* algo_name) {
+    std::ostringstream os;
+    size_t width = 8;
+    for (const auto& r : m.rows) width = std::max(width, r.path.size());
+
+    os << "\n" << std::string(60, '=') << "\n"
+       << "EQUIVALENCE MATRIX: " << algo_name << " (" << m.rows.size() << " paths x "
+       << m.cases.size() << " cases)\n"
+       << std::string(60, '=') << "\n";
+    os << std::string(width + 2, ' ');
+    for (size_t i = 0; i < m.cases.size(); i++) os << (i % 10);
+    os << "\n";
+    for (const auto& r : m.rows) {
+        os << r.path << std::string(width + 2 - r.path.size(), ' ');
+        for (const auto& c : r.cells) os << (!c.pass ? 'X' : c.bitwise ? '=' : '~');
+        os << (r.Ok() ? "" : "   <-- FAIL") << "\n";
+    }
+    os << "\n'=' bit-identical to scalar, '~' within tolerance only, 'X' outside tolerance\n";
+    for (size_t i = 0; i < m.cases.size(); i++) os << "  " << i << ": " << m.cases[i] << "\n";
+    return os.str();
+}
+
+inline nlohmann::json EquivalenceMatrixToJson(const EquivalenceMatrix& m, const char* algo_name) {
+    nlohmann::json j;
+    j["algorithm"] = algo_name;
+    j["cases"] = m.cases;
+    j["all_passed"] = m.Ok();
+    j["paths"] = nlohmann::json::array();
+    for (const auto& r : m.rows) {
+        nlohmann::json row;
+        row["path"] = r.path;
+        row["bitwise_required"] = r.bitwise_required;
+        row["all_pass"] = r.AllPass();
+        row["all_bitwise"] = r.AllBitwise();
+        row["cells"] = nlohmann::json::array();
+        for (size_t i = 0; i < r.cells.size(); i++) {
+            const MatrixCell& c = r.cells[i];
+            row["cells"].push_back({{"case", m.cases[i]},
+                                    {"pass", c.pass},
+                                    {"bitwise", c.bitwise},
+                                    {"max_absolute_error", c.max_abs_error},
+                                    {"max_diff_from_scalar", c.max_diff_from_scalar}});
+        }
+        j["paths"].push_back(std::move(row));
+    }
+    return j;
+}
+
+} // namespace harness
+
+#endif // HARNESS_EQUIVALENCE_MATRIX_H
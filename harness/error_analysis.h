@@ -0,0 +1,573 @@
+#ifndef HARNESS_ERROR_ANALYSIS_H
+#define HARNESS_ERROR_ANALYSIS_H
+
+// Error-distribution analysis of kernel variants (see variants.h).
+//
+// Every variant runs over a corpus — the JSON test vectors followed by
+// fuzz cases sampled from the schema envelope — and is compared with the
+// long double reference. Per output element we collect ULP error (in the
+// variant's own precision) and relative error histograms, then derive a
+// tolerance recommendation for the JSON vectors.
+//
+// Separately, the reference is re-run with Probe<long double> operands to
+// find catastrophic-cancellation sites: additions/subtractions whose result
+// is many bits smaller than their operands. Those are the places where a
+// variant's rounding differences get amplified.
+
+#include <dlfcn.h>
+#include <cxxabi.h>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "algorithm_harness.h"
+#include "fuzz_engine.h"
+#include "variants.h"
+
+namespace harness {
+
+// ---- ULP measurement ----
+
+// Spacing of T-representable numbers at |x| (one ULP in T).
+template <typename T>
+long double UlpOf(long double x) {
+    x = std::fabs(x);
+    if (!(x >= static_cast<long double>(std::numeric_limits<T>::min()))) {
+        return std::numeric_limits<T>::denorm_min();
+    }
+    return std::ldexp(1.0L, std::ilogb(x) - (std::numeric_limits<T>::digits - 1));
+}
+
+// |actual - ref| in units of T's ULP at ref. Matching NaNs/infinities are
+// zero error; any other non-finite mismatch is infinite.
+template <typename T>
+double UlpError(double actual, long double ref) {
+    if (std::isnan(actual) || std::isnan(ref)) {
+        return std::isnan(actual) && std::isnan(ref) ? 0.0 : std::numeric_limits<double>::infinity();
+    }
+    if (std::isinf(actual) || std::isinf(ref)) {
+        return actual == ref ? 0.0 : std::numeric_limits<double>::infinity();
+    }
+    return static_cast<double>(std::fabs(actual - ref) / UlpOf<T>(ref));
+}
+
+// ---- Histograms ----
+
+// Zero bin, then geometric bins (0, lo], (lo, lo*ratio], ... up to
+// lo*ratio^(bins-1), then an overflow bin (larger, infinite or NaN).
+class LogHistogram {
+public:
+    LogHistogram(double lo, double ratio, int bins)
+        : lo_(lo), ratio_(ratio), counts_(bins, 0) {}
+
+    void Add(double v) {
+        total_++;
+        if (v == 0.0) { zero_++; return; }
+        if (!(v <= UpperEdge(counts_.size() - 1))) { overflow_++; return; }
+        if (v <= lo_) { counts_[0]++; return; }
+        size_t i = static_cast<size_t>(std::ceil(std::log(v / lo_) / std::log(ratio_)));
+        counts_[std::min(i, counts_.size() - 1)]++;
+    }
+
+    void Merge(const LogHistogram& other) {
+        for (size_t i = 0; i < counts_.size(); i++) counts_[i] += other.counts_[i];
+        zero_ += other.zero_;
+        overflow_ += other.overflow_;
+        total_ += other.total_;
+    }
+
+    double UpperEdge(size_t bin) const { return lo_ * std::pow(ratio_, static_cast<double>(bin)); }
+
+    // Upper edge of the bin holding quantile q (0 if it falls in the zero bin)
+    double Quantile(double q) const {
+        uint64_t target = static_cast<uint64_t>(std::ceil(q * static_cast<double>(total_)));
+        uint64_t seen = zero_;
+        if (seen >= target) return 0.0;
+        for (size_t i = 0; i < counts_.size(); i++) {
+            seen += counts_[i];
+            if (seen >= target) return UpperEdge(i);
+        }
+        return std::numeric_limits<double>::infinity();
+    }
+
+    nlohmann::json ToJson() const {
+        nlohmann::json edges = nlohmann::json::array();
+        for (size_t i = 0; i < counts_.size(); i++) edges.push_back(UpperEdge(i));
+        return {{"zero", zero_}, {"upper_edges", edges}, {"counts", counts_}, {"overflow", overflow_}};
+    }
+
+private:
+    double lo_;
+    double ratio_;
+    std::vector<uint64_t> counts_;
+    uint64_t zero_ = 0;
+    uint64_t overflow_ = 0;
+    uint64_t total_ = 0;
+};
+
+// Statistics for one output element. Sequence outputs are pooled into a
+// single entry per field (element "*"), since their length varies by case.
+struct ElementStats {
+    size_t output = 0;
+    int element = -1;  // -1: pooled Sequence output
+    uint64_t count = 0;
+    double max_abs = 0.0;
+    double max_rel = 0.0;
+    double max_ulp = 0.0;
+    double sum_ulp = 0.0;
+    uint64_t worst_case = 0;  // corpus index of the max-ULP sample
+    LogHistogram ulp{0.0625, 2.0, 40};   // 1/16 ULP .. 2^35 ULP
+    LogHistogram rel{1e-20, 10.0, 21};   // 1e-20 .. 1
+
+    void Add(double abs_err, double rel_err, double ulp_err, uint64_t case_index) {
+        count++;
+        max_abs = std::max(max_abs, abs_err);
+        max_rel = std::max(max_rel, rel_err);
+        if (ulp_err > max_ulp || count == 1) {
+            max_ulp = ulp_err;
+            worst_case = case_index;
+        }
+        if (std::isfinite(ulp_err)) sum_ulp += ulp_err;
+        ulp.Add(ulp_err);
+        rel.Add(rel_err);
+    }
+
+    void Merge(const ElementStats& o) {
+        if (o.count == 0) return;
+        if (count == 0 || o.max_ulp > max_ulp) {
+            max_ulp = o.max_ulp;
+            worst_case = o.worst_case;
+        }
+        count += o.count;
+        max_abs = std::max(max_abs, o.max_abs);
+        max_rel = std::max(max_rel, o.max_rel);
+        sum_ulp += o.sum_ulp;
+        ulp.Merge(o.ulp);
+        rel.Merge(o.rel);
+    }
+};
+
+// One stats slot per Fixed/Scalar output element, one per Sequence output.
+template <class Sig>
+std::vector<ElementStats> MakeElementSlots(std::vector<size_t>& first_slot) {
+    std::vector<ElementStats> slots;
+    first_slot.clear();
+    for (size_t o = 0; o < Sig::kOutputs.size(); o++) {
+        const Field& f = Sig::kOutputs[o];
+        first_slot.push_back(slots.size());
+        int n = f.shape == Shape::Sequence ? 1 : f.size;
+        for (int e = 0; e < n; e++) {
+            ElementStats s;
+            s.output = o;
+            s.element = f.shape == Shape::Sequence ? -1 : e;
+            slots.push_back(s);
+        }
+    }
+    return slots;
+}
+
+template <class Sig>
+std::string ElementLabel(const ElementStats& s) {
+    std::string label = Sig::kOutputs[s.output].name;
+    return label + "[" + (s.element < 0 ? std::string("*") : std::to_string(s.element)) + "]";
+}
+
+// ---- Corpus ----
+
+// Test vectors first, then fuzz cases drawn from the schema envelope.
+struct Corpus {
+    std::vector<TestCase> vectors;
+    std::vector<InputDomain> domains;
+    uint64_t fuzz_cases = 0;
+    uint64_t seed = 1;
+
+    uint64_t Size() const { return vectors.size() + fuzz_cases; }
+
+    template <class Sig>
+    void Get(uint64_t i, Values& in) const {
+        if (i < vectors.size()) {
+            in = vectors[i].inputs;
+        } else {
+            SampleCase<Sig>(domains, seed, i - vectors.size(), in);
+        }
+    }
+
+    std::string Describe(uint64_t i) const {
+        if (i < vectors.size()) return "vector " + vectors[i].name;
+        return "fuzz seed " + std::to_string(seed) + " case " + std::to_string(i - vectors.size());
+    }
+};
+
+struct AnalysisOptions {
+    unsigned threads = DefaultThreadCount();
+    double cancellation_bits = 16.0;  // flag sites losing at least this many bits
+    double safety_factor = 4.0;       // headroom applied before rounding up tolerances
+};
+
+// ---- Variant analysis ----
+
+struct VariantAnalysis {
+    std::string name;
+    std::string description;
+    std::string precision;
+    std::vector<ElementStats> elements;
+    std::vector<std::string> failing_vectors;  // vs expected_output at current tolerance
+    uint64_t vectors_checked = 0;
+};
+
+template <class Sig, class Ref, class Variant>
+VariantAnalysis AnalyzeVariant(const Corpus& corpus, const AnalysisOptions& opts) {
+    using Scalar = typename Variant::Scalar;
+    constexpr uint64_t kChunk = 1024;
+
+    VariantAnalysis result;
+    result.name = Variant::kName;
+    result.description = Variant::kDescription;
+    result.precision = PrecisionName<Scalar>::kValue;
+
+    std::vector<size_t> first_slot;
+    result.elements = MakeElementSlots<Sig>(first_slot);
+    // Bytes, not vector<bool>: its packed bits would make neighbouring cases
+    // in different chunks write the same word
+    std::vector<unsigned char> vector_failed(corpus.vectors.size(), 0);
+    std::mutex merge_mutex;
+
+    uint64_t n = corpus.Size();
+    size_t n_chunks = static_cast<size_t>((n + kChunk - 1) / kChunk);
+    ParallelFor(n_chunks, opts.threads, [&](size_t chunk) {
+        std::vector<size_t> unused;
+        std::vector<ElementStats> local = MakeElementSlots<Sig>(unused);
+        Values in, out;
+        WideValues ref;
+
+        uint64_t end = std::min(n, (chunk + 1) * kChunk);
+        for (uint64_t idx = chunk * kChunk; idx < end; idx++) {
+            corpus.Get<Sig>(idx, in);
+            ResizeOutputs<Sig>(in, out);
+            ResizeOutputs<Sig>(in, ref);
+            Variant::Invoke(in, out);
+            Ref::Invoke(in, ref);
+
+            for (size_t o = 0; o < Sig::kOutputs.size(); o++) {
+                bool pooled = Sig::kOutputs[o].shape == Shape::Sequence;
+                for (size_t e = 0; e < out[o].size(); e++) {
+                    long double r = ref[o][e];
+                    double abs_err = static_cast<double>(std::fabs(out[o][e] - r));
+                    double ulp_err = UlpError<Scalar>(out[o][e], r);
+                    double rel_err = abs_err / std::max(static_cast<double>(std::fabs(r)),
+                                                        std::numeric_limits<double>::min());
+                    if (std::isinf(ulp_err)) abs_err = rel_err = ulp_err;
+                    local[first_slot[o] + (pooled ? 0 : e)].Add(abs_err, rel_err, ulp_err, idx);
+                }
+            }
+
+            if (idx < corpus.vectors.size()) {
+                const TestCase& tc = corpus.vectors[idx];
+                for (size_t o = 0; o < Sig::kOutputs.size(); o++) {
+                    for (size_t e = 0; e < out[o].size() && e < tc.expected[o].size(); e++) {
+                        if (!(std::fabs(out[o][e] - tc.expected[o][e]) <= tc.abs_tolerance)) {
+                            vector_failed[idx] = 1;  // distinct index per case: no race
+                        }
+                    }
+                }
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(merge_mutex);
+        for (size_t s = 0; s < local.size(); s++) result.elements[s].Merge(local[s]);
+    });
+
+    result.vectors_checked = corpus.vectors.size();
+    for (size_t i = 0; i < corpus.vectors.size(); i++) {
+        if (vector_failed[i]) result.failing_vectors.push_back(corpus.vectors[i].name);
+    }
+    return result;
+}
+
+// Smallest power of ten >= x * safety (at least 1e-16).
+inline double RoundUpTolerance(double x, double safety) {
+    double v = std::max(x * safety, 1e-16);
+    if (!std::isfinite(v)) return v;
+    double p = std::pow(10.0, std::ceil(std::log10(v)));
+    return p < v ? p * 10.0 : p;
+}
+
+// ---- Cancellation probe ----
+
+struct CancellationSite {
+    const void* address = nullptr;
+    char op = '+';
+    uint32_t ordinal = 0;        // n-th addition/subtraction within one call
+    uint64_t hits = 0;           // evaluations losing >= threshold bits
+    uint64_t evaluations = 0;
+    double worst_bits = 0.0;
+    long double worst_a = 0.0L;
+    long double worst_b = 0.0L;
+    uint64_t worst_case = 0;
+};
+
+// Per-thread record of additions/subtractions, keyed by call site.
+class CancellationLog {
+public:
+    explicit CancellationLog(double threshold_bits) : threshold_bits_(threshold_bits) {}
+
+    // Log receiving records from Probe arithmetic on this thread
+    static CancellationLog*& Current() {
+        thread_local CancellationLog* log = nullptr;
+        return log;
+    }
+
+    void BeginCase(uint64_t case_index) {
+        case_ = case_index;
+        ordinal_ = 0;
+    }
+
+    void Record(const void* address, char op, long double a, long double b, long double r) {
+        CancellationSite& s = sites_[address];
+        if (s.evaluations == 0) {
+            s.address = address;
+            s.op = op;
+            s.ordinal = ordinal_;
+        }
+        ordinal_++;
+        s.evaluations++;
+
+        long double big = std::max(std::fabs(a), std::fabs(b));
+        if (big == 0.0L || std::isnan(r) || std::isinf(big)) return;
+        double bits = r == 0.0L ? std::numeric_limits<long double>::digits
+                                : static_cast<double>(std::log2(big / std::fabs(r)));
+        if (bits >= threshold_bits_) s.hits++;
+        if (bits > s.worst_bits) {
+            s.worst_bits = bits;
+            s.worst_a = a;
+            s.worst_b = b;
+            s.worst_case = case_;
+        }
+    }
+
+    void Merge(const CancellationLog& other) {
+        for (const auto& kv : other.sites_) {
+            CancellationSite& s = sites_[kv.first];
+            const CancellationSite& o = kv.second;
+            if (s.evaluations == 0) {
+                s = o;
+                continue;
+            }
+            s.ordinal = std::min(s.ordinal, o.ordinal);
+            s.hits += o.hits;
+            s.evaluations += o.evaluations;
+            if (o.worst_bits > s.worst_bits) {
+                s.worst_bits = o.worst_bits;
+                s.worst_a = o.worst_a;
+                s.worst_b = o.worst_b;
+                s.worst_case = o.worst_case;
+            }
+        }
+    }
+
+    // Sites with at least one hit, most frequent first
+    std::vector<CancellationSite> FlaggedSites() const {
+        std::vector<CancellationSite> out;
+        for (const auto& kv : sites_) {
+            if (kv.second.hits > 0) out.push_back(kv.second);
+        }
+        std::sort(out.begin(), out.end(), [](const CancellationSite& a, const CancellationSite& b) {
+            return a.hits != b.hits ? a.hits > b.hits : a.ordinal < b.ordinal;
+        });
+        return out;
+    }
+
+private:
+    double threshold_bits_;
+    std::unordered_map<const void*, CancellationSite> sites_;
+    uint64_t case_ = 0;
+    uint32_t ordinal_ = 0;
+};
+
+// Arithmetic type that reports every addition and subtraction to the
+// current CancellationLog, keyed by the caller's return address — one key
+// per source-level operation in the instantiated reference.
+template <typename T>
+class Probe {
+public:
+    Probe() = default;
+    template <typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+    Probe(U v) : v_(static_cast<T>(v)) {}
+
+    explicit operator T() const { return v_; }
+    template <typename U, typename = std::enable_if_t<std::is_floating_point<U>::value>>
+    explicit operator U() const { return static_cast<U>(v_); }
+
+    __attribute__((noinline)) Probe& operator+=(Probe b) {
+        *this = Combine(__builtin_return_address(0), '+', v_, b.v_);
+        return *this;
+    }
+    __attribute__((noinline)) Probe& operator-=(Probe b) {
+        *this = Combine(__builtin_return_address(0), '-', v_, -b.v_);
+        return *this;
+    }
+    Probe& operator*=(Probe b) { v_ *= b.v_; return *this; }
+    Probe& operator/=(Probe b) { v_ /= b.v_; return *this; }
+
+    Probe operator-() const { return Probe(-v_); }
+
+    static Probe Combine(const void* site, char op, T a, T b) {
+        T r = a + b;
+        if (CancellationLog* log = CancellationLog::Current()) {
+            log->Record(site, op, a, op == '-' ? -b : b, r);
+        }
+        return Probe(r);
+    }
+
+    T v_{};
+};
+
+template <typename T>
+__attribute__((noinline)) Probe<T> operator+(Probe<T> a, Probe<T> b) {
+    return Probe<T>::Combine(__builtin_return_address(0), '+', a.v_, b.v_);
+}
+
+template <typename T>
+__attribute__((noinline)) Probe<T> operator-(Probe<T> a, Probe<T> b) {
+    return Probe<T>::Combine(__builtin_return_address(0), '-', a.v_, -b.v_);
+}
+
+template <typename T>
+Probe<T> operator*(Probe<T> a, Probe<T> b) { return Probe<T>(a.v_ * b.v_); }
+
+template <typename T>
+Probe<T> operator/(Probe<T> a, Probe<T> b) { return Probe<T>(a.v_ / b.v_); }
+
+// Run the reference over the corpus with probed arithmetic.
+template <class Sig, class Ref>
+std::vector<CancellationSite> AnalyzeCancellation(const Corpus& corpus, const AnalysisOptions& opts) {
+    constexpr uint64_t kChunk = 1024;
+    CancellationLog merged(opts.cancellation_bits);
+    std::mutex merge_mutex;
+
+    uint64_t n = corpus.Size();
+    size_t n_chunks = static_cast<size_t>((n + kChunk - 1) / kChunk);
+    ParallelFor(n_chunks, opts.threads, [&](size_t chunk) {
+        CancellationLog log(opts.cancellation_bits);
+        CancellationLog::Current() = &log;
+        Values in;
+        std::vector<std::vector<Probe<long double>>> out;
+
+        uint64_t end = std::min(n, (chunk + 1) * kChunk);
+        for (uint64_t idx = chunk * kChunk; idx < end; idx++) {
+            corpus.Get<Sig>(idx, in);
+            ResizeOutputs<Sig>(in, out);
+            log.BeginCase(idx);
+            Ref::template Evaluate<Probe<long double>>(in, out);
+        }
+        CancellationLog::Current() = nullptr;
+
+        std::lock_guard<std::mutex> lock(merge_mutex);
+        merged.Merge(log);
+    });
+    return merged.FlaggedSites();
+}
+
+// "function+0xoff" (needs the executable's symbols exported; parameter
+// list dropped) and the module-relative address for addr2line.
+inline std::pair<std::string, std::string> DescribeSite(const void* address) {
+    Dl_info info{};
+    std::ostringstream where, offset;
+    offset << "0x" << std::hex
+           << (dladdr(address, &info) ? reinterpret_cast<uintptr_t>(address) -
+                                            reinterpret_cast<uintptr_t>(info.dli_fbase)
+                                      : reinterpret_cast<uintptr_t>(address));
+    if (info.dli_sname != nullptr) {
+        int status = 0;
+        std::unique_ptr<char, void (*)(void*)> demangled(
+            abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status), std::free);
+        std::string name = status == 0 ? demangled.get() : info.dli_sname;
+        where << name.substr(0, name.find('(')) << "+0x" << std::hex
+              << (reinterpret_cast<uintptr_t>(address) - reinterpret_cast<uintptr_t>(info.dli_saddr));
+    } else {
+        where << "<unknown>";
+    }
+    return {where.str(), offset.str()};
+}
+
+// ---- Reporting ----
+
+template <class Sig>
+nlohmann::json VariantToJson(const VariantAnalysis& v, const AnalysisOptions& opts) {
+    nlohmann::json j;
+    j["name"] = v.name;
+    j["description"] = v.description;
+    j["precision"] = v.precision;
+
+    j["elements"] = nlohmann::json::array();
+    std::vector<double> out_abs(Sig::kOutputs.size(), 0.0), out_rel(Sig::kOutputs.size(), 0.0);
+    for (const auto& s : v.elements) {
+        out_abs[s.output] = std::max(out_abs[s.output], s.max_abs);
+        out_rel[s.output] = std::max(out_rel[s.output], s.max_rel);
+        j["elements"].push_back({
+            {"element", ElementLabel<Sig>(s)},
+            {"samples", s.count},
+            {"max_ulp", s.max_ulp},
+            {"mean_ulp", s.count ? s.sum_ulp / static_cast<double>(s.count) : 0.0},
+            {"p99_ulp", s.ulp.Quantile(0.99)},
+            {"p999_ulp", s.ulp.Quantile(0.999)},
+            {"max_absolute_error", s.max_abs},
+            {"max_relative_error", s.max_rel},
+            {"ulp_histogram", s.ulp.ToJson()},
+            {"relative_error_histogram", s.rel.ToJson()},
+        });
+    }
+
+    double global_abs = 0.0, global_rel = 0.0;
+    for (size_t o = 0; o < Sig::kOutputs.size(); o++) {
+        double a = RoundUpTolerance(out_abs[o], opts.safety_factor);
+        double r = RoundUpTolerance(out_rel[o], opts.safety_factor);
+        j["recommended_tolerance"]["outputs"][Sig::kOutputs[o].name] = {{"absolute", a}, {"relative", r}};
+        global_abs = std::max(global_abs, a);
+        global_rel = std::max(global_rel, r);
+    }
+    // Paste-ready for the "global_tolerance" of a vector file
+    j["recommended_tolerance"]["global_tolerance"] = {{"absolute", global_abs}, {"relative", global_rel}};
+
+    j["test_vectors"] = {{"checked", v.vectors_checked},
+                         {"failing_current_tolerance", v.failing_vectors}};
+    return j;
+}
+
+inline nlohmann::json CancellationToJson(const std::vector<CancellationSite>& sites, const Corpus& corpus,
+                                         const AnalysisOptions& opts) {
+    nlohmann::json j;
+    j["threshold_bits"] = opts.cancellation_bits;
+    j["sites"] = nlohmann::json::array();
+    for (const auto& s : sites) {
+        auto where = DescribeSite(s.address);
+        j["sites"].push_back({
+            {"operation", std::string(1, s.op)},
+            {"ordinal", s.ordinal},
+            {"function", where.first},
+            {"addr2line_address", where.second},
+            {"hits", s.hits},
+            {"evaluations", s.evaluations},
+            {"worst_bits_lost", s.worst_bits},
+            {"worst_operands", {static_cast<double>(s.worst_a), static_cast<double>(s.worst_b)}},
+            {"worst_case", corpus.Describe(s.worst_case)},
+        });
+    }
+    return j;
+}
+
+} // namespace harness
+
+#endif // HARNESS_ERROR_ANALYSIS_H
@@ -0,0 +1,459 @@
+#ifndef HARNESS_FUZZ_ENGINE_H
+#define HARNESS_FUZZ_ENGINE_H
+
+// Randomized equivalence fuzzing against a high-precision reference.
+//
+// Inputs are sampled inside the operating envelope declared in the
+// algorithm's test_vectors/schema.json, with a counter-based RNG keyed by
+// (seed, case index) so any case can be regenerated from the report. Each
+// case runs the generated double-precision function and the algorithm's
+// long double Reference; outputs are compared with the mixed criterion
+//
+//   |actual - reference| <= abs_tol + rel_tol * |reference|
+//
+// The worst cases are shrunk to minimal reproducers emitted as JSON test
+// cases that can be pasted into test_vectors/.
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "algorithm_harness.h"
+#include "counter_rng.h"
+
+namespace harness {
+
+// ---- Input space (from schema.json) ----
+
+struct InputDomain {
+    double lo = 0.0;
+    double hi = 0.0;
+    bool log_scale = false;     // x-fuzz-scale: "log" (requires lo > 0)
+    int min_len = 1;            // Sequence inputs only
+    int max_len = 1;
+    bool spd = false;           // x-fuzz-structure: "symmetric_positive_definite"
+    double min_diagonal = 0.0;  // x-fuzz-min-diagonal for spd inputs
+};
+
+namespace detail {
+
+inline void ReadBounds(const nlohmann::json& node, InputDomain& d, const std::string& field) {
+    if (!node.contains("minimum") || !node.contains("maximum")) {
+        throw std::runtime_error("schema.json: input '" + field + "' needs minimum and maximum");
+    }
+    d.lo = node["minimum"].get<double>();
+    d.hi = node["maximum"].get<double>();
+    if (node.contains("exclusiveMinimum") && d.lo <= node["exclusiveMinimum"].get<double>()) {
+        d.lo = std::nextafter(node["exclusiveMinimum"].get<double>(), d.hi);
+    }
+}
+
+} // namespace detail
+
+template <class Sig>
+std::vector<InputDomain> LoadInputDomains(const std::string& schema_path) {
+    std::ifstream f(schema_path);
+    if (!f.is_open()) throw std::runtime_error("Cannot open schema: " + schema_path);
+    nlohmann::json schema = nlohmann::json::parse(f);
+
+    const nlohmann::json& props =
+        schema["properties"]["test_cases"]["items"]["properties"]["inputs"]["properties"];
+
+    std::vector<InputDomain> domains;
+    for (const Field& field : Sig::kInputs) {
+        if (!props.contains(field.name)) {
+            throw std::runtime_error("schema.json has no bounds for input '" + std::string(field.name) + "'");
+        }
+        const nlohmann::json& node = props[field.name];
+        InputDomain d;
+        if (field.shape == Shape::Scalar) {
+            detail::ReadBounds(node, d, field.name);
+        } else {
+            detail::ReadBounds(node["items"], d, field.name);
+            d.min_len = node.value("minItems", field.shape == Shape::Fixed ? field.size : 1);
+            d.max_len = node.value("maxItems", field.size);
+            if (field.shape == Shape::Fixed) d.min_len = d.max_len = field.size;
+        }
+        d.log_scale = node.value("x-fuzz-scale", "") == "log";
+        d.spd = node.value("x-fuzz-structure", "") == "symmetric_positive_definite";
+        d.min_diagonal = node.value("x-fuzz-min-diagonal", d.spd ? std::max(d.lo, 1e-12) : d.lo);
+        if (d.log_scale && !d.spd && d.lo <= 0.0) {
+            throw std::runtime_error("schema.json: log-scaled input '" + std::string(field.name) +
+                                     "' needs a positive minimum");
+        }
+        domains.push_back(d);
+    }
+    return domains;
+}
+
+// Limit sampled Sequence lengths to max_length (no-op if max_length <= 0).
+inline void CapSequenceLength(std::vector<InputDomain>& domains, int max_length) {
+    if (max_length <= 0) return;
+    for (auto& d : domains) d.max_len = std::min(d.max_len, std::max(d.min_len, max_length));
+}
+
+// ---- Sampling ----
+
+inline double SampleScalar(const InputDomain& d, CounterRng& rng) {
+    return d.log_scale ? rng.LogUniform(d.lo, d.hi) : rng.Uniform(d.lo, d.hi);
+}
+
+// Random symmetric positive definite n x n matrix (row-major) with variances
+// in [min_diagonal, hi]: a random Gram matrix rescaled to those variances.
+inline void SampleSpd(const InputDomain& d, int n, CounterRng& rng, std::vector<double>& out) {
+    std::vector<double> a(n * n), gram(n * n), var(n);
+    for (double& v : a) v = rng.Uniform(-1.0, 1.0);
+    for (int i = 0; i < n; i++) {
+        var[i] = d.log_scale ? rng.LogUniform(d.min_diagonal, d.hi) : rng.Uniform(d.min_diagonal, d.hi);
+        for (int j = 0; j < n; j++) {
+            double s = (i == j) ? 1e-3 : 0.0;  // keep it strictly definite
+            for (int k = 0; k < n; k++) s += a[i * n + k] * a[j * n + k];
+            gram[i * n + j] = s;
+        }
+    }
+    out.resize(n * n);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            out[i * n + j] = i == j ? var[i]
+                : gram[i * n + j] * std::sqrt(var[i] * var[j] / (gram[i * n + i] * gram[j * n + j]));
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        for (int j = i + 1; j < n; j++) out[j * n + i] = out[i * n + j];  // exact symmetry
+    }
+}
+
+// Inputs for case `index` of run `seed`. Overwrites `in`, reusing its storage.
+template <class Sig>
+void SampleCase(const std::vector<InputDomain>& domains, uint64_t seed, uint64_t index, Values& in) {
+    CounterRng rng(seed, index);
+    in.resize(Sig::kInputs.size());
+    for (size_t i = 0; i < Sig::kInputs.size(); i++) {
+        const Field& f = Sig::kInputs[i];
+        const InputDomain& d = domains[i];
+        if (f.shape == Shape::Scalar) {
+            in[i].assign(1, SampleScalar(d, rng));
+            continue;
+        }
+        int len = f.shape == Shape::Fixed ? f.size : rng.UniformInt(d.min_len, d.max_len);
+        if (d.spd) {
+            int n = static_cast<int>(std::lround(std::sqrt(static_cast<double>(len))));
+            if (n * n != len) throw std::runtime_error("spd input '" + std::string(f.name) + "' is not square");
+            SampleSpd(d, n, rng, in[i]);
+        } else {
+            in[i].resize(len);
+            for (double& v : in[i]) v = SampleScalar(d, rng);
+        }
+    }
+}
+
+// ---- Comparison ----
+
+struct ErrorSample {
+    double abs_err = 0.0;
+    double rel_err = 0.0;
+    double excess = 0.0;  // abs_err / (abs_tol + rel_tol * |ref|); > 1 fails
+    size_t output = 0;
+    size_t element = 0;
+};
+
+struct FuzzOptions {
+    uint64_t seed = 1;
+    uint64_t cases = 1000000;
+    unsigned threads = DefaultThreadCount();
+    double abs_tol = kDefaultAbsTolerance;
+    double rel_tol = 1e-8;
+    int max_length = -1;       // cap on Sequence input lengths (-1: schema maxItems)
+    size_t reproducers = 5;    // failing cases to shrink and report
+};
+
+// Per-output maxima plus the element with the largest tolerance excess.
+template <class Sig>
+ErrorSample CompareToReference(const Values& actual, const WideValues& ref, const FuzzOptions& opts,
+                               std::vector<double>* max_abs = nullptr,
+                               std::vector<double>* max_rel = nullptr) {
+    ErrorSample worst;
+    worst.excess = -1.0;
+    for (size_t o = 0; o < Sig::kOutputs.size(); o++) {
+        for (size_t i = 0; i < actual[o].size(); i++) {
+            double a = actual[o][i];
+            long double r = ref[o][i];
+            double abs_err, rel_err, excess;
+            if (!std::isfinite(a) || !std::isfinite(r)) {
+                // As UlpError(): exact only for the same infinity or NaN on
+                // both sides (|inf - x| / (tol * inf) would be NaN)
+                abs_err = rel_err = excess = a == r || (std::isnan(a) && std::isnan(r))
+                    ? 0.0
+                    : std::numeric_limits<double>::infinity();
+            } else {
+                abs_err = static_cast<double>(std::fabs(static_cast<long double>(a) - r));
+                double mag = static_cast<double>(std::fabs(r));
+                rel_err = abs_err / std::max(mag, std::numeric_limits<double>::min());
+                excess = abs_err / (opts.abs_tol + opts.rel_tol * mag);
+                // A reference finite in long double but beyond double's range
+                if (std::isnan(excess)) excess = std::numeric_limits<double>::infinity();
+            }
+            if (max_abs) (*max_abs)[o] = std::max((*max_abs)[o], abs_err);
+            if (max_rel) (*max_rel)[o] = std::max((*max_rel)[o], rel_err);
+            if (excess > worst.excess) worst = {abs_err, rel_err, excess, o, i};
+        }
+    }
+    return worst;
+}
+
+template <class Sig, class Ref>
+ErrorSample EvaluateCase(const Values& in, const FuzzOptions& opts) {
+    Values out = AllocateOutputs<Sig>(in);
+    WideValues ref = AllocateOutputs<Sig, long double>(in);
+    Sig::Invoke(in, out);
+    Ref::Invoke(in, ref);
+    return CompareToReference<Sig>(out, ref, opts);
+}
+
+// ---- Reproducer shrinking ----
+
+// Greedily simplify `in` while the discrepancy stays at or above
+// `min_excess`: shorten sequences, then replace values by 0/±1 or by
+// shorter decimal roundings. Results always stay inside the domains.
+template <class Sig, class Ref>
+Values Shrink(Values in, const std::vector<InputDomain>& domains, double min_excess,
+              const FuzzOptions& opts) {
+    auto holds = [&](const Values& v) { return EvaluateCase<Sig, Ref>(v, opts).excess >= min_excess; };
+    auto inside = [](const InputDomain& d, double v) { return v >= d.lo && v <= d.hi; };
+
+    for (int pass = 0; pass < 4; pass++) {
+        bool changed = false;
+
+        for (size_t i = 0; i < Sig::kInputs.size(); i++) {
+            if (Sig::kInputs[i].shape != Shape::Sequence) continue;
+            while (static_cast<int>(in[i].size()) > domains[i].min_len) {
+                size_t keep = std::max<size_t>(domains[i].min_len, in[i].size() / 2);
+                Values head = in, tail = in;
+                head[i].resize(keep);
+                tail[i].erase(tail[i].begin(), tail[i].end() - keep);
+                if (holds(head)) { in = std::move(head); changed = true; }
+                else if (holds(tail)) { in = std::move(tail); changed = true; }
+                else break;
+            }
+        }
+
+        for (size_t i = 0; i < Sig::kInputs.size(); i++) {
+            const InputDomain& d = domains[i];
+            for (size_t e = 0; e < in[i].size(); e++) {
+                double original = in[i][e];
+                std::vector<double> candidates;
+                if (!d.spd) candidates.insert(candidates.end(), {0.0, 1.0, -1.0});
+                for (int digits = 1; digits <= 6; digits++) {
+                    std::ostringstream os;
+                    os.precision(digits);
+                    os << original;
+                    candidates.push_back(std::stod(os.str()));
+                }
+                for (double c : candidates) {
+                    if (c == original || !inside(d, c)) continue;
+                    Values trial = in;
+                    trial[i][e] = c;
+                    if (d.spd) {  // keep the mirrored element in step
+                        int n = static_cast<int>(std::lround(std::sqrt(static_cast<double>(in[i].size()))));
+                        size_t mirror = (e % n) * n + e / n;
+                        trial[i][mirror] = c;
+                    }
+                    if (holds(trial)) { in = std::move(trial); changed = true; break; }
+                }
+            }
+        }
+
+        if (!changed) break;
+    }
+    return in;
+}
+
+// ---- Engine ----
+
+struct FuzzFinding {
+    uint64_t index = 0;
+    Values inputs;
+    ErrorSample error;
+};
+
+struct FuzzReport {
+    uint64_t cases = 0;
+    uint64_t failures = 0;
+    double seconds = 0.0;
+    std::vector<double> max_abs;  // per output
+    std::vector<double> max_rel;  // per output
+    FuzzFinding worst;            // largest tolerance excess
+    std::vector<FuzzFinding> failing;       // lowest-index failures (before shrinking)
+    std::vector<FuzzFinding> reproducers;   // shrunk versions of `failing` (or of `worst`)
+};
+
+template <class Sig, class Ref>
+FuzzReport RunFuzz(std::vector<InputDomain> domains, const FuzzOptions& opts) {
+    CapSequenceLength(domains, opts.max_length);
+
+    constexpr uint64_t kChunk = 4096;
+    const size_t n_out = Sig::kOutputs.size();
+    std::atomic<uint64_t> next_chunk{0};
+    std::mutex merge_mutex;
+
+    FuzzReport report;
+    report.cases = opts.cases;
+    report.max_abs.assign(n_out, 0.0);
+    report.max_rel.assign(n_out, 0.0);
+    report.worst.error.excess = -1.0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    auto worker = [&] {
+        Values in, out;
+        WideValues ref;
+        std::vector<double> max_abs(n_out, 0.0), max_rel(n_out, 0.0);
+        uint64_t failures = 0;
+        // Index and error only; the inputs are resampled after the run
+        uint64_t worst_index = 0;
+        ErrorSample worst;
+        worst.excess = -1.0;
+        std::vector<FuzzFinding> failing;
+
+        for (;;) {
+            uint64_t begin = next_chunk++ * kChunk;
+            if (begin >= opts.cases) break;
+            uint64_t end = std::min(opts.cases, begin + kChunk);
+
+            for (uint64_t idx = begin; idx < end; idx++) {
+                SampleCase<Sig>(domains, opts.seed, idx, in);
+                ResizeOutputs<Sig>(in, out);
+                ResizeOutputs<Sig>(in, ref);
+                Sig::Invoke(in, out);
+                Ref::Invoke(in, ref);
+
+                ErrorSample e = CompareToReference<Sig>(out, ref, opts, &max_abs, &max_rel);
+                if (e.excess > worst.excess || (e.excess == worst.excess && idx < worst_index)) {
+                    worst_index = idx;
+                    worst = e;
+                }
+                if (e.excess > 1.0) {
+                    failures++;
+                    if (failing.size() < opts.reproducers) failing.push_back({idx, in, e});
+                }
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(merge_mutex);
+        report.failures += failures;
+        for (size_t o = 0; o < n_out; o++) {
+            report.max_abs[o] = std::max(report.max_abs[o], max_abs[o]);
+            report.max_rel[o] = std::max(report.max_rel[o], max_rel[o]);
+        }
+        if (worst.excess > report.worst.error.excess ||
+            (worst.excess == report.worst.error.excess && worst_index < report.worst.index)) {
+            report.worst.index = worst_index;
+            report.worst.error = worst;
+        }
+        for (auto& f : failing) report.failing.push_back(std::move(f));
+    };
+
+    unsigned threads = std::max(1u, opts.threads);
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; t++) pool.emplace_back(worker);
+    worker();
+    for (auto& t : pool) t.join();
+
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (report.worst.error.excess >= 0.0) {
+        SampleCase<Sig>(domains, opts.seed, report.worst.index, report.worst.inputs);
+    }
+
+    // Keep the lowest-index failures so the report does not depend on scheduling
+    std::sort(report.failing.begin(), report.failing.end(),
+              [](const FuzzFinding& a, const FuzzFinding& b) { return a.index < b.index; });
+    if (report.failing.size() > opts.reproducers) report.failing.resize(opts.reproducers);
+
+    // Failing runs shrink each failure past tolerance; passing runs shrink
+    // the worst case while it keeps at least half its excess.
+    if (!report.failing.empty()) {
+        for (const auto& f : report.failing) {
+            Values small = Shrink<Sig, Ref>(f.inputs, domains, 1.0, opts);
+            report.reproducers.push_back({f.index, small, EvaluateCase<Sig, Ref>(small, opts)});
+        }
+    } else if (report.worst.error.excess > 0.0) {
+        Values small = Shrink<Sig, Ref>(report.worst.inputs, domains, 0.5 * report.worst.error.excess, opts);
+        report.reproducers.push_back({report.worst.index, small, EvaluateCase<Sig, Ref>(small, opts)});
+    }
+    return report;
+}
+
+// ---- Reporting ----
+
+// A reproducer as a test_vectors/*.json test case (expected output from the reference).
+template <class Sig, class Ref>
+nlohmann::json ReproducerToJson(const FuzzFinding& f, const FuzzOptions& opts) {
+    WideValues ref = AllocateOutputs<Sig, long double>(f.inputs);
+    Ref::Invoke(f.inputs, ref);
+
+    nlohmann::json tc;
+    tc["name"] = std::string("fuzz_") + Sig::kName + "_s" + std::to_string(opts.seed) +
+                 "_c" + std::to_string(f.index);
+    tc["description"] = std::string("Shrunk fuzz reproducer: ") + Sig::kOutputs[f.error.output].name +
+                        "[" + std::to_string(f.error.element) + "] differs from the long double reference";
+    tc["tags"] = {"fuzz", "regression"};
+    for (size_t i = 0; i < Sig::kInputs.size(); i++) {
+        tc["inputs"][Sig::kInputs[i].name] = FieldToJson(Sig::kInputs[i], f.inputs[i]);
+    }
+    for (size_t o = 0; o < Sig::kOutputs.size(); o++) {
+        std::vector<double> rounded(ref[o].begin(), ref[o].end());
+        tc["expected_output"][Sig::kOutputs[o].name] = FieldToJson(Sig::kOutputs[o], rounded);
+    }
+    tc["tolerance"] = {{"absolute", opts.abs_tol}, {"relative", opts.rel_tol}};
+    tc["metadata"] = {{"source", std::string("fuzz_") + Sig::kName + " --seed " +
+                                     std::to_string(opts.seed) + " (case " + std::to_string(f.index) + ")"}};
+    return tc;
+}
+
+template <class Sig>
+nlohmann::json FindingToJson(const FuzzFinding& f) {
+    return {
+        {"case_index", f.index},
+        {"output", Sig::kOutputs[f.error.output].name},
+        {"element", f.error.element},
+        {"absolute_error", f.error.abs_err},
+        {"relative_error", f.error.rel_err},
+        {"tolerance_excess", f.error.excess},
+    };
+}
+
+template <class Sig, class Ref>
+nlohmann::json FuzzReportToJson(const FuzzReport& r, const FuzzOptions& opts) {
+    nlohmann::json j;
+    j["algorithm"] = Sig::kName;
+    j["seed"] = opts.seed;
+    j["cases"] = r.cases;
+    j["threads"] = opts.threads;
+    j["seconds"] = r.seconds;
+    j["tolerance"] = {{"absolute", opts.abs_tol}, {"relative", opts.rel_tol}};
+    j["failures"] = r.failures;
+    j["all_passed"] = r.failures == 0;
+    for (size_t o = 0; o < Sig::kOutputs.size(); o++) {
+        j["max_error"][Sig::kOutputs[o].name] = {{"absolute", r.max_abs[o]}, {"relative", r.max_rel[o]}};
+    }
+    j["worst_case"] = FindingToJson<Sig>(r.worst);
+    j["reproducers"] = nlohmann::json::array();
+    for (const auto& f : r.reproducers) j["reproducers"].push_back(ReproducerToJson<Sig, Ref>(f, opts));
+    return j;
+}
+
+} // namespace harness
+
+#endif // HARNESS_FUZZ_ENGINE_H
@@ -0,0 +1,174 @@
+#ifndef HARNESS_GTEST_HARNESS_H
+#define HARNESS_GTEST_HARNESS_H
+
+// Google Test glue for the table-driven harness.
+//
+// A per-algorithm test file only has to name its fixture and instantiate it:
+//
+//   using KalmanFilterTest = harness::VectorTest<kalman_filter::Signature>;
+//   TEST_P(KalmanFilterTest, MatchesExpectedOutput) { CheckExpectedOutput(); }
+//   INSTANTIATE_TEST_SUITE_P(TestVectors, KalmanFilterTest,
+//       ::testing::ValuesIn(LoadCases()), harness::TestCaseName);
+//
+// plus the loading-path checks and the cpp_outputs.json writer below.
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "algorithm_harness.h"
+#include "equivalence_matrix.h"
+
+namespace harness {
+
+// For Google Test to print test case names
+inline std::string TestCaseName(const ::testing::TestParamInfo<TestCase>& info) {
+    return info.param.name;
+}
+
+// Print parameters by name instead of as a raw byte dump
+inline void PrintTo(const TestCase& tc, std::ostream* os) {
+    *os << tc.name;
+}
+
+// Element-wise comparison of actual against expected outputs.
+template <class Sig>
+void ExpectOutputsNear(const TestCase& tc, const Values& actual) {
+    for (size_t o = 0; o < Sig::kOutputs.size(); o++) {
+        const char* field = Sig::kOutputs[o].name;
+        ASSERT_EQ(actual[o].size(), tc.expected[o].size())
+            << "Output '" << field << "' size mismatch in test case: " << tc.name;
+        for (size_t i = 0; i < actual[o].size(); i++) {
+            EXPECT_NEAR(actual[o][i], tc.expected[o][i], tc.abs_tolerance)
+                << "Output '" << field << "' mismatch at index " << i
+                << " in test case: " << tc.name;
+        }
+    }
+}
+
+// Bitwise comparison of two result sets (used to check that loading paths
+// and thread counts never change what the generated code computes).
+inline void ExpectSameResults(const std::vector<Values>& a, const std::vector<Values>& b) {
+    ASSERT_EQ(a.size(), b.size());
+    for (size_t i = 0; i < a.size(); i++) {
+        EXPECT_EQ(a[i], b[i]) << "Result mismatch for case " << i;
+    }
+}
+
+inline void ExpectSameCases(const std::vector<TestCase>& a, const std::vector<TestCase>& b) {
+    ASSERT_EQ(a.size(), b.size());
+    for (size_t i = 0; i < a.size(); i++) {
+        EXPECT_EQ(a[i].name, b[i].name);
+        EXPECT_EQ(a[i].inputs, b[i].inputs) << "Inputs differ for case: " << a[i].name;
+        EXPECT_EQ(a[i].expected, b[i].expected) << "Expected outputs differ for case: " << a[i].name;
+        EXPECT_EQ(a[i].abs_tolerance, b[i].abs_tolerance) << "Tolerance differs for case: " << a[i].name;
+    }
+}
+
+// ---- Parameterized fixture ----
+
+template <class Sig>
+class VectorTest : public ::testing::TestWithParam<TestCase> {
+protected:
+    void CheckExpectedOutput() {
+        const TestCase& tc = GetParam();
+        ExpectOutputsNear<Sig>(tc, harness::Run<Sig>(tc.inputs));
+    }
+};
+
+// ---- Loading-path and execution-path checks ----
+
+// Running on all workers must reproduce the serial results exactly.
+template <class Sig>
+void ExpectParallelMatchesSerial(const std::string& vectors_dir) {
+    auto cases = LoadTestVectors<Sig>(vectors_dir);
+    ExpectSameResults(RunAll<Sig>(cases, 1), RunAll<Sig>(cases, DefaultThreadCount()));
+}
+
+// JSON -> binary -> streaming reader must round-trip every case bit for bit.
+template <class Sig>
+void ExpectBinaryRoundTrip(const std::string& vectors_dir, const std::string& output_dir) {
+    auto cases = LoadTestVectors<Sig>(vectors_dir);
+    std::filesystem::create_directories(output_dir);
+    std::string path = (std::filesystem::path(output_dir) / (std::string(Sig::kName) + ".tvb")).string();
+
+    WriteBinaryVectors<Sig>(path, cases);
+    ExpectSameCases(cases, LoadBinaryVectors<Sig>(path));
+}
+
+// The streaming JSON path must yield the same cases as the bulk loader.
+template <class Sig>
+void ExpectStreamingMatchesBulk(const std::string& vectors_dir) {
+    std::vector<TestCase> streamed;
+    ForEachTestVector<Sig>(vectors_dir, [&](TestCase&& tc) { streamed.push_back(std::move(tc)); });
+    ExpectSameCases(LoadTestVectors<Sig>(vectors_dir), streamed);
+}
+
+// ---- Execution paths ----
+
+// Every execution path must pass every case, bit-identically where the
+// path requires it. Prints the matrix and writes <algo>_equivalence_matrix.json.
+template <class Sig>
+void ExpectAllPathsEquivalent(const std::vector<ExecutionPath>& paths, const std::vector<TestCase>& cases,
+                              const std::string& output_dir) {
+    EquivalenceMatrix m = BuildEquivalenceMatrix<Sig>(paths, cases);
+    std::cout << FormatEquivalenceMatrix(m, Sig::kName);
+
+    std::filesystem::create_directories(output_dir);
+    std::ofstream f(std::filesystem::path(output_dir) / (std::string(Sig::kName) + "_equivalence_matrix.json"));
+    f << EquivalenceMatrixToJson(m, Sig::kName).dump(2);
+
+    for (const auto& row : m.rows) {
+        for (size_t i = 0; i < row.cells.size(); i++) {
+            const MatrixCell& c = row.cells[i];
+            EXPECT_TRUE(c.pass) << "Path " << row.path << " outside tolerance on " << m.cases[i]
+                                << " (max abs error " << c.max_abs_error << ")";
+            if (row.bitwise_required) {
+                EXPECT_TRUE(c.bitwise) << "Path " << row.path << " not bit-identical to scalar on "
+                                       << m.cases[i] << " (max diff " << c.max_diff_from_scalar << ")";
+            }
+        }
+    }
+}
+
+// ---- Write outputs for equivalence comparison ----
+
+// Re-runs every case (in parallel) after the suite and writes cpp_outputs.json.
+template <class Sig>
+class CppOutputWriter : public ::testing::Environment {
+public:
+    using Loader = std::function<std::vector<TestCase>()>;
+
+    CppOutputWriter(Loader load, std::string output_dir)
+        : load_(std::move(load)), output_dir_(std::move(output_dir)) {}
+
+    void TearDown() override {
+        auto cases = load_();
+        nlohmann::json outputs = OutputsToJson<Sig>(cases, RunAll<Sig>(cases));
+
+        // Write to output directory
+        std::filesystem::path output_dir(output_dir_);
+        std::filesystem::create_directories(output_dir);
+        std::ofstream f(output_dir / "cpp_outputs.json");
+        f << outputs.dump(2);
+    }
+
+private:
+    Loader load_;
+    std::string output_dir_;
+};
+
+template <class Sig>
+::testing::Environment* RegisterOutputWriter(typename CppOutputWriter<Sig>::Loader load,
+                                             const std::string& output_dir) {
+    return ::testing::AddGlobalTestEnvironment(new CppOutputWriter<Sig>(std::move(load), output_dir));
+}
+
+} // namespace harness
+
+#endif // HARNESS_GTEST_HARNESS_H
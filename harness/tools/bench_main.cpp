@@ -0,0 +1,177 @@
+/**
+ * Throughput benchmark for one algorithm's scalar and batch paths.
+ *
+ * Built once per algorithm by add_harness_tool() (cmake/HarnessTools.cmake),
+ * which defines ALGORITHM_PATHS_HEADER and ALGORITHM_NAMESPACE.
+ *
+ * Usage: bench_<algorithm> [--vectors DIR|none] [--replay PATH]
+ *                          [--fuzz-cases N] [--seed S] [--max-length L]
+ *                          [--min-time SECONDS] [--repeats R]
+ *                          [--table N] [--huge-pages transparent|explicit]
+ *                          [--schema PATH] [--report PATH]
+ *
+ * The workload is the JSON test vectors, the replay log (JSON Lines, see
+ * docs/test_vector_format.md) and N samples from the schema envelope. It
+ * doubles as the training run of the PGO build (scripts/run_pgo.sh).
+ *
+ * --table N also times one batch call over the workload cycled to N
+ * entries, once on 4 KiB pages and once with the --huge-pages policy
+ * (runtime/large_buffer.h); with hardware counters available the dTLB
+ * column shows the misses each saves.
+ * Exit status: 0 on success, 2 on usage or setup errors.
+ */
+
+#include <cstdio>
+#include <exception>
+#include <stdexcept>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "benchmark.h"
+#include "fuzz_engine.h"
+#include ALGORITHM_PATHS_HEADER
+
+namespace {
+
+namespace algo = ALGORITHM_NAMESPACE;
+using Sig = algo::Signature;
+
+void PrintUsage(const char* argv0) {
+    std::cerr << "Usage: " << argv0
+              << " [--vectors DIR|none] [--replay PATH] [--fuzz-cases N] [--seed S]\n"
+                 "       [--max-length L] [--min-time SECONDS] [--repeats R]\n"
+                 "       [--table N] [--huge-pages transparent|explicit]\n"
+                 "       [--schema PATH] [--report PATH]\n";
+}
+
+runtime::HugePages ParseHugePages(const std::string& s) {
+    if (s == "transparent") return runtime::HugePages::Transparent;
+    if (s == "explicit") return runtime::HugePages::Explicit;
+    throw std::invalid_argument("--huge-pages must be transparent or explicit");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    harness::BenchOptions opts;
+    std::string vectors_dir = TEST_VECTORS_DIR;
+    std::string schema = std::string(TEST_VECTORS_DIR) + "/schema.json";
+    std::string replay_path;
+    std::string report_path;
+    uint64_t fuzz_cases = 1000;
+    uint64_t seed = 1;
+    int max_length = 256;
+    size_t table_entries = 0;
+    runtime::HugePages huge_pages = runtime::HugePages::Transparent;
+
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            if (arg == "--help" || arg == "-h") {
+                PrintUsage(argv[0]);
+                return 0;
+            }
+            if (i + 1 >= argc) throw std::invalid_argument("missing value for " + arg);
+            std::string value = argv[++i];
+            if (arg == "--vectors") vectors_dir = value;
+            else if (arg == "--replay") replay_path = value;
+            else if (arg == "--fuzz-cases") fuzz_cases = std::stoull(value);
+            else if (arg == "--seed") seed = std::stoull(value);
+            else if (arg == "--max-length") max_length = std::stoi(value);
+            else if (arg == "--min-time") opts.min_seconds = std::stod(value);
+            else if (arg == "--repeats") opts.repeats = std::stoi(value);
+            else if (arg == "--table") table_entries = std::stoull(value);
+            else if (arg == "--huge-pages") huge_pages = ParseHugePages(value);
+            else if (arg == "--schema") schema = value;
+            else if (arg == "--report") report_path = value;
+            else throw std::invalid_argument("unknown option " + arg);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "bench_" << Sig::kName << ": " << e.what() << "\n";
+        PrintUsage(argv[0]);
+        return 2;
+    }
+
+    nlohmann::json report;
+    try {
+        std::vector<harness::TestCase> workload;
+        size_t n_vectors = 0, n_replay = 0;
+        if (vectors_dir != "none") {
+            workload = harness::LoadTestVectors<Sig>(vectors_dir);
+            n_vectors = workload.size();
+        }
+        if (!replay_path.empty()) {
+            for (auto& tc : harness::LoadReplayLog<Sig>(replay_path)) workload.push_back(std::move(tc));
+            n_replay = workload.size() - n_vectors;
+        }
+        if (fuzz_cases > 0) {
+            auto domains = harness::LoadInputDomains<Sig>(schema);
+            harness::CapSequenceLength(domains, max_length);
+            for (uint64_t i = 0; i < fuzz_cases; i++) {
+                harness::TestCase tc;
+                tc.name = "fuzz_" + std::to_string(i);
+                harness::SampleCase<Sig>(domains, seed, i, tc.inputs);
+                workload.push_back(std::move(tc));
+            }
+        }
+        if (workload.empty()) throw std::runtime_error("empty workload");
+
+        const algo::BatchIsa selected = algo::batch_isa();
+        std::printf("\n============================================================\n");
+        std::printf("BENCHMARK: %s (%zu vectors + %zu replay + %llu fuzz entries, kernel %s)\n",
+                    Sig::kName, n_vectors, n_replay, static_cast<unsigned long long>(fuzz_cases),
+                    algo::batch_isa_name(selected));
+        std::printf("============================================================\n");
+        std::printf("  %-20s %14s %14s %14s\n", "path", "best ns/elem", "median ns/elem",
+                    "dTLB miss/elem");
+
+        report["algorithm"] = Sig::kName;
+        report["workload"] = {{"test_vectors", n_vectors},
+                              {"replay_entries", n_replay},
+                              {"fuzz_cases", fuzz_cases},
+                              {"seed", seed}};
+        report["batch_isa"] = algo::batch_isa_name(selected);
+        report["results"] = nlohmann::json::array();
+        auto record = [&](const harness::BenchResult& r) {
+            std::printf("  %-20s %14.2f %14.2f", r.path.c_str(), r.best_ns, r.median_ns);
+            if (r.dtlb_misses >= 0.0) std::printf(" %14.4f\n", r.dtlb_misses);
+            else std::printf(" %14s\n", "n/a");
+            report["results"].push_back(harness::BenchResultToJson(r));
+        };
+
+        record(harness::BenchScalar<Sig>(workload, opts));
+        for (size_t b : {8, 64}) record(harness::BenchBatch<algo::BatchAdapter>(workload, b, opts));
+
+        // Every kernel this CPU can run, pinned in turn
+        for (auto isa : {algo::BatchIsa::Portable, algo::BatchIsa::Sse2, algo::BatchIsa::Avx2,
+                         algo::BatchIsa::Avx512}) {
+            if (!algo::set_batch_isa(isa)) continue;
+            std::string prefix = std::string(algo::batch_isa_name(isa)) + "/";
+            record(harness::BenchBatch<algo::BatchAdapter>(workload, 64, opts, prefix));
+        }
+        algo::set_batch_isa(selected);
+
+        // Page size on a memory-bound table
+        if (table_entries > 0) {
+            for (auto h : {runtime::HugePages::None, huge_pages}) {
+                record(harness::BenchTable<algo::BatchAdapter>(workload, table_entries, h, opts));
+            }
+            report["table_entries"] = table_entries;
+        }
+        std::printf("============================================================\n");
+    } catch (const std::exception& e) {
+        std::cerr << "bench_" << Sig::kName << ": " << e.what() << "\n";
+        return 2;
+    }
+
+    if (!report_path.empty()) {
+        std::ofstream f(report_path);
+        if (!f.is_open()) {
+            std::cerr << "bench_" << Sig::kName << ": cannot write " << report_path << "\n";
+            return 2;
+        }
+        f << report.dump(2);
+    }
+    return 0;
+}
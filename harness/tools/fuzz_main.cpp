@@ -0,0 +1,116 @@
+/**
+ * Randomized equivalence fuzzer for one algorithm.
+ *
+ * Built once per algorithm by add_harness_tool() (cmake/HarnessTools.cmake),
+ * which defines ALGORITHM_REFERENCE_HEADER and ALGORITHM_NAMESPACE.
+ *
+ * Usage: fuzz_<algorithm> [--cases N] [--seed S] [--threads T]
+ *                         [--abs-tol X] [--rel-tol X] [--max-length L]
+ *                         [--reproducers K] [--schema PATH] [--report PATH]
+ *
+ * Exit status: 0 if every case is within tolerance, 1 on failures, 2 on
+ * usage or setup errors.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "fuzz_engine.h"
+#include ALGORITHM_REFERENCE_HEADER
+
+namespace {
+
+using Sig = ALGORITHM_NAMESPACE::Signature;
+using Ref = ALGORITHM_NAMESPACE::Reference;
+
+void PrintUsage(const char* argv0) {
+    std::cerr << "Usage: " << argv0
+              << " [--cases N] [--seed S] [--threads T] [--abs-tol X] [--rel-tol X]\n"
+                 "       [--max-length L] [--reproducers K] [--schema PATH] [--report PATH]\n";
+}
+
+void PrintFinding(const char* label, const harness::FuzzFinding& f) {
+    std::printf("%-20s#%llu %s[%zu] abs=%.2e rel=%.2e (%.3gx tolerance)\n", label,
+                static_cast<unsigned long long>(f.index), Sig::kOutputs[f.error.output].name,
+                f.error.element, f.error.abs_err, f.error.rel_err, f.error.excess);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    harness::FuzzOptions opts;
+    std::string schema = std::string(TEST_VECTORS_DIR) + "/schema.json";
+    std::string report_path;
+
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            if (arg == "--help" || arg == "-h") {
+                PrintUsage(argv[0]);
+                return 0;
+            }
+            if (i + 1 >= argc) throw std::invalid_argument("missing value for " + arg);
+            std::string value = argv[++i];
+            if (arg == "--cases") opts.cases = std::stoull(value);
+            else if (arg == "--seed") opts.seed = std::stoull(value);
+            else if (arg == "--threads") opts.threads = static_cast<unsigned>(std::stoul(value));
+            else if (arg == "--abs-tol") opts.abs_tol = std::stod(value);
+            else if (arg == "--rel-tol") opts.rel_tol = std::stod(value);
+            else if (arg == "--max-length") opts.max_length = std::stoi(value);
+            else if (arg == "--reproducers") opts.reproducers = std::stoul(value);
+            else if (arg == "--schema") schema = value;
+            else if (arg == "--report") report_path = value;
+            else throw std::invalid_argument("unknown option " + arg);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "fuzz_" << Sig::kName << ": " << e.what() << "\n";
+        PrintUsage(argv[0]);
+        return 2;
+    }
+
+    harness::FuzzReport report;
+    try {
+        report = harness::RunFuzz<Sig, Ref>(harness::LoadInputDomains<Sig>(schema), opts);
+    } catch (const std::exception& e) {
+        std::cerr << "fuzz_" << Sig::kName << ": " << e.what() << "\n";
+        return 2;
+    }
+
+    std::printf("\n============================================================\n");
+    std::printf("FUZZ REPORT: %s\n", Sig::kName);
+    std::printf("============================================================\n");
+    std::printf("Cases:              %llu (seed %llu, %u threads, %.2f s)\n",
+                static_cast<unsigned long long>(report.cases),
+                static_cast<unsigned long long>(opts.seed), opts.threads, report.seconds);
+    std::printf("Tolerance:          %.1e abs + %.1e rel\n", opts.abs_tol, opts.rel_tol);
+    std::printf("Failures:           %llu\n", static_cast<unsigned long long>(report.failures));
+    for (size_t o = 0; o < Sig::kOutputs.size(); o++) {
+        std::printf("  %-18s max abs %.2e, max rel %.2e\n", Sig::kOutputs[o].name,
+                    report.max_abs[o], report.max_rel[o]);
+    }
+    if (report.cases > 0) PrintFinding("Worst case:", report.worst);
+    for (const auto& f : report.reproducers) PrintFinding("Reproducer:", f);
+    std::printf("============================================================\n");
+
+    if (!report_path.empty()) {
+        std::ofstream f(report_path);
+        if (!f.is_open()) {
+            std::cerr << "fuzz_" << Sig::kName << ": cannot write " << report_path << "\n";
+            return 2;
+        }
+        f << harness::FuzzReportToJson<Sig, Ref>(report, opts).dump(2);
+    }
+
+    if (report.failures > 0) {
+        std::fprintf(stderr, "\nFUZZ CHECK FAILED for %s (%llu of %llu cases)\n", Sig::kName,
+                     static_cast<unsigned long long>(report.failures),
+                     static_cast<unsigned long long>(report.cases));
+        return 1;
+    }
+    std::printf("\nFUZZ CHECK PASSED for %s\n", Sig::kName);
+    return 0;
+}
@@ -0,0 +1,152 @@
+/**
+ * ULP and error-distribution analyzer for one algorithm's kernel variants.
+ *
+ * Built once per algorithm by add_harness_tool() (cmake/HarnessTools.cmake),
+ * which defines ALGORITHM_VARIANTS_HEADER and ALGORITHM_NAMESPACE.
+ *
+ * Usage: ulp_<algorithm> [--vectors DIR|none] [--fuzz-cases N] [--seed S]
+ *                        [--threads T] [--max-length L] [--variant NAME]
+ *                        [--cancellation-bits B] [--safety F]
+ *                        [--schema PATH] [--report PATH]
+ *
+ * Runs every variant in <algorithm>_variants.h over the test vectors plus
+ * N fuzz cases and reports error histograms, flagged cancellation sites and
+ * tolerance recommendations. Exit status: 0 on success, 2 on usage or setup
+ * errors (the analysis itself does not fail).
+ */
+
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "error_analysis.h"
+#include ALGORITHM_VARIANTS_HEADER
+
+namespace {
+
+using Sig = ALGORITHM_NAMESPACE::Signature;
+using Ref = ALGORITHM_NAMESPACE::Reference;
+using Variants = ALGORITHM_NAMESPACE::Variants;
+
+void PrintUsage(const char* argv0) {
+    std::cerr << "Usage: " << argv0
+              << " [--vectors DIR|none] [--fuzz-cases N] [--seed S] [--threads T]\n"
+                 "       [--max-length L] [--variant NAME] [--cancellation-bits B] [--safety F]\n"
+                 "       [--schema PATH] [--report PATH]\n";
+}
+
+void PrintVariant(const harness::VariantAnalysis& v, const nlohmann::json& j) {
+    std::printf("\nVariant %s (%s): %s\n", v.name.c_str(), v.precision.c_str(), v.description.c_str());
+    for (const auto& e : j["elements"]) {
+        std::printf("  %-24s max %9.3g ulp  p99.9 %9.3g ulp  mean %8.3g ulp  max rel %.2e\n",
+                    e["element"].get<std::string>().c_str(), e["max_ulp"].get<double>(),
+                    e["p999_ulp"].get<double>(), e["mean_ulp"].get<double>(),
+                    e["max_relative_error"].get<double>());
+    }
+    const auto& g = j["recommended_tolerance"]["global_tolerance"];
+    std::printf("  Recommended tolerance:  absolute %.0e, relative %.0e\n",
+                g["absolute"].get<double>(), g["relative"].get<double>());
+    std::printf("  Vectors failing current tolerance: %zu of %llu\n", v.failing_vectors.size(),
+                static_cast<unsigned long long>(v.vectors_checked));
+    for (const auto& name : v.failing_vectors) std::printf("    %s\n", name.c_str());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    harness::AnalysisOptions opts;
+    harness::Corpus corpus;
+    corpus.fuzz_cases = 100000;
+    std::string vectors_dir = TEST_VECTORS_DIR;
+    std::string schema = std::string(TEST_VECTORS_DIR) + "/schema.json";
+    std::string report_path;
+    std::string only_variant;
+    int max_length = -1;
+
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            if (arg == "--help" || arg == "-h") {
+                PrintUsage(argv[0]);
+                return 0;
+            }
+            if (i + 1 >= argc) throw std::invalid_argument("missing value for " + arg);
+            std::string value = argv[++i];
+            if (arg == "--vectors") vectors_dir = value;
+            else if (arg == "--fuzz-cases") corpus.fuzz_cases = std::stoull(value);
+            else if (arg == "--seed") corpus.seed = std::stoull(value);
+            else if (arg == "--threads") opts.threads = static_cast<unsigned>(std::stoul(value));
+            else if (arg == "--max-length") max_length = std::stoi(value);
+            else if (arg == "--variant") only_variant = value;
+            else if (arg == "--cancellation-bits") opts.cancellation_bits = std::stod(value);
+            else if (arg == "--safety") opts.safety_factor = std::stod(value);
+            else if (arg == "--schema") schema = value;
+            else if (arg == "--report") report_path = value;
+            else throw std::invalid_argument("unknown option " + arg);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "ulp_" << Sig::kName << ": " << e.what() << "\n";
+        PrintUsage(argv[0]);
+        return 2;
+    }
+
+    nlohmann::json report;
+    try {
+        if (vectors_dir != "none") corpus.vectors = harness::LoadTestVectors<Sig>(vectors_dir);
+        if (corpus.fuzz_cases > 0) {
+            corpus.domains = harness::LoadInputDomains<Sig>(schema);
+            harness::CapSequenceLength(corpus.domains, max_length);
+        }
+
+        std::printf("\n============================================================\n");
+        std::printf("ERROR ANALYSIS: %s (%zu vectors + %llu fuzz cases, seed %llu)\n", Sig::kName,
+                    corpus.vectors.size(), static_cast<unsigned long long>(corpus.fuzz_cases),
+                    static_cast<unsigned long long>(corpus.seed));
+        std::printf("============================================================\n");
+
+        report["algorithm"] = Sig::kName;
+        report["corpus"] = {{"test_vectors", corpus.vectors.size()},
+                            {"fuzz_cases", corpus.fuzz_cases},
+                            {"seed", corpus.seed}};
+        report["safety_factor"] = opts.safety_factor;
+        report["variants"] = nlohmann::json::array();
+
+        harness::ForEachVariant<Variants>([&](auto variant) {
+            using Variant = decltype(variant);
+            if (!only_variant.empty() && only_variant != Variant::kName) return;
+            auto analysis = harness::AnalyzeVariant<Sig, Ref, Variant>(corpus, opts);
+            nlohmann::json j = harness::VariantToJson<Sig>(analysis, opts);
+            PrintVariant(analysis, j);
+            report["variants"].push_back(std::move(j));
+        });
+
+        auto sites = harness::AnalyzeCancellation<Sig, Ref>(corpus, opts);
+        report["cancellation"] = harness::CancellationToJson(sites, corpus, opts);
+        std::printf("\nCancellation sites (>= %.0f bits lost):%s\n", opts.cancellation_bits,
+                    sites.empty() ? " none" : "");
+        for (const auto& s : report["cancellation"]["sites"]) {
+            std::printf("  op #%u '%s' at %s: %llu of %llu evaluations, worst %.1f bits (%s)\n",
+                        s["ordinal"].get<unsigned>(), s["operation"].get<std::string>().c_str(),
+                        s["function"].get<std::string>().c_str(),
+                        static_cast<unsigned long long>(s["hits"].get<uint64_t>()),
+                        static_cast<unsigned long long>(s["evaluations"].get<uint64_t>()),
+                        s["worst_bits_lost"].get<double>(), s["worst_case"].get<std::string>().c_str());
+        }
+        std::printf("============================================================\n");
+    } catch (const std::exception& e) {
+        std::cerr << "ulp_" << Sig::kName << ": " << e.what() << "\n";
+        return 2;
+    }
+
+    if (!report_path.empty()) {
+        std::ofstream f(report_path);
+        if (!f.is_open()) {
+            std::cerr << "ulp_" << Sig::kName << ": cannot write " << report_path << "\n";
+            return 2;
+        }
+        f << report.dump(2);
+    }
+    return 0;
+}
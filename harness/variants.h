@@ -0,0 +1,80 @@
+#ifndef HARNESS_VARIANTS_H
+#define HARNESS_VARIANTS_H
+
+// Kernel variant descriptors.
+//
+// A variant is an alternative implementation of an algorithm's signature
+// (FMA-contracted, reassociated for SIMD, reduced precision, ...) that the
+// analysis tools compare against the generated code and the long double
+// reference. A variant descriptor looks like:
+//
+//   struct FmaVariant {
+//       using Scalar = double;                    // precision it computes in
+//       static constexpr const char* kName = "fma";
+//       static constexpr const char* kDescription = "...";
+//       static void Invoke(const harness::Values& in, harness::Values& out);
+//   };
+//
+// Each algorithm lists its variants in <algo>_variants.h as
+// `using Variants = std::tuple<...>`.
+
+#include <tuple>
+#include <vector>
+
+#include "algorithm_harness.h"
+
+namespace harness {
+
+// The generated function itself, as built.
+template <class Sig>
+struct GeneratedVariant {
+    using Scalar = double;
+    static constexpr const char* kName = "generated";
+    static constexpr const char* kDescription = "Generated code as compiled";
+
+    static void Invoke(const Values& in, Values& out) { Sig::Invoke(in, out); }
+};
+
+template <typename T>
+struct PrecisionName;
+
+template <>
+struct PrecisionName<double> {
+    static constexpr const char* kValue = "double";
+};
+
+template <>
+struct PrecisionName<float> {
+    static constexpr const char* kValue = "float";
+};
+
+template <>
+struct PrecisionName<long double> {
+    static constexpr const char* kValue = "long_double";
+};
+
+// The reference transcription evaluated in T (e.g. float), widened back to
+// double. Models a reduced-precision build of the same operation order.
+template <class Ref, typename T>
+struct PrecisionVariant {
+    using Scalar = T;
+    static constexpr const char* kName = PrecisionName<T>::kValue;
+    static constexpr const char* kDescription = "Reference operation order evaluated in reduced precision";
+
+    static void Invoke(const Values& in, Values& out) {
+        thread_local std::vector<std::vector<T>> narrow;
+        ResizeOutputs<typename Ref::Signature>(in, narrow);
+        Ref::template Evaluate<T>(in, narrow);
+        for (size_t o = 0; o < narrow.size(); o++) out[o].assign(narrow[o].begin(), narrow[o].end());
+    }
+};
+
+// Call fn(Variant{}) for each variant type in a std::tuple.
+template <class Tuple, class Fn>
+void ForEachVariant(Fn&& fn) {
+    std::apply([&](auto... v) { (fn(v), ...); }, Tuple{});
+}
+
+} // namespace harness
+
+#endif // HARNESS_VARIANTS_H
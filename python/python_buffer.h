@@ -0,0 +1,167 @@
+#ifndef PYTHON_BUFFER_H
+#define PYTHON_BUFFER_H
+
+// Buffer-protocol helpers shared by the algorithm extension modules
+// (cpp/<algo>_python.cpp; hand-written, header-only, built by
+// cmake/PythonModule.cmake).
+//
+// Arrays cross into C++ without copies: a NumPy array, memoryview,
+// array.array('d') or any other exporter of C-contiguous float64 data is
+// read and written in place. Lists and tuples are accepted as inputs for
+// convenience and are copied. Anything else -- float32, strided views --
+// is a TypeError rather than a silent conversion, so a copy never hides in
+// a hot loop. New result arrays are numpy.ndarray when NumPy is importable
+// and memoryview('d') otherwise; neither is copied on the way out.
+//
+// Include Python.h (with PY_SSIZE_T_CLEAN) before this header.
+
+#include <climits>
+#include <cstring>
+#include <initializer_list>
+#include <vector>
+
+namespace python_buffer {
+
+// One float64 array argument, viewed in place or (sequences) copied
+class DoubleArray {
+public:
+    DoubleArray() { view_.obj = nullptr; }
+    ~DoubleArray() {
+        if (view_.obj) PyBuffer_Release(&view_);
+    }
+    DoubleArray(const DoubleArray&) = delete;
+    DoubleArray& operator=(const DoubleArray&) = delete;
+
+    // Views `obj` as float64 data. `writable` arrays are outputs or
+    // in-place state and must be buffers. Returns false with a Python
+    // exception set.
+    bool Parse(PyObject* obj, const char* name, bool writable) {
+        name_ = name;
+        if (PyObject_CheckBuffer(obj)) {
+            int flags = PyBUF_C_CONTIGUOUS | PyBUF_FORMAT | (writable ? PyBUF_WRITABLE : 0);
+            if (PyObject_GetBuffer(obj, &view_, flags) != 0) {
+                PyErr_Clear();
+                PyErr_Format(PyExc_TypeError, "%s must be a C-contiguous%s float64 array", name,
+                             writable ? ", writable" : "");
+                return false;
+            }
+            if (view_.itemsize != sizeof(double) || !IsDoubleFormat(view_.format)) {
+                PyErr_Format(PyExc_TypeError, "%s must have dtype float64 (got format '%s')", name,
+                             view_.format ? view_.format : "B");
+                return false;
+            }
+            data_ = static_cast<double*>(view_.buf);
+            size_ = view_.len / static_cast<Py_ssize_t>(sizeof(double));
+            return true;
+        }
+        if (writable) {
+            PyErr_Format(PyExc_TypeError, "%s is updated in place and must be a writable float64 array", name);
+            return false;
+        }
+        PyObject* seq = PySequence_Fast(obj, "");
+        if (!seq) {
+            PyErr_Clear();
+            PyErr_Format(PyExc_TypeError, "%s must be a float64 array or a sequence of floats", name);
+            return false;
+        }
+        Py_ssize_t n = PySequence_Fast_GET_SIZE(seq);
+        copy_.resize(static_cast<size_t>(n));
+        for (Py_ssize_t i = 0; i < n; i++) {
+            copy_[i] = PyFloat_AsDouble(PySequence_Fast_GET_ITEM(seq, i));
+            if (copy_[i] == -1.0 && PyErr_Occurred()) {
+                Py_DECREF(seq);
+                return false;
+            }
+        }
+        Py_DECREF(seq);
+        data_ = copy_.data();
+        size_ = n;
+        return true;
+    }
+
+    double* data() const { return data_; }
+    Py_ssize_t size() const { return size_; }
+    const char* name() const { return name_; }
+
+private:
+    static bool IsDoubleFormat(const char* format) {
+        if (!format) return false;
+        if (*format == '@' || *format == '=' || *format == '<') format++;
+        return std::strcmp(format, "d") == 0;
+    }
+
+    Py_buffer view_;
+    std::vector<double> copy_;
+    double* data_ = nullptr;
+    Py_ssize_t size_ = 0;
+    const char* name_ = "";
+};
+
+// Checks that `array` holds exactly `n` elements
+inline bool CheckSize(const DoubleArray& array, Py_ssize_t n) {
+    if (array.size() == n) return true;
+    PyErr_Format(PyExc_ValueError, "%s has %zd elements, expected %zd", array.name(), array.size(), n);
+    return false;
+}
+
+// Checks that every array has as many elements as the first
+inline bool CheckSameSize(std::initializer_list<const DoubleArray*> arrays) {
+    for (const DoubleArray* a : arrays) {
+        if (!CheckSize(*a, (*arrays.begin())->size())) return false;
+    }
+    return true;
+}
+
+// The C++ APIs count in int
+inline bool CheckIntSize(Py_ssize_t n) {
+    if (n <= INT_MAX) return true;
+    PyErr_SetString(PyExc_OverflowError, "arrays longer than INT_MAX elements are not supported");
+    return false;
+}
+
+// New uninitialized float64 array of the given shape: numpy.empty() when
+// NumPy is importable, else memoryview(bytearray).cast('d', shape) (flat
+// when empty). Returns
+// a new reference and views its storage in `out`, or nullptr with an
+// exception set.
+inline PyObject* NewArray(std::initializer_list<Py_ssize_t> shape, DoubleArray& out, const char* name) {
+    static PyObject* numpy_empty = nullptr;
+    static bool numpy_checked = false;
+    if (!numpy_checked) {
+        numpy_checked = true;
+        if (PyObject* numpy = PyImport_ImportModule("numpy")) {
+            numpy_empty = PyObject_GetAttrString(numpy, "empty");
+            Py_DECREF(numpy);
+        }
+        PyErr_Clear();
+    }
+
+    PyObject* dims = PyTuple_New(static_cast<Py_ssize_t>(shape.size()));
+    if (!dims) return nullptr;
+    Py_ssize_t count = 1, i = 0;
+    for (Py_ssize_t d : shape) {
+        PyTuple_SET_ITEM(dims, i++, PyLong_FromSsize_t(d));
+        count *= d;
+    }
+
+    PyObject* result = nullptr;
+    if (numpy_empty) {
+        result = PyObject_CallFunctionObjArgs(numpy_empty, dims, nullptr);
+    } else if (PyObject* bytes = PyByteArray_FromStringAndSize(nullptr, count * static_cast<Py_ssize_t>(sizeof(double)))) {
+        PyObject* view = PyMemoryView_FromObject(bytes);
+        Py_DECREF(bytes);
+        if (view) {
+            // memoryview cannot take a shape with a zero in it; empty is flat
+            result = count > 0 ? PyObject_CallMethod(view, "cast", "sO", "d", dims)
+                               : PyObject_CallMethod(view, "cast", "s", "d");
+            Py_DECREF(view);
+        }
+    }
+    Py_DECREF(dims);
+    if (result && !out.Parse(result, name, true)) Py_CLEAR(result);
+    return result;
+}
+
+} // namespace python_buffer
+
+#endif // PYTHON_BUFFER_H
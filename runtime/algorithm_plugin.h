@@ -0,0 +1,49 @@
+#ifndef RUNTIME_ALGORITHM_PLUGIN_H
+#define RUNTIME_ALGORITHM_PLUGIN_H
+
+/*
+ * C ABI of the algorithm plugins (hand-written, ships in the
+ * algorithm_runtime package). Valid C and C++.
+ *
+ * Each algorithm also builds as a shared object, lib<algo>_plugin.so,
+ * that exports one symbol:
+ *
+ *   const <algo>_plugin* <algo>_plugin_v1(void);
+ *
+ * The table it returns is written from the algorithm.yaml signature
+ * (cmake/GenerateWrappers.cmake, <algo>_plugin.h). It starts with an
+ * algorithm_plugin_info, and function pointers follow it. A host checks the info
+ * before it calls anything (runtime/plugin_host.h).
+ *
+ * Compatibility rules:
+ *   - The ABI version is part of the symbol name, so an incompatible
+ *     plugin has no entry point to call at all.
+ *   - Within a version, tables only grow at the end. `size` lets a host
+ *     accept a newer plugin that has more members than it knows about.
+ *   - `signature` is the entry point's parameter list. A release that
+ *     changes it is a different function and is refused.
+ */
+
+#include <stdint.h>
+
+#define ALGORITHM_PLUGIN_ABI_VERSION 1
+
+/* Entry symbol of an algorithm's plugin: <algo>_plugin_v<ABI version> */
+#define ALGORITHM_PLUGIN_ENTRY(algo) algo##_plugin_v1
+#define ALGORITHM_PLUGIN_ENTRY_NAME(algo) #algo "_plugin_v1"
+
+#if defined(_WIN32)
+#define ALGORITHM_PLUGIN_EXPORT __declspec(dllexport)
+#else
+#define ALGORITHM_PLUGIN_EXPORT __attribute__((visibility("default")))
+#endif
+
+typedef struct algorithm_plugin_info {
+    uint32_t abi_version;  /* ALGORITHM_PLUGIN_ABI_VERSION */
+    uint32_t size;         /* sizeof the whole table */
+    const char* name;      /* algorithm, e.g. "kalman_filter" */
+    const char* version;   /* package version (algorithms/<algo>/VERSION) */
+    const char* signature; /* "in double state[2]; in double measurement; ..." */
+} algorithm_plugin_info;
+
+#endif /* RUNTIME_ALGORITHM_PLUGIN_H */
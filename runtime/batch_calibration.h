@@ -0,0 +1,261 @@
+#ifndef RUNTIME_BATCH_CALIBRATION_H
+#define RUNTIME_BATCH_CALIBRATION_H
+
+// Startup calibration of batch kernels (hand-written, header-only, ships
+// in the algorithm_runtime package; the algorithm libraries' own
+// calibrate_batch() functions are built on it).
+//
+// The best kernel build, batch size and worker count for a batch API
+// differ between CPU generations. CalibrateBatch() measures them on the
+// machine it runs on, over a table of elements driven the way an
+// application would: `threads` workers each take a contiguous slice and
+// call the kernel on it `batch_size` elements at a time. It searches in
+// three short stages -- kernel (batch 1024, one thread), then batch size,
+// then worker count -- keeping a wider setting only when it is at least
+// 5% faster, so a noisy machine does not pick more threads than it needs.
+//
+// The decision is cached in a tab-separated file, one line per algorithm
+// and CPU model:
+//
+//   <algorithm> \t <cpu model> \t <kernel> \t <batch size> \t <threads>
+//
+// so later startups on the same kind of machine skip the measurement
+// (LookupCalibration()). A cached kernel this build cannot run (a
+// different package) is measured again.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace runtime {
+
+struct CalibrationResult {
+    std::string isa;     // kernel name, one of the candidates
+    int batch_size = 0;  // elements per batch call
+    int threads = 1;     // workers
+    bool from_cache = false;
+};
+
+struct CalibrationOptions {
+    std::string cache_path;      // "" = default_calibration_cache(); "-" = no cache
+    bool recalibrate = false;    // measure even when the cache has an answer
+    size_t table_elements = 1 << 16;
+    double seconds_per_trial = 0.01;
+    std::vector<int> batch_sizes = {16, 64, 256, 1024, 4096};
+    int max_threads = 0;         // 0 = std::thread::hardware_concurrency()
+};
+
+// "model name" from /proc/cpuinfo (else "unknown") and the logical CPU
+// count, e.g. "Intel(R) Xeon(R) Gold 6248 CPU @ 2.50GHz x80"
+inline std::string cpu_model() {
+    std::string model = "unknown";
+    std::ifstream f("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(f, line)) {
+        if (line.compare(0, 10, "model name") != 0 && line.compare(0, 9, "Processor") != 0) continue;
+        size_t colon = line.find(':');
+        if (colon == std::string::npos) continue;
+        model = line.substr(line.find_first_not_of(" \t", colon + 1));
+        break;
+    }
+    for (char& c : model) {
+        if (c == '\t' || c == '\n') c = ' ';
+    }
+    return model + " x" + std::to_string(std::max(1u, std::thread::hardware_concurrency()));
+}
+
+// $MATLAB_ALGORITHMS_CALIBRATION_CACHE, else
+// $XDG_CACHE_HOME/matlab_algorithms/batch_calibration.tsv, else the same
+// under $HOME/.cache; "" when none of them is set.
+inline std::string default_calibration_cache() {
+    if (const char* p = std::getenv("MATLAB_ALGORITHMS_CALIBRATION_CACHE")) return p;
+    std::string dir;
+    if (const char* x = std::getenv("XDG_CACHE_HOME")) dir = x;
+    else if (const char* h = std::getenv("HOME")) dir = std::string(h) + "/.cache";
+    if (dir.empty()) return "";
+    return dir + "/matlab_algorithms/batch_calibration.tsv";
+}
+
+namespace detail {
+
+inline std::vector<std::string> SplitTabs(const std::string& line) {
+    std::vector<std::string> fields;
+    std::stringstream ss(line);
+    std::string field;
+    while (std::getline(ss, field, '\t')) fields.push_back(field);
+    return fields;
+}
+
+inline bool ReadCachedTuning(const std::string& path, const std::string& algorithm,
+                             const std::string& model, CalibrationResult* out) {
+    std::ifstream f(path);
+    std::string line;
+    while (std::getline(f, line)) {
+        auto fields = SplitTabs(line);
+        if (fields.size() != 5 || fields[0] != algorithm || fields[1] != model) continue;
+        try {
+            out->isa = fields[2];
+            out->batch_size = std::stoi(fields[3]);
+            out->threads = std::stoi(fields[4]);
+        } catch (const std::exception&) {
+            return false;
+        }
+        return out->batch_size > 0 && out->threads > 0;
+    }
+    return false;
+}
+
+// Replace this algorithm/model's line; write-then-rename so concurrent
+// readers never see a partial file. Failures are ignored: the cache is
+// an optimisation.
+inline void WriteCachedTuning(const std::string& path, const std::string& algorithm,
+                              const std::string& model, const CalibrationResult& r) {
+    std::vector<std::string> keep;
+    {
+        std::ifstream f(path);
+        std::string line;
+        while (std::getline(f, line)) {
+            auto fields = SplitTabs(line);
+            if (fields.size() >= 2 && fields[0] == algorithm && fields[1] == model) continue;
+            if (!line.empty()) keep.push_back(line);
+        }
+    }
+    keep.push_back(algorithm + "\t" + model + "\t" + r.isa + "\t" + std::to_string(r.batch_size) +
+                   "\t" + std::to_string(r.threads));
+
+    std::error_code ec;
+    std::filesystem::path target(path);
+    if (target.has_parent_path()) std::filesystem::create_directories(target.parent_path(), ec);
+    std::string tmp = path + ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+    {
+        std::ofstream f(tmp, std::ios::trunc);
+        if (!f.is_open()) return;
+        for (auto& line : keep) f << line << "\n";
+        if (!f.good()) return;
+    }
+    std::filesystem::rename(tmp, target, ec);
+    if (ec) std::filesystem::remove(tmp, ec);
+}
+
+// Elements per second with `threads` workers over [0, elements), each
+// looping over its slice until the trial's deadline
+template <class Run>
+double Throughput(Run& run, int isa, int batch_size, int threads, size_t elements, double seconds) {
+    using Clock = std::chrono::steady_clock;
+    std::atomic<bool> go{false};
+    std::vector<size_t> done(threads, 0);
+    auto worker = [&](int t) {
+        size_t begin = elements * t / threads, end = elements * (t + 1) / threads;
+        while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+        auto deadline = Clock::now() + std::chrono::duration<double>(seconds);
+        do {
+            run(isa, batch_size, begin, end);
+            done[t] += end - begin;
+        } while (Clock::now() < deadline);
+    };
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threads; t++) workers.emplace_back(worker, t);
+    auto start = Clock::now();
+    go.store(true, std::memory_order_release);
+    worker(0);
+    for (auto& w : workers) w.join();
+    double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    size_t total = 0;
+    for (size_t d : done) total += d;
+    return total / std::max(elapsed, 1e-9);
+}
+
+} // namespace detail
+
+namespace detail {
+
+inline std::string CachePath(const CalibrationOptions& opts) {
+    if (opts.cache_path.empty()) return default_calibration_cache();
+    return opts.cache_path == "-" ? std::string() : opts.cache_path;
+}
+
+} // namespace detail
+
+// The cached decision for `algorithm` on this CPU model, if there is one,
+// opts.recalibrate is off and the cached kernel is among `isas`.
+inline bool LookupCalibration(const std::string& algorithm, const std::vector<std::string>& isas,
+                              const CalibrationOptions& opts, CalibrationResult* out) {
+    const std::string cache = detail::CachePath(opts);
+    if (cache.empty() || opts.recalibrate) return false;
+    CalibrationResult r;
+    if (!detail::ReadCachedTuning(cache, algorithm, cpu_model(), &r)) return false;
+    if (std::find(isas.begin(), isas.end(), r.isa) == isas.end()) return false;
+    r.from_cache = true;
+    *out = r;
+    return true;
+}
+
+// Measures kernel, batch size and worker count for `algorithm` and caches
+// the decision. Call after a LookupCalibration() miss, so the table behind
+// `run` is only built when it is needed.
+//   isas       candidate kernel names (this build and CPU can run all of them)
+//   run        run(isa_index, batch_size, begin, end): process table
+//              elements [begin, end) in batch calls of batch_size using
+//              kernel isas[isa_index]. All workers of a trial get the same
+//              isa_index and disjoint ranges of one table of
+//              opts.table_elements elements.
+template <class Run>
+CalibrationResult CalibrateBatch(const std::string& algorithm, const std::vector<std::string>& isas,
+                                 Run run, const CalibrationOptions& opts = CalibrationOptions()) {
+    CalibrationResult r;
+    const size_t n = std::max<size_t>(opts.table_elements, 1);
+    auto measure = [&](int isa, int batch, int threads) {
+        return detail::Throughput(run, isa, batch, threads, n, opts.seconds_per_trial);
+    };
+    auto better = [](double candidate, double best) { return candidate > best * 1.05; };
+
+    // 1. Kernel, at a middling batch size on one thread. Narrowest first,
+    //    so a wider kernel has to earn its place.
+    int isa = 0;
+    double best = measure(0, 1024, 1);
+    for (int i = 1; i < static_cast<int>(isas.size()); i++) {
+        double t = measure(i, 1024, 1);
+        if (better(t, best)) isa = i, best = t;
+    }
+
+    // 2. Batch size with that kernel
+    int batch = 1024;
+    best = 0.0;
+    for (int b : opts.batch_sizes) {
+        double t = measure(isa, b, 1);
+        if (t > best) batch = b, best = t;
+    }
+
+    // 3. Workers, doubling up to the CPU count
+    int max_threads = opts.max_threads > 0
+                          ? opts.max_threads
+                          : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    int threads = 1;
+    std::vector<int> counts;
+    for (int t = 2; t < max_threads; t *= 2) counts.push_back(t);
+    if (max_threads > 1) counts.push_back(max_threads);
+    for (int t : counts) {
+        double tp = measure(isa, batch, t);
+        if (better(tp, best)) threads = t, best = tp;
+    }
+
+    r.isa = isas[isa];
+    r.batch_size = batch;
+    r.threads = threads;
+    const std::string cache = detail::CachePath(opts);
+    if (!cache.empty()) detail::WriteCachedTuning(cache, algorithm, cpu_model(), r);
+    return r;
+}
+
+} // namespace runtime
+
+#endif // RUNTIME_BATCH_CALIBRATION_H
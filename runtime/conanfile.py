@@ -0,0 +1,40 @@
+from conan import ConanFile
+from conan.tools.cmake import CMake, CMakeToolchain, cmake_layout
+
+
+class AlgorithmRuntimeConan(ConanFile):
+    name = "algorithm_runtime"
+    license = "Proprietary"
+    description = "Header-only runtime helpers for the MatlabToCpp batch APIs (huge-page, NUMA-aware buffers, frame arenas, object pools, worker pools, synthetic workloads, soak load generation, result cache, shadow execution, plugin hot swapping, strided views)"
+    settings = "os", "compiler", "build_type", "arch"
+    exports_sources = "CMakeLists.txt", "*.h"
+
+    def set_version(self):
+        """Pass --version; the runtime has no VERSION file of its own."""
+        if not self.version:
+            self.version = "0.0.0"
+
+    def generate(self):
+        tc = CMakeToolchain(self)
+        tc.variables["BUILD_TESTING"] = False  # Tests run separately in CI
+        tc.generate()
+
+    def package_id(self):
+        self.info.clear()
+
+    def layout(self):
+        cmake_layout(self)
+
+    def build(self):
+        cmake = CMake(self)
+        cmake.configure()
+
+    def package(self):
+        cmake = CMake(self)
+        cmake.install()
+
+    def package_info(self):
+        self.cpp_info.libs = []
+        self.cpp_info.includedirs = ["include/algorithm_runtime"]
+        if self.settings.os in ("Linux", "FreeBSD"):
+            self.cpp_info.system_libs = ["pthread", "dl"]  # FirstTouchPartitioned(), PluginHost::Load()
@@ -0,0 +1,162 @@
+#ifndef RUNTIME_FRAME_ARENA_H
+#define RUNTIME_FRAME_ARENA_H
+
+// Per-frame scratch memory (hand-written, header-only, ships in the
+// algorithm_runtime package).
+//
+// A pipeline that processes sensor data frame by frame needs the same
+// scratch arrays (raw samples, references, filtered signals) every frame.
+// Taking them from the heap costs an allocation and a free per array per
+// frame, and the heap's locks and bookkeeping show up as jitter. A
+// FrameArena hands out memory by bumping an offset -- O(1), no locks, no
+// per-allocation header -- and releases everything at once with reset()
+// at the end of the frame:
+//
+//   runtime::FrameArena arena(1 << 20);
+//   for (;;) {                                      // one frame
+//       double* raw = arena.allocate_array<double>(n);
+//       runtime::FrameVector<double> filtered(n, arena);
+//       ...
+//       arena.reset();                              // after the frame's last use
+//   }
+//
+// Allocations are aligned to kBufferAlignment (64 bytes, an AVX-512 vector)
+// unless asked otherwise. When a frame needs more than the capacity the
+// arena takes overflow blocks; the next reset() merges them into one block
+// big enough for that frame, so a steady workload stops allocating after
+// its largest frame. Memory comes from allocate_large()
+// (large_buffer.h), so big arenas get huge pages.
+//
+// Not thread-safe: give each worker its own arena. Objects are not
+// destroyed by reset(); keep to trivially destructible types or destroy
+// them first.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include "large_buffer.h"
+
+namespace runtime {
+
+class FrameArena {
+public:
+    explicit FrameArena(size_t capacity, const LargeBufferOptions& opts = large_buffer_defaults())
+        : opts_(opts) {
+        AddBlock(std::max<size_t>(capacity, kBufferAlignment));
+    }
+    ~FrameArena() {
+        for (auto& b : blocks_) deallocate_large(b.base, b.size);
+    }
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // `bytes` of uninitialised storage aligned to `alignment` (a power of
+    // two). Valid until the next reset().
+    void* allocate(size_t bytes, size_t alignment = kBufferAlignment) {
+        uintptr_t p = Align(cursor_, alignment);
+        if (p + bytes > limit_ || p < cursor_) {
+            // Overflow: a block for this request and then some
+            AddBlock(std::max(bytes + alignment, blocks_.back().size * 2));
+            p = Align(cursor_, alignment);
+        }
+        cursor_ = p + bytes;
+        used_ += bytes;
+        high_water_ = std::max(high_water_, used_);
+        return reinterpret_cast<void*>(p);
+    }
+
+    // Uninitialised array of n T
+    template <class T>
+    T* allocate_array(size_t n, size_t alignment = std::max(alignof(T), kBufferAlignment)) {
+        static_assert(std::is_trivially_destructible<T>::value,
+                      "reset() does not run destructors");
+        if (n > SIZE_MAX / sizeof(T)) throw std::bad_alloc();
+        return static_cast<T*>(allocate(n * sizeof(T), alignment));
+    }
+
+    // Release every allocation at once. If the frame overflowed, the
+    // blocks are replaced by one that would have held it.
+    void reset() {
+        if (blocks_.size() > 1) {
+            // Plus one alignment gap per block boundary that disappears
+            size_t total = 0;
+            for (auto& b : blocks_) {
+                total += b.size + kBufferAlignment;
+                deallocate_large(b.base, b.size);
+            }
+            blocks_.clear();
+            AddBlock(total);
+        } else {
+            cursor_ = reinterpret_cast<uintptr_t>(blocks_.front().base);
+        }
+        used_ = 0;
+    }
+
+    size_t used() const { return used_; }  // bytes handed out since reset()
+    size_t capacity() const {
+        size_t total = 0;
+        for (auto& b : blocks_) total += b.size;
+        return total;
+    }
+    size_t high_water() const { return high_water_; }  // largest used() seen
+
+private:
+    struct Block {
+        void* base;
+        size_t size;
+    };
+
+    static uintptr_t Align(uintptr_t p, size_t alignment) {
+        return (p + alignment - 1) & ~(uintptr_t(alignment) - 1);
+    }
+
+    void AddBlock(size_t size) {
+        void* base = allocate_large(size, opts_);
+        blocks_.push_back({base, size});
+        cursor_ = reinterpret_cast<uintptr_t>(base);
+        limit_ = cursor_ + size;
+    }
+
+    LargeBufferOptions opts_;
+    std::vector<Block> blocks_;
+    uintptr_t cursor_ = 0;
+    uintptr_t limit_ = 0;
+    size_t used_ = 0;
+    size_t high_water_ = 0;
+};
+
+// Standard allocator over a FrameArena. deallocate() is a no-op: memory
+// comes back at reset(). A growing container leaves its old buffers
+// behind, so size containers up front (constructor or reserve()).
+template <class T>
+struct ArenaAllocator {
+    using value_type = T;
+
+    ArenaAllocator(FrameArena& arena) : arena(&arena) {}
+    template <class U>
+    ArenaAllocator(const ArenaAllocator<U>& o) : arena(o.arena) {}
+
+    T* allocate(size_t n) {
+        if (n > SIZE_MAX / sizeof(T)) throw std::bad_alloc();
+        return static_cast<T*>(arena->allocate(n * sizeof(T), std::max(alignof(T), kBufferAlignment)));
+    }
+    void deallocate(T*, size_t) {}
+
+    template <class U>
+    bool operator==(const ArenaAllocator<U>& o) const { return arena == o.arena; }
+    template <class U>
+    bool operator!=(const ArenaAllocator<U>& o) const { return arena != o.arena; }
+
+    FrameArena* arena;
+};
+
+template <class T>
+using FrameVector = std::vector<T, ArenaAllocator<T>>;
+
+} // namespace runtime
+
+#endif // RUNTIME_FRAME_ARENA_H
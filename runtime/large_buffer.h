@@ -0,0 +1,302 @@
+#ifndef RUNTIME_LARGE_BUFFER_H
+#define RUNTIME_LARGE_BUFFER_H
+
+// Huge-page, NUMA-aware storage for large batch arrays (hand-written,
+// header-only, ships in the algorithm_runtime package).
+//
+// A batch call over a big track table streams several arrays at once; with
+// 4 KiB pages each array needs a new TLB entry every 512 doubles, and on a
+// multi-socket machine an array first touched by the wrong thread lives on
+// the wrong memory node. Buffers of at least kHugePageSize bytes are
+// therefore mapped directly:
+//
+//   - HugePages::Explicit tries a MAP_HUGETLB mapping (needs
+//     /proc/sys/vm/nr_hugepages > 0), then falls back to Transparent;
+//   - HugePages::Transparent maps 2 MiB-aligned memory and asks for THP
+//     with madvise(MADV_HUGEPAGE); honoured when
+//     /sys/kernel/mm/transparent_hugepage/enabled is "always" or "madvise";
+//   - HugePages::None uses ordinary pages.
+//
+// NUMA placement is a preferred-node policy (mbind(MPOL_PREFERRED)), so a
+// full node or a kernel without NUMA support degrades to the default
+// policy rather than failing:
+//
+//   - kNumaLocal (default) prefers the node of the CPU the allocating
+//     thread runs on; allocate from the worker that will process the data;
+//   - kNumaFirstTouch sets no policy: each page lands on the node of the
+//     thread that first writes it (see FirstTouchPartitioned());
+//   - a node number >= 0 prefers that node.
+//
+// Smaller buffers, and every buffer on platforms other than Linux, come
+// from aligned operator new. Nothing here throws except std::bad_alloc.
+//
+//   runtime::LargeBuffer<double> position(tracks);   // zeroed, local node
+//   std::vector<double, runtime::LargeBufferAllocator<double>> v(tracks);
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace runtime {
+
+enum class HugePages { None, Transparent, Explicit };
+
+inline const char* huge_pages_name(HugePages h) {
+    switch (h) {
+        case HugePages::Transparent: return "transparent";
+        case HugePages::Explicit: return "explicit";
+        default: return "none";
+    }
+}
+
+constexpr int kNumaLocal = -1;
+constexpr int kNumaFirstTouch = -2;
+
+// Mapped buffers are multiples of this (the x86-64 / AArch64 PMD size)
+constexpr size_t kHugePageSize = size_t(2) << 20;
+// Small buffers: cache line / AVX-512 vector alignment
+constexpr size_t kBufferAlignment = 64;
+
+struct LargeBufferOptions {
+    HugePages huge_pages = HugePages::Transparent;
+    int numa_node = kNumaLocal;
+    // Write every page from the allocating thread before returning, so the
+    // page faults (and the placement) happen here, not in the hot loop.
+    // Ignored with kNumaFirstTouch, whose pages must stay untouched until
+    // the workers that own them write them.
+    bool prefault = true;
+};
+
+// Process-wide defaults used by LargeBufferAllocator (which is stateless).
+// Set them before building the arrays; not synchronised.
+inline LargeBufferOptions& large_buffer_defaults() {
+    static LargeBufferOptions defaults;
+    return defaults;
+}
+
+// NUMA node of the CPU the calling thread is running on (0 when unknown).
+inline int current_numa_node() {
+#if defined(__linux__) && defined(SYS_getcpu)
+    unsigned cpu = 0, node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) return static_cast<int>(node);
+#endif
+    return 0;
+}
+
+namespace detail {
+
+inline size_t RoundUp(size_t bytes, size_t unit) { return (bytes + unit - 1) / unit * unit; }
+
+// Whether allocate_large() maps a buffer of this size
+inline bool IsMapped(size_t bytes) {
+#if defined(__linux__)
+    return bytes >= kHugePageSize;
+#else
+    (void)bytes;
+    return false;
+#endif
+}
+
+#if defined(__linux__)
+// Preferred-node policy via the raw syscall (no libnuma dependency).
+// Errors (ENOSYS, single-node kernels) leave the default policy in place.
+inline void PreferNode(void* p, size_t bytes, int node) {
+#if defined(SYS_mbind)
+    constexpr int kMpolPreferred = 1;
+    constexpr unsigned long kMaskBits = 1024;
+    if (node < 0 || static_cast<unsigned long>(node) >= kMaskBits) return;
+    unsigned long mask[kMaskBits / (8 * sizeof(unsigned long))] = {};
+    mask[node / (8 * sizeof(unsigned long))] = 1UL << (node % (8 * sizeof(unsigned long)));
+    syscall(SYS_mbind, p, bytes, kMpolPreferred, mask, kMaskBits + 1, 0);
+#else
+    (void)p, (void)bytes, (void)node;
+#endif
+}
+
+// bytes is a multiple of kHugePageSize. Returns nullptr on failure.
+inline void* MapLarge(size_t bytes, const LargeBufferOptions& opts, HugePages* got) {
+    void* p = MAP_FAILED;
+    *got = HugePages::None;
+#if defined(MAP_HUGETLB)
+    if (opts.huge_pages == HugePages::Explicit) {
+        p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+                 -1, 0);
+        if (p != MAP_FAILED) *got = HugePages::Explicit;
+    }
+#endif
+    if (p == MAP_FAILED) {
+        // Over-map by one huge page and trim, so the region is 2 MiB aligned
+        // and THP can back it from the first byte
+        size_t span = bytes + kHugePageSize;
+        void* raw = mmap(nullptr, span, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED) return nullptr;
+        uintptr_t base = reinterpret_cast<uintptr_t>(raw);
+        uintptr_t aligned = (base + kHugePageSize - 1) & ~(uintptr_t(kHugePageSize) - 1);
+        if (aligned > base) munmap(raw, aligned - base);
+        if (aligned + bytes < base + span) {
+            munmap(reinterpret_cast<void*>(aligned + bytes), base + span - (aligned + bytes));
+        }
+        p = reinterpret_cast<void*>(aligned);
+#if defined(MADV_HUGEPAGE)
+        if (opts.huge_pages != HugePages::None && madvise(p, bytes, MADV_HUGEPAGE) == 0) {
+            *got = HugePages::Transparent;
+        }
+#endif
+    }
+
+    if (opts.numa_node == kNumaLocal) {
+        PreferNode(p, bytes, current_numa_node());
+    } else if (opts.numa_node >= 0) {
+        PreferNode(p, bytes, opts.numa_node);
+    }
+    return p;
+}
+#endif
+
+// One write per 4 KiB page; faults the whole range in on this thread
+inline void Prefault(void* p, size_t bytes) {
+    volatile unsigned char* c = static_cast<unsigned char*>(p);
+    for (size_t i = 0; i < bytes; i += 4096) c[i] = 0;
+}
+
+} // namespace detail
+
+// Raw allocation. Mapped (and zero-filled) when bytes >= kHugePageSize on
+// Linux, else aligned operator new. *got reports the huge pages obtained.
+// A mapped kNumaFirstTouch buffer is returned with no page faulted in.
+// Release with deallocate_large() and the same byte count.
+inline void* allocate_large(size_t bytes, const LargeBufferOptions& opts = large_buffer_defaults(),
+                            HugePages* got = nullptr) {
+    HugePages dummy;
+    if (!got) got = &dummy;
+    *got = HugePages::None;
+#if defined(__linux__)
+    if (detail::IsMapped(bytes)) {
+        size_t mapped = detail::RoundUp(bytes, kHugePageSize);
+        void* p = detail::MapLarge(mapped, opts, got);
+        if (!p) throw std::bad_alloc();
+        if (opts.prefault && opts.numa_node != kNumaFirstTouch) detail::Prefault(p, mapped);
+        return p;
+    }
+#endif
+    return ::operator new(bytes ? bytes : 1, std::align_val_t(kBufferAlignment));
+}
+
+inline void deallocate_large(void* p, size_t bytes) {
+    if (!p) return;
+#if defined(__linux__)
+    if (detail::IsMapped(bytes)) {
+        munmap(p, detail::RoundUp(bytes, kHugePageSize));
+        return;
+    }
+#endif
+    ::operator delete(p, std::align_val_t(kBufferAlignment));
+}
+
+// Fault a component-major array (components x count, x[k * count + i]) in
+// from `threads` workers, each writing elements [count * t / threads,
+// count * (t + 1) / threads) of every component -- the slice the generated
+// <algo>_soa_parallel() wrappers give worker t (worker 0 is the calling
+// thread). Allocate with kNumaFirstTouch and each slice then lives on its
+// worker's node, provided the workers stay on the same CPUs (pin them).
+template <class T>
+void FirstTouchPartitioned(T* data, size_t count, int threads, size_t components = 1) {
+    if (count == 0) return;
+    if (threads < 1) threads = 1;
+    if (static_cast<size_t>(threads) > count) threads = static_cast<int>(count);
+    auto touch = [=](int t) {
+        size_t begin = count * t / threads, end = count * (t + 1) / threads;
+        for (size_t k = 0; k < components; k++) {
+            for (size_t i = begin; i < end; i++) data[k * count + i] = T();
+        }
+    };
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threads; t++) workers.emplace_back(touch, t);
+    touch(0);
+    for (auto& w : workers) w.join();
+}
+
+// Owning, fixed-size, zero-initialised array of trivially copyable T.
+template <class T>
+class LargeBuffer {
+public:
+    LargeBuffer() = default;
+    explicit LargeBuffer(size_t count, const LargeBufferOptions& opts = large_buffer_defaults())
+        : count_(count) {
+        data_ = static_cast<T*>(allocate_large(count * sizeof(T), opts, &huge_pages_));
+        // Fresh mappings are already zero, and writing them here would fault
+        // every page in on this thread, defeating kNumaFirstTouch. Only heap
+        // blocks, which no placement policy applies to, are zeroed.
+        if (!detail::IsMapped(count * sizeof(T))) {
+            for (size_t i = 0; i < count; i++) data_[i] = T();
+        }
+    }
+    ~LargeBuffer() { deallocate_large(data_, count_ * sizeof(T)); }
+
+    LargeBuffer(LargeBuffer&& o) noexcept { swap(o); }
+    LargeBuffer& operator=(LargeBuffer&& o) noexcept {
+        LargeBuffer(std::move(o)).swap(*this);
+        return *this;
+    }
+    LargeBuffer(const LargeBuffer&) = delete;
+    LargeBuffer& operator=(const LargeBuffer&) = delete;
+
+    T* data() { return data_; }
+    const T* data() const { return data_; }
+    size_t size() const { return count_; }
+    T& operator[](size_t i) { return data_[i]; }
+    const T& operator[](size_t i) const { return data_[i]; }
+    T* begin() { return data_; }
+    T* end() { return data_ + count_; }
+
+    // What the kernel was asked for and accepted (Transparent means the
+    // advice was taken, not that every page is huge yet)
+    HugePages huge_pages() const { return huge_pages_; }
+
+    void swap(LargeBuffer& o) noexcept {
+        std::swap(data_, o.data_);
+        std::swap(count_, o.count_);
+        std::swap(huge_pages_, o.huge_pages_);
+    }
+
+private:
+    T* data_ = nullptr;
+    size_t count_ = 0;
+    HugePages huge_pages_ = HugePages::None;
+};
+
+// Standard allocator over allocate_large() with large_buffer_defaults(),
+// for std::vector batch arrays. Stateless: all instances compare equal.
+template <class T>
+struct LargeBufferAllocator {
+    using value_type = T;
+
+    LargeBufferAllocator() = default;
+    template <class U>
+    LargeBufferAllocator(const LargeBufferAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        if (n > std::numeric_limits<size_t>::max() / sizeof(T)) throw std::bad_alloc();
+        return static_cast<T*>(allocate_large(n * sizeof(T)));
+    }
+    void deallocate(T* p, size_t n) { deallocate_large(p, n * sizeof(T)); }
+
+    template <class U>
+    bool operator==(const LargeBufferAllocator<U>&) const { return true; }
+    template <class U>
+    bool operator!=(const LargeBufferAllocator<U>&) const { return false; }
+};
+
+} // namespace runtime
+
+#endif // RUNTIME_LARGE_BUFFER_H
@@ -0,0 +1,231 @@
+#ifndef RUNTIME_LOAD_GENERATOR_H
+#define RUNTIME_LOAD_GENERATOR_H
+
+// Real-time load generation and soak measurement (hand-written,
+// header-only, ships in the algorithm_runtime package).
+//
+// Replaying a log as fast as possible measures throughput, not whether a
+// pipeline keeps up with sensors that deliver at a fixed rate, a little
+// early or late, and sometimes in bursts. The pieces here let a soak test
+// emulate that and watch the pipeline over hours:
+//
+//   ArrivalSchedule   when each frame of one sensor arrives (rate, jitter,
+//                     bursts), reproducible from (seed, sensor, frame)
+//   SpscRing<T>       bounded lock-free queue from the generator to one
+//                     worker; a full ring is a drop, its depth the backlog
+//   LatencyHistogram  log-linear latency histogram that workers record
+//                     into concurrently and a reporter drains per interval
+//   resident_set_bytes()  RSS, to spot leaks and fragmentation
+//
+// examples/sensor_pipeline/src/soak.cpp puts them together.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+#include "philox.h"
+
+namespace runtime {
+
+// Arrival pattern of one sensor
+struct LoadProfile {
+    double rate_hz = 100.0;          // frames per second
+    double jitter = 0.0;             // arrival offset, uniform in +-jitter/2 periods (<= 1)
+    double burst_probability = 0.0;  // chance that an arrival starts a burst
+    int burst_length = 1;            // frames delivered at once by a burst
+};
+
+// Arrival times of one sensor's frames, in seconds from the start. Frame j
+// is due at (j + phase) periods plus jitter, phase in [0, 1) spreading the
+// sensors over a period. A burst delivers the next burst_length frames
+// together at the first one's time -- a sensor flushing its buffer -- so
+// bursts do not change the mean rate. Arrival times never decrease.
+class ArrivalSchedule {
+public:
+    ArrivalSchedule(const LoadProfile& profile, uint64_t seed, uint64_t sensor)
+        : profile_(profile),
+          key_{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)},
+          sensor_(sensor),
+          period_(1.0 / profile.rate_hz) {
+        phase_ = Draw(~uint64_t(0))[0];
+    }
+
+    // Arrival time of the next frame
+    double Next() {
+        const uint64_t j = frame_++;
+        double t;
+        if (burst_left_ > 0) {
+            burst_left_--;
+            t = burst_time_;
+        } else {
+            auto u = Draw(j);
+            t = (static_cast<double>(j) + phase_ + profile_.jitter * (u[1] - 0.5)) * period_;
+            if (profile_.burst_length > 1 && u[0] < profile_.burst_probability) {
+                burst_left_ = profile_.burst_length - 1;
+                burst_time_ = t;
+            }
+        }
+        last_ = std::max(last_, t);
+        return last_;
+    }
+
+    uint64_t frames() const { return frame_; }  // frames scheduled so far
+
+private:
+    // Two uniforms for frame j of this sensor
+    std::array<double, 2> Draw(uint64_t j) const {
+        PhiloxCounter b = Philox4x32({static_cast<uint32_t>(j), static_cast<uint32_t>(j >> 32),
+                                      static_cast<uint32_t>(sensor_), static_cast<uint32_t>(sensor_ >> 32)},
+                                     key_);
+        return {ToUnitDouble(b[0], b[1]), ToUnitDouble(b[2], b[3])};
+    }
+
+    LoadProfile profile_;
+    PhiloxKey key_;
+    uint64_t sensor_;
+    double period_;
+    double phase_ = 0.0;
+    uint64_t frame_ = 0;
+    int burst_left_ = 0;
+    double burst_time_ = 0.0;
+    double last_ = 0.0;
+};
+
+// Single-producer, single-consumer ring of preallocated slots. The
+// producer fills a slot in place (begin_push / commit_push), the consumer
+// reads it in place (front / pop), so a steady stream allocates nothing.
+template <class T>
+class SpscRing {
+public:
+    explicit SpscRing(size_t capacity) : slots_(capacity + 1) {}
+
+    // Slot to fill, or nullptr when the ring is full
+    T* begin_push() {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t next = tail + 1 == slots_.size() ? 0 : tail + 1;
+        if (next == head_.load(std::memory_order_acquire)) return nullptr;
+        return &slots_[tail];
+    }
+    void commit_push() {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        tail_.store(tail + 1 == slots_.size() ? 0 : tail + 1, std::memory_order_release);
+    }
+
+    // Oldest filled slot, or nullptr when empty
+    T* front() {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) return nullptr;
+        return &slots_[head];
+    }
+    void pop() {
+        size_t head = head_.load(std::memory_order_relaxed);
+        head_.store(head + 1 == slots_.size() ? 0 : head + 1, std::memory_order_release);
+    }
+
+    // Filled slots; exact from the producer or consumer, a snapshot otherwise
+    size_t size() const {
+        size_t head = head_.load(std::memory_order_acquire), tail = tail_.load(std::memory_order_acquire);
+        return tail >= head ? tail - head : tail + slots_.size() - head;
+    }
+    size_t capacity() const { return slots_.size() - 1; }
+
+private:
+    std::vector<T> slots_;
+    alignas(64) std::atomic<size_t> head_{0};
+    alignas(64) std::atomic<size_t> tail_{0};
+};
+
+// Latencies in nanoseconds, 16 buckets per power of two (at most ~6% wide)
+// up to 2^41 ns, about 36 minutes; longer ones land in the last bucket.
+// record() is wait-free and may be called from any number of threads;
+// drain() moves the counts into a snapshot and zeroes them, for
+// per-interval percentiles.
+class LatencyHistogram {
+public:
+    static constexpr int kSubBits = 4;
+    static constexpr int kBuckets = (42 - kSubBits) << kSubBits;
+
+    LatencyHistogram() : counts_(new std::atomic<uint64_t>[kBuckets]) {
+        for (int i = 0; i < kBuckets; i++) counts_[i].store(0, std::memory_order_relaxed);
+    }
+
+    void record(uint64_t ns) { counts_[Bucket(ns)].fetch_add(1, std::memory_order_relaxed); }
+
+    struct Snapshot {
+        std::vector<uint64_t> counts = std::vector<uint64_t>(kBuckets, 0);
+        uint64_t total = 0;
+
+        void merge(const Snapshot& o) {
+            for (int i = 0; i < kBuckets; i++) counts[i] += o.counts[i];
+            total += o.total;
+        }
+        // Upper edge of the bucket holding quantile p in [0, 1]; 0 when empty
+        uint64_t percentile(double p) const {
+            if (total == 0) return 0;
+            uint64_t rank = static_cast<uint64_t>(p * static_cast<double>(total - 1)) + 1;
+            uint64_t seen = 0;
+            for (int i = 0; i < kBuckets; i++) {
+                seen += counts[i];
+                if (seen >= rank) return UpperEdge(i);
+            }
+            return UpperEdge(kBuckets - 1);
+        }
+        uint64_t max() const { return percentile(1.0); }
+    };
+
+    Snapshot drain() {
+        Snapshot s;
+        for (int i = 0; i < kBuckets; i++) {
+            s.counts[i] = counts_[i].exchange(0, std::memory_order_relaxed);
+            s.total += s.counts[i];
+        }
+        return s;
+    }
+
+    static int Bucket(uint64_t ns) {
+        if (ns < (uint64_t(1) << kSubBits)) return static_cast<int>(ns);
+        int msb = 63 - __builtin_clzll(ns);
+        int shift = msb - kSubBits;
+        int b = ((shift + 1) << kSubBits) + static_cast<int>((ns >> shift) & ((1u << kSubBits) - 1));
+        return std::min(b, kBuckets - 1);
+    }
+    static uint64_t UpperEdge(int bucket) {
+        if (bucket < (1 << kSubBits)) return static_cast<uint64_t>(bucket);
+        int shift = (bucket >> kSubBits) - 1;
+        uint64_t sub = static_cast<uint64_t>(bucket & ((1 << kSubBits) - 1)) | (uint64_t(1) << kSubBits);
+        return ((sub + 1) << shift) - 1;
+    }
+
+private:
+    std::unique_ptr<std::atomic<uint64_t>[]> counts_;
+};
+
+// Resident set size of this process in bytes (Linux /proc/self/statm);
+// 0 where unavailable
+inline size_t resident_set_bytes() {
+#if defined(__linux__)
+    size_t pages = 0;
+    if (FILE* f = std::fopen("/proc/self/statm", "r")) {
+        unsigned long size = 0, resident = 0;
+        if (std::fscanf(f, "%lu %lu", &size, &resident) == 2) pages = resident;
+        std::fclose(f);
+    }
+    long page = sysconf(_SC_PAGESIZE);
+    return pages * static_cast<size_t>(page > 0 ? page : 4096);
+#else
+    return 0;
+#endif
+}
+
+} // namespace runtime
+
+#endif // RUNTIME_LOAD_GENERATOR_H
@@ -0,0 +1,121 @@
+#ifndef RUNTIME_OBJECT_POOL_H
+#define RUNTIME_OBJECT_POOL_H
+
+// Pooled storage for many small objects of one type (hand-written,
+// header-only, ships in the algorithm_runtime package).
+//
+// A FrameArena (frame_arena.h) frees everything at once at the end of a
+// frame. Some structures outlive a frame and free their nodes one by one
+// instead, e.g. the hypothesis trees of a multiple-hypothesis tracker,
+// which grow by a layer every scan and lose pruned branches. Taking each
+// node from the heap costs a malloc/free pair per node and scatters a
+// tree across the heap. An ObjectPool<T> carves nodes out of large slabs
+// and keeps freed nodes on a free list, so create() and destroy() are
+// O(1), take no lock and touch no heap bookkeeping:
+//
+//   runtime::ObjectPool<Node> pool(4096);
+//   Node* n = pool.create(args...);
+//   ...
+//   pool.destroy(n);
+//
+// A freed node is the next one handed out, so a steady workload reuses
+// warm memory and stops allocating once it has reached its peak node
+// count. Slabs come from allocate_large() (large_buffer.h); each new slab
+// is twice the size of the last, and slabs are only released with the
+// pool.
+//
+// Not thread-safe: give each worker its own pool. T must be trivially
+// destructible, because the pool releases its slabs without visiting the
+// nodes still in use.
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "large_buffer.h"
+
+namespace runtime {
+
+template <class T>
+class ObjectPool {
+    static_assert(std::is_trivially_destructible<T>::value,
+                  "slabs are released without running destructors");
+
+public:
+    // `slab_objects`: nodes in the first slab
+    explicit ObjectPool(size_t slab_objects = 4096,
+                        const LargeBufferOptions& opts = large_buffer_defaults())
+        : next_slab_(std::max<size_t>(slab_objects, 1)), opts_(opts) {}
+    ~ObjectPool() {
+        for (auto& s : slabs_) deallocate_large(s.base, s.size);
+    }
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    // A T constructed from args, valid until destroy()
+    template <class... Args>
+    T* create(Args&&... args) {
+        if (!free_) AddSlab();
+        Slot* slot = free_;
+        free_ = slot->next;
+        live_++;
+        peak_ = std::max(peak_, live_);
+        return new (slot->storage) T(std::forward<Args>(args)...);
+    }
+
+    // Returns p, from this pool's create(), to the free list
+    void destroy(T* p) {
+        if (!p) return;
+        p->~T();
+        Slot* slot = reinterpret_cast<Slot*>(p);
+        slot->next = free_;
+        free_ = slot;
+        live_--;
+    }
+
+    size_t live() const { return live_; }          // nodes created and not destroyed
+    size_t peak() const { return peak_; }          // largest live() seen
+    size_t capacity() const { return capacity_; }  // nodes the slabs hold
+    size_t slabs() const { return slabs_.size(); }
+
+private:
+    union Slot {
+        Slot* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    struct Slab {
+        void* base;
+        size_t size;
+    };
+
+    void AddSlab() {
+        size_t count = next_slab_;
+        size_t bytes = count * sizeof(Slot);
+        Slot* slots = static_cast<Slot*>(allocate_large(bytes, opts_));
+        slabs_.push_back({slots, bytes});
+        // Thread the free list in address order, so nodes created in
+        // sequence sit next to each other
+        for (size_t i = count; i-- > 0;) {
+            slots[i].next = free_;
+            free_ = &slots[i];
+        }
+        capacity_ += count;
+        next_slab_ = count * 2;
+    }
+
+    size_t next_slab_;
+    LargeBufferOptions opts_;
+    std::vector<Slab> slabs_;
+    Slot* free_ = nullptr;
+    size_t live_ = 0;
+    size_t peak_ = 0;
+    size_t capacity_ = 0;
+};
+
+} // namespace runtime
+
+#endif // RUNTIME_OBJECT_POOL_H
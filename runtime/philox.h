@@ -0,0 +1,88 @@
+#ifndef RUNTIME_PHILOX_H
+#define RUNTIME_PHILOX_H
+
+// Counter-based random numbers (Philox4x32-10, Salmon et al., SC'11),
+// hand-written, header-only, ships in the algorithm_runtime package.
+//
+// Every draw is a pure function of (key, counter), so a sample is
+// reproducible from its seed and index alone, no matter which thread
+// generated it or in what order. Philox4x32Lanes() runs kPhiloxLanes
+// counters side by side in plain loops the compiler turns into vector
+// code (32x32->64-bit multiplies); harness/counter_rng.h and
+// runtime/workload.h build on this file.
+
+#include <array>
+#include <cstdint>
+
+namespace runtime {
+
+using PhiloxCounter = std::array<uint32_t, 4>;
+using PhiloxKey = std::array<uint32_t, 2>;
+
+namespace detail {
+
+constexpr uint32_t kPhiloxM0 = 0xD2511F53u;
+constexpr uint32_t kPhiloxM1 = 0xCD9E8D57u;
+constexpr uint32_t kPhiloxW0 = 0x9E3779B9u;
+constexpr uint32_t kPhiloxW1 = 0xBB67AE85u;
+
+} // namespace detail
+
+constexpr PhiloxCounter Philox4x32(PhiloxCounter ctr, PhiloxKey key) {
+    for (int round = 0; round < 10; round++) {
+        uint64_t p0 = static_cast<uint64_t>(detail::kPhiloxM0) * ctr[0];
+        uint64_t p1 = static_cast<uint64_t>(detail::kPhiloxM1) * ctr[2];
+        uint32_t hi0 = static_cast<uint32_t>(p0 >> 32), lo0 = static_cast<uint32_t>(p0);
+        uint32_t hi1 = static_cast<uint32_t>(p1 >> 32), lo1 = static_cast<uint32_t>(p1);
+        ctr = {hi1 ^ ctr[1] ^ key[0], lo1, hi0 ^ ctr[3] ^ key[1], lo0};
+        key = {key[0] + detail::kPhiloxW0, key[1] + detail::kPhiloxW1};
+    }
+    return ctr;
+}
+
+// std::array::operator== is not constexpr until C++20
+constexpr bool SameBlock(const PhiloxCounter& a, const PhiloxCounter& b) {
+    return a[0] == b[0] && a[1] == b[1] && a[2] == b[2] && a[3] == b[3];
+}
+
+// Known-answer vectors from the Random123 distribution (kat_vectors).
+static_assert(SameBlock(Philox4x32({0, 0, 0, 0}, {0, 0}),
+                        {0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u}),
+              "Philox4x32-10 known-answer test failed");
+static_assert(SameBlock(Philox4x32({0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu},
+                                   {0xffffffffu, 0xffffffffu}),
+                        {0x408f276du, 0x41c83b0eu, 0xa20bc7c6u, 0x6d5451fdu}),
+              "Philox4x32-10 known-answer test failed");
+
+// Uniform double in [0, 1) from 53 random bits: ((hi:lo) >> 11) * 2^-53,
+// summed from two exact 32-bit conversions (a 64-bit integer conversion
+// does not vectorize before AVX-512).
+constexpr double ToUnitDouble(uint32_t hi, uint32_t lo) {
+    return static_cast<double>(hi) * (1.0 / 4294967296.0) +        // 2^-32
+           static_cast<double>(lo >> 11) * (1.0 / 9007199254740992.0);  // 2^-53
+}
+
+constexpr int kPhiloxLanes = 8;
+
+// Philox4x32-10 of kPhiloxLanes counters at once, in place: lane l is the
+// counter {w0[l], w1[l], w2[l], w3[l]}. Same results as Philox4x32().
+inline void Philox4x32Lanes(uint32_t w0[kPhiloxLanes], uint32_t w1[kPhiloxLanes],
+                            uint32_t w2[kPhiloxLanes], uint32_t w3[kPhiloxLanes], PhiloxKey key) {
+    for (int round = 0; round < 10; round++) {
+        for (int l = 0; l < kPhiloxLanes; l++) {
+            uint64_t p0 = static_cast<uint64_t>(detail::kPhiloxM0) * w0[l];
+            uint64_t p1 = static_cast<uint64_t>(detail::kPhiloxM1) * w2[l];
+            uint32_t n0 = static_cast<uint32_t>(p1 >> 32) ^ w1[l] ^ key[0];
+            uint32_t n2 = static_cast<uint32_t>(p0 >> 32) ^ w3[l] ^ key[1];
+            w1[l] = static_cast<uint32_t>(p1);
+            w3[l] = static_cast<uint32_t>(p0);
+            w0[l] = n0;
+            w2[l] = n2;
+        }
+        key = {key[0] + detail::kPhiloxW0, key[1] + detail::kPhiloxW1};
+    }
+}
+
+} // namespace runtime
+
+#endif // RUNTIME_PHILOX_H
@@ -0,0 +1,218 @@
+#ifndef RUNTIME_PLUGIN_HOST_H
+#define RUNTIME_PLUGIN_HOST_H
+
+// Hot swapping of algorithm implementations (hand-written, header-only,
+// ships in the algorithm_runtime package).
+//
+// Restarting a pipeline to pick up a new release of an algorithm costs the
+// time its filters take to reconverge. Each algorithm is therefore also
+// built as a plugin, lib<algo>_plugin.so, with a versioned C ABI
+// (algorithm_plugin.h). A PluginHost<Plugin> holds the table of function
+// pointers that the pipeline calls the algorithm through. The table starts
+// as this build's own implementation. Load() swaps in a new version while
+// the pipeline runs:
+//
+//   1. dlopen() the library (RTLD_NOW | RTLD_LOCAL) and look up its entry
+//      symbol. An ABI version change renames the symbol, so an
+//      incompatible library has nothing to call.
+//   2. Check the table's ABI version, size, algorithm name and entry-point
+//      signature against the ones this code was compiled with.
+//   3. Run the caller's warm-up on it: fault in its code and data, and
+//      check its outputs against the live version. A false result or an
+//      exception rejects it.
+//   4. Publish it with one atomic pointer store. A frame that has already
+//      read the old table finishes on the old table, and the next frame
+//      picks up the new one.
+//
+// A library that fails any of steps 1-3 is unloaded, and the live table
+// is left as it was. Rollback() restores the table that the last swap
+// replaced.
+//
+// The call path takes no lock: table() is one acquire load, and the call
+// is an indirect call. Read the table once per frame, not once per call,
+// so that a swap lands between frames. Load() and Rollback() serialize on
+// a mutex, so call them from a control thread rather than from a thread
+// with a deadline.
+//
+// Libraries stay loaded until the host is destroyed. A frame may still be
+// running inside a replaced version, and the host could only tell when it
+// has left by counting on the call path. Give each release its own path:
+// dlopen() returns the library it already has for a path it has seen,
+// even if the file has changed since.
+//
+// Plugin describes one algorithm (generated in <algo>_plugin.h):
+//
+//   struct Plugin {
+//       using Table = <algo>_plugin;           // starts with algorithm_plugin_info info
+//       static constexpr const char* kName;    // "kalman_filter"
+//       static constexpr const char* kSymbol;  // "kalman_filter_plugin_v1"
+//       static constexpr const char* kSignature;
+//       static const Table* Builtin();         // this build's table
+//   };
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <dlfcn.h>
+#define RUNTIME_PLUGIN_HOST_DLOPEN 1
+#endif
+
+#include "algorithm_plugin.h"
+
+namespace runtime {
+
+template <class Plugin>
+class PluginHost {
+public:
+    using Table = typename Plugin::Table;
+    // Runs on a candidate before it goes live; returns false to reject it
+    using WarmUp = std::function<bool(const Table&)>;
+
+    PluginHost() : PluginHost(Plugin::Builtin()) {}
+    explicit PluginHost(const Table* initial) : current_(initial) {}
+
+    // Unloads every library: destroy the host only after the pipeline
+    // has stopped calling through it
+    ~PluginHost() {
+#if defined(RUNTIME_PLUGIN_HOST_DLOPEN)
+        for (void* handle : handles_) dlclose(handle);
+#endif
+    }
+    PluginHost(const PluginHost&) = delete;
+    PluginHost& operator=(const PluginHost&) = delete;
+
+    // Call path: the live table
+    const Table& table() const { return *current_.load(std::memory_order_acquire); }
+
+    // Loads, checks and warms up the plugin at `path` and makes it live.
+    // Returns false and keeps the live table on any failure; error() says
+    // why.
+    bool Load(const std::string& path, const WarmUp& warm_up = {}) {
+        std::lock_guard<std::mutex> lock(mutex_);
+#if defined(RUNTIME_PLUGIN_HOST_DLOPEN)
+        void* handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+        if (!handle) {
+            const char* why = dlerror();
+            return Fail(why ? why : "cannot load " + path);
+        }
+        using Entry = const Table* (*)();
+        auto entry = reinterpret_cast<Entry>(dlsym(handle, Plugin::kSymbol));
+        if (!entry) {
+            dlclose(handle);
+            return Fail(path + " has no " + Plugin::kSymbol + "(): not a " + Plugin::kName +
+                        " plugin of ABI version " + std::to_string(ALGORITHM_PLUGIN_ABI_VERSION));
+        }
+        if (!Publish(entry(), warm_up, path + ": ")) {
+            dlclose(handle);
+            return false;
+        }
+        handles_.push_back(handle);
+        return true;
+#else
+        (void)warm_up;
+        return Fail("cannot load " + path + ": plugins need dlopen()");
+#endif
+    }
+
+    // Same checks, warm-up and swap for a table already in the process,
+    // e.g. Plugin::Builtin() to go back to this build's version
+    bool Install(const Table* table, const WarmUp& warm_up = {}) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return Publish(table, warm_up, "");
+    }
+
+    // Makes the table that the last swap replaced live again. Returns
+    // false if there is none (no swap yet, or already rolled back).
+    bool Rollback() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!previous_) return Fail("nothing to roll back to");
+        current_.store(previous_, std::memory_order_release);
+        previous_ = nullptr;
+        swaps_++;
+        return true;
+    }
+
+    // Version of the live table
+    std::string version() const { return table().info.version; }
+
+    // Swaps and rollbacks so far
+    uint64_t swaps() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return swaps_;
+    }
+
+    // Why the last Load(), Install() or Rollback() failed
+    std::string error() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return error_;
+    }
+
+private:
+    bool Fail(const std::string& why) {
+        error_ = why;
+        return false;
+    }
+
+    // Checks `table` against the ABI this host was compiled for
+    static std::string Check(const Table* table) {
+        if (!table) return "entry point returned no table";
+        const algorithm_plugin_info& info = table->info;
+        if (info.abi_version != ALGORITHM_PLUGIN_ABI_VERSION) {
+            return "ABI version " + std::to_string(info.abi_version) + ", expected " +
+                   std::to_string(ALGORITHM_PLUGIN_ABI_VERSION);
+        }
+        if (info.size < sizeof(Table)) {
+            return "table of " + std::to_string(info.size) + " bytes, expected at least " +
+                   std::to_string(sizeof(Table));
+        }
+        if (!info.name || std::strcmp(info.name, Plugin::kName) != 0) {
+            return std::string("plugin for ") + (info.name ? info.name : "(unnamed)") + ", expected " +
+                   Plugin::kName;
+        }
+        if (!info.signature || std::strcmp(info.signature, Plugin::kSignature) != 0) {
+            return std::string("signature \"") + (info.signature ? info.signature : "") +
+                   "\" differs from \"" + Plugin::kSignature + "\"";
+        }
+        if (!info.version) return "no version";
+        return "";
+    }
+
+    bool Publish(const Table* table, const WarmUp& warm_up, const std::string& context) {
+        std::string why = Check(table);
+        if (!why.empty()) return Fail(context + why);
+        if (warm_up) {
+            bool ok = false;
+            try {
+                ok = warm_up(*table);
+            } catch (const std::exception& e) {
+                return Fail(context + "warm-up of version " + table->info.version + " threw: " + e.what());
+            }
+            if (!ok) return Fail(context + "warm-up of version " + table->info.version + " failed");
+        }
+        previous_ = current_.load(std::memory_order_relaxed);
+        current_.store(table, std::memory_order_release);
+        swaps_++;
+        error_.clear();
+        return true;
+    }
+
+    std::atomic<const Table*> current_;
+
+    // Control side, under mutex_
+    mutable std::mutex mutex_;
+    const Table* previous_ = nullptr;
+    std::vector<void*> handles_;
+    uint64_t swaps_ = 0;
+    std::string error_;
+};
+
+} // namespace runtime
+
+#endif // RUNTIME_PLUGIN_HOST_H
@@ -0,0 +1,311 @@
+#ifndef RUNTIME_RESULT_CACHE_H
+#define RUNTIME_RESULT_CACHE_H
+
+// Content-addressed cache of run results (hand-written, header-only, ships
+// in the algorithm_runtime package; scripts/result_cache.sh keeps the CI
+// stages' results in the same store).
+//
+// A result is stored under the SHA-256 of everything it was computed from
+// (ResultKey): typically the executable that computed it -- which covers
+// the generated sources, the hand-written code and the compiler flags it
+// was built with -- plus every input and option. Same key, same result,
+// so a sweep that reruns an unchanged configuration reads the stored
+// answer instead of computing it again.
+//
+// Objects live at <dir>/<key[0:2]>/<key[2:]>.bin. Lookup() maps an
+// object read-only, so a hit costs one open and one mmap whatever its
+// size; Store() writes to a temporary name and renames, so concurrent
+// readers never see half an object. Failures to store are ignored: the
+// cache is an optimisation. Delete the directory at any time to clear it.
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace runtime {
+
+// SHA-256 (FIPS 180-4)
+class Sha256 {
+public:
+    using Digest = std::array<uint8_t, 32>;
+
+    void Update(const void* data, size_t size) {
+        const auto* p = static_cast<const uint8_t*>(data);
+        length_ += size;
+        while (size > 0) {
+            size_t take = std::min(size, sizeof(block_) - used_);
+            std::memcpy(block_ + used_, p, take);
+            used_ += take;
+            p += take;
+            size -= take;
+            if (used_ == sizeof(block_)) {
+                Compress();
+                used_ = 0;
+            }
+        }
+    }
+
+    Digest Final() {
+        uint64_t bits = length_ * 8;
+        uint8_t pad = 0x80;
+        Update(&pad, 1);
+        pad = 0;
+        while (used_ != 56) Update(&pad, 1);
+        for (int i = 7; i >= 0; i--) block_[used_++] = static_cast<uint8_t>(bits >> (8 * i));
+        Compress();
+        Digest digest;
+        for (int i = 0; i < 8; i++) {
+            for (int j = 0; j < 4; j++) digest[4 * i + j] = static_cast<uint8_t>(state_[i] >> (24 - 8 * j));
+        }
+        return digest;
+    }
+
+    static std::string Hex(const Digest& digest) {
+        static const char kHex[] = "0123456789abcdef";
+        std::string s;
+        for (uint8_t b : digest) {
+            s += kHex[b >> 4];
+            s += kHex[b & 15];
+        }
+        return s;
+    }
+
+private:
+    static uint32_t Rotr(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+
+    void Compress() {
+        static const uint32_t kRound[64] = {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+        uint32_t w[64];
+        for (int i = 0; i < 16; i++) {
+            w[i] = static_cast<uint32_t>(block_[4 * i]) << 24 | static_cast<uint32_t>(block_[4 * i + 1]) << 16 |
+                   static_cast<uint32_t>(block_[4 * i + 2]) << 8 | block_[4 * i + 3];
+        }
+        for (int i = 16; i < 64; i++) {
+            uint32_t s0 = Rotr(w[i - 15], 7) ^ Rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            uint32_t s1 = Rotr(w[i - 2], 17) ^ Rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+        uint32_t a = state_[0], b = state_[1], c = state_[2], d = state_[3];
+        uint32_t e = state_[4], f = state_[5], g = state_[6], h = state_[7];
+        for (int i = 0; i < 64; i++) {
+            uint32_t t1 = h + (Rotr(e, 6) ^ Rotr(e, 11) ^ Rotr(e, 25)) + ((e & f) ^ (~e & g)) + kRound[i] + w[i];
+            uint32_t t2 = (Rotr(a, 2) ^ Rotr(a, 13) ^ Rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+        state_[0] += a;
+        state_[1] += b;
+        state_[2] += c;
+        state_[3] += d;
+        state_[4] += e;
+        state_[5] += f;
+        state_[6] += g;
+        state_[7] += h;
+    }
+
+    uint32_t state_[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                          0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+    uint8_t block_[64] = {};
+    size_t used_ = 0;
+    uint64_t length_ = 0;
+};
+
+// Builds a cache key from the things a result depends on. Every field is
+// length-prefixed, so ("ab", "c") and ("a", "bc") give different keys.
+class ResultKey {
+public:
+    ResultKey& Add(std::string_view field) {
+        uint64_t n = field.size();
+        sha_.Update(&n, sizeof(n));
+        sha_.Update(field.data(), field.size());
+        return *this;
+    }
+
+    ResultKey& Add(double value) { return Add(std::string_view(reinterpret_cast<const char*>(&value), sizeof(value))); }
+    ResultKey& Add(uint64_t value) { return Add(std::string_view(reinterpret_cast<const char*>(&value), sizeof(value))); }
+
+    // Contents of a file; an unreadable file adds a marker instead, so
+    // the key still differs from one where the file was read.
+    ResultKey& AddFile(const std::string& path) {
+        std::ifstream f(path, std::ios::binary);
+        if (!f.is_open()) return Add("<unreadable " + path + ">");
+        std::vector<char> buffer(1 << 16);
+        Sha256 file;
+        while (f.read(buffer.data(), static_cast<std::streamsize>(buffer.size())) || f.gcount() > 0) {
+            file.Update(buffer.data(), static_cast<size_t>(f.gcount()));
+        }
+        return Add(Sha256::Hex(file.Final()));
+    }
+
+    // The running executable: its code and the flags it was compiled with
+    ResultKey& AddExecutable() { return AddFile("/proc/self/exe"); }
+
+    // 64 hex digits
+    std::string Hex() { return Sha256::Hex(sha_.Final()); }
+
+private:
+    Sha256 sha_;
+};
+
+// $MATLAB_ALGORITHMS_RESULT_CACHE, else
+// $XDG_CACHE_HOME/matlab_algorithms/results, else the same under
+// $HOME/.cache; "" when none of them is set.
+inline std::string default_result_cache() {
+    if (const char* p = std::getenv("MATLAB_ALGORITHMS_RESULT_CACHE")) return p;
+    std::string dir;
+    if (const char* x = std::getenv("XDG_CACHE_HOME")) dir = x;
+    else if (const char* h = std::getenv("HOME")) dir = std::string(h) + "/.cache";
+    if (dir.empty()) return "";
+    return dir + "/matlab_algorithms/results";
+}
+
+// A stored result, mapped read-only for as long as this object lives
+class CachedResult {
+public:
+    CachedResult() = default;
+    ~CachedResult() { Release(); }
+    CachedResult(CachedResult&& other) noexcept { *this = std::move(other); }
+    CachedResult& operator=(CachedResult&& other) noexcept {
+        if (this != &other) {
+            Release();
+            mapped_ = std::exchange(other.mapped_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+            copy_ = std::move(other.copy_);
+        }
+        return *this;
+    }
+    CachedResult(const CachedResult&) = delete;
+    CachedResult& operator=(const CachedResult&) = delete;
+
+    // Maps the file at `path`; false if it cannot be read
+    bool Open(const std::string& path) {
+        Release();
+#if defined(__unix__)
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return false;
+        struct stat st;
+        bool ok = ::fstat(fd, &st) == 0;
+        if (ok && st.st_size > 0) {
+            void* p = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                ok = false;
+            } else {
+                mapped_ = p;
+                size_ = static_cast<size_t>(st.st_size);
+            }
+        }
+        ::close(fd);
+        return ok;
+#else
+        std::ifstream f(path, std::ios::binary);
+        if (!f.is_open()) return false;
+        copy_.assign(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+        size_ = copy_.size();
+        return true;
+#endif
+    }
+
+    const char* data() const { return mapped_ ? static_cast<const char*>(mapped_) : copy_.data(); }
+    size_t size() const { return size_; }
+    std::string_view view() const { return {data(), size_}; }
+
+private:
+    void Release() {
+#if defined(__unix__)
+        if (mapped_) ::munmap(mapped_, size_);
+#endif
+        mapped_ = nullptr;
+        size_ = 0;
+        copy_.clear();
+    }
+
+    void* mapped_ = nullptr;
+    size_t size_ = 0;
+    std::string copy_;  // platforms without mmap
+};
+
+class ResultCache {
+public:
+    // "" = default_result_cache(); "-" = disabled
+    explicit ResultCache(std::string dir = "")
+        : dir_(dir.empty() ? default_result_cache() : dir == "-" ? std::string() : std::move(dir)) {}
+
+    bool enabled() const { return !dir_.empty(); }
+    const std::string& dir() const { return dir_; }
+
+    std::string ObjectPath(const std::string& key) const {
+        return dir_ + "/" + key.substr(0, 2) + "/" + key.substr(2) + ".bin";
+    }
+
+    // The result stored under `key`, if there is one
+    bool Lookup(const std::string& key, CachedResult* out) const {
+        return enabled() && key.size() > 2 && out->Open(ObjectPath(key));
+    }
+
+    // Stores `size` bytes under `key`; false if it could not be written
+    bool Store(const std::string& key, const void* data, size_t size) const {
+        if (!enabled() || key.size() <= 2) return false;
+        std::filesystem::path target(ObjectPath(key));
+        std::error_code ec;
+        std::filesystem::create_directories(target.parent_path(), ec);
+        std::string tmp = target.string() + ".tmp" +
+                          std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+        {
+            std::ofstream f(tmp, std::ios::binary | std::ios::trunc);
+            if (!f.is_open()) return false;
+            f.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+            if (!f.good()) {
+                f.close();
+                std::filesystem::remove(tmp, ec);
+                return false;
+            }
+        }
+        std::filesystem::rename(tmp, target, ec);
+        if (!ec) return true;
+        std::filesystem::remove(tmp, ec);
+        return false;
+    }
+
+    bool Store(const std::string& key, std::string_view data) const { return Store(key, data.data(), data.size()); }
+
+private:
+    std::string dir_;
+};
+
+} // namespace runtime
+
+#endif // RUNTIME_RESULT_CACHE_H
@@ -0,0 +1,290 @@
+#ifndef RUNTIME_SHADOW_RUNNER_H
+#define RUNTIME_SHADOW_RUNNER_H
+
+// Shadow-mode execution of a candidate algorithm version (hand-written,
+// header-only, ships in the algorithm_runtime package).
+//
+// Before a new version of an algorithm replaces the live one, run it next
+// to the live one in production. The live path copies a sampled fraction
+// of its calls -- the inputs and the outputs the live version produced --
+// into a bounded queue. A low-priority worker thread, optionally pinned to
+// a spare core, runs the candidate on the same inputs and compares. An
+// output element agrees when
+//
+//   |candidate - live| <= absolute + relative * |live|
+//
+// the tolerance form of the test vectors. Divergent calls are counted and
+// the first few kept, inputs included, for triage. Every sampled call is
+// replayed from the live call's own inputs, so a divergence belongs to one
+// call rather than to state the two versions accumulated differently.
+//
+// The live path never waits for the candidate. An unsampled call costs a
+// decrement and a branch; a sampled one copies the call into a
+// preallocated ring slot, and a full ring drops the sample. Sampled offers
+// are timed: one that takes longer than ShadowOptions::budget_ns pauses
+// sampling for backoff_calls calls, so a disturbed machine sheds shadow
+// work before it costs the live path more.
+//
+// Calls are flattened to kInputs input and kOutputs output doubles; each
+// algorithm's <algo>_shadow.h defines the layout. A runner has a single
+// producer: give each live thread its own.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "load_generator.h"
+
+namespace runtime {
+
+struct ShadowTolerance {
+    double absolute = 1e-10;
+    double relative = 1e-8;
+};
+
+struct ShadowOptions {
+    double sample_fraction = 0.01;  // of live calls, drawn at random
+    size_t queue = 1024;            // sampled calls waiting for the candidate
+    int cpu = -1;                   // pin the worker to this CPU; -1 = any (Linux only)
+    bool low_priority = true;       // SCHED_IDLE worker (Linux only)
+    uint64_t budget_ns = 5000;      // live-path cost of one sampled offer; 0 = unbounded
+    uint64_t backoff_calls = 100000;  // calls not sampled after an offer over budget
+    size_t max_examples = 8;        // divergent calls kept in the report
+    uint64_t seed = 1;
+    ShadowTolerance tolerance;
+};
+
+// One divergent call
+template <size_t kInputs, size_t kOutputs>
+struct ShadowExample {
+    uint64_t call = 0;  // 1-based index among the live calls
+    std::array<double, kInputs> inputs{};
+    std::array<double, kOutputs> live{};
+    std::array<double, kOutputs> candidate{};
+};
+
+template <size_t kInputs, size_t kOutputs>
+struct ShadowReport {
+    uint64_t calls = 0;        // live calls seen
+    uint64_t sampled = 0;      // queued for the candidate
+    uint64_t dropped = 0;      // sampled with the queue full
+    uint64_t over_budget = 0;  // offers slower than budget_ns
+    uint64_t compared = 0;     // run through the candidate
+    uint64_t diverged = 0;     // with an output outside the tolerance
+    double max_abs_error = 0.0;
+    double max_excess = 0.0;   // |error| / (absolute + relative |live|); > 1 diverges
+    int worst_output = -1;     // output index of max_excess
+    LatencyHistogram::Snapshot offer_ns;  // live-path cost of the sampled calls
+    std::vector<ShadowExample<kInputs, kOutputs>> examples;
+
+    bool agrees() const { return diverged == 0; }
+};
+
+template <size_t kInputs, size_t kOutputs>
+class ShadowRunner {
+public:
+    // Computes the candidate's outputs for one flattened call
+    using Candidate = std::function<void(const double* inputs, double* outputs)>;
+    using Report = ShadowReport<kInputs, kOutputs>;
+
+    ShadowRunner(Candidate candidate, const ShadowOptions& opts)
+        : candidate_(std::move(candidate)), opts_(opts), ring_(std::max<size_t>(opts.queue, 1)),
+          rng_(opts.seed) {
+        countdown_ = NextGap();
+        worker_ = std::thread([this] { Work(); });
+    }
+    ~ShadowRunner() { Stop(); }
+    ShadowRunner(const ShadowRunner&) = delete;
+    ShadowRunner& operator=(const ShadowRunner&) = delete;
+
+    // Live path, after the live call. When this call is sampled,
+    // fill(double* inputs, double* live_outputs) writes it straight into
+    // the queue; otherwise fill is not called.
+    template <class Fill>
+    void Offer(Fill&& fill) {
+        calls_.store(calls_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        if (--countdown_ != 0) return;
+        OfferSampled(fill);
+    }
+
+    void Offer(const double* inputs, const double* live_outputs) {
+        Offer([&](double* in, double* live) {
+            std::memcpy(in, inputs, kInputs * sizeof(double));
+            std::memcpy(live, live_outputs, kOutputs * sizeof(double));
+        });
+    }
+
+    // Runs the candidate on what is still queued, then stops the worker.
+    // Call from the producer once it has stopped offering.
+    void Stop() {
+        stop_.store(true, std::memory_order_release);
+        if (worker_.joinable()) worker_.join();
+    }
+
+    // Counts so far; safe to call while the runner is working
+    Report report() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        offer_total_.merge(offer_ns_.drain());
+        Report r = results_;
+        r.calls = calls_.load(std::memory_order_relaxed);
+        r.sampled = sampled_.load(std::memory_order_relaxed);
+        r.dropped = dropped_.load(std::memory_order_relaxed);
+        r.over_budget = over_budget_.load(std::memory_order_relaxed);
+        r.offer_ns = offer_total_;
+        return r;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Call {
+        uint64_t call;
+        std::array<double, kInputs> inputs;
+        std::array<double, kOutputs> live;
+    };
+
+    template <class Fill>
+    void OfferSampled(Fill& fill) {
+        auto start = Clock::now();
+        countdown_ = NextGap();
+        if (Call* slot = ring_.begin_push()) {
+            slot->call = calls_.load(std::memory_order_relaxed);
+            fill(slot->inputs.data(), slot->live.data());
+            ring_.commit_push();
+            Bump(sampled_);
+        } else {
+            Bump(dropped_);
+        }
+        uint64_t ns = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+        offer_ns_.record(ns);
+        if (opts_.budget_ns > 0 && ns > opts_.budget_ns) {
+            Bump(over_budget_);
+            countdown_ = countdown_ > std::numeric_limits<uint64_t>::max() - opts_.backoff_calls
+                ? std::numeric_limits<uint64_t>::max()
+                : countdown_ + opts_.backoff_calls;
+        }
+    }
+
+    // Single writer: no read-modify-write needed
+    static void Bump(std::atomic<uint64_t>& counter) {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    // Calls until the next sample: geometric, so every call is sampled
+    // with probability sample_fraction independently of the others
+    uint64_t NextGap() {
+        double f = opts_.sample_fraction;
+        if (f >= 1.0) return 1;
+        if (!(f > 0.0)) return std::numeric_limits<uint64_t>::max();
+        // splitmix64
+        uint64_t z = (rng_ += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        z ^= z >> 31;
+        double u = (static_cast<double>(z >> 11) + 1.0) * 0x1.0p-53;  // (0, 1]
+        double gap = std::floor(std::log(u) / std::log1p(-f));
+        return gap >= 1e18 ? std::numeric_limits<uint64_t>::max() : 1 + static_cast<uint64_t>(gap);
+    }
+
+    void ConfigureThread() {
+#if defined(__linux__)
+        if (opts_.cpu >= 0 && opts_.cpu < CPU_SETSIZE) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(opts_.cpu, &set);
+            pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        }
+#if defined(SCHED_IDLE)
+        if (opts_.low_priority) {
+            sched_param param{};
+            pthread_setschedparam(pthread_self(), SCHED_IDLE, &param);
+        }
+#endif
+#endif
+    }
+
+    void Work() {
+        ConfigureThread();
+        std::array<double, kOutputs> candidate{};
+        for (;;) {
+            Call* call = ring_.front();
+            if (!call) {
+                if (stop_.load(std::memory_order_acquire)) {
+                    if (!ring_.front()) return;
+                    continue;
+                }
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+                continue;
+            }
+            candidate_(call->inputs.data(), candidate.data());
+            Compare(*call, candidate);
+            ring_.pop();
+        }
+    }
+
+    void Compare(const Call& call, const std::array<double, kOutputs>& candidate) {
+        bool diverged = false;
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t o = 0; o < kOutputs; o++) {
+            double live = call.live[o], cand = candidate[o];
+            if (cand == live || (std::isnan(cand) && std::isnan(live))) continue;
+            double err = std::fabs(cand - live);
+            double tol = opts_.tolerance.absolute + opts_.tolerance.relative * std::fabs(live);
+            // Past the equality test above, an infinity or NaN on either
+            // side is a divergence; err / tol would be inf / inf = NaN,
+            // which compares as agreement
+            bool finite = std::isfinite(cand) && std::isfinite(live);
+            double excess = finite && tol > 0.0 ? err / tol : std::numeric_limits<double>::infinity();
+            if (!std::isnan(err)) results_.max_abs_error = std::max(results_.max_abs_error, err);
+            if (excess > results_.max_excess) {
+                results_.max_excess = excess;
+                results_.worst_output = static_cast<int>(o);
+            }
+            diverged |= excess > 1.0;
+        }
+        results_.compared++;
+        if (!diverged) return;
+        results_.diverged++;
+        if (results_.examples.size() < opts_.max_examples) {
+            results_.examples.push_back({call.call, call.inputs, call.live, candidate});
+        }
+    }
+
+    Candidate candidate_;
+    ShadowOptions opts_;
+    SpscRing<Call> ring_;
+
+    // Producer side
+    uint64_t countdown_ = 1;
+    uint64_t rng_;
+    std::atomic<uint64_t> calls_{0}, sampled_{0}, dropped_{0}, over_budget_{0};
+    mutable LatencyHistogram offer_ns_;  // drained into offer_total_ by report()
+
+    // Worker side, read by report()
+    mutable std::mutex mutex_;
+    Report results_;
+    mutable LatencyHistogram::Snapshot offer_total_;
+
+    std::atomic<bool> stop_{false};
+    std::thread worker_;
+};
+
+} // namespace runtime
+
+#endif // RUNTIME_SHADOW_RUNNER_H
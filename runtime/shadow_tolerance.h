@@ -0,0 +1,40 @@
+#ifndef RUNTIME_SHADOW_TOLERANCE_H
+#define RUNTIME_SHADOW_TOLERANCE_H
+
+// The test vectors' tolerance for ShadowRunner comparisons (hand-written,
+// header-only, ships in the algorithm_runtime package).
+//
+// Reads JSON, so it needs nlohmann_json, which algorithm_runtime itself
+// does not require; include it where the vector file is read -- at
+// start-up, in tools and tests -- not next to the live path, which only
+// needs shadow_runner.h. Each algorithm's <algo>_shadow_tolerance.h
+// forwards to it.
+
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include <nlohmann/json.hpp>
+
+#include "shadow_runner.h"
+
+namespace runtime {
+
+// The global_tolerance of a test-vector file (test_vectors/nominal.json),
+// the tolerance MATLAB and C++ are held to; fields it omits keep their
+// defaults. Throws std::runtime_error if the file cannot be read.
+inline ShadowTolerance read_shadow_tolerance(const std::string& vector_file) {
+    std::ifstream f(vector_file);
+    if (!f.is_open()) throw std::runtime_error("Cannot open " + vector_file);
+    nlohmann::json data = nlohmann::json::parse(f);
+    ShadowTolerance tol;
+    if (data.contains("global_tolerance")) {
+        tol.absolute = data["global_tolerance"].value("absolute", tol.absolute);
+        tol.relative = data["global_tolerance"].value("relative", tol.relative);
+    }
+    return tol;
+}
+
+} // namespace runtime
+
+#endif // RUNTIME_SHADOW_TOLERANCE_H
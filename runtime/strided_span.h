@@ -0,0 +1,99 @@
+#ifndef RUNTIME_STRIDED_SPAN_H
+#define RUNTIME_STRIDED_SPAN_H
+
+// Strided views of one field of interleaved records (hand-written,
+// header-only, ships in the algorithm_runtime package).
+//
+// Sensor records usually arrive as arrays of structs, while the generated
+// entry points take contiguous arrays. Filtering one field that way means
+// gathering it into a temporary, calling, and scattering the result back.
+// The <algo>_strided.h overloads take StridedSpans instead and read and
+// write the records in place:
+//
+//   struct Sample { double t, raw, filtered; };
+//   std::vector<Sample> frame = ...;
+//   low_pass_filter::low_pass_filter(runtime::field(frame, &Sample::raw), alpha,
+//                                    runtime::field(frame, &Sample::filtered));
+//
+// This is std::span plus a stride, or a rank-1 std::mdspan with
+// layout_stride, neither of which C++17 has. The stride is in bytes rather
+// than elements: for a field of a record array it is sizeof(Record),
+// whatever the field's type. Each element must be aligned for T. A
+// contiguous array is the case stride == sizeof(T), and a std::vector
+// converts to one implicitly.
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace runtime {
+
+template <typename T>
+class StridedSpan {
+public:
+    using Byte =
+        typename std::conditional<std::is_const<T>::value, const unsigned char, unsigned char>::type;
+
+    StridedSpan() = default;
+    StridedSpan(T* data, size_t size, std::ptrdiff_t stride_bytes = sizeof(T))
+        : data_(reinterpret_cast<Byte*>(data)), size_(size), stride_(stride_bytes) {}
+    // Contiguous vector
+    template <typename U, typename A,
+              typename = typename std::enable_if<std::is_same<const U, const T>::value>::type>
+    StridedSpan(std::vector<U, A>& v) : StridedSpan(v.data(), v.size()) {}
+    template <typename U, typename A,
+              typename = typename std::enable_if<std::is_same<const U, T>::value>::type>
+    StridedSpan(const std::vector<U, A>& v) : StridedSpan(v.data(), v.size()) {}
+    // Read-only view of a writable one
+    template <typename U, typename = typename std::enable_if<std::is_same<const U, T>::value &&
+                                                             !std::is_same<U, T>::value>::type>
+    StridedSpan(const StridedSpan<U>& other)
+        : StridedSpan(other.data(), other.size(), other.stride()) {}
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    std::ptrdiff_t stride() const { return stride_; }
+    T* data() const { return reinterpret_cast<T*>(data_); }
+    // Whether element i + 1 directly follows element i
+    bool contiguous() const { return stride_ == static_cast<std::ptrdiff_t>(sizeof(T)); }
+
+    // Element i; a reference into the record, so it reads and writes in place
+    T& operator[](size_t i) const {
+        return *reinterpret_cast<T*>(data_ + static_cast<std::ptrdiff_t>(i) * stride_);
+    }
+
+    // Elements [offset, offset + count)
+    StridedSpan subspan(size_t offset, size_t count) const {
+        return StridedSpan(&(*this)[offset], count, stride_);
+    }
+
+private:
+    Byte* data_ = nullptr;
+    size_t size_ = 0;
+    std::ptrdiff_t stride_ = sizeof(T);
+};
+
+// Field `member` of `count` records starting at `records`
+template <typename Record, typename T>
+StridedSpan<T> field(Record* records, size_t count, T Record::*member) {
+    return StridedSpan<T>(count ? &(records->*member) : nullptr, count, sizeof(Record));
+}
+
+template <typename Record, typename T>
+StridedSpan<const T> field(const Record* records, size_t count, T Record::*member) {
+    return StridedSpan<const T>(count ? &(records->*member) : nullptr, count, sizeof(Record));
+}
+
+template <typename Record, typename A, typename T>
+StridedSpan<T> field(std::vector<Record, A>& records, T Record::*member) {
+    return field(records.data(), records.size(), member);
+}
+
+template <typename Record, typename A, typename T>
+StridedSpan<const T> field(const std::vector<Record, A>& records, T Record::*member) {
+    return field(records.data(), records.size(), member);
+}
+
+} // namespace runtime
+
+#endif // RUNTIME_STRIDED_SPAN_H
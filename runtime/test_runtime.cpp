@@ -0,0 +1,879 @@
+/**
+ * test_runtime.cpp
+ *
+ * Tests for the header-only runtime helpers (runtime/). Huge pages and NUMA
+ * placement are best effort, so the tests check the contract that holds
+ * everywhere -- zeroed, aligned, writable storage and a truthful report of
+ * what the kernel granted -- not that a particular machine grants them.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "frame_arena.h"
+#include "large_buffer.h"
+#include "load_generator.h"
+#include "object_pool.h"
+#include "plugin_host.h"
+#include "result_cache.h"
+#include "shadow_runner.h"
+#include "shadow_tolerance.h"
+#include "strided_span.h"
+#include "worker_pool.h"
+#include "workload.h"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+bool IsAligned(const void* p, size_t alignment) {
+    return reinterpret_cast<uintptr_t>(p) % alignment == 0;
+}
+
+} // namespace
+
+// ---- Large buffers (large_buffer.h) ----
+
+TEST(RuntimeLargeBuffer, SmallBufferIsAlignedAndZeroed) {
+    runtime::LargeBuffer<double> b(1000);
+    ASSERT_EQ(b.size(), 1000u);
+    EXPECT_TRUE(IsAligned(b.data(), runtime::kBufferAlignment));
+    EXPECT_EQ(b.huge_pages(), runtime::HugePages::None);
+    for (double x : b) EXPECT_EQ(x, 0.0);
+}
+
+TEST(RuntimeLargeBuffer, LargeBufferFallsBackAndStaysUsable) {
+    const size_t n = 3 * runtime::kHugePageSize / sizeof(double) + 17;
+    for (auto mode : {runtime::HugePages::None, runtime::HugePages::Transparent,
+                      runtime::HugePages::Explicit}) {
+        runtime::LargeBufferOptions opts;
+        opts.huge_pages = mode;
+        runtime::LargeBuffer<double> b(n, opts);
+        ASSERT_NE(b.data(), nullptr);
+        EXPECT_TRUE(IsAligned(b.data(), runtime::kBufferAlignment));
+        // Never more than was asked for: Explicit may degrade, None never upgrades
+        if (mode == runtime::HugePages::None) {
+            EXPECT_EQ(b.huge_pages(), runtime::HugePages::None);
+        }
+        if (mode == runtime::HugePages::Transparent) {
+            EXPECT_NE(b.huge_pages(), runtime::HugePages::Explicit);
+        }
+        EXPECT_EQ(b[0], 0.0);
+        EXPECT_EQ(b[n - 1], 0.0);
+        std::iota(b.begin(), b.end(), 0.0);
+        EXPECT_EQ(b[n - 1], static_cast<double>(n - 1));
+    }
+}
+
+TEST(RuntimeLargeBuffer, MoveTransfersOwnership) {
+    runtime::LargeBuffer<double> a(runtime::kHugePageSize / sizeof(double));
+    double* p = a.data();
+    runtime::LargeBuffer<double> b(std::move(a));
+    EXPECT_EQ(b.data(), p);
+    EXPECT_EQ(a.data(), nullptr);
+    a = std::move(b);
+    EXPECT_EQ(a.data(), p);
+}
+
+TEST(RuntimeLargeBuffer, AllocatorBacksVectorsOfAnySize) {
+    using Vec = std::vector<double, runtime::LargeBufferAllocator<double>>;
+    Vec v;
+    // Crosses the mapping threshold while growing: every reallocation must
+    // release the previous block with the size it was allocated with
+    for (size_t i = 0; i < runtime::kHugePageSize / sizeof(double) + 1000; i++) {
+        v.push_back(static_cast<double>(i));
+    }
+    EXPECT_TRUE(IsAligned(v.data(), runtime::kBufferAlignment));
+    EXPECT_EQ(v.back(), static_cast<double>(v.size() - 1));
+    Vec w(v);
+    EXPECT_EQ(w, v);
+}
+
+#if defined(__linux__)
+// Pages of [p, p + bytes) resident in memory, by mincore()
+size_t ResidentPages(const void* p, size_t bytes) {
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    std::vector<unsigned char> resident((bytes + page - 1) / page);
+    if (mincore(const_cast<void*>(p), bytes, resident.data()) != 0) return 0;
+    return static_cast<size_t>(std::count_if(resident.begin(), resident.end(),
+                                             [](unsigned char r) { return r & 1; }));
+}
+
+TEST(RuntimeLargeBuffer, FirstTouchBufferIsNotFaultedOnAllocation) {
+    const size_t n = 2 * runtime::kHugePageSize / sizeof(double);
+    runtime::LargeBufferOptions opts;
+    opts.numa_node = runtime::kNumaFirstTouch;  // prefault stays at its default, true
+    runtime::LargeBuffer<double> b(n, opts);
+    EXPECT_EQ(ResidentPages(b.data(), n * sizeof(double)), 0u);
+
+    // The workers' first writes place the pages
+    runtime::FirstTouchPartitioned(b.data(), n, 2);
+    EXPECT_GT(ResidentPages(b.data(), n * sizeof(double)), 0u);
+
+    // Other policies still prefault
+    runtime::LargeBuffer<double> local(n);
+    EXPECT_GT(ResidentPages(local.data(), n * sizeof(double)), 0u);
+}
+#endif
+
+TEST(RuntimeLargeBuffer, FirstTouchPartitionedWritesEverySlice) {
+    const size_t n = 1001;
+    std::vector<double> a(3 * n, 1.0);
+    runtime::FirstTouchPartitioned(a.data(), n, 4, 3);
+    for (double x : a) EXPECT_EQ(x, 0.0);
+    // More threads than elements
+    std::vector<double> tiny(2, 1.0);
+    runtime::FirstTouchPartitioned(tiny.data(), tiny.size(), 8);
+    EXPECT_EQ(tiny[0], 0.0);
+    EXPECT_EQ(tiny[1], 0.0);
+}
+
+// ---- Frame arena (frame_arena.h) ----
+
+TEST(RuntimeFrameArena, AllocationsAreAlignedAndDisjoint) {
+    runtime::FrameArena arena(4096);
+    char* a = static_cast<char*>(arena.allocate(3));
+    char* b = static_cast<char*>(arena.allocate(100));
+    double* c = arena.allocate_array<double>(5, 256);
+    EXPECT_TRUE(IsAligned(a, runtime::kBufferAlignment));
+    EXPECT_TRUE(IsAligned(b, runtime::kBufferAlignment));
+    EXPECT_TRUE(IsAligned(c, 256));
+    EXPECT_GE(b, a + 3);
+    EXPECT_GE(reinterpret_cast<char*>(c), b + 100);
+    EXPECT_EQ(arena.used(), 3u + 100u + 5 * sizeof(double));
+}
+
+TEST(RuntimeFrameArena, ResetReusesTheSameMemory) {
+    runtime::FrameArena arena(4096);
+    void* first = arena.allocate(512);
+    arena.allocate(512);
+    arena.reset();
+    EXPECT_EQ(arena.used(), 0u);
+    EXPECT_EQ(arena.allocate(512), first);
+}
+
+TEST(RuntimeFrameArena, OverflowIsMergedAtReset) {
+    runtime::FrameArena arena(1024);
+    for (int i = 0; i < 10; i++) {
+        double* p = arena.allocate_array<double>(100);
+        p[99] = i;  // every block is writable
+    }
+    EXPECT_GE(arena.high_water(), 10 * 100 * sizeof(double));
+    arena.reset();
+    size_t capacity = arena.capacity();
+    EXPECT_GE(capacity, 10 * 100 * sizeof(double));
+    // The same frame now fits without growing
+    for (int i = 0; i < 10; i++) arena.allocate_array<double>(100);
+    EXPECT_EQ(arena.capacity(), capacity);
+}
+
+TEST(RuntimeFrameArena, FrameVectorUsesTheArena) {
+    runtime::FrameArena arena(1 << 16);
+    runtime::FrameVector<double> v(1000, arena);
+    EXPECT_EQ(arena.used(), 1000 * sizeof(double));
+    EXPECT_TRUE(IsAligned(v.data(), runtime::kBufferAlignment));
+    for (double x : v) EXPECT_EQ(x, 0.0);
+    runtime::FrameVector<int> w(v.get_allocator());
+    w.reserve(10);
+    EXPECT_EQ(w.get_allocator(), runtime::ArenaAllocator<int>(arena));
+}
+
+// ---- Synthetic workloads (philox.h, workload.h) ----
+
+TEST(RuntimeWorkload, LanesMatchScalarPhilox) {
+    uint32_t w0[runtime::kPhiloxLanes], w1[runtime::kPhiloxLanes];
+    uint32_t w2[runtime::kPhiloxLanes], w3[runtime::kPhiloxLanes];
+    const runtime::PhiloxKey key = {0x12345678u, 0x9abcdef0u};
+    for (int l = 0; l < runtime::kPhiloxLanes; l++) {
+        w0[l] = 1000u + l, w1[l] = 7u, w2[l] = 0xffffffffu - l, w3[l] = 3u * l;
+    }
+    runtime::Philox4x32Lanes(w0, w1, w2, w3, key);
+    for (int l = 0; l < runtime::kPhiloxLanes; l++) {
+        auto expect = runtime::Philox4x32({1000u + l, 7u, 0xffffffffu - l, 3u * l}, key);
+        EXPECT_TRUE(runtime::SameBlock({w0[l], w1[l], w2[l], w3[l]}, expect)) << "lane " << l;
+    }
+}
+
+TEST(RuntimeWorkload, FillUniformFollowsTheCounterSequence) {
+    const uint64_t seed = 0x0123456789abcdefull, stream = 5;
+    const runtime::PhiloxKey key = {static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)};
+    std::vector<double> u(37);
+    runtime::FillUniform(u.data(), u.size(), seed, stream);
+    for (size_t i = 0; i < u.size(); i++) {
+        auto b = runtime::Philox4x32({static_cast<uint32_t>(i / 2), 0, static_cast<uint32_t>(stream), 0}, key);
+        double expect = i % 2 ? runtime::ToUnitDouble(b[2], b[3]) : runtime::ToUnitDouble(b[0], b[1]);
+        ASSERT_EQ(u[i], expect) << "sample " << i;
+    }
+    // An odd starting index continues the same sequence
+    std::vector<double> tail(20);
+    runtime::FillUniform(tail.data(), tail.size(), seed, stream, 17);
+    for (size_t i = 0; i < tail.size(); i++) EXPECT_EQ(tail[i], u[17 + i]);
+}
+
+TEST(RuntimeWorkload, FillNormalHasTheRequestedMoments) {
+    const size_t n = 200000;
+    std::vector<double> z(n);
+    runtime::FillNormal(z.data(), n, 3.0, 2.0, 42, 0);
+    double sum = 0.0, sq = 0.0;
+    for (double x : z) sum += x, sq += x * x;
+    double mean = sum / n, var = sq / n - mean * mean;
+    EXPECT_NEAR(mean, 3.0, 0.02);
+    EXPECT_NEAR(var, 4.0, 0.05);
+}
+
+TEST(RuntimeWorkload, PolynomialMathMatchesLibm) {
+    for (double u = 0.0; u < 1.0; u += 1.0 / 997) {
+        double s, c;
+        runtime::detail::WorkloadSinCos2Pi(u, &s, &c);
+        EXPECT_NEAR(s, std::sin(6.283185307179586 * u), 1e-15);
+        EXPECT_NEAR(c, std::cos(6.283185307179586 * u), 1e-15);
+    }
+    for (double x : {1e-300, 1e-12, 0.25, 0.7071, 1.0, 1.4143, 3.0, 1e10}) {
+        EXPECT_NEAR(runtime::detail::WorkloadLog(x), std::log(x), 4e-16 * std::fabs(std::log(x)) + 1e-16);
+    }
+}
+
+TEST(RuntimeWorkload, SignalsFollowTheirSpecs) {
+    const int n = 1000, channels = 3;
+    const double dt = 0.001;
+    runtime::ChannelSpec spec[channels];
+    spec[0].amplitude = 2.0, spec[0].frequency = 5.0, spec[0].phase = 0.3;
+    spec[1].frequency = 10.0, spec[1].chirp_rate = 40.0, spec[1].offset = -1.0;
+    spec[2].amplitude = 0.0, spec[2].step_time = 0.5, spec[2].step_height = 4.0, spec[2].noise_stddev = 1.0;
+    std::vector<double> noisy(n * channels), clean(n * channels);
+    runtime::GenerateSignals(noisy.data(), clean.data(), n, channels, dt, spec, 7);
+
+    std::vector<double> noise(n);
+    runtime::FillNormal(noise.data(), n, 0.0, 1.0, 7, 2);
+    for (int k = 0; k < n; k++) {
+        double t = k * dt;
+        EXPECT_NEAR(clean[k * channels + 0], 2.0 * std::sin(0.3 + 2 * M_PI * 5.0 * t), 1e-12);
+        EXPECT_NEAR(clean[k * channels + 1], std::sin(2 * M_PI * (10.0 * t + 20.0 * t * t)) - 1.0, 1e-12);
+        EXPECT_EQ(clean[k * channels + 2], t >= 0.5 ? 4.0 : 0.0);
+        EXPECT_EQ(noisy[k * channels + 0], clean[k * channels + 0]);  // no noise asked for
+        // Channel c's noise is stream c of the seed
+        EXPECT_EQ(noisy[k * channels + 2], clean[k * channels + 2] + noise[k]);
+    }
+}
+
+TEST(RuntimeWorkload, ChunkingDoesNotChangeTheData) {
+    const int n = 500, channels = 11;
+    std::vector<runtime::ChannelSpec> spec(channels);
+    for (int c = 0; c < channels; c++) {
+        spec[c].frequency = 1.0 + c, spec[c].chirp_rate = 0.5 * c, spec[c].noise_stddev = 0.1 * c;
+    }
+    std::vector<double> whole(n * channels), parts(n * channels);
+    runtime::GenerateSignals(whole.data(), nullptr, n, channels, 0.01, spec.data(), 99);
+    // Chunks starting on and between anchors, on odd and even samples
+    const int bounds[] = {0, 1, 64, 200, 333, n};
+    for (int i = 0; i + 1 < 6; i++) {
+        runtime::GenerateSignals(parts.data() + bounds[i] * channels, nullptr, bounds[i + 1] - bounds[i],
+                                 channels, 0.01, spec.data(), 99, bounds[i]);
+    }
+    EXPECT_EQ(parts, whole);
+}
+
+// ---- Load generation (load_generator.h) ----
+
+TEST(RuntimeLoadGenerator, ScheduleIsReproducibleAndMonotone) {
+    runtime::LoadProfile profile;
+    profile.rate_hz = 50.0;
+    profile.jitter = 0.8;
+    profile.burst_probability = 0.05;
+    profile.burst_length = 4;
+    runtime::ArrivalSchedule a(profile, 3, 7), b(profile, 3, 7), other(profile, 3, 8);
+    double prev = 0.0;
+    bool differs = false;
+    for (int j = 0; j < 5000; j++) {
+        double t = a.Next();
+        EXPECT_EQ(t, b.Next());
+        EXPECT_GE(t, prev);
+        differs |= other.Next() != t;
+        prev = t;
+    }
+    EXPECT_TRUE(differs);  // sensors get their own streams
+    EXPECT_EQ(a.frames(), 5000u);
+    // Jitter and bursts move frames around but keep the mean rate
+    EXPECT_NEAR(prev, 5000 / profile.rate_hz, 2.0 / profile.rate_hz * profile.burst_length);
+}
+
+TEST(RuntimeLoadGenerator, BurstsDeliverFramesTogether) {
+    runtime::LoadProfile profile;
+    profile.rate_hz = 10.0;
+    profile.burst_probability = 0.2;
+    profile.burst_length = 5;
+    runtime::ArrivalSchedule schedule(profile, 11, 0);
+    const int n = 20000;
+    int together = 0;
+    double prev = schedule.Next();
+    for (int j = 1; j < n; j++) {
+        double t = schedule.Next();
+        together += t == prev;
+        prev = t;
+    }
+    // A burst starts at ~p of the arrivals that are not already in one and
+    // adds burst_length - 1 same-time frames: p(L-1) / (1 + p(L-1)) of all
+    double expected = 0.2 * 4 / (1 + 0.2 * 4);
+    EXPECT_NEAR(static_cast<double>(together) / n, expected, 0.02);
+}
+
+TEST(RuntimeLoadGenerator, HistogramPercentiles) {
+    for (uint64_t ns : {0ull, 1ull, 15ull, 16ull, 17ull, 1000ull, 123456789ull, 1ull << 40}) {
+        int b = runtime::LatencyHistogram::Bucket(ns);
+        EXPECT_GE(runtime::LatencyHistogram::UpperEdge(b), ns);
+        if (b > 0) {
+            EXPECT_LT(runtime::LatencyHistogram::UpperEdge(b - 1), ns);
+        }
+    }
+
+    runtime::LatencyHistogram h;
+    for (uint64_t ns = 1; ns <= 100000; ns++) h.record(ns * 10);  // 10 ns .. 1 ms, uniform
+    auto s = h.drain();
+    EXPECT_EQ(s.total, 100000u);
+    for (double p : {0.5, 0.9, 0.99, 0.999}) {
+        double exact = p * 1e6;
+        EXPECT_GE(static_cast<double>(s.percentile(p)), exact * 0.999);
+        EXPECT_LE(static_cast<double>(s.percentile(p)), exact * 1.07);
+    }
+    EXPECT_GE(s.max(), 1000000u);
+    EXPECT_EQ(h.drain().total, 0u);  // drained
+
+    runtime::LatencyHistogram::Snapshot merged;
+    merged.merge(s);
+    merged.merge(s);
+    EXPECT_EQ(merged.total, 200000u);
+    EXPECT_EQ(merged.percentile(0.5), s.percentile(0.5));
+}
+
+TEST(RuntimeLoadGenerator, RingIsFifoAndBounded) {
+    runtime::SpscRing<int> ring(3);
+    EXPECT_EQ(ring.capacity(), 3u);
+    EXPECT_EQ(ring.front(), nullptr);
+    for (int round = 0; round < 4; round++) {  // wraps around
+        for (int i = 0; i < 3; i++) {
+            int* slot = ring.begin_push();
+            ASSERT_NE(slot, nullptr);
+            *slot = round * 10 + i;
+            ring.commit_push();
+        }
+        EXPECT_EQ(ring.begin_push(), nullptr);  // full: the caller drops
+        EXPECT_EQ(ring.size(), 3u);
+        for (int i = 0; i < 3; i++) {
+            ASSERT_NE(ring.front(), nullptr);
+            EXPECT_EQ(*ring.front(), round * 10 + i);
+            ring.pop();
+        }
+        EXPECT_EQ(ring.size(), 0u);
+    }
+}
+
+TEST(RuntimeLoadGenerator, RingHandsOffBetweenThreads) {
+    runtime::SpscRing<uint64_t> ring(64);
+    const uint64_t n = 200000;
+    uint64_t sum = 0, expected_next = 0;
+    bool ordered = true;
+    std::thread consumer([&] {
+        while (expected_next < n) {
+            if (uint64_t* v = ring.front()) {
+                ordered &= *v == expected_next++;
+                sum += *v;
+                ring.pop();
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    for (uint64_t i = 0; i < n;) {
+        if (uint64_t* slot = ring.begin_push()) {
+            *slot = i++;
+            ring.commit_push();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    consumer.join();
+    EXPECT_TRUE(ordered);
+    EXPECT_EQ(sum, n * (n - 1) / 2);
+}
+
+#if defined(__linux__)
+TEST(RuntimeLoadGenerator, ReportsResidentSetSize) {
+    size_t before = runtime::resident_set_bytes();
+    EXPECT_GT(before, 0u);
+    std::vector<char> touched(64 << 20, 1);  // 64 MiB, written
+    EXPECT_GE(runtime::resident_set_bytes(), before + (32u << 20));
+    EXPECT_EQ(touched[12345], 1);
+}
+#endif
+
+// ---- Object pools (object_pool.h) ----
+
+TEST(RuntimeObjectPool, ReusesFreedNodesBeforeGrowing) {
+    struct Node {
+        Node* parent;
+        double value;
+    };
+    runtime::ObjectPool<Node> pool(4);
+    Node* a = pool.create(Node{nullptr, 1.0});
+    Node* b = pool.create(Node{a, 2.0});
+    EXPECT_EQ(b->parent, a);
+    EXPECT_EQ(b->value, 2.0);
+    EXPECT_EQ(b, a + 1);  // a fresh slab hands out nodes in address order
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(a) % alignof(Node), 0u);
+    EXPECT_EQ(pool.live(), 2u);
+
+    pool.destroy(a);
+    EXPECT_EQ(pool.create(), a);  // the last node freed is the next one out
+    Node* zeroed = pool.create();
+    EXPECT_EQ(zeroed->parent, nullptr);
+    EXPECT_EQ(zeroed->value, 0.0);
+    EXPECT_EQ(pool.slabs(), 1u);
+
+    // Churn within the peak takes no new slab
+    std::vector<Node*> nodes;
+    for (int round = 0; round < 100; round++) {
+        for (int i = 0; i < 3; i++) nodes.push_back(pool.create());
+        for (Node* n : nodes) pool.destroy(n);
+        nodes.clear();
+    }
+    EXPECT_EQ(pool.slabs(), 2u);
+    EXPECT_EQ(pool.capacity(), 4u + 8u);
+    EXPECT_EQ(pool.live(), 3u);
+    EXPECT_EQ(pool.peak(), 6u);
+}
+
+// ---- Worker pools (worker_pool.h) ----
+
+TEST(RuntimeWorkerPool, RunsEveryTaskOncePerCall) {
+    runtime::WorkerPool pool(4);
+    EXPECT_EQ(pool.size(), 4);
+    // Many short runs back to back: workers that wake late for one run must
+    // not take tasks of the next
+    for (int round = 0; round < 2000; round++) {
+        const int tasks = 1 + round % 9;
+        std::vector<std::atomic<int>> calls(tasks);
+        pool.run(tasks, [&](int t) { calls[t]++; });
+        for (int t = 0; t < tasks; t++) ASSERT_EQ(calls[t].load(), 1) << "round " << round << " task " << t;
+    }
+    runtime::WorkerPool single(1);
+    EXPECT_EQ(single.size(), 1);
+    int sum = 0;
+    single.run(5, [&](int t) { sum += t; });  // all on the calling thread
+    EXPECT_EQ(sum, 10);
+    EXPECT_GE(runtime::WorkerPool().size(), 1);
+}
+
+// ---- Result cache (result_cache.h) ----
+
+namespace {
+
+std::string Sha256Hex(const std::string& message) {
+    runtime::Sha256 sha;
+    sha.Update(message.data(), message.size());
+    return runtime::Sha256::Hex(sha.Final());
+}
+
+} // namespace
+
+TEST(RuntimeResultCache, Sha256KnownAnswers) {
+    // FIPS 180-4 examples, including the two-block padding case
+    EXPECT_EQ(Sha256Hex(""), "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    EXPECT_EQ(Sha256Hex("abc"), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    EXPECT_EQ(Sha256Hex("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"),
+              "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+    // A million 'a's, fed in uneven pieces across block boundaries
+    std::string million(1000000, 'a');
+    runtime::Sha256 sha;
+    for (size_t at = 0, piece = 1; at < million.size(); at += piece, piece = piece * 7 % 997 + 1) {
+        sha.Update(million.data() + at, std::min(piece, million.size() - at));
+    }
+    EXPECT_EQ(runtime::Sha256::Hex(sha.Final()), "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+}
+
+TEST(RuntimeResultCache, KeysSeparateFields) {
+    EXPECT_NE(runtime::ResultKey().Add("ab").Add("c").Hex(), runtime::ResultKey().Add("a").Add("bc").Hex());
+    EXPECT_EQ(runtime::ResultKey().Add(0.5).Add(uint64_t{3}).Hex(),
+              runtime::ResultKey().Add(0.5).Add(uint64_t{3}).Hex());
+    EXPECT_NE(runtime::ResultKey().AddExecutable().Hex(), runtime::ResultKey().Hex());
+}
+
+TEST(RuntimeResultCache, StoreAndLookup) {
+    auto dir = std::filesystem::temp_directory_path() / ("result_cache_test_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+    runtime::ResultCache cache(dir.string());
+    std::string key = runtime::ResultKey().Add("StoreAndLookup").Hex();
+    runtime::CachedResult hit;
+    EXPECT_FALSE(cache.Lookup(key, &hit));
+
+    std::string payload(100000, '\0');
+    for (size_t i = 0; i < payload.size(); i++) payload[i] = static_cast<char>(i * 31);
+    ASSERT_TRUE(cache.Store(key, payload));
+    ASSERT_TRUE(cache.Lookup(key, &hit));
+    EXPECT_EQ(hit.view(), payload);
+
+    // Replacing an object leaves an open mapping of the old one intact
+    ASSERT_TRUE(cache.Store(key, std::string("new")));
+    EXPECT_EQ(hit.view(), payload);
+    runtime::CachedResult again;
+    ASSERT_TRUE(cache.Lookup(key, &again));
+    EXPECT_EQ(again.view(), "new");
+
+    std::string empty_key = runtime::ResultKey().Add("empty").Hex();
+    ASSERT_TRUE(cache.Store(empty_key, std::string()));
+    ASSERT_TRUE(cache.Lookup(empty_key, &hit));
+    EXPECT_EQ(hit.size(), 0u);
+
+    runtime::ResultCache disabled("-");
+    EXPECT_FALSE(disabled.enabled());
+    EXPECT_FALSE(disabled.Store(key, payload));
+    EXPECT_FALSE(disabled.Lookup(key, &hit));
+    std::filesystem::remove_all(dir);
+}
+
+// ---- Shadow execution (shadow_runner.h) ----
+
+namespace {
+
+// y = 2 x0 + x1, y' = x0 x1
+void ShadowLive(const double* in, double* out) {
+    out[0] = 2 * in[0] + in[1];
+    out[1] = in[0] * in[1];
+}
+
+} // namespace
+
+TEST(RuntimeShadowRunner, IdenticalCandidateAgrees) {
+    runtime::ShadowOptions opts;
+    opts.sample_fraction = 0.1;
+    opts.queue = 1 << 16;  // nothing dropped
+    opts.budget_ns = 0;
+    runtime::ShadowRunner<2, 2> shadow(ShadowLive, opts);
+    const int n = 100000;
+    for (int i = 0; i < n; i++) {
+        double in[2] = {0.001 * i, 1.0 - 0.002 * i}, out[2];
+        ShadowLive(in, out);
+        shadow.Offer(in, out);
+    }
+    shadow.Stop();
+    auto r = shadow.report();
+    EXPECT_EQ(r.calls, static_cast<uint64_t>(n));
+    EXPECT_NEAR(static_cast<double>(r.sampled) / n, 0.1, 0.01);
+    EXPECT_EQ(r.dropped, 0u);
+    EXPECT_EQ(r.compared, r.sampled);
+    EXPECT_EQ(r.offer_ns.total, r.sampled);
+    EXPECT_TRUE(r.agrees());
+    EXPECT_EQ(r.max_abs_error, 0.0);
+}
+
+TEST(RuntimeShadowRunner, ReportsDivergenceOutsideTolerance) {
+    runtime::ShadowOptions opts;
+    opts.sample_fraction = 1.0;
+    opts.queue = 4096;
+    opts.budget_ns = 0;
+    opts.max_examples = 3;
+    opts.tolerance = {1e-10, 1e-8};
+    // Relative error 1e-9 on output 0 everywhere (inside), and a real
+    // error on output 1 when x0 >= 0.5
+    auto candidate = [](const double* in, double* out) {
+        ShadowLive(in, out);
+        out[0] *= 1 + 1e-9;
+        if (in[0] >= 0.5) out[1] += 1e-6;
+    };
+    runtime::ShadowRunner<2, 2> shadow(candidate, opts);
+    int expected = 0;
+    for (int i = 0; i < 1000; i++) {
+        double in[2] = {0.001 * i, 3.0}, out[2];
+        ShadowLive(in, out);
+        shadow.Offer(in, out);
+        expected += in[0] >= 0.5;
+    }
+    shadow.Stop();
+    auto r = shadow.report();
+    EXPECT_EQ(r.compared, 1000u);
+    EXPECT_EQ(r.diverged, static_cast<uint64_t>(expected));
+    EXPECT_FALSE(r.agrees());
+    EXPECT_EQ(r.worst_output, 1);
+    EXPECT_NEAR(r.max_abs_error, 1e-6, 1e-12);
+    ASSERT_EQ(r.examples.size(), 3u);
+    EXPECT_EQ(r.examples[0].call, 501u);
+    EXPECT_EQ(r.examples[0].inputs[0], 0.5);
+    EXPECT_NEAR(r.examples[0].candidate[1] - r.examples[0].live[1], 1e-6, 1e-12);
+}
+
+TEST(RuntimeShadowRunner, NanOnOneSideDiverges) {
+    runtime::ShadowOptions opts;
+    opts.sample_fraction = 1.0;
+    opts.budget_ns = 0;
+    runtime::ShadowRunner<2, 2> shadow([](const double*, double* out) { out[0] = out[1] = std::nan(""); }, opts);
+    double in[2] = {1, 2}, live[2] = {std::nan(""), 5.0};
+    shadow.Offer(in, live);
+    shadow.Stop();
+    auto r = shadow.report();
+    EXPECT_EQ(r.diverged, 1u);
+    EXPECT_EQ(r.worst_output, 1);  // output 0 is NaN on both sides
+}
+
+// An infinite live output makes the tolerance infinite too; a finite or
+// opposite-signed candidate must still diverge
+TEST(RuntimeShadowRunner, InfinityAgainstAnythingElseDiverges) {
+    runtime::ShadowOptions opts;
+    opts.sample_fraction = 1.0;
+    opts.budget_ns = 0;
+    const double inf = std::numeric_limits<double>::infinity();
+    for (double candidate : {0.0, -inf}) {
+        runtime::ShadowRunner<2, 2> shadow(
+            [candidate](const double*, double* out) {
+                out[0] = candidate;
+                out[1] = 5.0;
+            },
+            opts);
+        double in[2] = {1, 2}, live[2] = {inf, 5.0};
+        shadow.Offer(in, live);
+        shadow.Stop();
+        auto r = shadow.report();
+        EXPECT_EQ(r.diverged, 1u) << candidate;
+        EXPECT_EQ(r.worst_output, 0) << candidate;
+        EXPECT_EQ(r.max_excess, inf) << candidate;
+        ASSERT_EQ(r.examples.size(), 1u) << candidate;
+        EXPECT_EQ(r.examples[0].candidate[0], candidate);
+    }
+}
+
+TEST(RuntimeShadowRunner, ToleranceIsReadFromVectorFile) {
+    auto path = std::filesystem::temp_directory_path() /
+                ("shadow_tolerance_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) +
+                 ".json");
+    {
+        std::ofstream f(path);
+        f << R"({"global_tolerance": {"absolute": 1e-6}, "test_cases": []})";
+    }
+    runtime::ShadowTolerance tol = runtime::read_shadow_tolerance(path.string());
+    EXPECT_EQ(tol.absolute, 1e-6);
+    EXPECT_EQ(tol.relative, runtime::ShadowTolerance().relative);  // omitted: default
+    std::filesystem::remove(path);
+    EXPECT_THROW(runtime::read_shadow_tolerance(path.string()), std::runtime_error);
+}
+
+// A stalled candidate fills the queue; the live path drops samples
+// instead of waiting
+TEST(RuntimeShadowRunner, FullQueueDropsWithoutBlocking) {
+    std::atomic<bool> release{false};
+    runtime::ShadowOptions opts;
+    opts.sample_fraction = 1.0;
+    opts.queue = 8;
+    opts.budget_ns = 0;
+    runtime::ShadowRunner<2, 2> shadow(
+        [&](const double* in, double* out) {
+            while (!release.load()) std::this_thread::sleep_for(std::chrono::microseconds(50));
+            ShadowLive(in, out);
+        },
+        opts);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 1000; i++) {
+        double in[2] = {1.0 * i, 2.0}, out[2];
+        ShadowLive(in, out);
+        shadow.Offer(in, out);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    release = true;
+    shadow.Stop();
+    auto r = shadow.report();
+    EXPECT_LT(seconds, 0.5);
+    EXPECT_EQ(r.sampled + r.dropped, 1000u);
+    EXPECT_LE(r.sampled, 9u);  // the queue, plus the call the worker holds
+    EXPECT_EQ(r.compared, r.sampled);
+    EXPECT_TRUE(r.agrees());
+}
+
+// An offer over budget pauses sampling for backoff_calls calls
+TEST(RuntimeShadowRunner, OverBudgetBacksOff) {
+    runtime::ShadowOptions opts;
+    opts.sample_fraction = 1.0;
+    opts.budget_ns = 1;  // every offer is over
+    opts.backoff_calls = 99;
+    runtime::ShadowRunner<2, 2> shadow(ShadowLive, opts);
+    for (int i = 0; i < 1000; i++) {
+        double in[2] = {1.0, 2.0}, out[2];
+        ShadowLive(in, out);
+        shadow.Offer(in, out);
+    }
+    shadow.Stop();
+    auto r = shadow.report();
+    EXPECT_EQ(r.sampled, 10u);  // calls 1, 101, 201, ...
+    EXPECT_EQ(r.over_budget, 10u);
+}
+
+// ---- Strided views (strided_span.h) ----
+
+TEST(RuntimeStridedSpan, FieldViewsReadAndWriteRecordsInPlace) {
+    struct Record {
+        int id;
+        double x, y;
+    };
+    std::vector<Record> records = {{1, 1.0, 10.0}, {2, 2.0, 20.0}, {3, 3.0, 30.0}};
+    runtime::StridedSpan<double> y = runtime::field(records, &Record::y);
+    ASSERT_EQ(y.size(), 3u);
+    EXPECT_EQ(y.stride(), static_cast<std::ptrdiff_t>(sizeof(Record)));
+    EXPECT_FALSE(y.contiguous());
+    EXPECT_EQ(y[2], 30.0);
+    y[1] = -20.0;
+    EXPECT_EQ(records[1].y, -20.0);
+
+    runtime::StridedSpan<const double> x = runtime::field(records, &Record::x);  // read-only
+    runtime::StridedSpan<const double> tail = x.subspan(1, 2);
+    EXPECT_EQ(tail.size(), 2u);
+    EXPECT_EQ(tail[0], 2.0);
+    EXPECT_EQ(tail[1], 3.0);
+
+    const std::vector<Record>& readonly = records;
+    EXPECT_EQ(runtime::field(readonly, &Record::y)[1], -20.0);
+    EXPECT_TRUE(runtime::field(readonly.data(), 0, &Record::y).empty());
+}
+
+TEST(RuntimeStridedSpan, ContiguousAndByteStrides) {
+    std::vector<double> v = {1.0, 2.0, 3.0};
+    runtime::StridedSpan<double> all = v;
+    EXPECT_TRUE(all.contiguous());
+    EXPECT_EQ(all.data(), v.data());
+    runtime::StridedSpan<const double> every_other(v.data(), 2, 2 * sizeof(double));
+    EXPECT_EQ(every_other[1], 3.0);
+
+    // Stride in bytes: 12-byte records of a 4-byte field
+    struct Reading {
+        float value;
+        char flags[8];
+    };
+    Reading readings[3] = {{0.5f, {}}, {1.5f, {}}, {2.5f, {}}};
+    runtime::StridedSpan<float> values = runtime::field(readings, 3, &Reading::value);
+    EXPECT_EQ(values.stride(), 12);
+    float sum = 0.0f;
+    for (size_t i = 0; i < values.size(); i++) sum += values[i];
+    EXPECT_EQ(sum, 4.5f);
+}
+
+// ---- Plugin host (plugin_host.h) ----
+
+namespace {
+
+struct FakeTable {
+    algorithm_plugin_info info;
+    double (*call)(double x);
+};
+
+double Twice(double x) { return 2 * x; }
+double Thrice(double x) { return 3 * x; }
+
+#define FAKE_SIGNATURE "in double x; out double y"
+
+const FakeTable kFakeV1 = {{ALGORITHM_PLUGIN_ABI_VERSION, sizeof(FakeTable), "fake", "1.0.0", FAKE_SIGNATURE}, Twice};
+const FakeTable kFakeV2 = {{ALGORITHM_PLUGIN_ABI_VERSION, sizeof(FakeTable), "fake", "2.0.0", FAKE_SIGNATURE}, Thrice};
+
+struct FakePlugin {
+    using Table = FakeTable;
+    static constexpr const char* kName = "fake";
+    static constexpr const char* kSymbol = ALGORITHM_PLUGIN_ENTRY_NAME(fake);
+    static constexpr const char* kSignature = FAKE_SIGNATURE;
+    static const Table* Builtin() { return &kFakeV1; }
+};
+
+} // namespace
+
+TEST(RuntimePluginHost, InstallSwapsAndRollbackRestores) {
+    runtime::PluginHost<FakePlugin> host;
+    EXPECT_EQ(host.version(), "1.0.0");
+    EXPECT_EQ(host.table().call(1.0), 2.0);
+    EXPECT_FALSE(host.Rollback());  // nothing swapped yet
+
+    ASSERT_TRUE(host.Install(&kFakeV2)) << host.error();
+    EXPECT_EQ(host.version(), "2.0.0");
+    EXPECT_EQ(host.table().call(1.0), 3.0);
+
+    ASSERT_TRUE(host.Rollback());
+    EXPECT_EQ(host.version(), "1.0.0");
+    EXPECT_FALSE(host.Rollback());  // one level deep
+    EXPECT_EQ(host.swaps(), 2u);
+}
+
+TEST(RuntimePluginHost, RejectsIncompatibleTables) {
+    runtime::PluginHost<FakePlugin> host;
+    FakeTable abi = kFakeV2, small = kFakeV2, other = kFakeV2, signature = kFakeV2;
+    abi.info.abi_version = ALGORITHM_PLUGIN_ABI_VERSION + 1;
+    small.info.size = sizeof(algorithm_plugin_info);
+    other.info.name = "kalman_filter";
+    signature.info.signature = "in double x; in double y; out double z";
+
+    EXPECT_FALSE(host.Install(nullptr));
+    EXPECT_FALSE(host.Install(&abi));
+    EXPECT_NE(host.error().find("ABI version"), std::string::npos) << host.error();
+    EXPECT_FALSE(host.Install(&small));
+    EXPECT_NE(host.error().find("bytes"), std::string::npos) << host.error();
+    EXPECT_FALSE(host.Install(&other));
+    EXPECT_NE(host.error().find("kalman_filter"), std::string::npos) << host.error();
+    EXPECT_FALSE(host.Install(&signature));
+    EXPECT_NE(host.error().find("signature"), std::string::npos) << host.error();
+    EXPECT_EQ(host.version(), "1.0.0");
+    EXPECT_EQ(host.swaps(), 0u);
+
+    // A newer plugin may have grown the table
+    FakeTable larger = kFakeV2;
+    larger.info.size = sizeof(FakeTable) + 16;
+    EXPECT_TRUE(host.Install(&larger)) << host.error();
+}
+
+TEST(RuntimePluginHost, FailedWarmUpKeepsLiveTable) {
+    runtime::PluginHost<FakePlugin> host;
+    int warmed = 0;
+    EXPECT_FALSE(host.Install(&kFakeV2, [&](const FakeTable& t) {
+        warmed++;
+        return t.call(1.0) == 2.0;  // V2 disagrees with the live version
+    }));
+    EXPECT_FALSE(host.Install(&kFakeV2, [](const FakeTable&) -> bool { throw std::runtime_error("boom"); }));
+    EXPECT_NE(host.error().find("boom"), std::string::npos) << host.error();
+    EXPECT_EQ(warmed, 1);
+    EXPECT_EQ(host.version(), "1.0.0");
+    EXPECT_FALSE(host.Rollback());
+}
+
+TEST(RuntimePluginHost, LoadReportsMissingLibrary) {
+    runtime::PluginHost<FakePlugin> host;
+    EXPECT_FALSE(host.Load("/nonexistent/libfake_plugin.so"));
+    EXPECT_FALSE(host.error().empty());
+    EXPECT_EQ(host.version(), "1.0.0");
+}
+
+// Readers calling through table() during swaps always see a whole table
+TEST(RuntimePluginHost, ReadersNeverSeeTornTables) {
+    runtime::PluginHost<FakePlugin> host;
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> bad{0}, reads{0};
+    std::thread reader([&] {
+        while (!stop.load(std::memory_order_relaxed)) {
+            const FakeTable& t = host.table();
+            double y = t.call(1.0);
+            if (!(y == 2.0 && t.info.version[0] == '1') && !(y == 3.0 && t.info.version[0] == '2')) bad++;
+            reads++;
+        }
+    });
+    for (int i = 0; i < 2000; i++) {
+        ASSERT_TRUE(host.Install(i % 2 ? &kFakeV1 : &kFakeV2));
+    }
+    while (reads.load() == 0) std::this_thread::yield();
+    stop = true;
+    reader.join();
+    EXPECT_EQ(bad.load(), 0u);
+}
@@ -0,0 +1,141 @@
+#ifndef RUNTIME_WORKER_POOL_H
+#define RUNTIME_WORKER_POOL_H
+
+// Persistent worker threads for repeated parallel batch calls
+// (hand-written, header-only, ships in the algorithm_runtime package).
+//
+// <algo>_soa_parallel(..., threads) starts and joins its threads on every
+// call, which costs tens of microseconds -- more than the kernel work of a
+// small batch. A WorkerPool starts its threads once and parks them between
+// calls; the generated <algo>_soa_parallel(..., executor) overload runs on
+// it:
+//
+//   runtime::WorkerPool pool(8);          // the caller plus 7 workers
+//   while (running) {
+//       kalman_filter::kalman_filter_soa_parallel(n, ..., pool);
+//   }
+//
+// run(tasks, fn) calls fn(t) once for each t in [0, tasks), on the workers
+// and on the calling thread, and returns when every call has finished.
+// fn must not throw. One run() at a time: the pool is owned by one
+// caller, not shared between threads.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace runtime {
+
+class WorkerPool {
+public:
+    // `threads`: participants including the calling thread (0: one per
+    // hardware thread)
+    explicit WorkerPool(int threads = 0) {
+        if (threads <= 0) threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        for (int t = 1; t < threads; t++) workers_.emplace_back([this] { WorkerLoop(); });
+    }
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto& w : workers_) w.join();
+    }
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    int size() const { return static_cast<int>(workers_.size()) + 1; }
+
+    template <class Fn>
+    void run(int tasks, Fn&& fn) {
+        if (tasks <= 0) return;
+        using F = std::remove_reference_t<Fn>;
+        if (workers_.empty() || tasks == 1) {
+            for (int t = 0; t < tasks; t++) fn(t);
+            return;
+        }
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            // A worker still leaving the previous run must not see this
+            // run's counter
+            Wait(done_, lock, [&] { return busy_ == 0; });
+            job_ = {[](void* f, int t) { (*static_cast<F*>(f))(t); }, &fn, tasks};
+            next_.store(0, std::memory_order_relaxed);
+            remaining_ = tasks;
+            generation_++;
+        }
+        wake_.notify_all();
+        Work(job_);
+        std::unique_lock<std::mutex> lock(mutex_);
+        Wait(done_, lock, [&] { return remaining_ == 0; });
+    }
+
+private:
+    struct Job {
+        void (*invoke)(void* fn, int t);
+        void* fn;
+        int tasks;
+    };
+
+    // condition_variable::wait() is an exported libstdc++ symbol whose
+    // version moved in GCC 12 (GLIBCXX_3.4.30), so binaries built with a
+    // newer compiler than the runtime library they load would not start;
+    // the timed wait is inline over pthread_cond_clockwait.
+    template <class Pred>
+    static void Wait(std::condition_variable& cv, std::unique_lock<std::mutex>& lock, Pred pred) {
+        while (!cv.wait_for(lock, std::chrono::seconds(1), pred)) {
+        }
+    }
+
+    // Claims tasks until none are left
+    void Work(const Job& job) {
+        int finished = 0;
+        for (int t; (t = next_.fetch_add(1, std::memory_order_relaxed)) < job.tasks; finished++) {
+            job.invoke(job.fn, t);
+        }
+        if (finished == 0) return;
+        std::lock_guard<std::mutex> lock(mutex_);
+        remaining_ -= finished;
+        if (remaining_ == 0) done_.notify_all();
+    }
+
+    void WorkerLoop() {
+        uint64_t seen = 0;
+        for (;;) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                Wait(wake_, lock, [&] { return stop_ || generation_ != seen; });
+                if (stop_) return;
+                seen = generation_;
+                job = job_;
+                busy_++;
+            }
+            Work(job);
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--busy_ == 0) done_.notify_all();
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wake_;  // workers: a new run or stop
+    std::condition_variable done_;  // caller: remaining_ or busy_ reached 0
+    Job job_ = {nullptr, nullptr, 0};
+    std::atomic<int> next_{0};
+    int remaining_ = 0;
+    int busy_ = 0;
+    uint64_t generation_ = 0;
+    bool stop_ = false;
+};
+
+} // namespace runtime
+
+#endif // RUNTIME_WORKER_POOL_H
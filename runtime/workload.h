@@ -0,0 +1,353 @@
+#ifndef RUNTIME_WORKLOAD_H
+#define RUNTIME_WORKLOAD_H
+
+// Synthetic sensor workloads (hand-written, header-only, ships in the
+// algorithm_runtime package).
+//
+// Load tests need many channels of realistic input -- tones, chirps, steps
+// and Gaussian noise -- produced faster than the algorithms consume them
+// and identical from run to run. Per-sample std::sin and hash-style noise
+// do not scale; here:
+//
+//   - randomness is Philox4x32-10 (philox.h): sample k of channel c is a
+//     pure function of (seed, c, k), so any slice of the data can be
+//     regenerated on any thread, in any chunking, with the same bits;
+//   - Gaussians come from Box-Muller, both outputs used, with the
+//     logarithm, square root and sine/cosine evaluated by fixed
+//     branch-free sequences (no libm), so results do not depend on the
+//     platform's math library and the loops vectorize;
+//   - tones and chirps advance by complex rotation (two multiplies per
+//     sample), re-anchored from the exact phase every kAnchorInterval
+//     samples so rounding cannot drift;
+//   - every inner loop runs across channels with no branches, the layout
+//     the compiler vectorizes.
+//
+// Signals are channel-interleaved (sample k of channel c at
+// [k * channels + c]), the layout of low_pass_filter_batch().
+//
+// The results are reproducible for a given build. Builds that contract
+// a * b + c into fused multiply-adds (-ffp-contract=fast with FMA
+// enabled, e.g. -march=native) round differently.
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "philox.h"
+
+namespace runtime {
+
+namespace detail {
+
+// ln(x) for normal x > 0 by argument reduction to [sqrt(1/2), sqrt(2))
+// and the atanh series; within a few ulp. Branch-free.
+inline double WorkloadLog(double x) {
+    uint64_t bits;
+    std::memcpy(&bits, &x, sizeof bits);
+    // x = m 2^e with m in [sqrt(1/2), sqrt(2)), in integer arithmetic (a
+    // floating-point compare and select would not vectorize at -O2)
+    const uint64_t mantissa = bits & 0x000FFFFFFFFFFFFFull;
+    const uint64_t high = (0x6A09E667F3BCCull - mantissa) >> 63;  // 1 if the mantissa > sqrt(2)
+    double e = static_cast<double>(static_cast<int32_t>(bits >> 52) - 1023 + static_cast<int32_t>(high));
+    bits = mantissa | ((0x3FFull - high) << 52);
+    double m;
+    std::memcpy(&m, &bits, sizeof m);
+
+    double s = (m - 1.0) / (m + 1.0);  // |s| <= 0.1716
+    double s2 = s * s;
+    double p = 1.0 / 25;
+    p = p * s2 + 1.0 / 23;
+    p = p * s2 + 1.0 / 21;
+    p = p * s2 + 1.0 / 19;
+    p = p * s2 + 1.0 / 17;
+    p = p * s2 + 1.0 / 15;
+    p = p * s2 + 1.0 / 13;
+    p = p * s2 + 1.0 / 11;
+    p = p * s2 + 1.0 / 9;
+    p = p * s2 + 1.0 / 7;
+    p = p * s2 + 1.0 / 5;
+    p = p * s2 + 1.0 / 3;
+    p = p * s2 + 1.0;
+    constexpr double kLn2Hi = 6.93147180369123816490e-01;  // 32 significant bits
+    constexpr double kLn2Lo = 1.90821492927058770002e-10;
+    return e * kLn2Hi + (2.0 * s * p + e * kLn2Lo);
+}
+
+// sqrt(x) for 0 <= x < 2^1000 to about an ulp: bit-trick estimate of
+// 1/sqrt(x), four Newton steps. std::sqrt sets errno on negative input,
+// which keeps compilers from vectorizing it unless -fno-math-errno is on.
+inline double WorkloadSqrt(double x) {
+    uint64_t bits;
+    std::memcpy(&bits, &x, sizeof bits);
+    bits = 0x5FE6EB50C7B537A9ull - (bits >> 1);
+    double y;
+    std::memcpy(&y, &bits, sizeof y);
+    const double h = 0.5 * x;
+    y = y * (1.5 - h * y * y);
+    y = y * (1.5 - h * y * y);
+    y = y * (1.5 - h * y * y);
+    y = y * (1.5 - h * y * y);
+    return x * y;
+}
+
+// sin and cos of 2 pi u for u in [0, 1): quadrant reduction (exact), then
+// Taylor series on [-pi/4, pi/4]. Branch-free.
+inline void WorkloadSinCos2Pi(double u, double* sin_out, double* cos_out) {
+    // Nearest quarter turn, 0..4 (truncation is floor here: no libm call,
+    // no rounding-mode instruction needed)
+    int32_t quarter = static_cast<int32_t>(4.0 * u + 0.5);
+    double x = 6.283185307179586 * (u - 0.25 * static_cast<double>(quarter));
+    double x2 = x * x;
+
+    double sp = -1.0 / 355687428096000.0;  // -1/17!
+    sp = sp * x2 + 1.0 / 1307674368000.0;
+    sp = sp * x2 - 1.0 / 6227020800.0;
+    sp = sp * x2 + 1.0 / 39916800.0;
+    sp = sp * x2 - 1.0 / 362880.0;
+    sp = sp * x2 + 1.0 / 5040.0;
+    sp = sp * x2 - 1.0 / 120.0;
+    sp = sp * x2 + 1.0 / 6.0;
+    double s = x - x * x2 * sp;  // sp holds the series of -(sin x - x) / x^3
+
+    double cp = 1.0 / 6402373705728000.0;  // 1/18!
+    cp = cp * x2 - 1.0 / 20922789888000.0;
+    cp = cp * x2 + 1.0 / 87178291200.0;
+    cp = cp * x2 - 1.0 / 479001600.0;
+    cp = cp * x2 + 1.0 / 3628800.0;
+    cp = cp * x2 - 1.0 / 40320.0;
+    cp = cp * x2 + 1.0 / 720.0;
+    cp = cp * x2 - 1.0 / 24.0;
+    cp = cp * x2 + 0.5;
+    double c = 1.0 - x2 * cp;
+
+    // Rotate by q quarter turns. The blends are exact: each weight is 0 or 1
+    double odd = static_cast<double>(quarter & 1);
+    double half = static_cast<double>((quarter >> 1) & 1);
+    double rs = (1.0 - odd) * s + odd * c;
+    double rc = (1.0 - odd) * c + odd * s;
+    *sin_out = (1.0 - 2.0 * half) * rs;
+    *cos_out = (1.0 - 2.0 * (odd + half - 2.0 * odd * half)) * rc;  // odd xor half
+}
+
+} // namespace detail
+
+// Standard normal pairs from kPhiloxLanes Philox4x32Lanes() blocks, for
+// callers that lay out their own counters (Box-Muller: words 0-1 the
+// radius, 2-3 the angle; z0 the cosine branch, z1 the sine)
+inline void BoxMullerLanes(const uint32_t w0[kPhiloxLanes], const uint32_t w1[kPhiloxLanes],
+                           const uint32_t w2[kPhiloxLanes], const uint32_t w3[kPhiloxLanes],
+                           double z0[kPhiloxLanes], double z1[kPhiloxLanes]) {
+    // Computed into locals: z0 and z1 might alias, which would stop the
+    // loop vectorizing
+    double cos_branch[kPhiloxLanes], sin_branch[kPhiloxLanes];
+    for (int l = 0; l < kPhiloxLanes; l++) {
+        double u1 = 1.0 - ToUnitDouble(w0[l], w1[l]);  // (0, 1]
+        double u2 = ToUnitDouble(w2[l], w3[l]);
+        double r = detail::WorkloadSqrt(-2.0 * detail::WorkloadLog(u1));
+        double s, c;
+        detail::WorkloadSinCos2Pi(u2, &s, &c);
+        cos_branch[l] = r * c;
+        sin_branch[l] = r * s;
+    }
+    for (int l = 0; l < kPhiloxLanes; l++) {
+        z0[l] = cos_branch[l];
+        z1[l] = sin_branch[l];
+    }
+}
+
+namespace detail {
+
+// out[i] for sample index first + i of (seed, stream), where counter block
+// j = {j, stream} yields samples 2j and 2j + 1: pairs(w0, w1, w2, w3, even,
+// odd) turns kPhiloxLanes consecutive blocks into those samples.
+template <class Pairs>
+void FillFromBlocks(double* out, size_t n, uint64_t seed, uint64_t stream, uint64_t first, Pairs pairs) {
+    const PhiloxKey key = {static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)};
+    size_t i = 0;
+    while (i < n) {
+        uint32_t w0[kPhiloxLanes], w1[kPhiloxLanes], w2[kPhiloxLanes], w3[kPhiloxLanes];
+        const uint64_t block0 = (first + i) / 2;
+        for (int l = 0; l < kPhiloxLanes; l++) {
+            w0[l] = static_cast<uint32_t>(block0 + l);
+            w1[l] = static_cast<uint32_t>((block0 + l) >> 32);
+            w2[l] = static_cast<uint32_t>(stream);
+            w3[l] = static_cast<uint32_t>(stream >> 32);
+        }
+        Philox4x32Lanes(w0, w1, w2, w3, key);
+        double even[kPhiloxLanes], odd[kPhiloxLanes];
+        pairs(w0, w1, w2, w3, even, odd);
+        // The first block may start on an odd sample
+        uint64_t sample = first + i;
+        for (; i < n && sample < 2 * (block0 + kPhiloxLanes); i++, sample++) {
+            size_t l = static_cast<size_t>(sample / 2 - block0);
+            out[i] = sample % 2 ? odd[l] : even[l];
+        }
+    }
+}
+
+} // namespace detail
+
+// out[i] = uniform [0, 1) for sample index first + i of (seed, stream):
+// the same sequence harness::CounterRng(seed, stream).NextUniform() draws.
+inline void FillUniform(double* out, size_t n, uint64_t seed, uint64_t stream, uint64_t first = 0) {
+    detail::FillFromBlocks(out, n, seed, stream, first,
+                           [](const uint32_t* w0, const uint32_t* w1, const uint32_t* w2,
+                              const uint32_t* w3, double* even, double* odd) {
+                               for (int l = 0; l < kPhiloxLanes; l++) {
+                                   even[l] = ToUnitDouble(w0[l], w1[l]);
+                                   odd[l] = ToUnitDouble(w2[l], w3[l]);
+                               }
+                           });
+}
+
+// out[i] = Gaussian(mean, stddev) for sample index first + i of
+// (seed, stream). Counter block j yields samples 2j and 2j + 1.
+inline void FillNormal(double* out, size_t n, double mean, double stddev, uint64_t seed,
+                       uint64_t stream, uint64_t first = 0) {
+    detail::FillFromBlocks(out, n, seed, stream, first,
+                           [&](const uint32_t* w0, const uint32_t* w1, const uint32_t* w2,
+                               const uint32_t* w3, double* even, double* odd) {
+                               BoxMullerLanes(w0, w1, w2, w3, even, odd);
+                               for (int l = 0; l < kPhiloxLanes; l++) {
+                                   even[l] = mean + stddev * even[l];
+                                   odd[l] = mean + stddev * odd[l];
+                               }
+                           });
+}
+
+// One channel of a synthetic sensor: a (chirped) tone plus offset, an
+// optional step and additive Gaussian noise.
+//   clean(t) = amplitude * sin(phase + 2 pi (frequency t + chirp_rate t^2 / 2))
+//              + offset + (t >= step_time ? step_height : 0)
+//   noisy(t) = clean(t) + N(0, noise_stddev^2)
+struct ChannelSpec {
+    double amplitude = 1.0;
+    double frequency = 1.0;    // Hz at t = 0
+    double chirp_rate = 0.0;   // Hz per second
+    double phase = 0.0;        // radians
+    double offset = 0.0;
+    double step_time = std::numeric_limits<double>::infinity();  // seconds; none by default
+    double step_height = 0.0;
+    double noise_stddev = 0.0;
+};
+
+constexpr int kAnchorInterval = 64;
+
+// Samples [first_sample, first_sample + n) of `channels` channels at
+// sample interval dt, interleaved (k * channels + c). `noisy` and/or
+// `clean` may be null. Noise for channel c is stream c of `seed`, so a
+// channel's data does not depend on how many channels are generated with
+// it, nor on how the samples are split into calls.
+inline void GenerateSignals(double* noisy, double* clean, int n, int channels, double dt,
+                            const ChannelSpec spec[], uint64_t seed, uint64_t first_sample = 0) {
+    if (n <= 0 || channels <= 0) return;
+    const size_t C = static_cast<size_t>(channels);
+    const PhiloxKey key = {static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)};
+    const size_t padded = (C + kPhiloxLanes - 1) / kPhiloxLanes * kPhiloxLanes;
+
+    // Per-channel state: tone z = amp * e^{i theta_k}, per-sample rotator
+    // r = e^{i dtheta_k}, chirp factor rr = e^{i 2 pi chirp_rate dt^2}; a
+    // pair of noise samples from one Philox block
+    std::vector<double> state(11 * C + 2 * padded);
+    double* z_re = state.data();
+    double* z_im = z_re + C;
+    double* r_re = z_im + C;
+    double* r_im = r_re + C;
+    double* rr_re = r_im + C;
+    double* rr_im = rr_re + C;
+    double* offset = rr_im + C;
+    double* step_time = offset + C;
+    double* step_height = step_time + C;
+    double* sigma = step_height + C;
+    double* base = sigma + C;        // offset + step, per channel for this sample
+    double* noise0 = base + C;       // even sample of the current pair
+    double* noise1 = noise0 + padded;
+
+    for (size_t c = 0; c < C; c++) {
+        offset[c] = spec[c].offset;
+        step_time[c] = spec[c].step_time;
+        step_height[c] = spec[c].step_height;
+        sigma[c] = spec[c].noise_stddev;
+    }
+
+    // Exact phase (in turns) and tone at absolute sample `s`
+    auto anchor = [&](uint64_t s) {
+        const double t = static_cast<double>(s) * dt;
+        for (size_t c = 0; c < C; c++) {
+            const ChannelSpec& p = spec[c];
+            double turns = p.phase / 6.283185307179586 + p.frequency * t + 0.5 * p.chirp_rate * t * t;
+            double dturns = p.frequency * dt + p.chirp_rate * dt * dt * (static_cast<double>(s) + 0.5);
+            double ddturns = p.chirp_rate * dt * dt;
+            double sn, cs;
+            detail::WorkloadSinCos2Pi(turns - std::floor(turns), &sn, &cs);
+            z_re[c] = p.amplitude * cs;
+            z_im[c] = p.amplitude * sn;
+            detail::WorkloadSinCos2Pi(dturns - std::floor(dturns), &sn, &cs);
+            r_re[c] = cs;
+            r_im[c] = sn;
+            detail::WorkloadSinCos2Pi(ddturns - std::floor(ddturns), &sn, &cs);
+            rr_re[c] = cs;
+            rr_im[c] = sn;
+        }
+    };
+    auto advance = [&] {
+        for (size_t c = 0; c < C; c++) {
+            double zr = z_re[c] * r_re[c] - z_im[c] * r_im[c];
+            double zi = z_re[c] * r_im[c] + z_im[c] * r_re[c];
+            double rr = r_re[c] * rr_re[c] - r_im[c] * rr_im[c];
+            double ri = r_re[c] * rr_im[c] + r_im[c] * rr_re[c];
+            z_re[c] = zr;
+            z_im[c] = zi;
+            r_re[c] = rr;
+            r_im[c] = ri;
+        }
+    };
+    // Noise pair `pair` (samples 2 pair, 2 pair + 1) for every channel
+    auto noise_pair = [&](uint64_t pair) {
+        for (size_t c0 = 0; c0 < padded; c0 += kPhiloxLanes) {
+            uint32_t w0[kPhiloxLanes], w1[kPhiloxLanes], w2[kPhiloxLanes], w3[kPhiloxLanes];
+            for (int l = 0; l < kPhiloxLanes; l++) {
+                w0[l] = static_cast<uint32_t>(pair);
+                w1[l] = static_cast<uint32_t>(pair >> 32);
+                w2[l] = static_cast<uint32_t>(c0 + l);
+                w3[l] = static_cast<uint32_t>(static_cast<uint64_t>(c0 + l) >> 32);
+            }
+            Philox4x32Lanes(w0, w1, w2, w3, key);
+            BoxMullerLanes(w0, w1, w2, w3, noise0 + c0, noise1 + c0);
+        }
+    };
+
+    // Start from the anchor at or before first_sample, as a single call
+    // from sample 0 would have
+    uint64_t s = first_sample - first_sample % kAnchorInterval;
+    anchor(s);
+    for (; s < first_sample; s++) advance();
+    if (noisy) noise_pair(first_sample / 2);
+
+    for (int k = 0; k < n; k++, s++) {
+        if (k > 0 && s % kAnchorInterval == 0) anchor(s);
+        if (noisy && k > 0 && s % 2 == 0) noise_pair(s / 2);
+
+        const double t = static_cast<double>(s) * dt;
+        for (size_t c = 0; c < C; c++) {
+            base[c] = offset[c] + (t >= step_time[c] ? step_height[c] : 0.0);
+        }
+        const double* noise = (s % 2 == 0) ? noise0 : noise1;
+        double* noisy_row = noisy ? noisy + static_cast<size_t>(k) * C : nullptr;
+        double* clean_row = clean ? clean + static_cast<size_t>(k) * C : nullptr;
+        if (clean_row) {
+            for (size_t c = 0; c < C; c++) clean_row[c] = z_im[c] + base[c];
+        }
+        if (noisy_row) {
+            for (size_t c = 0; c < C; c++) noisy_row[c] = z_im[c] + base[c] + sigma[c] * noise[c];
+        }
+        advance();
+    }
+}
+
+} // namespace runtime
+
+#endif // RUNTIME_WORKLOAD_H
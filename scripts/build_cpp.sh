@@ -57,6 +57,8 @@ cmake -S "${ALGO_DIR}/cpp" \
       -DBUILD_TESTING=ON \
       -DGENERATED_DIR="${ALGO_DIR}/generated" \
       -DTEST_VECTORS_DIR="${ALGO_DIR}/test_vectors" \
+      -DHARNESS_DIR="${REPO_ROOT}/harness" \
+      -DRUNTIME_DIR="${REPO_ROOT}/runtime" \
       -DALGORITHM_NAME="${ALGO}" \
       ${CONAN_TOOLCHAIN} \
       2>&1 | tee "${RESULTS_DIR}/cmake_configure.log"
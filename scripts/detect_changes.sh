@@ -5,11 +5,20 @@
 #
 # Output: writes one algorithm name per line to ${WORKSPACE}/changed_algorithms.txt
 # If no baseline is given, compares HEAD against HEAD~1.
+#
+# When shared infrastructure triggers a rebuild of every algorithm, those
+# whose own files did not change and whose stage results are in the result
+# cache (result_cache.sh) are restored into results/ instead of rebuilt;
+# they are listed in ${WORKSPACE}/cached_algorithms.txt. RESULT_CACHE=0
+# rebuilds them all.
 
 source "$(dirname "$0")/common.sh"
+source "$(dirname "$0")/result_cache.sh"
 
 BASELINE_COMMIT="${1:-}"
 OUTPUT_FILE="${WORKSPACE}/changed_algorithms.txt"
+CACHED_FILE="${WORKSPACE}/cached_algorithms.txt"
+: > "$CACHED_FILE"
 
 # Default baseline: previous commit
 if [ -z "$BASELINE_COMMIT" ]; then
@@ -40,28 +49,52 @@ while IFS= read -r file; do
     fi
 done <<< "$CHANGED_FILES"
 
+# Extract algorithm names from changed file paths
+while IFS= read -r file; do
+    if [[ "$file" =~ ^algorithms/([^/]+)/ ]]; then
+        algo="${BASH_REMATCH[1]}"
+        if [ -z "${seen_algos[$algo]:-}" ]; then
+            seen_algos[$algo]=1
+            # Verify it's actually an algorithm (has algorithm.yaml)
+            if [ -f "${REPO_ROOT}/algorithms/${algo}/algorithm.yaml" ]; then
+                ALGOS+=("$algo")
+            fi
+        fi
+    fi
+done <<< "$CHANGED_FILES"
+
 if [ "$REBUILD_ALL" = true ]; then
     log_info "Shared infrastructure changed — rebuilding all algorithms"
+    MATLAB_AVAILABLE=false
+    [ -x "${MATLAB_ROOT}/bin/matlab" ] && MATLAB_AVAILABLE=true
+    CACHED=()
     for dir in "${REPO_ROOT}"/algorithms/*/; do
         algo=$(basename "$dir")
-        if [ -f "$dir/algorithm.yaml" ]; then
-            ALGOS+=("$algo")
+        if [ ! -f "$dir/algorithm.yaml" ] || [ -n "${seen_algos[$algo]:-}" ]; then
+            continue
         fi
-    done
-else
-    # Extract algorithm names from changed file paths
-    while IFS= read -r file; do
-        if [[ "$file" =~ ^algorithms/([^/]+)/ ]]; then
-            algo="${BASH_REMATCH[1]}"
-            if [ -z "${seen_algos[$algo]:-}" ]; then
-                seen_algos[$algo]=1
-                # Verify it's actually an algorithm (has algorithm.yaml)
-                if [ -f "${REPO_ROOT}/algorithms/${algo}/algorithm.yaml" ]; then
-                    ALGOS+=("$algo")
-                fi
+        # Unchanged algorithm: skip it if every stage it would run is cached
+        cpp_key=$(result_cache_key "$algo" cpp)
+        if result_cache_has "$cpp_key"; then
+            if [ "$MATLAB_AVAILABLE" = false ]; then
+                result_cache_restore "$cpp_key" "$(ensure_results_dir "$algo" cpp)"
+                CACHED+=("$algo")
+                continue
+            fi
+            equivalence_key=$(result_cache_key "$algo" equivalence)
+            if result_cache_has "$equivalence_key"; then
+                result_cache_restore "$cpp_key" "$(ensure_results_dir "$algo" cpp)"
+                result_cache_restore "$equivalence_key" "$(ensure_results_dir "$algo" equivalence)"
+                CACHED+=("$algo")
+                continue
             fi
         fi
-    done <<< "$CHANGED_FILES"
+        ALGOS+=("$algo")
+    done
+    if [ ${#CACHED[@]} -gt 0 ]; then
+        printf "%s\n" "${CACHED[@]}" > "$CACHED_FILE"
+        log_info "Unchanged with cached results: ${CACHED[*]}"
+    fi
 fi
 
 # Write output
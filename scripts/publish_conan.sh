@@ -36,6 +36,11 @@ conan remote add nexus "$NEXUS_URL" --force 2>/dev/null || true
 
 # Set GENERATED_DIR for the Conan build
 export GENERATED_DIR="${ALGO_DIR}/generated"
+# Wrapper generator inputs (algorithm.yaml signature, cmake/GenerateWrappers.cmake)
+export ALGORITHM_YAML="${ALGO_DIR}/algorithm.yaml"
+export CMAKE_MODULES_DIR="${REPO_ROOT}/cmake"
+# Header-only runtime helpers (calibrate_batch() is built on them)
+export RUNTIME_DIR="${REPO_ROOT}/runtime"
 
 # Ensure Conan has a default profile
 conan profile detect --exist-ok 2>/dev/null || true
@@ -59,6 +64,28 @@ conan create "${ALGO_DIR}/cpp" \
     --build=missing \
     2>&1 < /dev/null | tee "${WORKSPACE}/results/${ALGO}/conan_create.log"
 
+# Header-only variant (-o <algo>/*:header_only=True); one binary for all settings
+conan create "${ALGO_DIR}/cpp" \
+    --name="${ALGO}" \
+    --version="${NEW_VERSION}" \
+    -pr="$CONAN_PROFILE" \
+    -o "${ALGO}/*:header_only=True" \
+    --build=missing \
+    2>&1 < /dev/null | tee -a "${WORKSPACE}/results/${ALGO}/conan_create.log"
+
+# Profile-guided variant (-o <algo>/*:pgo=True); trains on the test vectors
+# and, when present, the algorithm's replay log
+export HARNESS_DIR="${REPO_ROOT}/harness"
+export TEST_VECTORS_DIR="${ALGO_DIR}/test_vectors"
+export PGO_REPLAY_LOG="${PGO_REPLAY_LOG:-${ALGO_DIR}/replay/replay.jsonl}"
+conan create "${ALGO_DIR}/cpp" \
+    --name="${ALGO}" \
+    --version="${NEW_VERSION}" \
+    -pr="$CONAN_PROFILE" \
+    -o "${ALGO}/*:pgo=True" \
+    --build=missing \
+    2>&1 < /dev/null | tee -a "${WORKSPACE}/results/${ALGO}/conan_create.log"
+
 # Re-enable nexus remote and login for upload
 conan remote enable nexus 2>/dev/null || true
 conan remote login nexus "$NEXUS_USER" -p "$NEXUS_PASS" < /dev/null
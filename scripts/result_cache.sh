@@ -0,0 +1,124 @@
+#!/bin/bash
+# result_cache.sh — Content-addressed cache of per-algorithm stage results.
+#
+# Source after common.sh:
+#   source "$(dirname "$0")/result_cache.sh"
+#
+# A stage's results (results/<algo>/<stage>/) are stored under a key that
+# hashes everything they are computed from: the algorithm's generated code,
+# hand-written C++, test vectors and algorithm.yaml (and those of its
+# dependencies), the shared harness/runtime/cmake/conan trees, the scripts
+# that build and run the stage, and the compiler version and flags. Same
+# key, same results, so an unchanged run is served from the cache instead
+# of rebuilt and rerun.
+#
+# Stages: cpp (run_cpp_tests.sh) and equivalence (run_equivalence.sh, which
+# also hashes matlab/ and the MATLAB install path).
+#
+# Objects are tarballs at ${RESULT_CACHE_DIR}/<key[0:2]>/<key[2:]>.tar, the
+# layout the C++ tools also use for their own results (.bin objects,
+# runtime/result_cache.h). They are written to a temporary name and
+# renamed, so concurrent stages never see half an object. Only passing runs
+# are stored. Delete the directory at any time to clear the cache.
+#
+# Environment:
+#   RESULT_CACHE=0      disable lookups and stores
+#   RESULT_CACHE_DIR    store location (default: $MATLAB_ALGORITHMS_RESULT_CACHE,
+#                       else ${XDG_CACHE_HOME:-~/.cache}/matlab_algorithms/results)
+
+RESULT_CACHE="${RESULT_CACHE:-1}"
+RESULT_CACHE_DIR="${RESULT_CACHE_DIR:-${MATLAB_ALGORITHMS_RESULT_CACHE:-${XDG_CACHE_HOME:-${HOME:-/tmp}/.cache}/matlab_algorithms/results}}"
+
+# Dependencies listed in algorithm.yaml (`dependencies: [a, b]` or a list)
+read_algo_dependencies() {
+    local algo="$1"
+    local yaml_file="${REPO_ROOT}/algorithms/${algo}/algorithm.yaml"
+
+    awk '/^dependencies:/{
+             sub(/^dependencies:[[:space:]]*/, "");
+             if ($0 ~ /^\[/) { gsub(/[][,"]/, " "); n = split($0, a, " "); for (i = 1; i <= n; i++) print a[i]; exit }
+             found = 1; next
+         }
+         found && /^[[:space:]]+-/{gsub(/^[[:space:]]+-[[:space:]]*/, ""); gsub(/"/, ""); print}
+         found && /^[a-z]/{exit}' "$yaml_file"
+}
+
+# sha256 of each file under the given paths (relative to the repo root), in
+# a stable order; missing paths are skipped
+_result_cache_hash_tree() {
+    (
+        cd "$REPO_ROOT"
+        for path in "$@"; do
+            [ -e "$path" ] || continue
+            find "$path" -type f ! -name '*.pyc' ! -path '*/__pycache__/*' -print0
+        done | LC_ALL=C sort -z | xargs -0 -r sha256sum
+    )
+}
+
+# result_cache_key <algo> <stage> — prints the cache key
+result_cache_key() {
+    local algo="$1"
+    local stage="$2"
+    local algos=("$algo")
+    local dep
+    while IFS= read -r dep; do
+        [ -n "$dep" ] && algos+=("$dep")
+    done < <(read_algo_dependencies "$algo")
+
+    local paths=(harness runtime cmake conan scripts/common.sh scripts/build_cpp.sh scripts/result_cache.sh)
+    local a
+    for a in "${algos[@]}"; do
+        paths+=("algorithms/${a}/generated" "algorithms/${a}/cpp" "algorithms/${a}/test_vectors"
+                "algorithms/${a}/algorithm.yaml")
+    done
+    case "$stage" in
+        cpp)         paths+=(scripts/run_cpp_tests.sh) ;;
+        equivalence) paths+=(scripts/run_cpp_tests.sh scripts/run_matlab_tests.sh scripts/run_equivalence.sh)
+                     for a in "${algos[@]}"; do paths+=("algorithms/${a}/matlab"); done ;;
+        *)           log_error "result_cache_key: unknown stage '${stage}'"; return 1 ;;
+    esac
+
+    {
+        echo "stage ${stage} algorithm ${algo}"
+        echo "compiler $("${CXX:-c++}" --version 2>/dev/null | head -1)"
+        echo "flags ${CXXFLAGS:-} ${LDFLAGS:-}"
+        [ "$stage" = equivalence ] && echo "matlab ${MATLAB_ROOT}"
+        _result_cache_hash_tree "${paths[@]}"
+    } | sha256sum | cut -c1-64
+}
+
+_result_cache_object() {
+    echo "${RESULT_CACHE_DIR}/${1:0:2}/${1:2}.tar"
+}
+
+# result_cache_has <key> — succeeds if the key is stored
+result_cache_has() {
+    [ "$RESULT_CACHE" != 0 ] && [ -f "$(_result_cache_object "$1")" ]
+}
+
+# result_cache_restore <key> <dir> — unpacks a stored result into <dir>;
+# fails (leaving <dir> alone) on a miss
+result_cache_restore() {
+    local key="$1"
+    local dir="$2"
+    result_cache_has "$key" || return 1
+    mkdir -p "$dir"
+    tar -xf "$(_result_cache_object "$key")" -C "$dir"
+}
+
+# result_cache_store <key> <dir> — stores the contents of <dir> under <key>
+result_cache_store() {
+    local key="$1"
+    local dir="$2"
+    [ "$RESULT_CACHE" != 0 ] || return 0
+    local object
+    object=$(_result_cache_object "$key")
+    mkdir -p "$(dirname "$object")"
+    local tmp="${object}.tmp.$$"
+    if tar -cf "$tmp" -C "$dir" . && mv -f "$tmp" "$object"; then
+        log_info "Results stored in cache (${key:0:12})"
+    else
+        rm -f "$tmp"
+        log_warn "Could not store results in ${RESULT_CACHE_DIR}"
+    fi
+}
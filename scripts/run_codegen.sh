@@ -5,6 +5,8 @@
 #
 # Invokes the algorithm's codegen_config.m, which configures and runs
 # MATLAB Coder. Generated C++ source is written to algorithms/<name>/generated/.
+# The wrappers described by the algorithm.yaml signature are then checked
+# and written to results/<name>/wrappers/.
 
 source "$(dirname "$0")/common.sh"
 
@@ -48,6 +50,18 @@ if [ "$CPP_COUNT" -eq 0 ]; then
     exit 1
 fi
 
+# Check the algorithm.yaml signature against the new header and write the
+# batch/parallel/streaming wrappers (the CMake build regenerates them too)
+log_info "Generating wrappers from the algorithm.yaml signature..."
+if ! cmake -DALGO_NAME="$ALGO" \
+        -DALGORITHM_YAML="${ALGO_DIR}/algorithm.yaml" \
+        -DGENERATED_DIR="$GEN_DIR" \
+        -DOUTPUT_DIR="${RESULTS_DIR}/wrappers" \
+        -P "${REPO_ROOT}/cmake/GenerateWrappers.cmake" 2>&1 | tee "${RESULTS_DIR}/wrappers.log"; then
+    log_error "Wrapper generation failed; update the signature: section of algorithm.yaml"
+    exit 1
+fi
+
 # Record generated file manifest
 find "$GEN_DIR" -type f | sort > "${RESULTS_DIR}/generated_manifest.txt"
 
@@ -0,0 +1,47 @@
+#!/bin/bash
+# run_consistency.sh — Monte Carlo NEES/NIS consistency check of an
+# estimator (currently kalman_filter) on its own motion model.
+#
+# Usage: bash scripts/run_consistency.sh <algorithm_name> [runs] [steps] [seed]
+#
+# Simulates `runs` independent trajectories of `steps` steps each
+# (default 10000 x 10000), runs the batch filter over them on all cores and
+# writes per-step NEES/NIS averages with their 95% chi-square bands to
+# results/<algo>/consistency/. Algorithms without a consistency model
+# (no cpp/<algo>_consistency_main.cpp) are skipped.
+# CONSISTENCY_RUNS / CONSISTENCY_STEPS / CONSISTENCY_SEED may also be set
+# in the environment. A report for an unchanged build and the same options
+# comes from the result cache (result_cache.sh); RESULT_CACHE=0 reruns it.
+
+source "$(dirname "$0")/common.sh"
+source "$(dirname "$0")/result_cache.sh"
+
+ALGO="${1:?Usage: run_consistency.sh <algorithm_name> [runs] [steps] [seed]}"
+RUNS="${2:-${CONSISTENCY_RUNS:-10000}}"
+STEPS="${3:-${CONSISTENCY_STEPS:-10000}}"
+SEED="${4:-${CONSISTENCY_SEED:-1}}"
+BUILD_DIR="${WORKSPACE}/build/${ALGO}"
+CHECKER="${BUILD_DIR}/consistency_${ALGO}"
+
+if [ ! -f "${REPO_ROOT}/algorithms/${ALGO}/cpp/${ALGO}_consistency_main.cpp" ]; then
+    log_info "No consistency model for ${ALGO}; skipping"
+    exit 0
+fi
+
+if [ ! -x "$CHECKER" ]; then
+    log_error "Consistency checker not found: $CHECKER. Run build_cpp.sh first."
+    exit 1
+fi
+
+REPORT_DIR=$(ensure_results_dir "$ALGO" "consistency")
+
+log_info "Consistency of ${ALGO}: ${RUNS} runs x ${STEPS} steps, seed ${SEED}"
+
+CACHE_ARGS=(--cache-dir "$RESULT_CACHE_DIR")
+[ "$RESULT_CACHE" = 0 ] && CACHE_ARGS=(--no-cache)
+
+"$CHECKER" --runs "$RUNS" --steps "$STEPS" --seed "$SEED" "${CACHE_ARGS[@]}" \
+           --report "${REPORT_DIR}/consistency_report.json" \
+           2>&1 | tee "${REPORT_DIR}/consistency_output.log"
+
+log_info "Consistency check passed for: $ALGO"
@@ -5,13 +5,22 @@
 #
 # Runs CTest in the algorithm's build directory. The test binary also writes
 # cpp_outputs.json for later equivalence comparison with MATLAB.
+# Results of an unchanged algorithm are served from the result cache
+# (result_cache.sh) instead; RESULT_CACHE=0 always runs the tests.
 
 source "$(dirname "$0")/common.sh"
+source "$(dirname "$0")/result_cache.sh"
 
 ALGO="${1:?Usage: run_cpp_tests.sh <algorithm_name>}"
 BUILD_DIR="${WORKSPACE}/build/${ALGO}"
 RESULTS_DIR=$(ensure_results_dir "$ALGO" "cpp")
 
+CACHE_KEY=$(result_cache_key "$ALGO" cpp)
+if result_cache_restore "$CACHE_KEY" "$RESULTS_DIR"; then
+    log_info "C++ test results for ${ALGO} served from cache (${CACHE_KEY:0:12}); tests not rerun"
+    exit 0
+fi
+
 if [ ! -d "$BUILD_DIR" ]; then
     log_error "Build directory not found: $BUILD_DIR. Run build_cpp.sh first."
     exit 1
@@ -35,4 +44,11 @@ if [ -f "${BUILD_DIR}/test_outputs/cpp_outputs.json" ]; then
     log_info "C++ outputs saved for equivalence check"
 fi
 
+# Path x case matrix (scalar vs batch / threaded paths)
+if [ -f "${BUILD_DIR}/test_outputs/${ALGO}_equivalence_matrix.json" ]; then
+    cp "${BUILD_DIR}/test_outputs/${ALGO}_equivalence_matrix.json" "${RESULTS_DIR}/equivalence_matrix.json"
+fi
+
+result_cache_store "$CACHE_KEY" "$RESULTS_DIR"
+
 log_info "C++ tests passed for: $ALGO"
@@ -6,14 +6,23 @@
 # Reads matlab_outputs.json and cpp_outputs.json (produced by earlier stages),
 # compares actual outputs element-by-element within the defined tolerances.
 # This is the critical quality gate: if MATLAB and C++ disagree, the pipeline stops.
+# A passing report for unchanged MATLAB and C++ inputs is served from the
+# result cache (result_cache.sh); RESULT_CACHE=0 always compares.
 
 source "$(dirname "$0")/common.sh"
+source "$(dirname "$0")/result_cache.sh"
 
 ALGO="${1:?Usage: run_equivalence.sh <algorithm_name>}"
 MATLAB_RESULTS="${WORKSPACE}/results/${ALGO}/matlab/matlab_outputs.json"
 CPP_RESULTS="${WORKSPACE}/results/${ALGO}/cpp/cpp_outputs.json"
 REPORT_DIR=$(ensure_results_dir "$ALGO" "equivalence")
 
+CACHE_KEY=$(result_cache_key "$ALGO" equivalence)
+if result_cache_restore "$CACHE_KEY" "$REPORT_DIR"; then
+    log_info "Equivalence report for ${ALGO} served from cache (${CACHE_KEY:0:12}); comparison not rerun"
+    exit 0
+fi
+
 # Verify both output files exist
 if [ ! -f "$MATLAB_RESULTS" ]; then
     log_error "MATLAB outputs not found: $MATLAB_RESULTS"
@@ -161,4 +170,6 @@ if not all_passed:
 print(f"\nEQUIVALENCE CHECK PASSED for {algo_name}")
 PYEOF
 
+result_cache_store "$CACHE_KEY" "$REPORT_DIR"
+
 log_info "Equivalence check passed for: $ALGO"
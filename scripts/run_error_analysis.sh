@@ -0,0 +1,30 @@
+#!/bin/bash
+# run_error_analysis.sh — ULP / error-distribution analysis of the kernel
+# variants of a single algorithm (FMA, reassociated, float, ...).
+#
+# Usage: bash scripts/run_error_analysis.sh <algorithm_name> [fuzz_cases]
+#
+# Runs every variant in cpp/<algo>_variants.h over the JSON test vectors and
+# a fuzz corpus, and writes histograms, cancellation sites and per-variant
+# tolerance recommendations to results/<algo>/error_analysis/.
+
+source "$(dirname "$0")/common.sh"
+
+ALGO="${1:?Usage: run_error_analysis.sh <algorithm_name> [fuzz_cases]}"
+FUZZ_CASES="${2:-1000000}"
+BUILD_DIR="${WORKSPACE}/build/${ALGO}"
+REPORT_DIR=$(ensure_results_dir "$ALGO" "error_analysis")
+ANALYZER="${BUILD_DIR}/ulp_${ALGO}"
+
+if [ ! -x "$ANALYZER" ]; then
+    log_error "Analyzer not found: $ANALYZER. Run build_cpp.sh first."
+    exit 1
+fi
+
+log_info "Analyzing kernel variants of ${ALGO} (${FUZZ_CASES} fuzz cases)"
+
+"$ANALYZER" --fuzz-cases "$FUZZ_CASES" \
+            --report "${REPORT_DIR}/error_analysis.json" \
+            2>&1 | tee "${REPORT_DIR}/error_analysis.log"
+
+log_info "Error analysis written to ${REPORT_DIR}/error_analysis.json"
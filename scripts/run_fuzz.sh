@@ -0,0 +1,32 @@
+#!/bin/bash
+# run_fuzz.sh — Randomized equivalence fuzzing of generated C++ against the
+# long double reference, for a single algorithm.
+#
+# Usage: bash scripts/run_fuzz.sh <algorithm_name> [cases] [seed]
+#
+# Samples inputs inside the operating envelope declared in
+# test_vectors/schema.json and reports worst-case errors plus shrunk
+# reproducers (paste-ready test vectors) in results/<algo>/fuzz/.
+# FUZZ_CASES / FUZZ_SEED may also be set in the environment.
+
+source "$(dirname "$0")/common.sh"
+
+ALGO="${1:?Usage: run_fuzz.sh <algorithm_name> [cases] [seed]}"
+CASES="${2:-${FUZZ_CASES:-1000000}}"
+SEED="${3:-${FUZZ_SEED:-1}}"
+BUILD_DIR="${WORKSPACE}/build/${ALGO}"
+REPORT_DIR=$(ensure_results_dir "$ALGO" "fuzz")
+FUZZER="${BUILD_DIR}/fuzz_${ALGO}"
+
+if [ ! -x "$FUZZER" ]; then
+    log_error "Fuzzer not found: $FUZZER. Run build_cpp.sh first."
+    exit 1
+fi
+
+log_info "Fuzzing ${ALGO}: ${CASES} cases, seed ${SEED}"
+
+"$FUZZER" --cases "$CASES" --seed "$SEED" \
+          --report "${REPORT_DIR}/fuzz_report.json" \
+          2>&1 | tee "${REPORT_DIR}/fuzz_output.log"
+
+log_info "Fuzzing passed for: $ALGO"
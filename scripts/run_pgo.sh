@@ -0,0 +1,121 @@
+#!/bin/bash
+# run_pgo.sh — Profile-guided optimized build of a single algorithm,
+# benchmarked against the default Release build.
+#
+# Usage: bash scripts/run_pgo.sh <algorithm_name> [replay_log]
+#
+#   1. Release build: the linux-gcc12-release baseline
+#   2. Instrumented build (PGO_MODE=generate), trained by bench_<algo> on
+#      the test vectors, the replay log and schema-envelope samples
+#   3. Rebuild from the profile with LTO (PGO_MODE=use)
+#   4. bench_<algo> from both builds on the same workload, alternated over
+#      PGO_BENCH_ROUNDS rounds (default 3), best time per path
+#
+# The replay log defaults to algorithms/<algo>/replay/replay.jsonl when it
+# exists (PGO_REPLAY_LOG may also be set). Reports go to results/<algo>/pgo/.
+# The published PGO package is built the same way by the Conan option
+# pgo=True (see publish_conan.sh).
+
+source "$(dirname "$0")/common.sh"
+
+ALGO="${1:?Usage: run_pgo.sh <algorithm_name> [replay_log]}"
+ALGO_DIR="${REPO_ROOT}/algorithms/${ALGO}"
+REPLAY_LOG="${2:-${PGO_REPLAY_LOG:-${ALGO_DIR}/replay/replay.jsonl}}"
+PGO_ROOT="${WORKSPACE}/build/${ALGO}-pgo"
+REPORT_DIR=$(ensure_results_dir "$ALGO" "pgo")
+
+validate_algorithm "$ALGO"
+
+CMAKE_ARGS=(
+    -DCMAKE_BUILD_TYPE=Release
+    -DBUILD_TESTING=OFF
+    -DGENERATED_DIR="${ALGO_DIR}/generated"
+    -DTEST_VECTORS_DIR="${ALGO_DIR}/test_vectors"
+    -DHARNESS_DIR="${REPO_ROOT}/harness"
+    -DRUNTIME_DIR="${REPO_ROOT}/runtime"
+)
+# Reuse the Conan toolchain from build_cpp.sh (nlohmann_json) when present
+TOOLCHAIN_FILE=$(find "${WORKSPACE}/build/${ALGO}/conan" -name "conan_toolchain.cmake" -print -quit 2>/dev/null || true)
+if [ -n "$TOOLCHAIN_FILE" ]; then
+    CMAKE_ARGS+=("-DCMAKE_TOOLCHAIN_FILE=${TOOLCHAIN_FILE}")
+fi
+
+BENCH_ARGS=()
+if [ -f "$REPLAY_LOG" ]; then
+    BENCH_ARGS+=(--replay "$REPLAY_LOG")
+    log_info "Replay log: $REPLAY_LOG"
+else
+    log_warn "No replay log at $REPLAY_LOG — training on test vectors and envelope samples only"
+fi
+
+rm -rf "$PGO_ROOT"
+BASELINE_DIR="${PGO_ROOT}/baseline"
+PGO_DIR="${PGO_ROOT}/pgo"
+PROFILE_DIR="${PGO_ROOT}/profile"
+
+log_info "Baseline Release build for: $ALGO"
+cmake -S "${ALGO_DIR}/cpp" -B "$BASELINE_DIR" "${CMAKE_ARGS[@]}" -DBUILD_BENCHMARKS=ON \
+      > "${REPORT_DIR}/baseline_build.log" 2>&1
+cmake --build "$BASELINE_DIR" --target "bench_${ALGO}" --parallel "$(nproc 2>/dev/null || echo 4)" \
+      >> "${REPORT_DIR}/baseline_build.log" 2>&1
+
+log_info "Instrumented build and training run..."
+cmake -S "${ALGO_DIR}/cpp" -B "$PGO_DIR" "${CMAKE_ARGS[@]}" \
+      -DPGO_MODE=generate -DPGO_PROFILE_DIR="$PROFILE_DIR" \
+      > "${REPORT_DIR}/pgo_build.log" 2>&1
+cmake --build "$PGO_DIR" --target "bench_${ALGO}" --parallel "$(nproc 2>/dev/null || echo 4)" \
+      >> "${REPORT_DIR}/pgo_build.log" 2>&1
+"${PGO_DIR}/bench_${ALGO}" "${BENCH_ARGS[@]}" --min-time 0.05 --repeats 1 \
+      > "${REPORT_DIR}/training.log" 2>&1
+
+log_info "Rebuilding with profile + LTO..."
+cmake -S "${ALGO_DIR}/cpp" -B "$PGO_DIR" -DPGO_MODE=use >> "${REPORT_DIR}/pgo_build.log" 2>&1
+cmake --build "$PGO_DIR" --target "bench_${ALGO}" --parallel "$(nproc 2>/dev/null || echo 4)" \
+      >> "${REPORT_DIR}/pgo_build.log" 2>&1
+
+# Alternate the two builds over several rounds and keep each path's best,
+# so drift in machine load hits both sides alike
+ROUNDS="${PGO_BENCH_ROUNDS:-3}"
+log_info "Benchmarking baseline vs PGO (${ROUNDS} alternating rounds)..."
+for round in $(seq 1 "$ROUNDS"); do
+    for variant in baseline pgo; do
+        "${PGO_ROOT}/${variant}/bench_${ALGO}" "${BENCH_ARGS[@]}" \
+            --report "${REPORT_DIR}/bench_${variant}_${round}.json" \
+            >> "${REPORT_DIR}/bench_${variant}.log"
+    done
+done
+
+python3 - "$REPORT_DIR" "$ROUNDS" <<'PYEOF'
+import json, sys, os
+
+report_dir, rounds = sys.argv[1], int(sys.argv[2])
+
+def best_of_rounds(variant):
+    best = {}
+    for i in range(1, rounds + 1):
+        with open(os.path.join(report_dir, "bench_%s_%d.json" % (variant, i))) as f:
+            report = json.load(f)
+        for r in report["results"]:
+            ns = r["best_ns_per_element"]
+            best[r["path"]] = min(ns, best.get(r["path"], ns))
+    return report, best
+
+_, baseline = best_of_rounds("baseline")
+report, pgo = best_of_rounds("pgo")
+
+rows = []
+print("\n  %-20s %12s %12s %9s" % ("path", "release ns", "pgo ns", "speedup"))
+for path, ns in pgo.items():
+    if path not in baseline:
+        continue
+    speedup = baseline[path] / ns
+    rows.append({"path": path, "release_ns_per_element": baseline[path],
+                 "pgo_ns_per_element": ns, "speedup": speedup})
+    print("  %-20s %12.2f %12.2f %8.2fx" % (path, baseline[path], ns, speedup))
+
+with open(os.path.join(report_dir, "pgo_comparison.json"), "w") as f:
+    json.dump({"algorithm": report["algorithm"], "workload": report["workload"],
+               "rounds": rounds, "paths": rows}, f, indent=2)
+PYEOF
+
+log_info "PGO comparison written to ${REPORT_DIR}/pgo_comparison.json"